@@ -232,6 +232,76 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
        */
       static bool TestFileWriteAppend();
 
+      /**
+       * FAT12 volume sync test.
+       * @return
+       *   True on success.
+       */
+      static bool TestSync();
+
+      /**
+       * FAT12 multi-cluster write and scattered read test.
+       * @return
+       *   True on success.
+       */
+      static bool TestExtents();
+
+      /**
+       * FAT12 multi-sector read test.
+       * @return
+       *   True on success.
+       */
+      static bool TestCoalescedRead();
+
+      /**
+       * FAT12 sector-aligned write test.
+       * @return
+       *   True on success.
+       */
+      static bool TestAlignedWrite();
+
+      /**
+       * FAT12 interleaved growth with size hints test.
+       * @return
+       *   True on success.
+       */
+      static bool TestInterleavedGrowth();
+
+      /**
+       * FAT12 directory listing across a mutation test.
+       * @return
+       *   True on success.
+       */
+      static bool TestDirectoryCursor();
+
+      /**
+       * FAT12 batched directory read test.
+       * @return
+       *   True on success.
+       */
+      static bool TestDirectoryBatch();
+
+      /**
+       * FAT12 positional read and write test.
+       * @return
+       *   True on success.
+       */
+      static bool TestPositionalIO();
+
+      /**
+       * FAT12 bulk transfer through shared memory test.
+       * @return
+       *   True on success.
+       */
+      static bool TestBulkTransfer();
+
+      /**
+       * FAT12 direct service channel test.
+       * @return
+       *   True on success.
+       */
+      static bool TestDirectChannel();
+
       /**
        * FAT12 create directory test.
        * @return
@@ -246,6 +316,13 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
        */
       static bool TestCreateFile();
 
+      /**
+       * FAT12 lookup cache invalidation test.
+       * @return
+       *   True on success.
+       */
+      static bool TestLookupInvalidation();
+
       /**
        * FAT12 stat test.
        * @return
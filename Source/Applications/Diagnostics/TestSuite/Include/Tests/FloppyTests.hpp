@@ -132,5 +132,33 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
        *   True on success.
        */
       static bool TestCrossTrackWriteReadback();
+
+      /**
+       * Tests that a multi-chunk read matches per-sector reads.
+       * @return
+       *   True on success.
+       */
+      static bool TestLargeReadMatchesSectors();
+
+      /**
+       * Tests buffer cache hits on repeated reads and write-back flush.
+       * @return
+       *   True on success.
+       */
+      static bool TestBufferCache();
+
+      /**
+       * Tests asynchronous reads with polled and port completion.
+       * @return
+       *   True on success.
+       */
+      static bool TestAsyncRead();
+
+      /**
+       * Tests that reordered and merged requests return the right sectors.
+       * @return
+       *   True on success.
+       */
+      static bool TestScheduledReads();
   };
 }
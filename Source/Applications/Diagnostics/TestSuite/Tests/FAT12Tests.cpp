@@ -9,6 +9,8 @@
 #include <ABI/Console.hpp>
 #include <ABI/Devices/BlockDevices.hpp>
 #include <ABI/FileSystem.hpp>
+#include <ABI/Handle.hpp>
+#include <ABI/SharedMemory.hpp>
 #include <ABI/Task.hpp>
 
 #include "Testing.hpp"
@@ -18,6 +20,7 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
   using ABI::Console;
   using ABI::Devices::BlockDevices;
   using ABI::FileSystem;
+  using ABI::SharedMemory;
   using ABI::Task;
 
   void FAT12Tests::LogSkip(CString reason) {
@@ -231,6 +234,11 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
 
     FileSystem::Remove(volume, "TESTDIR/TEST.TXT");
     FileSystem::Remove(volume, "TESTDIR/APPEND.TXT");
+    FileSystem::Remove(volume, "TESTDIR/EXTENT.TXT");
+    FileSystem::Remove(volume, "TESTDIR/GROWA.TXT");
+    FileSystem::Remove(volume, "TESTDIR/GROWB.TXT");
+    FileSystem::Remove(volume, "TESTDIR/CURSOR.TXT");
+    FileSystem::Remove(volume, "TESTDIR/BULK.TXT");
     FileSystem::Remove(volume, "TESTDIR");
 
     FileSystem::Remove(volume, "LONGDIRNAME/LONGFILENAME.TXT");
@@ -238,6 +246,7 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
 
     FileSystem::Remove(volume, "NEWDIR/RENAMED.TXT");
     FileSystem::Remove(volume, "NEWDIR/NEWFILE.TXT");
+    FileSystem::Remove(volume, "NEWDIR/CACHE.TXT");
     FileSystem::Remove(volume, "NEWDIR");
 
     FileSystem::CloseVolume(volume);
@@ -894,6 +903,768 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
     return match;
   }
 
+  bool FAT12Tests::TestSync() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    const char filePath[] = "TESTDIR/APPEND.TXT";
+    const char syncText[] = "Quantum FAT12 sync.\n";
+    const UInt32 syncLength = sizeof(syncText) - 1;
+    FileSystem::Handle handle = FileSystem::Open(volume, filePath, 0);
+
+    if (handle == 0) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "sync file open failed");
+
+      return false;
+    }
+
+    FileSystem::FileInfo before {};
+    bool statOk = FileSystem::Stat(handle, before) == 0;
+
+    FileSystem::Seek(handle, 0, 2);
+
+    UInt32 written = FileSystem::Write(handle, syncText, syncLength);
+
+    // sync while the handle is open so the FAT is flushed by Sync, not Close
+    UInt32 status = FileSystem::Sync(volume);
+    FileSystem::VolumeInfo volumeInfo {};
+    bool cleanOk = FileSystem::GetVolumeInfo(volume, volumeInfo) == 0
+      && volumeInfo.dirtySectors == 0;
+
+    FileSystem::Close(handle);
+
+    // reopen and read the appended bytes back through the synced chain
+    bool readOk = statOk && written == syncLength;
+
+    if (readOk) {
+      char buffer[sizeof(syncText)] = {};
+
+      handle = FileSystem::Open(volume, filePath, 0);
+      readOk = handle != 0
+        && FileSystem::Seek(handle, before.sizeBytes, 0) == before.sizeBytes
+        && FileSystem::Read(handle, buffer, syncLength) == syncLength;
+
+      for (UInt32 i = 0; i < syncLength && readOk; ++i) {
+        readOk = buffer[i] == syncText[i];
+      }
+
+      if (handle != 0) {
+        FileSystem::Close(handle);
+      }
+    }
+
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(statOk, "sync stat failed");
+    TEST_ASSERT(written == syncLength, "sync write failed");
+    TEST_ASSERT(status == 0, "sync failed");
+    TEST_ASSERT(cleanOk, "sync left dirty FAT sectors");
+    TEST_ASSERT(readOk, "sync read back mismatch");
+
+    return statOk && written == syncLength && status == 0 && cleanOk
+      && readOk;
+  }
+
+  bool FAT12Tests::TestExtents() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    const char filePath[] = "TESTDIR/EXTENT.TXT";
+    const UInt32 chunkBytes = 256;
+    const UInt32 chunkCount = 8;
+
+    if (!EnsureDirectory(volume, _testDir) || !EnsureFile(volume, filePath)) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "extent file missing");
+
+      return false;
+    }
+
+    FileSystem::Handle handle = FileSystem::Open(volume, filePath, 0);
+
+    if (handle == 0) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "extent file open failed");
+
+      return false;
+    }
+
+    // grow the file across several clusters through a single handle
+    bool writeOk = true;
+    UInt8 chunk[chunkBytes] = {};
+
+    for (UInt32 c = 0; c < chunkCount && writeOk; ++c) {
+      for (UInt32 i = 0; i < chunkBytes; ++i) {
+        chunk[i] = static_cast<UInt8>(((c * chunkBytes + i) * 7 + 3) & 0xFF);
+      }
+
+      writeOk = FileSystem::Write(handle, chunk, chunkBytes) == chunkBytes;
+    }
+
+    // read back out of order so lookups land in every part of the chain
+    const UInt32 offsets[] = { 1900, 10, 1024, 600, 1530, 0, 2032 };
+    bool readOk = writeOk;
+
+    for (UInt32 o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o) {
+      if (!readOk) {
+        break;
+      }
+
+      UInt8 verify[16] = {};
+
+      if (FileSystem::Seek(handle, offsets[o], 0) != offsets[o]) {
+        readOk = offsets[o] == 0;
+      }
+
+      if (FileSystem::Read(handle, verify, sizeof(verify)) != sizeof(verify)) {
+        readOk = false;
+
+        break;
+      }
+
+      for (UInt32 i = 0; i < sizeof(verify); ++i) {
+        UInt32 position = offsets[o] + i;
+
+        if (verify[i] != static_cast<UInt8>((position * 7 + 3) & 0xFF)) {
+          readOk = false;
+
+          break;
+        }
+      }
+    }
+
+    FileSystem::Close(handle);
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(writeOk, "extent write failed");
+    TEST_ASSERT(readOk, "extent read mismatch");
+
+    return writeOk && readOk;
+  }
+
+  bool FAT12Tests::TestCoalescedRead() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    FileSystem::Handle handle
+      = FileSystem::Open(volume, "TESTDIR/EXTENT.TXT", 0);
+
+    if (handle == 0) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "coalesced file open failed");
+
+      return false;
+    }
+
+    // aligned and unaligned starts, each covering whole sectors plus a tail
+    const UInt32 offsets[] = { 0, 512, 300, 1100 };
+    bool readOk = true;
+
+    for (UInt32 o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o) {
+      UInt8 verify[FileSystem::messageDataBytes] = {};
+      UInt32 wanted = 2048 - offsets[o];
+
+      if (wanted > sizeof(verify)) {
+        wanted = sizeof(verify);
+      }
+
+      if (FileSystem::Seek(handle, offsets[o], 0) != offsets[o]) {
+        readOk = offsets[o] == 0;
+      }
+
+      if (!readOk || FileSystem::Read(handle, verify, wanted) != wanted) {
+        readOk = false;
+
+        break;
+      }
+
+      for (UInt32 i = 0; i < wanted; ++i) {
+        UInt32 position = offsets[o] + i;
+
+        if (verify[i] != static_cast<UInt8>((position * 7 + 3) & 0xFF)) {
+          readOk = false;
+
+          break;
+        }
+      }
+    }
+
+    FileSystem::Close(handle);
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(readOk, "coalesced read mismatch");
+
+    return readOk;
+  }
+
+  bool FAT12Tests::TestAlignedWrite() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    FileSystem::Handle handle
+      = FileSystem::Open(volume, "TESTDIR/EXTENT.TXT", 0);
+
+    if (handle == 0) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "aligned file open failed");
+
+      return false;
+    }
+
+    // overwrite exactly one sector; its neighbours must keep their bytes
+    UInt8 sector[512] = {};
+
+    for (UInt32 i = 0; i < sizeof(sector); ++i) {
+      sector[i] = static_cast<UInt8>(((512 + i) * 5 + 1) & 0xFF);
+    }
+
+    bool writeOk = FileSystem::Seek(handle, 512, 0) == 512
+      && FileSystem::Write(handle, sector, sizeof(sector)) == sizeof(sector);
+    UInt8 verify[516] = {};
+    bool readOk = writeOk
+      && FileSystem::Seek(handle, 510, 0) == 510
+      && FileSystem::Read(handle, verify, sizeof(verify)) == sizeof(verify);
+
+    for (UInt32 i = 0; i < sizeof(verify) && readOk; ++i) {
+      UInt32 position = 510 + i;
+      UInt8 expected = position >= 512 && position < 1024
+        ? static_cast<UInt8>((position * 5 + 1) & 0xFF)
+        : static_cast<UInt8>((position * 7 + 3) & 0xFF);
+
+      readOk = verify[i] == expected;
+    }
+
+    FileSystem::Close(handle);
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(writeOk, "aligned write failed");
+    TEST_ASSERT(readOk, "aligned write mismatch");
+
+    return writeOk && readOk;
+  }
+
+  bool FAT12Tests::TestInterleavedGrowth() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    CString paths[2] = { "TESTDIR/GROWA.TXT", "TESTDIR/GROWB.TXT" };
+    FileSystem::Handle handles[2] = {};
+    const UInt32 chunkBytes = 512;
+    const UInt32 chunkCount = 4;
+    bool openOk = EnsureDirectory(volume, _testDir);
+
+    // start from empty files so both chains are allocated by this run
+    for (UInt32 f = 0; f < 2 && openOk; ++f) {
+      FileSystem::Remove(volume, paths[f]);
+
+      openOk = EnsureFile(volume, paths[f]);
+
+      if (openOk) {
+        handles[f] = FileSystem::Open(volume, paths[f], 0);
+        openOk = handles[f] != 0;
+      }
+    }
+
+    // grow both files in turn; the size hints keep each one contiguous
+    bool writeOk = openOk;
+    UInt8 chunk[chunkBytes] = {};
+
+    for (UInt32 c = 0; c < chunkCount && writeOk; ++c) {
+      for (UInt32 f = 0; f < 2 && writeOk; ++f) {
+        for (UInt32 i = 0; i < chunkBytes; ++i) {
+          chunk[i] = static_cast<UInt8>(f * 0x40 + c * 0x10 + (i & 0x0F));
+        }
+
+        writeOk = FileSystem::Write(
+          handles[f],
+          chunk,
+          chunkBytes,
+          chunkBytes * chunkCount,
+          FileSystem::requestTimeoutTicks
+        ) == chunkBytes;
+      }
+    }
+
+    bool readOk = writeOk;
+
+    for (UInt32 f = 0; f < 2 && readOk; ++f) {
+      readOk = FileSystem::Seek(handles[f], 0, 0) == 0;
+
+      for (UInt32 c = 0; c < chunkCount && readOk; ++c) {
+        readOk = FileSystem::Read(handles[f], chunk, chunkBytes) == chunkBytes;
+
+        for (UInt32 i = 0; i < chunkBytes && readOk; ++i) {
+          readOk = chunk[i]
+            == static_cast<UInt8>(f * 0x40 + c * 0x10 + (i & 0x0F));
+        }
+      }
+    }
+
+    // each file must be a single run despite the interleaved writes
+    bool contiguousOk = readOk;
+
+    for (UInt32 f = 0; f < 2 && contiguousOk; ++f) {
+      FileSystem::FileInfo info {};
+
+      contiguousOk = FileSystem::Stat(handles[f], info) == 0
+        && info.extentCount == 1;
+    }
+
+    for (UInt32 f = 0; f < 2; ++f) {
+      if (handles[f] != 0) {
+        FileSystem::Close(handles[f]);
+      }
+    }
+
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(openOk, "growth files missing");
+    TEST_ASSERT(writeOk, "growth write failed");
+    TEST_ASSERT(readOk, "growth read mismatch");
+    TEST_ASSERT(contiguousOk, "growth files fragmented");
+
+    return openOk && writeOk && readOk && contiguousOk;
+  }
+
+  bool FAT12Tests::TestDirectoryCursor() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    FileSystem::Remove(volume, "TESTDIR/CURSOR.TXT");
+
+    if (!EnsureDirectory(volume, _testDir)) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "testdir missing");
+
+      return false;
+    }
+
+    // list three times: before, across and after adding an entry
+    UInt32 counts[3] = {};
+    UInt32 seen = 0;
+    bool created = false;
+
+    for (UInt32 pass = 0; pass < 3; ++pass) {
+      FileSystem::Handle dirHandle = FileSystem::Open(volume, _testDir, 0);
+      FileSystem::DirectoryEntry entry {};
+
+      for (UInt32 guard = 0; dirHandle != 0 && guard < 256; ++guard) {
+        if (
+          FileSystem::ReadDirectory(dirHandle, entry) != 0
+          || entry.name[0] == '\0'
+        ) {
+          break;
+        }
+
+        ++counts[pass];
+
+        if (pass == 2 && NameEquals(entry.name, "CURSOR.TXT")) {
+          ++seen;
+        }
+
+        // mutate the directory while the handle's cursor is mid-listing
+        if (pass == 1 && !created) {
+          created
+            = FileSystem::CreateFile(volume, "TESTDIR/CURSOR.TXT") == 0;
+        }
+      }
+
+      if (dirHandle != 0) {
+        FileSystem::Close(dirHandle);
+      }
+    }
+
+    FileSystem::CloseVolume(volume);
+
+    bool listedOk = counts[0] > 0 && counts[1] >= counts[0];
+
+    TEST_ASSERT(listedOk, "cursor listing failed");
+    TEST_ASSERT(created, "cursor create failed");
+    TEST_ASSERT(counts[2] == counts[0] + 1, "cursor listing mismatch");
+    TEST_ASSERT(seen == 1, "cursor entry not listed once");
+
+    return listedOk && created && counts[2] == counts[0] + 1 && seen == 1;
+  }
+
+  bool FAT12Tests::TestDirectoryBatch() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    if (!EnsureDirectory(volume, _testDir)) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "testdir missing");
+
+      return false;
+    }
+
+    // reference listing, one entry per request
+    const UInt32 maxListed = 32;
+    FileSystem::DirectoryEntry single[maxListed] = {};
+    UInt32 singleCount = 0;
+    FileSystem::Handle dirHandle = FileSystem::Open(volume, _testDir, 0);
+
+    while (dirHandle != 0 && singleCount < maxListed) {
+      FileSystem::DirectoryEntry& entry = single[singleCount];
+
+      if (
+        FileSystem::ReadDirectory(dirHandle, entry) != 0
+        || entry.name[0] == '\0'
+      ) {
+        break;
+      }
+
+      ++singleCount;
+    }
+
+    if (dirHandle != 0) {
+      FileSystem::Close(dirHandle);
+    }
+
+    // the same listing in small batches, so it takes several round trips
+    FileSystem::DirectoryEntry batch[3] = {};
+    UInt32 batchCount = 0;
+    UInt32 cookie = 0;
+    UInt32 calls = 0;
+    bool batchOk = true;
+
+    dirHandle = FileSystem::Open(volume, _testDir, 0);
+
+    while (
+      dirHandle != 0
+      && cookie != FileSystem::directoryEndCookie
+      && calls < maxListed
+    ) {
+      UInt32 count = 0;
+
+      ++calls;
+
+      if (
+        FileSystem::ReadDirectoryBatch(dirHandle, batch, 3, cookie, count)
+        != 0
+      ) {
+        batchOk = false;
+
+        break;
+      }
+
+      for (UInt32 i = 0; i < count; ++i, ++batchCount) {
+        if (
+          batchCount >= singleCount
+          || !NameEquals(batch[i].name, single[batchCount].name)
+          || batch[i].sizeBytes != single[batchCount].sizeBytes
+          || batch[i].attributes != single[batchCount].attributes
+        ) {
+          batchOk = false;
+        }
+      }
+    }
+
+    if (dirHandle != 0) {
+      FileSystem::Close(dirHandle);
+    }
+
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(singleCount > 0, "batch reference listing empty");
+    TEST_ASSERT(batchOk, "batch entries differ");
+    TEST_ASSERT(batchCount == singleCount, "batch count mismatch");
+    TEST_ASSERT(
+      cookie == FileSystem::directoryEndCookie,
+      "batch did not reach the end"
+    );
+
+    return singleCount > 0
+      && batchOk
+      && batchCount == singleCount
+      && cookie == FileSystem::directoryEndCookie;
+  }
+
+  bool FAT12Tests::TestPositionalIO() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    FileSystem::Handle handle
+      = FileSystem::Open(volume, "TESTDIR/EXTENT.TXT", 0);
+
+    if (handle == 0) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "positional file open failed");
+
+      return false;
+    }
+
+    const UInt8 marker[4] = { 0xAA, 0x55, 0xA5, 0x5A };
+    UInt8 verify[16] = {};
+    bool seekOk = FileSystem::Seek(handle, 100, 0) == 100;
+    bool writeOk = FileSystem::WriteAt(handle, 1800, marker, 4) == 4;
+    bool readAtOk = FileSystem::ReadAt(handle, 1800, verify, 4) == 4;
+
+    for (UInt32 i = 0; i < 4 && readAtOk; ++i) {
+      readAtOk = verify[i] == marker[i];
+    }
+
+    // positional calls must not have moved the handle from offset 100
+    bool positionOk = FileSystem::Read(handle, verify, 4) == 4;
+
+    for (UInt32 i = 0; i < 4 && positionOk; ++i) {
+      positionOk = verify[i] == static_cast<UInt8>(((100 + i) * 7 + 3) & 0xFF);
+    }
+
+    FileSystem::Close(handle);
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(seekOk, "positional seek failed");
+    TEST_ASSERT(writeOk, "positional write failed");
+    TEST_ASSERT(readAtOk, "positional read mismatch");
+    TEST_ASSERT(positionOk, "positional calls moved the handle");
+
+    return seekOk && writeOk && readAtOk && positionOk;
+  }
+
+  bool FAT12Tests::TestBulkTransfer() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    // several messages' worth of data in each direction
+    const UInt32 totalBytes = 3000;
+    UInt32 shared = SharedMemory::Create(totalBytes);
+    SharedMemory::Info info {};
+    UInt8* buffer = shared != 0
+      ? reinterpret_cast<UInt8*>(SharedMemory::Map(shared))
+      : nullptr;
+    bool setupOk = buffer
+      && SharedMemory::GetInfo(shared, info) == 0
+      && info.size >= totalBytes
+      && EnsureDirectory(volume, _testDir)
+      && EnsureFile(volume, "TESTDIR/BULK.TXT");
+    FileSystem::Handle handle = setupOk
+      ? FileSystem::Open(volume, "TESTDIR/BULK.TXT", 0)
+      : 0;
+    bool writeOk = false;
+    bool readOk = false;
+    bool chunkOk = false;
+
+    if (handle != 0) {
+      for (UInt32 i = 0; i < totalBytes; ++i) {
+        buffer[i] = static_cast<UInt8>((i * 11 + 5) & 0xFF);
+      }
+
+      writeOk = FileSystem::WriteBulk(handle, info.id, totalBytes)
+        == totalBytes;
+
+      for (UInt32 i = 0; i < totalBytes; ++i) {
+        buffer[i] = 0;
+      }
+
+      FileSystem::Seek(handle, 0, 0);
+
+      readOk = FileSystem::ReadBulk(handle, info.id, totalBytes)
+        == totalBytes;
+
+      for (UInt32 i = 0; i < totalBytes && readOk; ++i) {
+        readOk = buffer[i] == static_cast<UInt8>((i * 11 + 5) & 0xFF);
+      }
+
+      // the message path must see what the bulk path wrote
+      UInt8 chunk[64] = {};
+
+      chunkOk = FileSystem::ReadAt(handle, 2500, chunk, sizeof(chunk))
+        == sizeof(chunk);
+
+      for (UInt32 i = 0; i < sizeof(chunk) && chunkOk; ++i) {
+        chunkOk = chunk[i]
+          == static_cast<UInt8>(((2500 + i) * 11 + 5) & 0xFF);
+      }
+
+      FileSystem::Close(handle);
+    }
+
+    if (buffer) {
+      SharedMemory::Unmap(buffer);
+    }
+
+    if (shared != 0) {
+      ABI::Handle::Close(shared);
+    }
+
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(setupOk && handle != 0, "bulk setup failed");
+    TEST_ASSERT(writeOk, "bulk write failed");
+    TEST_ASSERT(readOk, "bulk read mismatch");
+    TEST_ASSERT(chunkOk, "bulk data not visible to message reads");
+
+    return setupOk && handle != 0 && writeOk && readOk && chunkOk;
+  }
+
+  bool FAT12Tests::TestDirectChannel() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    // two handles on one file must not be confused by their channels
+    FileSystem::Handle first
+      = FileSystem::Open(volume, "TESTDIR/EXTENT.TXT", 0);
+    FileSystem::Handle second
+      = FileSystem::Open(volume, "TESTDIR/EXTENT.TXT", 0);
+    bool openOk = first != 0 && second != 0 && first != second;
+    UInt8 left[4] = {};
+    UInt8 right[4] = {};
+    bool readOk = openOk
+      && FileSystem::Seek(second, 40, 0) == 40
+      && FileSystem::Read(first, left, 4) == 4
+      && FileSystem::Read(second, right, 4) == 4;
+
+    for (UInt32 i = 0; i < 4 && readOk; ++i) {
+      readOk = left[i] == static_cast<UInt8>((i * 7 + 3) & 0xFF)
+        && right[i] == static_cast<UInt8>(((40 + i) * 7 + 3) & 0xFF);
+    }
+
+    FileSystem::FileInfo info {};
+    bool statOk = openOk && FileSystem::Stat(first, info) == 0
+      && info.sizeBytes >= 2048;
+    bool closeOk = openOk && FileSystem::Close(first) == 0;
+
+    // a closed handle must be refused rather than routed to the service
+    bool staleOk = closeOk && FileSystem::Read(first, left, 4) == 0;
+
+    if (second != 0) {
+      FileSystem::Close(second);
+    }
+
+    if (first != 0 && !closeOk) {
+      FileSystem::Close(first);
+    }
+
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(openOk, "channel open failed");
+    TEST_ASSERT(readOk, "channel read mismatch");
+    TEST_ASSERT(statOk, "channel stat failed");
+    TEST_ASSERT(closeOk, "channel close failed");
+    TEST_ASSERT(staleOk, "closed handle still readable");
+
+    return openOk && readOk && statOk && closeOk && staleOk;
+  }
+
   bool FAT12Tests::TestCreateDirectory() {
     if (!WaitForFloppyReady()) {
       LogSkip("floppy not ready");
@@ -1007,6 +1778,98 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
     return okAttr;
   }
 
+  bool FAT12Tests::TestLookupInvalidation() {
+    if (!WaitForFloppyReady()) {
+      LogSkip("floppy not ready");
+
+      return true;
+    }
+
+    FileSystem::VolumeHandle volume = 0;
+
+    if (!OpenVolume(volume)) {
+      LogSkip("no FAT12 volume");
+
+      return true;
+    }
+
+    const char filePath[] = "NEWDIR/CACHE.TXT";
+
+    if (!EnsureDirectory(volume, "NEWDIR")) {
+      FileSystem::CloseVolume(volume);
+
+      TEST_ASSERT(false, "create directory failed");
+
+      return false;
+    }
+
+    FileSystem::Remove(volume, filePath);
+
+    // the failed open leaves a negative lookup that create must drop
+    FileSystem::Handle missing = FileSystem::Open(volume, filePath, 0);
+
+    if (missing != 0) {
+      FileSystem::Close(missing);
+    }
+
+    bool created = FileSystem::CreateFile(volume, filePath) == 0;
+    FileSystem::Handle handle = FileSystem::Open(volume, filePath, 0);
+    bool opened = handle != 0;
+
+    if (opened) {
+      FileSystem::Close(handle);
+    }
+
+    // other clients can only add to the counters, so compare deltas
+    FileSystem::VolumeInfo before {};
+    FileSystem::VolumeInfo after {};
+    bool statsRead = FileSystem::GetVolumeInfo(volume, before) == 0;
+    FileSystem::Handle repeat = FileSystem::Open(volume, filePath, 0);
+
+    if (repeat != 0) {
+      FileSystem::Close(repeat);
+    }
+
+    statsRead = statsRead && FileSystem::GetVolumeInfo(volume, after) == 0;
+
+    bool hit = after.lookupHits > before.lookupHits;
+    bool removed = FileSystem::Remove(volume, filePath) == 0;
+
+    statsRead = statsRead && FileSystem::GetVolumeInfo(volume, before) == 0;
+
+    FileSystem::Handle stale = FileSystem::Open(volume, filePath, 0);
+
+    if (stale != 0) {
+      FileSystem::Close(stale);
+    }
+
+    statsRead = statsRead && FileSystem::GetVolumeInfo(volume, after) == 0;
+
+    bool miss = after.lookupMisses > before.lookupMisses;
+
+    FileSystem::CloseVolume(volume);
+
+    TEST_ASSERT(missing == 0, "missing file opened");
+    TEST_ASSERT(created, "lookup file create failed");
+    TEST_ASSERT(opened, "created file not found");
+    TEST_ASSERT(statsRead, "lookup stats unavailable");
+    TEST_ASSERT(repeat != 0, "created file not found again");
+    TEST_ASSERT(hit, "repeated lookup missed the cache");
+    TEST_ASSERT(removed, "lookup file remove failed");
+    TEST_ASSERT(stale == 0, "removed file still opens");
+    TEST_ASSERT(miss, "lookup after remove hit a stale entry");
+
+    return missing == 0
+      && created
+      && opened
+      && statsRead
+      && repeat != 0
+      && hit
+      && removed
+      && stale == 0
+      && miss;
+  }
+
   bool FAT12Tests::TestStat() {
     if (!WaitForFloppyReady()) {
       LogSkip("floppy not ready");
@@ -1300,8 +2163,19 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
     Testing::Register("FAT12 TEST.TXT read", TestFileRead);
     Testing::Register("FAT12 TEST.TXT seek", TestFileSeek);
     Testing::Register("FAT12 append write", TestFileWriteAppend);
+    Testing::Register("FAT12 sync", TestSync);
+    Testing::Register("FAT12 extents", TestExtents);
+    Testing::Register("FAT12 coalesced read", TestCoalescedRead);
+    Testing::Register("FAT12 aligned write", TestAlignedWrite);
+    Testing::Register("FAT12 interleaved growth", TestInterleavedGrowth);
+    Testing::Register("FAT12 directory cursor", TestDirectoryCursor);
+    Testing::Register("FAT12 directory batch", TestDirectoryBatch);
+    Testing::Register("FAT12 positional I/O", TestPositionalIO);
+    Testing::Register("FAT12 bulk transfer", TestBulkTransfer);
+    Testing::Register("FAT12 direct channel", TestDirectChannel);
     Testing::Register("FAT12 create directory", TestCreateDirectory);
     Testing::Register("FAT12 create file", TestCreateFile);
+    Testing::Register("FAT12 lookup invalidation", TestLookupInvalidation);
     Testing::Register("FAT12 stat", TestStat);
     Testing::Register("FAT12 rename", TestRename);
     Testing::Register("FAT12 remove", TestRemove);
@@ -10,14 +10,18 @@
 #include <ABI/Devices/BlockDevices.hpp>
 #include <ABI/Devices/DeviceBroker.hpp>
 #include <ABI/Handle.hpp>
+#include <ABI/IPC.hpp>
 #include <ABI/Task.hpp>
+#include <Bytes.hpp>
 
 #include "Testing.hpp"
 #include "Tests/FloppyTests.hpp"
 
 namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
+  using ::Quantum::CopyBytes;
   using ABI::Console;
   using ABI::Devices::BlockDevices;
+  using ABI::IPC;
   using ABI::Task;
 
   void FloppyTests::LogSkip(CString reason) {
@@ -501,6 +505,393 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
     return match;
   }
 
+  bool FloppyTests::TestLargeReadMatchesSectors() {
+    UInt32 deviceToken = 0;
+    BlockDevices::Info info {};
+
+    if (!FindFloppyDevice(deviceToken, info)) {
+      LogSkip("no device");
+
+      return true;
+    }
+
+    constexpr UInt32 maxBytes = 8192;
+    constexpr UInt32 sectorCount = 12;
+    constexpr UInt32 startLBA = 30;
+
+    if (info.sectorSize == 0 || info.sectorSize * sectorCount > maxBytes) {
+      LogSkip("sector size");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    if (info.sectorCount < startLBA + sectorCount) {
+      LogSkip("sector count");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    UInt8 bulk[maxBytes] = {};
+    UInt8 single[maxBytes] = {};
+
+    // spans a cylinder boundary and more than one DMA buffer's worth
+    if (!ReadSectors(deviceToken, startLBA, sectorCount, bulk)) {
+      TEST_ASSERT(false, "floppy large read failed");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return false;
+    }
+
+    for (UInt32 i = 0; i < sectorCount; ++i) {
+      if (
+        !ReadSectors(
+          deviceToken,
+          startLBA + i,
+          1,
+          single + i * info.sectorSize
+        )
+      ) {
+        TEST_ASSERT(false, "floppy single-sector reread failed");
+        CloseDeviceToken(deviceToken, info.id);
+
+        return false;
+      }
+    }
+
+    bool match = true;
+
+    for (UInt32 i = 0; i < info.sectorSize * sectorCount; ++i) {
+      if (bulk[i] != single[i]) {
+        match = false;
+
+        break;
+      }
+    }
+
+    TEST_ASSERT(match, "floppy large read differs from single-sector reads");
+
+    CloseDeviceToken(deviceToken, info.id);
+
+    return match;
+  }
+
+  bool FloppyTests::TestBufferCache() {
+    UInt32 deviceToken = 0;
+    BlockDevices::Info info {};
+
+    if (!FindFloppyDevice(deviceToken, info)) {
+      LogSkip("no device");
+
+      return true;
+    }
+
+    BlockDevices::CacheStats before {};
+
+    if (BlockDevices::GetCacheStats(before) != 0 || before.capacity == 0) {
+      Console::WriteLine("Floppy cache test skipped (cache disabled)");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    constexpr UInt32 maxBytes = 4096;
+
+    if (info.sectorSize == 0 || info.sectorSize > maxBytes) {
+      LogSkip("sector size");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    UInt8 first[maxBytes] = {};
+    UInt8 second[maxBytes] = {};
+
+    if (
+      !ReadSectors(deviceToken, 0, 1, first)
+      || !ReadSectors(deviceToken, 0, 1, second)
+    ) {
+      TEST_ASSERT(false, "floppy cache read failed");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return false;
+    }
+
+    BlockDevices::CacheStats after {};
+
+    BlockDevices::GetCacheStats(after);
+
+    bool match = true;
+
+    for (UInt32 i = 0; i < info.sectorSize; ++i) {
+      if (first[i] != second[i]) {
+        match = false;
+
+        break;
+      }
+    }
+
+    TEST_ASSERT(match, "floppy cached read differs");
+    TEST_ASSERT(after.hits > before.hits, "floppy repeated read missed cache");
+
+    bool flushed = true;
+
+    if ((info.flags & static_cast<UInt32>(BlockDevices::Flag::ReadOnly)) == 0) {
+      // rewrite the boot sector unchanged so the flush has work to do
+      flushed = WriteSectors(deviceToken, 0, 1, first)
+        && BlockDevices::Flush(deviceToken) == 0;
+
+      TEST_ASSERT(flushed, "floppy cache flush failed");
+    }
+
+    CloseDeviceToken(deviceToken, info.id);
+
+    return match && after.hits > before.hits && flushed;
+  }
+
+  bool FloppyTests::TestAsyncRead() {
+    UInt32 deviceToken = 0;
+    BlockDevices::Info info {};
+
+    if (!FindFloppyDevice(deviceToken, info)) {
+      LogSkip("no device");
+
+      return true;
+    }
+
+    constexpr UInt32 maxBytes = 4096;
+    constexpr UInt32 sectorCount = 4;
+
+    if (info.sectorSize == 0 || info.sectorSize * sectorCount > maxBytes) {
+      LogSkip("sector size");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    UInt8 expected[maxBytes] = {};
+    UInt8 polled[maxBytes] = {};
+    UInt8 notified[maxBytes] = {};
+
+    if (!ReadSectors(deviceToken, 0, sectorCount, expected)) {
+      TEST_ASSERT(false, "floppy async reference read failed");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return false;
+    }
+
+    BlockDevices::Request request {};
+
+    request.deviceId = deviceToken;
+    request.lba = 0;
+    request.count = sectorCount;
+    request.buffer = nullptr;
+
+    // polled completion
+    UInt32 requestId = BlockDevices::Submit(
+      request,
+      BlockDevices::Operation::Read
+    );
+    BlockDevices::CompletionStatus status
+      = BlockDevices::CompletionStatus::Failed;
+
+    if (requestId != 0) {
+      for (UInt32 i = 0; i < 1000; ++i) {
+        status = BlockDevices::Complete(requestId, polled);
+
+        if (status != BlockDevices::CompletionStatus::Pending) {
+          break;
+        }
+
+        Task::SleepTicks(1);
+      }
+    }
+
+    TEST_ASSERT(requestId != 0, "floppy async submit failed");
+    TEST_ASSERT(
+      status == BlockDevices::CompletionStatus::Success,
+      "floppy async poll failed"
+    );
+
+    // port completion
+    UInt32 portId = IPC::CreatePort();
+    bool notifiedOk = false;
+
+    if (portId != 0) {
+      UInt32 notifyId = BlockDevices::Submit(
+        request,
+        BlockDevices::Operation::Read,
+        portId
+      );
+      IPC::Message msg {};
+
+      if (
+        notifyId != 0
+        && IPC::ReceiveTimeout(portId, msg, 1000) == 0
+        && msg.length >= sizeof(BlockDevices::CompletionMessage)
+      ) {
+        BlockDevices::CompletionMessage notice {};
+
+        CopyBytes(&notice, msg.payload, sizeof(notice));
+
+        notifiedOk = notice.op == BlockDevices::Operation::Complete
+          && notice.requestId == notifyId
+          && notice.status == 0
+          && BlockDevices::Complete(notifyId, notified)
+            == BlockDevices::CompletionStatus::Success;
+      }
+
+      IPC::DestroyPort(portId);
+    }
+
+    TEST_ASSERT(notifiedOk, "floppy async port completion failed");
+
+    bool match = true;
+
+    for (UInt32 i = 0; i < info.sectorSize * sectorCount; ++i) {
+      if (polled[i] != expected[i] || notified[i] != expected[i]) {
+        match = false;
+
+        break;
+      }
+    }
+
+    TEST_ASSERT(match, "floppy async read data mismatch");
+
+    CloseDeviceToken(deviceToken, info.id);
+
+    return status == BlockDevices::CompletionStatus::Success
+      && notifiedOk
+      && match;
+  }
+
+  bool FloppyTests::TestScheduledReads() {
+    UInt32 deviceToken = 0;
+    BlockDevices::Info info {};
+
+    if (!FindFloppyDevice(deviceToken, info)) {
+      LogSkip("no device");
+
+      return true;
+    }
+
+    constexpr UInt32 sectorBytes = 512;
+    constexpr UInt32 span = 3;
+
+    if (info.sectorSize != sectorBytes) {
+      LogSkip("sector size");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    UInt8 boot[sectorBytes] = {};
+
+    if (!ReadSectors(deviceToken, 0, 1, boot)) {
+      TEST_ASSERT(false, "floppy scheduler boot read failed");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return false;
+    }
+
+    UInt32 reserved = boot[14] | (static_cast<UInt32>(boot[15]) << 8);
+    UInt32 fatCount = boot[16];
+    UInt32 sectorsPerFat = boot[22] | (static_cast<UInt32>(boot[23]) << 8);
+
+    // the two FAT copies give a known-equal pair of ranges to compare
+    if (fatCount < 2 || sectorsPerFat < span || reserved == 0) {
+      Console::WriteLine("Floppy scheduler test skipped (no FAT copies)");
+      CloseDeviceToken(deviceToken, info.id);
+
+      return true;
+    }
+
+    TEST_ASSERT(
+      BlockDevices::SetScheduler(
+        deviceToken,
+        BlockDevices::Scheduler::Elevator
+      ) == 0,
+      "floppy set scheduler failed"
+    );
+
+    UInt32 firstFat = reserved;
+    UInt32 secondFat = reserved + sectorsPerFat;
+    // out of order, with adjacent neighbours the scheduler can merge
+    UInt32 order[span * 2] = {
+      secondFat + 2,
+      firstFat,
+      secondFat,
+      firstFat + 2,
+      firstFat + 1,
+      secondFat + 1
+    };
+    UInt32 ids[span * 2] = {};
+    UInt8 copies[span * 2][sectorBytes] = {};
+    bool ok = true;
+
+    for (UInt32 i = 0; i < span * 2; ++i) {
+      BlockDevices::Request request {};
+
+      request.deviceId = deviceToken;
+      request.lba = order[i];
+      request.count = 1;
+
+      ids[i] = BlockDevices::Submit(request, BlockDevices::Operation::Read);
+
+      if (ids[i] == 0) {
+        ok = false;
+      }
+    }
+
+    for (UInt32 i = 0; i < span * 2 && ok; ++i) {
+      UInt32 lba = order[i];
+      UInt32 slot = lba >= secondFat
+        ? span + (lba - secondFat)
+        : lba - firstFat;
+      BlockDevices::CompletionStatus status
+        = BlockDevices::CompletionStatus::Pending;
+
+      for (UInt32 attempt = 0; attempt < 1000; ++attempt) {
+        status = BlockDevices::Complete(ids[i], copies[slot]);
+
+        if (status != BlockDevices::CompletionStatus::Pending) {
+          break;
+        }
+
+        Task::SleepTicks(1);
+      }
+
+      if (status != BlockDevices::CompletionStatus::Success) {
+        ok = false;
+      }
+    }
+
+    TEST_ASSERT(ok, "floppy scheduled reads failed");
+
+    bool match = ok;
+
+    for (UInt32 i = 0; i < span && match; ++i) {
+      for (UInt32 j = 0; j < sectorBytes; ++j) {
+        if (copies[i][j] != copies[span + i][j]) {
+          match = false;
+
+          break;
+        }
+      }
+    }
+
+    TEST_ASSERT(match, "floppy scheduled reads returned mismatched FATs");
+
+    BlockDevices::SetScheduler(
+      deviceToken,
+      BlockDevices::Scheduler::Deadline
+    );
+    CloseDeviceToken(deviceToken, info.id);
+
+    return ok && match;
+  }
+
   void FloppyTests::RegisterTests() {
     Testing::Register("Floppy single-sector read", TestSingleSectorRead);
     Testing::Register("Floppy multi-sector read", TestMultiSectorRead);
@@ -513,6 +904,13 @@ namespace Quantum::Applications::Diagnostics::TestSuite::Tests {
       "Floppy cross-track write/readback",
       TestCrossTrackWriteReadback
     );
+    Testing::Register(
+      "Floppy large read matches sector reads",
+      TestLargeReadMatchesSectors
+    );
+    Testing::Register("Floppy buffer cache", TestBufferCache);
+    Testing::Register("Floppy async read", TestAsyncRead);
+    Testing::Register("Floppy scheduled reads", TestScheduledReads);
   }
 }
 
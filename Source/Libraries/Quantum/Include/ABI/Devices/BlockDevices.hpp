@@ -40,7 +40,44 @@ namespace Quantum::ABI::Devices {
         /**
          * Response payload.
          */
-        Response = 3
+        Response = 3,
+
+        /**
+         * Read into the driver's shared DMA buffer; the message carries only
+         * the descriptor.
+         */
+        ReadBulk = 4,
+
+        /**
+         * Write from the driver's shared DMA buffer; the message carries only
+         * the descriptor.
+         */
+        WriteBulk = 5,
+
+        /**
+         * Completion notice for an asynchronous request.
+         */
+        Complete = 6
+      };
+
+      /**
+       * Result of polling an asynchronous request.
+       */
+      enum class CompletionStatus : UInt32 {
+        /**
+         * The request finished successfully; read data has been copied out.
+         */
+        Success = 0,
+
+        /**
+         * The request failed or the id is unknown.
+         */
+        Failed = 1,
+
+        /**
+         * The request is still queued or in progress.
+         */
+        Pending = 2
       };
 
       /**
@@ -136,6 +173,37 @@ namespace Quantum::ABI::Devices {
          * Controller-specific device index (e.g., floppy A=0, B=1).
          */
         UInt32 deviceIndex;
+
+        /**
+         * Sectors per track (0 if the device has no CHS geometry).
+         */
+        UInt32 sectorsPerTrack;
+
+        /**
+         * Number of heads (0 if the device has no CHS geometry).
+         */
+        UInt32 headCount;
+      };
+
+      /**
+       * Request scheduling policies.
+       */
+      enum class Scheduler : UInt32 {
+        /**
+         * Arrival order.
+         */
+        Noop = 0,
+
+        /**
+         * Elevator order, but serve any request that has waited past its
+         * expiry first.
+         */
+        Deadline = 1,
+
+        /**
+         * One-way (C-SCAN) elevator by cylinder.
+         */
+        Elevator = 2
       };
 
       /**
@@ -244,6 +312,76 @@ namespace Quantum::ABI::Devices {
         UInt32 size;
       };
 
+      /**
+       * Completion notice posted to a submitter's port.
+       */
+      struct CompletionMessage {
+        /**
+         * Always `Operation::Complete`.
+         */
+        Operation op;
+
+        /**
+         * Request id returned by `Submit`.
+         */
+        UInt32 requestId;
+
+        /**
+         * Target device id.
+         */
+        UInt32 deviceId;
+
+        /**
+         * Status code (0 success, non-zero failure).
+         */
+        UInt32 status;
+      };
+
+      /**
+       * Kernel buffer cache statistics.
+       */
+      struct CacheStats {
+        /**
+         * Cache capacity in blocks.
+         */
+        UInt32 capacity;
+
+        /**
+         * Number of blocks currently cached.
+         */
+        UInt32 used;
+
+        /**
+         * Number of cached blocks awaiting write-back.
+         */
+        UInt32 dirty;
+
+        /**
+         * Sectors served from the cache.
+         */
+        UInt32 hits;
+
+        /**
+         * Sectors fetched from the device.
+         */
+        UInt32 misses;
+
+        /**
+         * Sectors written back to the device.
+         */
+        UInt32 writeBacks;
+
+        /**
+         * Valid blocks evicted to make room.
+         */
+        UInt32 evictions;
+      };
+
+      /**
+       * Maximum bytes a single asynchronous request may transfer.
+       */
+      static constexpr UInt32 maxQueuedBytes = 0x8000;
+
       /**
        * Maximum sector size supported by WritePartial.
        */
@@ -450,6 +588,108 @@ namespace Quantum::ABI::Devices {
         return Write(withTimeout);
       }
 
+      /**
+       * Selects the kernel request scheduling policy for a device.
+       * @param deviceId
+       *   Device identifier or handle.
+       * @param scheduler
+       *   Policy to use.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 SetScheduler(UInt32 deviceId, Scheduler scheduler) {
+        return InvokeSystemCall(
+          SystemCall::Block_SetScheduler,
+          deviceId,
+          static_cast<UInt32>(scheduler),
+          0
+        );
+      }
+
+      /**
+       * Queues an asynchronous block request.
+       * @param request
+       *   Block I/O request descriptor. Write data is copied before the call
+       *   returns; read data is delivered by `Complete`.
+       * @param op
+       *   `Operation::Read` or `Operation::Write`.
+       * @param completionPort
+       *   Port id or handle to receive a `CompletionMessage`, or 0 to poll.
+       * @return
+       *   Request id on success; 0 if the request is invalid or the device
+       *   queue is full.
+       */
+      static UInt32 Submit(
+        const Request& request,
+        Operation op,
+        UInt32 completionPort = 0
+      ) {
+        return InvokeSystemCall(
+          SystemCall::Block_Submit,
+          reinterpret_cast<UInt32>(&request),
+          static_cast<UInt32>(op),
+          completionPort
+        );
+      }
+
+      /**
+       * Collects an asynchronous request.
+       * @param requestId
+       *   Request id returned by `Submit`.
+       * @param buffer
+       *   Receives read data (ignored for writes).
+       * @return
+       *   Completion status; the id is retired unless `Pending`.
+       */
+      static CompletionStatus Complete(UInt32 requestId, void* buffer) {
+        return static_cast<CompletionStatus>(
+          InvokeSystemCall(
+            SystemCall::Block_Complete,
+            requestId,
+            reinterpret_cast<UInt32>(buffer),
+            0
+          )
+        );
+      }
+
+      /**
+       * Writes back blocks held dirty in the kernel buffer cache.
+       * @param deviceId
+       *   Device identifier or handle, or 0 for all devices.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 Flush(UInt32 deviceId) {
+        return InvokeSystemCall(SystemCall::Block_Flush, deviceId, 0, 0);
+      }
+
+      /**
+       * Retrieves kernel buffer cache statistics.
+       * @param outStats
+       *   Receives the statistics.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 GetCacheStats(CacheStats& outStats) {
+        return InvokeSystemCall(
+          SystemCall::Block_GetCacheStats,
+          reinterpret_cast<UInt32>(&outStats),
+          0,
+          0
+        );
+      }
+
+      /**
+       * Resizes the kernel buffer cache (coordinator only).
+       * @param blocks
+       *   New capacity in blocks (0 disables caching).
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 ConfigureCache(UInt32 blocks) {
+        return InvokeSystemCall(SystemCall::Block_ConfigureCache, blocks, 0, 0);
+      }
+
       /**
        * Binds a device to a driver IPC port.
        * @param deviceId
@@ -471,7 +711,8 @@ namespace Quantum::ABI::Devices {
       /**
        * Allocates a DMA buffer and maps it into the caller's address space.
        * @param sizeBytes
-       *   Requested buffer size in bytes.
+       *   Requested buffer size in bytes (at most 64 KB); check
+       *   `outBuffer.size`, which may be smaller.
        * @param outBuffer
        *   Receives the DMA buffer descriptor.
        * @return
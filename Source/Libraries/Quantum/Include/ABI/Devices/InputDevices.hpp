@@ -293,6 +293,30 @@ namespace Quantum::ABI::Devices {
         );
       }
 
+      /**
+       * Reads the next event for a device with a timeout in nanoseconds.
+       * @param deviceId
+       *   Identifier of the device to read.
+       * @param outEvent
+       *   Receives the event.
+       * @param timeoutNanoseconds
+       *   Maximum number of nanoseconds to wait (up to about 4.29 s).
+       * @return
+       *   0 on success, non-zero on failure or timeout.
+       */
+      static UInt32 ReadEventNanoseconds(
+        UInt32 deviceId,
+        Event& outEvent,
+        UInt32 timeoutNanoseconds
+      ) {
+        return InvokeSystemCall(
+          SystemCall::Input_ReadEventTimeoutNanoseconds,
+          deviceId,
+          reinterpret_cast<UInt32>(&outEvent),
+          timeoutNanoseconds
+        );
+      }
+
       /**
        * Pushes an event into the device queue.
        * @param deviceId
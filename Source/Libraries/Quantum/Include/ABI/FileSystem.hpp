@@ -9,6 +9,7 @@
 #pragma once
 
 #include "ABI/IPC.hpp"
+#include "ABI/SharedMemory.hpp"
 #include "ABI/SystemCall.hpp"
 #include "Bytes.hpp"
 #include "Types.hpp"
@@ -106,7 +107,37 @@ namespace Quantum::ABI {
         /**
          * Registers a file system service.
          */
-        RegisterService = 17
+        RegisterService = 17,
+
+        /**
+         * Writes a volume's buffered metadata and data to its device.
+         */
+        Sync = 18,
+
+        /**
+         * Reads as many directory entries as fit in one reply.
+         */
+        ReadDirectoryBatch = 19,
+
+        /**
+         * Reads from a file handle at an explicit offset.
+         */
+        ReadAt = 20,
+
+        /**
+         * Writes to a file handle at an explicit offset.
+         */
+        WriteAt = 21,
+
+        /**
+         * Reads from a file handle into a shared memory object.
+         */
+        ReadBulk = 22,
+
+        /**
+         * Writes to a file handle from a shared memory object.
+         */
+        WriteBulk = 23
       };
 
       /**
@@ -185,6 +216,12 @@ namespace Quantum::ABI {
          * FAT last write date.
          */
         UInt16 writeDate;
+
+        /**
+         * Number of contiguous cluster runs holding the file's data; 0 for
+         * an empty file or when the service does not report it.
+         */
+        UInt32 extentCount;
       };
 
       /**
@@ -215,6 +252,21 @@ namespace Quantum::ABI {
          * Free sector count.
          */
         UInt32 freeSectors;
+
+        /**
+         * Path lookups answered from the service's lookup cache.
+         */
+        UInt32 lookupHits;
+
+        /**
+         * Path lookups that had to scan a directory.
+         */
+        UInt32 lookupMisses;
+
+        /**
+         * Cached FAT sectors not yet written to disk.
+         */
+        UInt32 dirtySectors;
       };
 
       /**
@@ -280,7 +332,7 @@ namespace Quantum::ABI {
       /**
        * IPC message header size for file system service messages.
        */
-      static constexpr UInt32 messageHeaderBytes = 7 * sizeof(UInt32);
+      static constexpr UInt32 messageHeaderBytes = 8 * sizeof(UInt32);
 
       /**
        * IPC message data bytes for file system service messages.
@@ -288,6 +340,17 @@ namespace Quantum::ABI {
       static constexpr UInt32 messageDataBytes
         = IPC::maxPayloadBytes - messageHeaderBytes;
 
+      /**
+       * Most directory entries returned by one `ReadDirectoryBatch` reply.
+       */
+      static constexpr UInt32 directoryBatchEntries
+        = messageDataBytes / sizeof(DirectoryEntry);
+
+      /**
+       * Continuation cookie reported once a directory has been fully read.
+       */
+      static constexpr UInt32 directoryEndCookie = 0xFFFFFFFF;
+
       /**
        * Default timeout in ticks for file system requests.
        */
@@ -312,6 +375,12 @@ namespace Quantum::ABI {
          */
         UInt32 replyPortId;
 
+        /**
+         * Broker request id; services echo it in the reply so forwarded
+         * requests can be matched out of order (0 for direct calls).
+         */
+        UInt32 requestId;
+
         /**
          * First argument.
          */
@@ -541,6 +610,39 @@ namespace Quantum::ABI {
         return SendRequest(request, response, nullptr, 0, timeoutTicks);
       }
 
+      /**
+       * Writes a volume's buffered changes to its device.
+       * @param volume
+       *   Volume handle to sync.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 Sync(VolumeHandle volume) {
+        return Sync(volume, requestTimeoutTicks);
+      }
+
+      /**
+       * Writes a volume's buffered changes with a timeout.
+       * @param volume
+       *   Volume handle to sync.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 Sync(VolumeHandle volume, UInt32 timeoutTicks) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        request.op = Operation::Sync;
+        request.arg0 = volume;
+        request.arg1 = 0;
+        request.arg2 = 0;
+        request.dataLength = 0;
+
+        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+      }
+
       /**
        * Opens a file or directory relative to a volume.
        * @param volume
@@ -584,7 +686,16 @@ namespace Quantum::ABI {
         request.arg2 = 0;
         request.dataLength = CopyString(path, request.data, messageDataBytes);
 
-        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+        Handle handle
+          = SendRequest(request, response, nullptr, 0, timeoutTicks);
+
+        // the coordinator names the owning service so later data operations
+        // can skip the relay
+        if (handle != 0 && response.arg0 != 0) {
+          OpenChannel(handle, response.arg0, response.arg1);
+        }
+
+        return handle;
       }
 
       /**
@@ -617,7 +728,14 @@ namespace Quantum::ABI {
         request.arg2 = 0;
         request.dataLength = 0;
 
-        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+        UInt32 status
+          = SendRequest(request, response, nullptr, 0, timeoutTicks);
+
+        if (status == 0) {
+          CloseChannel(handle);
+        }
+
+        return status;
       }
 
       /**
@@ -718,6 +836,276 @@ namespace Quantum::ABI {
         return SendRequest(request, response, nullptr, 0, timeoutTicks);
       }
 
+      /**
+       * Writes to a file handle, hinting at the file's final size so the
+       * service can keep its clusters contiguous.
+       * @param handle
+       *   File handle.
+       * @param buffer
+       *   Input buffer.
+       * @param length
+       *   Number of bytes to write.
+       * @param sizeHint
+       *   Expected final file size in bytes (0 = unknown).
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   Number of bytes written, or 0 on failure.
+       */
+      static UInt32 Write(
+        Handle handle,
+        const void* buffer,
+        UInt32 length,
+        UInt32 sizeHint,
+        UInt32 timeoutTicks
+      ) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        request.op = Operation::Write;
+        request.arg0 = handle;
+        request.arg1 = length;
+        request.arg2 = sizeHint;
+        request.dataLength = 0;
+
+        if (buffer && length <= messageDataBytes) {
+          ::Quantum::CopyBytes(request.data, buffer, length);
+
+          request.dataLength = length;
+        }
+
+        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+      }
+
+      /**
+       * Reads from a file handle at an offset without moving its position.
+       * @param handle
+       *   File handle.
+       * @param offset
+       *   Byte offset to read from.
+       * @param buffer
+       *   Output buffer.
+       * @param length
+       *   Maximum number of bytes to read.
+       * @return
+       *   Number of bytes read, or 0 on failure.
+       */
+      static UInt32 ReadAt(
+        Handle handle,
+        UInt32 offset,
+        void* buffer,
+        UInt32 length
+      ) {
+        return ReadAt(handle, offset, buffer, length, requestTimeoutTicks);
+      }
+
+      /**
+       * Reads from a file handle at an offset with a timeout.
+       * @param handle
+       *   File handle.
+       * @param offset
+       *   Byte offset to read from.
+       * @param buffer
+       *   Output buffer.
+       * @param length
+       *   Maximum number of bytes to read.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   Number of bytes read, or 0 on failure.
+       */
+      static UInt32 ReadAt(
+        Handle handle,
+        UInt32 offset,
+        void* buffer,
+        UInt32 length,
+        UInt32 timeoutTicks
+      ) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        request.op = Operation::ReadAt;
+        request.arg0 = handle;
+        request.arg1 = length;
+        request.arg2 = offset;
+        request.dataLength = 0;
+
+        return SendRequest(request, response, buffer, length, timeoutTicks);
+      }
+
+      /**
+       * Writes to a file handle at an offset without moving its position.
+       * @param handle
+       *   File handle.
+       * @param offset
+       *   Byte offset to write at.
+       * @param buffer
+       *   Input buffer.
+       * @param length
+       *   Number of bytes to write.
+       * @return
+       *   Number of bytes written, or 0 on failure.
+       */
+      static UInt32 WriteAt(
+        Handle handle,
+        UInt32 offset,
+        const void* buffer,
+        UInt32 length
+      ) {
+        return WriteAt(handle, offset, buffer, length, requestTimeoutTicks);
+      }
+
+      /**
+       * Writes to a file handle at an offset with a timeout.
+       * @param handle
+       *   File handle.
+       * @param offset
+       *   Byte offset to write at.
+       * @param buffer
+       *   Input buffer.
+       * @param length
+       *   Number of bytes to write.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   Number of bytes written, or 0 on failure.
+       */
+      static UInt32 WriteAt(
+        Handle handle,
+        UInt32 offset,
+        const void* buffer,
+        UInt32 length,
+        UInt32 timeoutTicks
+      ) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        request.op = Operation::WriteAt;
+        request.arg0 = handle;
+        request.arg1 = length;
+        request.arg2 = offset;
+        request.dataLength = 0;
+
+        if (buffer && length <= messageDataBytes) {
+          ::Quantum::CopyBytes(request.data, buffer, length);
+
+          request.dataLength = length;
+        }
+
+        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+      }
+
+      /**
+       * Reads from a file handle straight into a shared memory object, so a
+       * single request is not limited to one message of data. The object
+       * must have been created by the caller, and the file must have a
+       * direct channel to its service.
+       * @param handle
+       *   File handle.
+       * @param sharedId
+       *   Shared memory id (see ABI::SharedMemory::GetInfo); the data lands
+       *   at the start of the object.
+       * @param length
+       *   Maximum number of bytes to read.
+       * @return
+       *   Number of bytes read, or 0 on failure.
+       */
+      static UInt32 ReadBulk(Handle handle, UInt32 sharedId, UInt32 length) {
+        return ReadBulk(handle, sharedId, length, requestTimeoutTicks);
+      }
+
+      /**
+       * Reads from a file handle into a shared memory object with a timeout.
+       * @param handle
+       *   File handle.
+       * @param sharedId
+       *   Shared memory id; the data lands at the start of the object.
+       * @param length
+       *   Maximum number of bytes to read.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   Number of bytes read, or 0 on failure.
+       */
+      static UInt32 ReadBulk(
+        Handle handle,
+        UInt32 sharedId,
+        UInt32 length,
+        UInt32 timeoutTicks
+      ) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        UInt32 rights = static_cast<UInt32>(SharedMemory::Right::Read)
+          | static_cast<UInt32>(SharedMemory::Right::Write);
+
+        if (!GrantBulk(handle, sharedId, rights)) {
+          return 0;
+        }
+
+        request.op = Operation::ReadBulk;
+        request.arg0 = handle;
+        request.arg1 = length;
+        request.arg2 = sharedId;
+        request.dataLength = 0;
+
+        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+      }
+
+      /**
+       * Writes to a file handle straight from a shared memory object. The
+       * object must have been created by the caller, and the file must have
+       * a direct channel to its service.
+       * @param handle
+       *   File handle.
+       * @param sharedId
+       *   Shared memory id; the data is taken from the start of the object.
+       * @param length
+       *   Number of bytes to write.
+       * @return
+       *   Number of bytes written, or 0 on failure.
+       */
+      static UInt32 WriteBulk(Handle handle, UInt32 sharedId, UInt32 length) {
+        return WriteBulk(handle, sharedId, length, requestTimeoutTicks);
+      }
+
+      /**
+       * Writes to a file handle from a shared memory object with a timeout.
+       * @param handle
+       *   File handle.
+       * @param sharedId
+       *   Shared memory id; the data is taken from the start of the object.
+       * @param length
+       *   Number of bytes to write.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   Number of bytes written, or 0 on failure.
+       */
+      static UInt32 WriteBulk(
+        Handle handle,
+        UInt32 sharedId,
+        UInt32 length,
+        UInt32 timeoutTicks
+      ) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        UInt32 rights = static_cast<UInt32>(SharedMemory::Right::Read);
+
+        if (!GrantBulk(handle, sharedId, rights)) {
+          return 0;
+        }
+
+        request.op = Operation::WriteBulk;
+        request.arg0 = handle;
+        request.arg1 = length;
+        request.arg2 = sharedId;
+        request.dataLength = 0;
+
+        return SendRequest(request, response, nullptr, 0, timeoutTicks);
+      }
+
       /**
        * Seeks within a file handle.
        * @param handle
@@ -858,6 +1246,107 @@ namespace Quantum::ABI {
         );
       }
 
+      /**
+       * Reads a batch of directory entries from a directory handle.
+       * @param handle
+       *   Directory handle.
+       * @param outEntries
+       *   Receives up to `maxEntries` entries.
+       * @param maxEntries
+       *   Capacity of `outEntries`; at most `directoryBatchEntries` are
+       *   returned per call.
+       * @param cookie
+       *   Continuation cookie: 0 to start, then the value from the previous
+       *   call. Set to `directoryEndCookie` once the directory is exhausted.
+       * @param outCount
+       *   Receives the number of entries returned.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 ReadDirectoryBatch(
+        Handle handle,
+        DirectoryEntry* outEntries,
+        UInt32 maxEntries,
+        UInt32& cookie,
+        UInt32& outCount
+      ) {
+        return ReadDirectoryBatch(
+          handle,
+          outEntries,
+          maxEntries,
+          cookie,
+          outCount,
+          requestTimeoutTicks
+        );
+      }
+
+      /**
+       * Reads a batch of directory entries with a timeout.
+       * @param handle
+       *   Directory handle.
+       * @param outEntries
+       *   Receives up to `maxEntries` entries.
+       * @param maxEntries
+       *   Capacity of `outEntries`; at most `directoryBatchEntries` are
+       *   returned per call.
+       * @param cookie
+       *   Continuation cookie: 0 to start, then the value from the previous
+       *   call. Set to `directoryEndCookie` once the directory is exhausted.
+       * @param outCount
+       *   Receives the number of entries returned.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 ReadDirectoryBatch(
+        Handle handle,
+        DirectoryEntry* outEntries,
+        UInt32 maxEntries,
+        UInt32& cookie,
+        UInt32& outCount,
+        UInt32 timeoutTicks
+      ) {
+        ServiceMessage request {};
+        ServiceMessage response {};
+
+        outCount = 0;
+
+        if (!outEntries || maxEntries == 0) {
+          return 1;
+        }
+
+        if (maxEntries > directoryBatchEntries) {
+          maxEntries = directoryBatchEntries;
+        }
+
+        request.op = Operation::ReadDirectoryBatch;
+        request.arg0 = handle;
+        request.arg1 = maxEntries;
+        request.arg2 = cookie;
+        request.dataLength = 0;
+
+        UInt32 status = SendRequest(
+          request,
+          response,
+          outEntries,
+          maxEntries * static_cast<UInt32>(sizeof(DirectoryEntry)),
+          timeoutTicks
+        );
+
+        // a failed call leaves the response empty; don't restart the listing
+        if (response.op != Operation::ReadDirectoryBatch) {
+          return 1;
+        }
+
+        if (status == 0) {
+          outCount = response.arg0 < maxEntries ? response.arg0 : maxEntries;
+          cookie = response.arg1;
+        }
+
+        return status;
+      }
+
       /**
        * Creates a directory.
        * @param volume
@@ -1087,6 +1576,163 @@ namespace Quantum::ABI {
       }
 
     private:
+      /**
+       * Direct route from an open file handle to its service.
+       */
+      struct Channel {
+        /**
+         * Coordinator file handle.
+         */
+        Handle handle;
+
+        /**
+         * Service-local file handle.
+         */
+        Handle serviceHandle;
+
+        /**
+         * Send handle to the service port.
+         */
+        IPC::Handle portHandle;
+      };
+
+      /**
+       * Maximum number of open files with a direct channel.
+       */
+      static constexpr UInt32 _maxChannels = 16;
+
+      /**
+       * Direct channels for open files.
+       */
+      inline static Channel _channels[_maxChannels] = {};
+
+      /**
+       * Records a direct channel for a newly opened file. Without a free
+       * slot the file keeps going through the coordinator.
+       * @param handle
+       *   Coordinator file handle.
+       * @param servicePort
+       *   Port id of the owning service.
+       * @param serviceHandle
+       *   Service-local file handle.
+       */
+      static void OpenChannel(
+        Handle handle,
+        UInt32 servicePort,
+        Handle serviceHandle
+      ) {
+        for (UInt32 i = 0; i < _maxChannels; ++i) {
+          if (_channels[i].handle != 0) {
+            continue;
+          }
+
+          IPC::Handle portHandle = IPC::OpenPort(
+            servicePort,
+            static_cast<UInt32>(IPC::Right::Send)
+          );
+
+          if (portHandle == 0) {
+            return;
+          }
+
+          _channels[i].handle = handle;
+          _channels[i].serviceHandle = serviceHandle;
+          _channels[i].portHandle = portHandle;
+
+          return;
+        }
+      }
+
+      /**
+       * Drops the direct channel of a closed file.
+       * @param handle
+       *   Coordinator file handle.
+       */
+      static void CloseChannel(Handle handle) {
+        Channel* channel = FindChannel(handle);
+
+        if (!channel) {
+          return;
+        }
+
+        IPC::CloseHandle(channel->portHandle);
+
+        channel->handle = 0;
+        channel->serviceHandle = 0;
+        channel->portHandle = 0;
+      }
+
+      /**
+       * Finds the direct channel of an open file.
+       * @param handle
+       *   Coordinator file handle.
+       * @return
+       *   Channel, or `nullptr` if the file has none.
+       */
+      static Channel* FindChannel(Handle handle) {
+        if (handle == 0) {
+          return nullptr;
+        }
+
+        for (UInt32 i = 0; i < _maxChannels; ++i) {
+          if (_channels[i].handle == handle) {
+            return &_channels[i];
+          }
+        }
+
+        return nullptr;
+      }
+
+      /**
+       * Lets the service owning a file open a shared memory object for a
+       * bulk request. Bulk requests only go over a direct channel, where the
+       * service sees who sent them and can check they own the object.
+       * @param handle
+       *   File handle.
+       * @param sharedId
+       *   Shared memory id named by the request.
+       * @param rights
+       *   Rights the service needs.
+       * @return
+       *   True if the service was granted access.
+       */
+      static bool GrantBulk(Handle handle, UInt32 sharedId, UInt32 rights) {
+        Channel* channel = FindChannel(handle);
+
+        return channel
+          && SharedMemory::Grant(sharedId, channel->portHandle, rights) == 0;
+      }
+
+      /**
+       * Returns true for operations on an open file that the owning service
+       * can answer without the coordinator. Close stays with the coordinator
+       * so it can drop its handle mapping.
+       * @param op
+       *   Operation identifier.
+       * @return
+       *   True if the operation may use a direct channel.
+       */
+      static bool IsChannelOperation(Operation op) {
+        switch (op) {
+          case Operation::ReadDirectory:
+          case Operation::ReadDirectoryBatch:
+          case Operation::Read:
+          case Operation::Write:
+          case Operation::ReadAt:
+          case Operation::WriteAt:
+          case Operation::ReadBulk:
+          case Operation::WriteBulk:
+          case Operation::Stat:
+          case Operation::Seek: {
+            return true;
+          }
+
+          default: {
+            return false;
+          }
+        }
+      }
+
       static UInt32 CopyString(CString src, UInt8* dest, UInt32 maxBytes) {
         if (!src || !dest || maxBytes == 0) {
           return 0;
@@ -1111,13 +1757,17 @@ namespace Quantum::ABI {
         UInt32 outputBytes,
         UInt32 timeoutTicks
       ) {
-        UInt32 replyPortId = IPC::CreatePort();
+        request.replyPortId = 0;
 
-        if (replyPortId == 0) {
-          return 0;
-        }
+        UInt32 portId = static_cast<UInt32>(IPC::Ports::FileSystem);
+        Channel* channel = IsChannelOperation(request.op)
+          ? FindChannel(request.arg0)
+          : nullptr;
 
-        request.replyPortId = 0;
+        if (channel) {
+          portId = channel->portHandle;
+          request.arg0 = channel->serviceHandle;
+        }
 
         IPC::Message msg {};
         UInt32 requestBytes = messageHeaderBytes + request.dataLength;
@@ -1126,70 +1776,19 @@ namespace Quantum::ABI {
 
         ::Quantum::CopyBytes(msg.payload, &request, requestBytes);
 
-        IPC::Handle replyHandle = IPC::OpenPort(
-          replyPortId,
-          static_cast<UInt32>(IPC::Right::Receive) | static_cast<UInt32>(IPC::Right::Manage) | static_cast<UInt32>(IPC::Right::Send)
-        );
-
-        if (replyHandle == 0) {
-          IPC::DestroyPort(replyPortId);
-
-          return 0;
-        }
-
-        IPC::Handle fsHandle = IPC::OpenPort(
-          static_cast<UInt32>(IPC::Ports::FileSystem),
-          static_cast<UInt32>(IPC::Right::Send)
-        );
-
-        if (fsHandle == 0) {
-          IPC::CloseHandle(replyHandle);
-
+        // the reply comes back through the call itself, so no reply port or
+        // handle transfer is needed
+        if (IPC::Call(portId, msg, timeoutTicks) != 0) {
           return 0;
         }
 
-        if (IPC::SendHandle(
-          fsHandle,
-          replyHandle,
-          static_cast<UInt32>(IPC::Right::Send)
-        ) != 0) {
-          IPC::CloseHandle(fsHandle);
-          IPC::DestroyPort(replyHandle);
-          IPC::CloseHandle(replyHandle);
-
-          return 0;
-        }
-
-        if (IPC::Send(fsHandle, msg) != 0) {
-          IPC::CloseHandle(fsHandle);
-          IPC::DestroyPort(replyHandle);
-          IPC::CloseHandle(replyHandle);
-
-          return 0;
-        }
-
-        IPC::CloseHandle(fsHandle);
-
-        IPC::Message reply {};
-
-        if (IPC::ReceiveTimeout(
-          replyHandle,
-          reply,
-          timeoutTicks
-        ) != 0) {
-          IPC::DestroyPort(replyHandle);
-          IPC::CloseHandle(replyHandle);
-
-          return 0;
-        }
-
-        UInt32 copyBytes = reply.length;
+        UInt32 copyBytes = msg.length;
 
         if (copyBytes > sizeof(response)) {
           copyBytes = sizeof(response);
         }
 
-        ::Quantum::CopyBytes(&response, reply.payload, copyBytes);
+        ::Quantum::CopyBytes(&response, msg.payload, copyBytes);
 
         if (output && outputBytes > 0 && response.dataLength > 0) {
           UInt32 responseBytes = response.dataLength;
@@ -1201,12 +1800,7 @@ namespace Quantum::ABI {
           ::Quantum::CopyBytes(output, response.data, responseBytes);
         }
 
-        UInt32 status = static_cast<UInt32>(response.status);
-
-        IPC::DestroyPort(replyHandle);
-        IPC::CloseHandle(replyHandle);
-
-        return status;
+        return static_cast<UInt32>(response.status);
       }
   };
 }
@@ -92,6 +92,12 @@ namespace Quantum::ABI {
          */
         UInt32 length;
 
+        /**
+         * One-shot reply token when the sender used `Call` (set by the
+         * kernel; 0 otherwise).
+         */
+        UInt32 replyToken;
+
         /**
          * Message payload bytes.
          */
@@ -219,6 +225,28 @@ namespace Quantum::ABI {
         );
       }
 
+      /**
+       * Sends a message to a port, failing instead of blocking if the
+       * port's queue is full.
+       * @param portId
+       *   Target port id or handle.
+       * @param message
+       *   Message to send; length must be <= `maxPayloadBytes`.
+       * @return
+       *   0 on success, non-zero on failure or if the queue is full.
+       */
+      static UInt32 SendNoWait(
+        UInt32 portId,
+        const Message& message
+      ) {
+        return InvokeSystemCall(
+          SystemCall::IPC_SendNoWait,
+          portId,
+          reinterpret_cast<UInt32>(&message),
+          0
+        );
+      }
+
       /**
        * Sends a handle to a port (handle is duplicated to the receiver).
        * @param portId
@@ -288,6 +316,30 @@ namespace Quantum::ABI {
         );
       }
 
+      /**
+       * Receives a message with a timeout in nanoseconds.
+       * @param portId
+       *   Port id or handle to receive from.
+       * @param outMessage
+       *   Receives the message contents.
+       * @param timeoutNanoseconds
+       *   Maximum number of nanoseconds to wait (up to about 4.29 s).
+       * @return
+       *   0 on success, non-zero on timeout or failure.
+       */
+      static UInt32 ReceiveTimeoutNanoseconds(
+        UInt32 portId,
+        Message& outMessage,
+        UInt32 timeoutNanoseconds
+      ) {
+        return InvokeSystemCall(
+          SystemCall::IPC_ReceiveTimeoutNanoseconds,
+          portId,
+          reinterpret_cast<UInt32>(&outMessage),
+          timeoutNanoseconds
+        );
+      }
+
       /**
        * Attempts to receive a message without blocking.
        * @param portId
@@ -308,5 +360,133 @@ namespace Quantum::ABI {
           0
         );
       }
+
+      /**
+       * Creates a port set for waiting on several ports at once.
+       * @return
+       *   Port set handle, or 0 on failure.
+       */
+      static Handle CreatePortSet() {
+        return InvokeSystemCall(SystemCall::IPC_CreatePortSet);
+      }
+
+      /**
+       * Attaches a port owned by the caller to a port set.
+       * @param portSet
+       *   Port set handle.
+       * @param portId
+       *   Port id or handle to attach.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 AddToPortSet(Handle portSet, UInt32 portId) {
+        return InvokeSystemCall(SystemCall::IPC_AddToPortSet, portSet, portId);
+      }
+
+      /**
+       * Detaches a port from a port set.
+       * @param portSet
+       *   Port set handle.
+       * @param portId
+       *   Port id or handle to detach.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 RemoveFromPortSet(Handle portSet, UInt32 portId) {
+        return InvokeSystemCall(
+          SystemCall::IPC_RemoveFromPortSet,
+          portSet,
+          portId
+        );
+      }
+
+      /**
+       * Blocks until any port in a set has a message pending. The message
+       * stays queued; receive it from the returned port with `TryReceive`.
+       * @param portSet
+       *   Port set handle.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait (0 waits forever).
+       * @return
+       *   Id of a ready port, or 0 on timeout or failure.
+       */
+      static UInt32 WaitAny(Handle portSet, UInt32 timeoutTicks = 0) {
+        return InvokeSystemCall(
+          SystemCall::IPC_WaitAny,
+          portSet,
+          timeoutTicks
+        );
+      }
+
+      /**
+       * Sends a request and blocks until the receiver replies. No reply port
+       * is needed; the reply overwrites the request in `message`.
+       * @param portId
+       *   Target port id or handle.
+       * @param message
+       *   Request on input; receives the reply on success.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait for the reply (0 waits forever).
+       * @return
+       *   0 on success, non-zero on timeout or failure.
+       */
+      static UInt32 Call(
+        UInt32 portId,
+        Message& message,
+        UInt32 timeoutTicks = 0
+      ) {
+        return InvokeSystemCall(
+          SystemCall::IPC_Call,
+          portId,
+          reinterpret_cast<UInt32>(&message),
+          timeoutTicks
+        );
+      }
+
+      /**
+       * Replies to a request received from `Call`.
+       * @param replyToken
+       *   Reply token from the received request.
+       * @param message
+       *   Reply to deliver.
+       * @return
+       *   0 on success, non-zero if the token is invalid or already used.
+       */
+      static UInt32 Reply(
+        UInt32 replyToken,
+        const Message& message
+      ) {
+        return InvokeSystemCall(
+          SystemCall::IPC_Reply,
+          replyToken,
+          reinterpret_cast<UInt32>(&message),
+          0
+        );
+      }
+
+      /**
+       * Replies to the previous request (if any) and blocks for the next one
+       * in a single call.
+       * @param portId
+       *   Port id or handle to receive from.
+       * @param replyToken
+       *   Reply token of the previous request, or 0 to only receive.
+       * @param message
+       *   Reply on input; receives the next request on success.
+       * @return
+       *   0 on success, non-zero on receive failure.
+       */
+      static UInt32 ReplyWait(
+        UInt32 portId,
+        UInt32 replyToken,
+        Message& message
+      ) {
+        return InvokeSystemCall(
+          SystemCall::IPC_ReplyWait,
+          portId,
+          reinterpret_cast<UInt32>(&message),
+          replyToken
+        );
+      }
   };
 }
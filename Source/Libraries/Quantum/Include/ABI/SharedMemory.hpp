@@ -0,0 +1,164 @@
+/**
+ * @file Libraries/Quantum/Include/ABI/SharedMemory.hpp
+ * @brief Shared memory syscall wrappers.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include "ABI/SystemCall.hpp"
+#include "Types.hpp"
+
+namespace Quantum::ABI {
+  /**
+   * Shared memory syscall wrappers.
+   */
+  class SharedMemory {
+    public:
+      /**
+       * Shared memory handle rights.
+       */
+      enum class Right : UInt32 {
+        /**
+         * Map for reading.
+         */
+        Read = 1u << 0,
+
+        /**
+         * Map for writing.
+         */
+        Write = 1u << 1
+      };
+
+      /**
+       * Largest shared memory object in bytes.
+       */
+      static constexpr UInt32 maxBytes = 64 * 4096;
+
+      /**
+       * Shared memory information payload.
+       */
+      struct Info {
+        /**
+         * Shared memory identifier other tasks open it by.
+         */
+        UInt32 id;
+
+        /**
+         * Size in bytes, rounded up to whole pages.
+         */
+        UInt32 size;
+
+        /**
+         * Task that created the object.
+         */
+        UInt32 ownerId;
+      };
+
+      /**
+       * Creates a zero-filled shared memory object.
+       * @param sizeBytes
+       *   Requested size in bytes.
+       * @return
+       *   Handle with read and write rights on success; 0 on failure.
+       */
+      static UInt32 Create(UInt32 sizeBytes) {
+        return InvokeSystemCall(
+          SystemCall::Memory_CreateShared,
+          sizeBytes,
+          0,
+          0
+        );
+      }
+
+      /**
+       * Opens a shared memory object by id. Only the creator and tasks it
+       * granted access to (see Grant) may open it.
+       * @param id
+       *   Shared memory identifier.
+       * @param rights
+       *   Requested rights mask.
+       * @return
+       *   Handle on success; 0 on failure.
+       */
+      static UInt32 Open(UInt32 id, UInt32 rights) {
+        return InvokeSystemCall(SystemCall::Memory_OpenShared, id, rights, 0);
+      }
+
+      /**
+       * Lets the task owning a port open a shared memory object created by
+       * the caller.
+       * @param id
+       *   Shared memory identifier.
+       * @param portId
+       *   Port id or handle owned by the task receiving access.
+       * @param rights
+       *   Rights mask the task may open the object with.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 Grant(UInt32 id, UInt32 portId, UInt32 rights) {
+        return InvokeSystemCall(
+          SystemCall::Memory_GrantShared,
+          id,
+          portId,
+          rights
+        );
+      }
+
+      /**
+       * Maps a shared memory object into the calling task. The mapping is
+       * writable only when the handle carries the write right.
+       * @param handle
+       *   Shared memory handle.
+       * @return
+       *   Base address of the mapping, or `nullptr` on failure.
+       */
+      static void* Map(UInt32 handle) {
+        UInt32 address = InvokeSystemCall(
+          SystemCall::Memory_MapShared,
+          handle,
+          0,
+          0
+        );
+
+        return reinterpret_cast<void*>(address);
+      }
+
+      /**
+       * Removes a mapping created by Map.
+       * @param address
+       *   Base address returned by Map.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 Unmap(void* address) {
+        return InvokeSystemCall(
+          SystemCall::Memory_UnmapShared,
+          reinterpret_cast<UInt32>(address),
+          0,
+          0
+        );
+      }
+
+      /**
+       * Queries a shared memory handle.
+       * @param handle
+       *   Shared memory handle.
+       * @param outInfo
+       *   Receives the id and size.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static UInt32 GetInfo(UInt32 handle, Info& outInfo) {
+        return InvokeSystemCall(
+          SystemCall::Memory_GetSharedInfo,
+          handle,
+          reinterpret_cast<UInt32>(&outInfo),
+          0
+        );
+      }
+  };
+}
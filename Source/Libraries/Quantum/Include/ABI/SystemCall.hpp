@@ -20,6 +20,10 @@ namespace Quantum::ABI {
     Task_GrantIOAccess = 102,
     Task_Sleep = 103,
     Task_GetTickRate = 104,
+    Task_SetPriority = 105,
+    Task_GetNanoseconds = 106,
+    Task_SleepNanoseconds = 107,
+    Task_SetTaskPriority = 108,
     Console_Write = 200,
     Console_WriteLine = 201,
     InitBundle_GetInfo = 300,
@@ -33,6 +37,15 @@ namespace Quantum::ABI {
     IPC_CloseHandle = 406,
     IPC_SendHandle = 407,
     IPC_ReceiveTimeout = 408,
+    IPC_Call = 409,
+    IPC_Reply = 410,
+    IPC_ReplyWait = 411,
+    IPC_CreatePortSet = 412,
+    IPC_AddToPortSet = 413,
+    IPC_RemoveFromPortSet = 414,
+    IPC_WaitAny = 415,
+    IPC_ReceiveTimeoutNanoseconds = 416,
+    IPC_SendNoWait = 417,
     IRQ_Register = 501,
     IRQ_Unregister = 502,
     IRQ_Enable = 503,
@@ -53,6 +66,12 @@ namespace Quantum::ABI {
     Block_UpdateInfo = 706,
     Block_Register = 707,
     Block_Open = 708,
+    Block_Flush = 709,
+    Block_GetCacheStats = 710,
+    Block_ConfigureCache = 711,
+    Block_Submit = 712,
+    Block_Complete = 713,
+    Block_SetScheduler = 714,
     Input_GetCount = 720,
     Input_GetInfo = 721,
     Input_Register = 722,
@@ -61,7 +80,14 @@ namespace Quantum::ABI {
     Input_PushEvent = 725,
     Input_Open = 726,
     Input_ReadEventTimeout = 727,
+    Input_ReadEventTimeoutNanoseconds = 728,
     Memory_ExpandHeap = 800,
+    Memory_CreateShared = 801,
+    Memory_OpenShared = 802,
+    Memory_MapShared = 803,
+    Memory_UnmapShared = 804,
+    Memory_GetSharedInfo = 805,
+    Memory_GrantShared = 806,
     Handle_Close = 810,
     Handle_Dup = 811,
     Handle_Query = 812
@@ -17,6 +17,22 @@ namespace Quantum::ABI {
    */
   class Task {
     public:
+      /**
+       * Lowest scheduling priority.
+       */
+      static constexpr UInt32 lowestPriority = 0;
+
+      /**
+       * Priority tasks start with.
+       */
+      static constexpr UInt32 defaultPriority = 3;
+
+      /**
+       * Highest priority a task may request. Raising above
+       * `defaultPriority` requires I/O access.
+       */
+      static constexpr UInt32 highestPriority = 6;
+
       /**
        * Yields the current task.
        */
@@ -62,25 +78,41 @@ namespace Quantum::ABI {
       }
 
       /**
-       * Sleeps for at least the specified number of milliseconds.
-       * @param ms
-       *   Milliseconds to sleep.
+       * Returns the kernel's monotonic nanosecond clock.
+       * @return
+       *   Nanoseconds since timer init, or 0 on failure.
        */
-      static inline void SleepMs(UInt32 ms) {
-        UInt32 hz = GetTickRate();
+      static inline UInt64 GetNanoseconds() {
+        UInt64 nanoseconds = 0;
 
-        if (hz == 0) {
-          return;
-        }
+        ABI::InvokeSystemCall(
+          ABI::SystemCall::Task_GetNanoseconds,
+          reinterpret_cast<UInt32>(&nanoseconds)
+        );
 
-        UInt64 ticks = static_cast<UInt64>(ms) * hz;
-        ticks = (ticks + 999) / 1000;
+        return nanoseconds;
+      }
 
-        if (ticks == 0) {
-          ticks = 1;
-        }
+      /**
+       * Sleeps for at least the specified number of nanoseconds.
+       * @param nanoseconds
+       *   Nanoseconds to sleep.
+       */
+      static inline void SleepNanoseconds(UInt64 nanoseconds) {
+        ABI::InvokeSystemCall(
+          ABI::SystemCall::Task_SleepNanoseconds,
+          static_cast<UInt32>(nanoseconds),
+          static_cast<UInt32>(nanoseconds >> 32)
+        );
+      }
 
-        SleepTicks(static_cast<UInt32>(ticks));
+      /**
+       * Sleeps for at least the specified number of milliseconds.
+       * @param ms
+       *   Milliseconds to sleep.
+       */
+      static inline void SleepMs(UInt32 ms) {
+        SleepNanoseconds(static_cast<UInt64>(ms) * 1000000);
       }
 
       /**
@@ -89,20 +121,43 @@ namespace Quantum::ABI {
        *   Microseconds to sleep.
        */
       static inline void SleepUs(UInt32 us) {
-        UInt32 hz = GetTickRate();
-
-        if (hz == 0) {
-          return;
-        }
-
-        UInt64 ticks = static_cast<UInt64>(us) * hz;
-        ticks = (ticks + 999999) / 1000000;
+        SleepNanoseconds(static_cast<UInt64>(us) * 1000);
+      }
 
-        if (ticks == 0) {
-          ticks = 1;
-        }
+      /**
+       * Sets the scheduling priority of the current task or one of its
+       * threads. Higher priorities run first.
+       * @param priority
+       *   New priority, from `lowestPriority` to `highestPriority`.
+       * @param threadId
+       *   Thread to update, or 0 for the whole task.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static inline UInt32 SetPriority(UInt32 priority, UInt32 threadId = 0) {
+        return ABI::InvokeSystemCall(
+          ABI::SystemCall::Task_SetPriority,
+          priority,
+          threadId
+        );
+      }
 
-        SleepTicks(static_cast<UInt32>(ticks));
+      /**
+       * Sets the scheduling priority of another task and all of its
+       * threads. Only the coordinator may call this.
+       * @param taskId
+       *   Task to update.
+       * @param priority
+       *   New priority, from `lowestPriority` to `highestPriority`.
+       * @return
+       *   0 on success, non-zero on failure.
+       */
+      static inline UInt32 SetTaskPriority(UInt32 taskId, UInt32 priority) {
+        return ABI::InvokeSystemCall(
+          ABI::SystemCall::Task_SetTaskPriority,
+          taskId,
+          priority
+        );
       }
 
     private:
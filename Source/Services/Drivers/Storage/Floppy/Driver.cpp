@@ -231,12 +231,79 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
     return header.op == ABI::IRQ::Operation::Notify && header.irq == _irqLine;
   }
 
-  void Driver::QueuePendingMessage(const IPC::Message& msg) {
-    if (_pendingCount >= _maxPendingMessages) {
+  bool Driver::EnqueueRequest(const IPC::Message& msg) {
+    if (_requestQueueCount >= _requestQueueCapacity) {
+      return false;
+    }
+
+    UInt32 tail = (_requestQueueHead + _requestQueueCount)
+      % _requestQueueCapacity;
+
+    _requestQueue[tail] = msg;
+    _requestQueueCount++;
+
+    return true;
+  }
+
+  bool Driver::DequeueRequest(IPC::Message& outMsg) {
+    if (_requestQueueCount == 0) {
+      return false;
+    }
+
+    outMsg = _requestQueue[_requestQueueHead];
+    _requestQueueHead = (_requestQueueHead + 1) % _requestQueueCapacity;
+    _requestQueueCount--;
+
+    return true;
+  }
+
+  void Driver::RejectRequest(const IPC::Message& msg) {
+    if (msg.length < BlockDevices::messageHeaderBytes) {
+      return;
+    }
+
+    BlockDevices::Message header {};
+
+    CopyBytes(&header, msg.payload, BlockDevices::messageHeaderBytes);
+
+    if (
+      header.op != BlockDevices::Operation::Read
+      && header.op != BlockDevices::Operation::Write
+      && header.op != BlockDevices::Operation::ReadBulk
+      && header.op != BlockDevices::Operation::WriteBulk
+    ) {
       return;
     }
 
-    _pendingMessages[_pendingCount++] = msg;
+    header.op = BlockDevices::Operation::Response;
+    header.status = 8;
+    header.dataLength = 0;
+
+    IPC::Message& reply = _rejectMessage;
+
+    reply.length = BlockDevices::messageHeaderBytes;
+
+    CopyBytes(reply.payload, &header, reply.length);
+
+    if (msg.replyToken != 0) {
+      IPC::Reply(msg.replyToken, reply);
+
+      return;
+    }
+
+    if (header.replyPortId == 0) {
+      return;
+    }
+
+    IPC::Handle replyHandle = IPC::OpenPort(
+      header.replyPortId,
+      static_cast<UInt32>(IPC::Right::Send)
+    );
+
+    if (replyHandle != 0) {
+      IPC::Send(replyHandle, reply);
+      IPC::CloseHandle(replyHandle);
+    }
   }
 
   bool Driver::WaitForIRQ() {
@@ -258,7 +325,9 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
             return true;
           }
 
-          QueuePendingMessage(msg);
+          if (!EnqueueRequest(msg)) {
+            RejectRequest(msg);
+          }
         }
       }
 
@@ -639,7 +708,55 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
     cylinder = static_cast<UInt8>(track / headCount);
   }
 
-  bool Driver::ReadSectors(
+  bool Driver::TrackCacheHolds(
+    UInt8 driveIndex,
+    UInt8 cylinder,
+    UInt32 sectorSize,
+    UInt8 sectorsPerTrack,
+    UInt8 headCount
+  ) {
+    return _trackCacheValid
+      && _trackCacheDrive == driveIndex
+      && _trackCacheCylinder == cylinder
+      && _trackCacheSectorSize == sectorSize
+      && _trackCacheSectorsPerTrack == sectorsPerTrack
+      && _trackCacheHeadCount == headCount;
+  }
+
+  void Driver::InvalidateTrackCache(
+    UInt8 driveIndex,
+    UInt32 lba,
+    UInt32 count,
+    UInt8 sectorsPerTrack,
+    UInt8 headCount
+  ) {
+    if (!_trackCacheValid || _trackCacheDrive != driveIndex) {
+      return;
+    }
+
+    // a different geometry maps LBAs elsewhere, so drop the cylinder outright
+    if (
+      _trackCacheSectorsPerTrack == sectorsPerTrack
+      && _trackCacheHeadCount == headCount
+      && count != 0
+    ) {
+      UInt32 sectorsPerCylinder
+        = static_cast<UInt32>(sectorsPerTrack) * headCount;
+      UInt32 firstCylinder = lba / sectorsPerCylinder;
+      UInt32 lastCylinder = (lba + count - 1) / sectorsPerCylinder;
+
+      if (
+        _trackCacheCylinder < firstCylinder
+        || _trackCacheCylinder > lastCylinder
+      ) {
+        return;
+      }
+    }
+
+    _trackCacheValid = false;
+  }
+
+  bool Driver::ReadFromTrackCache(
     UInt8 driveIndex,
     UInt32 lba,
     UInt32 count,
@@ -647,207 +764,372 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
     UInt8 sectorsPerTrack,
     UInt8 headCount
   ) {
-    if (count == 0 || sectorSize == 0) {
-      LogReadFailure("bad request");
+    if (!_trackCacheValid || count == 0) {
+      return false;
+    }
 
+    UInt32 sectorsPerCylinder
+      = static_cast<UInt32>(sectorsPerTrack) * headCount;
+    UInt32 cylinder = lba / sectorsPerCylinder;
+    UInt32 bytes = count * sectorSize;
+
+    if (
+      cylinder > 0xFF
+      || (lba + count - 1) / sectorsPerCylinder != cylinder
+      || bytes > _dmaBufferBytes
+      || !TrackCacheHolds(
+        driveIndex,
+        static_cast<UInt8>(cylinder),
+        sectorSize,
+        sectorsPerTrack,
+        headCount
+      )
+    ) {
       return false;
     }
 
-    if (_dmaBufferVirtual == nullptr || _dmaBufferBytes < sectorSize) {
-      LogReadFailure("DMA buffer too small");
+    UInt32 offset = (lba - cylinder * sectorsPerCylinder) * sectorSize;
+
+    CopyBytes(_dmaBufferVirtual, _trackCache + offset, bytes);
+
+    return true;
+  }
 
+  bool Driver::FillTrackCache(
+    UInt8 driveIndex,
+    UInt8 cylinder,
+    UInt32 sectorSize,
+    UInt8 sizeCode,
+    UInt8 sectorsPerTrack,
+    UInt8 headCount,
+    UInt32 dmaOffset
+  ) {
+    UInt32 sectors = static_cast<UInt32>(sectorsPerTrack) * headCount;
+    UInt32 bytes = sectors * sectorSize;
+
+    if (bytes > _trackCacheBytes || dmaOffset + bytes > _dmaBufferBytes) {
       return false;
     }
 
-    if (sectorsPerTrack == 0 || headCount == 0) {
-      LogReadFailure("bad geometry");
+    _trackCacheValid = false;
 
+    // head 0 sector 1 with multi-track set runs through both heads, so the
+    // whole cylinder arrives in one revolution per head
+    if (!ReadSegment(
+      driveIndex,
+      cylinder,
+      0,
+      1,
+      sectors,
+      sectorSize,
+      sizeCode,
+      sectorsPerTrack,
+      headCount,
+      _dmaBufferPhysical + dmaOffset
+    )) {
       return false;
     }
 
-    UInt32 remaining = count;
-    UInt32 currentLBA = lba;
+    CopyBytes(_trackCache, _dmaBufferVirtual + dmaOffset, bytes);
 
-    SetDrive(driveIndex, true);
-    WaitForMotorSpinUp();
+    _trackCacheDrive = driveIndex;
+    _trackCacheCylinder = cylinder;
+    _trackCacheSectorSize = sectorSize;
+    _trackCacheSectorsPerTrack = sectorsPerTrack;
+    _trackCacheHeadCount = headCount;
+    _trackCacheValid = true;
 
-    if (_currentCylinder[driveIndex] == 0xFF) {
-      if (!Calibrate(driveIndex)) {
-        LogReadFailure("calibrate");
+    return true;
+  }
 
-        return false;
+  bool Driver::ReadSegment(
+    UInt8 driveIndex,
+    UInt8 cylinder,
+    UInt8 head,
+    UInt8 sector,
+    UInt32 count,
+    UInt32 sectorSize,
+    UInt8 sizeCode,
+    UInt8 sectorsPerTrack,
+    UInt8 headCount,
+    UInt32 physicalAddress
+  ) {
+    bool success = false;
+    CString failure = nullptr;
+
+    for (UInt32 attempt = 0; attempt < _maxRetries; ++attempt) {
+      failure = nullptr;
+      if (attempt > 0) {
+        Calibrate(driveIndex);
       }
-    }
 
-    UInt32 size = sectorSize;
+      if (_currentCylinder[driveIndex] != cylinder) {
+        if (!Seek(driveIndex, cylinder, head)) {
+          failure = "seek";
 
-    if (size < 128 || (size & (size - 1)) != 0) {
-      LogReadFailure("sector size");
+          continue;
+        }
+      }
 
-      return false;
-    }
+      if (!ProgramDMARead(physicalAddress, count * sectorSize)) {
+        failure = "DMA program";
 
-    UInt8 sizeCode = 0;
+        continue;
+      }
 
-    while (size > 128) {
-      size >>= 1;
-      ++sizeCode;
-    }
+      _irqPendingCount = 0;
 
-    while (remaining > 0) {
-      UInt8 cylinder = 0;
-      UInt8 head = 0;
-      UInt8 sector = 0;
+      bool multiTrack
+        = headCount > 1 && (sector + count - 1) > sectorsPerTrack;
+      UInt8 command = multiTrack
+        ? _commandReadDataMultiTrack
+        : _commandReadData;
 
-      LBAToCHS(currentLBA, sectorsPerTrack, headCount, cylinder, head, sector);
+      if (!WriteFIFOByte(command)) {
+        failure = "write command";
 
-      UInt32 totalLeft
-        = static_cast<UInt32>((sectorsPerTrack * headCount)
-        - (head * sectorsPerTrack)
-        - (sector - 1));
-      UInt32 toRead = remaining < totalLeft ? remaining : totalLeft;
-      UInt32 bytes = toRead * sectorSize;
+        continue;
+      }
 
-      if (bytes > _dmaBufferBytes) {
-        LogReadFailure("DMA buffer too small");
+      UInt8 driveHead
+        = static_cast<UInt8>(((head & 0x01) << 2)
+        | (driveIndex & 0x03));
 
-        return false;
+      if (!WriteFIFOByte(driveHead)) {
+        failure = "write drive/head";
+
+        continue;
       }
 
-      bool success = false;
-      CString failure = nullptr;
+      if (!WriteFIFOByte(cylinder)) {
+        failure = "write cylinder";
 
-      for (UInt32 attempt = 0; attempt < _maxRetries; ++attempt) {
-        failure = nullptr;
-        if (attempt > 0) {
-          Calibrate(driveIndex);
-        }
+        continue;
+      }
 
-        if (_currentCylinder[driveIndex] != cylinder) {
-          if (!Seek(driveIndex, cylinder, head)) {
-            failure = "seek";
+      if (!WriteFIFOByte(head)) {
+        failure = "write head";
 
-            continue;
-          }
-        }
+        continue;
+      }
 
-        if (!ProgramDMARead(_dmaBufferPhysical, bytes)) {
-          failure = "DMA program";
+      if (!WriteFIFOByte(sector)) {
+        failure = "write sector";
 
-          continue;
-        }
+        continue;
+      }
 
-        _irqPendingCount = 0;
+      if (!WriteFIFOByte(sizeCode)) {
+        failure = "write sector size";
 
-        bool multiTrack
-          = headCount > 1 && (sector + toRead - 1) > sectorsPerTrack;
-        UInt8 command = multiTrack
-          ? _commandReadDataMultiTrack
-          : _commandReadData;
+        continue;
+      }
 
-        if (!WriteFIFOByte(command)) {
-          failure = "write command";
+      UInt8 endOfTrack = multiTrack
+        ? sectorsPerTrack
+        : static_cast<UInt8>(sector + count - 1);
 
-          continue;
-        }
+      if (!WriteFIFOByte(endOfTrack)) {
+        failure = "write EOT";
 
-        UInt8 driveHead
-          = static_cast<UInt8>(((head & 0x01) << 2)
-          | (driveIndex & 0x03));
+        continue;
+      }
 
-        if (!WriteFIFOByte(driveHead)) {
-          failure = "write drive/head";
+      if (!WriteFIFOByte(0x1B)) {
+        failure = "write GAP";
 
-          continue;
-        }
+        continue;
+      }
 
-        if (!WriteFIFOByte(cylinder)) {
-          failure = "write cylinder";
+      if (!WriteFIFOByte(0xFF)) {
+        failure = "write DTL";
 
-          continue;
-        }
+        continue;
+      }
 
-        if (!WriteFIFOByte(head)) {
-          failure = "write head";
+      if (!WaitForIRQ()) {
+        failure = "IRQ timeout";
 
-          continue;
-        }
+        continue;
+      }
 
-        if (!WriteFIFOByte(sector)) {
-          failure = "write sector";
+      UInt8 result[7] = {};
 
-          continue;
+      for (UInt32 i = 0; i < 7; ++i) {
+        if (!ReadFIFOByte(result[i])) {
+          failure = "read result";
+
+          break;
         }
+      }
 
-        if (!WriteFIFOByte(sizeCode)) {
-          failure = "write sector size";
+      if (failure != nullptr) {
+        continue;
+      }
 
-          continue;
-        }
+      if ((result[0] & 0xC0) != 0) {
+        LogResultBytes(result);
 
-        UInt8 endOfTrack = multiTrack
-          ? sectorsPerTrack
-          : static_cast<UInt8>(sector + toRead - 1);
+        failure = "status error";
 
-        if (!WriteFIFOByte(endOfTrack)) {
-          failure = "write EOT";
+        continue;
+      }
 
-          continue;
-        }
+      success = true;
 
-        if (!WriteFIFOByte(0x1B)) {
-          failure = "write GAP";
+      break;
+    }
 
-          continue;
-        }
+    if (!success) {
+      if (failure != nullptr) {
+        LogReadFailure(failure);
+      }
 
-        if (!WriteFIFOByte(0xFF)) {
-          failure = "write DTL";
+      return false;
+    }
 
-          continue;
-        }
+    return true;
+  }
 
-        if (!WaitForIRQ()) {
-          failure = "IRQ timeout";
+  bool Driver::ReadSectors(
+    UInt8 driveIndex,
+    UInt32 lba,
+    UInt32 count,
+    UInt32 sectorSize,
+    UInt8 sectorsPerTrack,
+    UInt8 headCount
+  ) {
+    if (count == 0 || sectorSize == 0) {
+      LogReadFailure("bad request");
 
-          continue;
-        }
+      return false;
+    }
 
-        UInt8 result[7] = {};
+    if (_dmaBufferVirtual == nullptr || _dmaBufferBytes < sectorSize) {
+      LogReadFailure("DMA buffer too small");
 
-        for (UInt32 i = 0; i < 7; ++i) {
-          if (!ReadFIFOByte(result[i])) {
-            failure = "read result";
+      return false;
+    }
 
-            break;
-          }
-        }
+    if (sectorsPerTrack == 0 || headCount == 0) {
+      LogReadFailure("bad geometry");
 
-        if (failure != nullptr) {
-          continue;
-        }
+      return false;
+    }
 
-        if ((result[0] & 0xC0) != 0) {
-          LogResultBytes(result);
+    // sequential reads inside the last cylinder never touch the controller
+    if (ReadFromTrackCache(
+      driveIndex,
+      lba,
+      count,
+      sectorSize,
+      sectorsPerTrack,
+      headCount
+    )) {
+      return true;
+    }
 
-          failure = "status error";
+    UInt32 remaining = count;
+    UInt32 currentLBA = lba;
 
-          continue;
-        }
+    SetDrive(driveIndex, true);
+    WaitForMotorSpinUp();
 
-        success = true;
+    if (_currentCylinder[driveIndex] == 0xFF) {
+      if (!Calibrate(driveIndex)) {
+        LogReadFailure("calibrate");
 
-        break;
+        return false;
       }
+    }
 
-      if (!success) {
-        if (failure != nullptr) {
-          LogReadFailure(failure);
-        }
+    UInt32 size = sectorSize;
+
+    if (size < 128 || (size & (size - 1)) != 0) {
+      LogReadFailure("sector size");
+
+      return false;
+    }
+
+    UInt8 sizeCode = 0;
+
+    while (size > 128) {
+      size >>= 1;
+      ++sizeCode;
+    }
+
+    UInt32 cylinderBytes
+      = static_cast<UInt32>(sectorsPerTrack) * headCount * sectorSize;
+
+    while (remaining > 0) {
+      UInt8 cylinder = 0;
+      UInt8 head = 0;
+      UInt8 sector = 0;
+
+      LBAToCHS(currentLBA, sectorsPerTrack, headCount, cylinder, head, sector);
+
+      UInt32 totalLeft
+        = static_cast<UInt32>((sectorsPerTrack * headCount)
+        - (head * sectorsPerTrack)
+        - (sector - 1));
+      UInt32 toRead = remaining < totalLeft ? remaining : totalLeft;
+      UInt32 bytes = toRead * sectorSize;
+      UInt32 offset = (count - remaining) * sectorSize;
+
+      // requests that cross a cylinder land after the previous segment
+      if (offset + bytes > _dmaBufferBytes) {
+        LogReadFailure("DMA buffer too small");
 
         return false;
       }
 
+      bool cached = TrackCacheHolds(
+        driveIndex,
+        cylinder,
+        sectorSize,
+        sectorsPerTrack,
+        headCount
+      );
+
+      // on a miss pull in the whole cylinder when it fits behind this
+      // segment; a failed fill falls back to reading just the segment
+      if (
+        !cached
+        && cylinderBytes <= _trackCacheBytes
+        && offset + cylinderBytes <= _dmaBufferBytes
+      ) {
+        cached = FillTrackCache(
+          driveIndex,
+          cylinder,
+          sectorSize,
+          sizeCode,
+          sectorsPerTrack,
+          headCount,
+          offset
+        );
+      }
+
+      if (cached) {
+        UInt32 trackOffset
+          = ((static_cast<UInt32>(head) * sectorsPerTrack) + (sector - 1))
+          * sectorSize;
+
+        CopyBytes(_dmaBufferVirtual + offset, _trackCache + trackOffset, bytes);
+      } else if (!ReadSegment(
+        driveIndex,
+        cylinder,
+        head,
+        sector,
+        toRead,
+        sectorSize,
+        sizeCode,
+        sectorsPerTrack,
+        headCount,
+        _dmaBufferPhysical + offset
+      )) {
+        return false;
+      }
+
       remaining -= toRead;
       currentLBA += toRead;
     }
@@ -881,6 +1163,9 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
       return false;
     }
 
+    // drop the cached cylinder before the medium changes under it
+    InvalidateTrackCache(driveIndex, lba, count, sectorsPerTrack, headCount);
+
     SetDrive(driveIndex, true);
     WaitForMotorSpinUp();
 
@@ -923,8 +1208,10 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
         - (sector - 1));
       UInt32 toWrite = remaining < totalLeft ? remaining : totalLeft;
       UInt32 bytes = toWrite * sectorSize;
+      UInt32 offset = (count - remaining) * sectorSize;
 
-      if (bytes > _dmaBufferBytes) {
+      // requests that cross a cylinder land after the previous segment
+      if (offset + bytes > _dmaBufferBytes) {
         LogReadFailure("DMA buffer too small");
 
         return false;
@@ -947,7 +1234,7 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
           }
         }
 
-        if (!ProgramDMAWrite(_dmaBufferPhysical, bytes)) {
+        if (!ProgramDMAWrite(_dmaBufferPhysical + offset, bytes)) {
           failure = "DMA program";
 
           continue;
@@ -1302,6 +1589,8 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
       info.sectorCount = sectorCount;
       info.flags = static_cast<UInt32>(BlockDevices::Flag::Removable);
       info.deviceIndex = driveIndex;
+      info.sectorsPerTrack = sectorsPerTrack;
+      info.headCount = headCount;
 
       UInt32 deviceId = BlockDevices::Register(info);
 
@@ -1354,15 +1643,7 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
     for (;;) {
       IPC::Message& msg = _receiveMessage;
 
-      if (_pendingCount > 0) {
-        msg = _pendingMessages[0];
-
-        for (UInt32 i = 1; i < _pendingCount; ++i) {
-          _pendingMessages[i - 1] = _pendingMessages[i];
-        }
-
-        --_pendingCount;
-      } else {
+      if (!DequeueRequest(msg)) {
         if (IPC::Receive(_portHandle, msg) != 0) {
           UpdateMotorIdle();
 
@@ -1389,7 +1670,9 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
 
       CopyBytes(&request, msg.payload, copyBytes);
 
-      if (request.replyPortId == 0) {
+      UInt32 replyToken = msg.replyToken;
+
+      if (replyToken == 0 && request.replyPortId == 0) {
         continue;
       }
 
@@ -1424,7 +1707,42 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
 
       (void)driveIndex;
 
-      if (response.status == 0) {
+      bool bulk = request.op == BlockDevices::Operation::ReadBulk
+        || request.op == BlockDevices::Operation::WriteBulk;
+
+      if (response.status == 0 && bulk) {
+        UInt32 bytes = request.count * sectorSize;
+
+        // the kernel has already filled (or will drain) the DMA buffer, so
+        // the sectors move straight between the controller and that buffer
+        if (bytes == 0 || bytes > _dmaBufferBytes) {
+          response.status = 5;
+        } else if (request.lba + request.count > sectorCount) {
+          response.status = 7;
+        } else {
+          bool ok = request.op == BlockDevices::Operation::ReadBulk
+            ? ReadSectors(
+              driveIndex,
+              request.lba,
+              request.count,
+              sectorSize,
+              sectorsPerTrack,
+              headCount
+            )
+            : WriteSectors(
+              driveIndex,
+              request.lba,
+              request.count,
+              sectorSize,
+              sectorsPerTrack,
+              headCount
+            );
+
+          if (!ok) {
+            response.status = 6;
+          }
+        }
+      } else if (response.status == 0) {
         UInt32 bytes = request.count * sectorSize;
 
         if (bytes > BlockDevices::messageDataBytes) {
@@ -1542,6 +1860,12 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
 
       CopyBytes(reply.payload, &response, reply.length);
 
+      if (replyToken != 0) {
+        IPC::Reply(replyToken, reply);
+
+        continue;
+      }
+
       IPC::Handle replyHandle = IPC::OpenPort(
         request.replyPortId,
         static_cast<UInt32>(IPC::Right::Send)
@@ -323,9 +323,10 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
       inline static UInt32 _deviceCount = 0;
 
       /**
-       * Default DMA buffer size in bytes.
+       * Requested DMA buffer size in bytes; a full 64 KB DMA window leaves
+       * room for a whole cylinder behind any multi-sector segment.
        */
-      static constexpr UInt32 _dmaBufferDefaultBytes = 4096;
+      static constexpr UInt32 _dmaBufferDefaultBytes = 0x10000;
 
       /**
        * DMA buffer physical address.
@@ -342,6 +343,46 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
        */
       inline static UInt32 _dmaBufferBytes = 0;
 
+      /**
+       * Track cache capacity in bytes; both heads of a 2.88 MB cylinder.
+       */
+      static constexpr UInt32 _trackCacheBytes = 2 * 36 * 512;
+
+      /**
+       * Contents of the most recently read cylinder.
+       */
+      inline static UInt8 _trackCache[_trackCacheBytes] = {};
+
+      /**
+       * Whether the track cache holds a cylinder.
+       */
+      inline static bool _trackCacheValid = false;
+
+      /**
+       * Drive index of the cached cylinder.
+       */
+      inline static UInt8 _trackCacheDrive = 0;
+
+      /**
+       * Cylinder number held by the track cache.
+       */
+      inline static UInt8 _trackCacheCylinder = 0;
+
+      /**
+       * Sector size the cached cylinder was read with.
+       */
+      inline static UInt32 _trackCacheSectorSize = 0;
+
+      /**
+       * Sectors per track the cached cylinder was read with.
+       */
+      inline static UInt8 _trackCacheSectorsPerTrack = 0;
+
+      /**
+       * Head count the cached cylinder was read with.
+       */
+      inline static UInt8 _trackCacheHeadCount = 0;
+
       /**
        * Cached cylinder per drive index.
        */
@@ -383,19 +424,31 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
       inline static ABI::IRQ::Handle _irqHandle = 0;
 
       /**
-       * Maximum number of queued non-IRQ messages while waiting.
+       * Capacity of the request queue; matches the kernel's per-device
+       * request limit plus room for direct legacy clients.
+       */
+      static constexpr UInt32 _requestQueueCapacity = 16;
+
+      /**
+       * Requests received while a transfer was waiting for an IRQ, in
+       * arrival order.
        */
-      static constexpr UInt32 _maxPendingMessages = 4;
+      inline static IPC::Message _requestQueue[_requestQueueCapacity] = {};
 
       /**
-       * Pending IPC messages received during IRQ waits.
+       * Index of the oldest queued request.
        */
-      inline static IPC::Message _pendingMessages[_maxPendingMessages] = {};
+      inline static UInt32 _requestQueueHead = 0;
 
       /**
-       * Number of pending IPC messages.
+       * Number of queued requests.
        */
-      inline static UInt32 _pendingCount = 0;
+      inline static UInt32 _requestQueueCount = 0;
+
+      /**
+       * IPC send buffer for rejecting requests mid-transfer.
+       */
+      inline static IPC::Message _rejectMessage {};
 
       /**
        * IPC receive buffer.
@@ -509,8 +562,27 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
        * Queues a non-IRQ message while waiting for an IRQ.
        * @param msg
        *   IPC message to queue.
+       * @return
+       *   True if queued; false if the queue is full.
        */
-      static void QueuePendingMessage(const IPC::Message& msg);
+      static bool EnqueueRequest(const IPC::Message& msg);
+
+      /**
+       * Takes the oldest queued message.
+       * @param outMsg
+       *   Receives the message.
+       * @return
+       *   True if a message was dequeued; false if the queue is empty.
+       */
+      static bool DequeueRequest(IPC::Message& outMsg);
+
+      /**
+       * Fails a block request that could not be queued so its sender does
+       * not wait for a timeout.
+       * @param msg
+       *   IPC message carrying the request.
+       */
+      static void RejectRequest(const IPC::Message& msg);
 
       /**
        * Fills a buffer with a byte value.
@@ -599,6 +671,145 @@ namespace Quantum::Services::Drivers::Storage::Floppy {
         UInt8& sector
       );
 
+      /**
+       * Checks whether the track cache holds a cylinder.
+       * @param driveIndex
+       *   Target drive index.
+       * @param cylinder
+       *   Cylinder number.
+       * @param sectorSize
+       *   Sector size in bytes.
+       * @param sectorsPerTrack
+       *   Sectors per track for the drive.
+       * @param headCount
+       *   Head count for the drive.
+       * @return
+       *   True if the cylinder is cached with the same geometry.
+       */
+      static bool TrackCacheHolds(
+        UInt8 driveIndex,
+        UInt8 cylinder,
+        UInt32 sectorSize,
+        UInt8 sectorsPerTrack,
+        UInt8 headCount
+      );
+
+      /**
+       * Drops the cached cylinder if a sector range touches it.
+       * @param driveIndex
+       *   Target drive index.
+       * @param lba
+       *   Starting logical block address.
+       * @param count
+       *   Number of sectors.
+       * @param sectorsPerTrack
+       *   Sectors per track for the drive.
+       * @param headCount
+       *   Head count for the drive.
+       */
+      static void InvalidateTrackCache(
+        UInt8 driveIndex,
+        UInt32 lba,
+        UInt32 count,
+        UInt8 sectorsPerTrack,
+        UInt8 headCount
+      );
+
+      /**
+       * Serves a read entirely from the track cache into the DMA buffer.
+       * @param driveIndex
+       *   Target drive index.
+       * @param lba
+       *   Starting logical block address.
+       * @param count
+       *   Number of sectors to read.
+       * @param sectorSize
+       *   Sector size in bytes.
+       * @param sectorsPerTrack
+       *   Sectors per track for the drive.
+       * @param headCount
+       *   Head count for the drive.
+       * @return
+       *   True if every sector was cached; false otherwise.
+       */
+      static bool ReadFromTrackCache(
+        UInt8 driveIndex,
+        UInt32 lba,
+        UInt32 count,
+        UInt32 sectorSize,
+        UInt8 sectorsPerTrack,
+        UInt8 headCount
+      );
+
+      /**
+       * Reads both heads of a cylinder with one multi-track command and
+       * stores it in the track cache.
+       * @param driveIndex
+       *   Target drive index.
+       * @param cylinder
+       *   Cylinder number.
+       * @param sectorSize
+       *   Sector size in bytes.
+       * @param sizeCode
+       *   Controller sector size code.
+       * @param sectorsPerTrack
+       *   Sectors per track for the drive.
+       * @param headCount
+       *   Head count for the drive.
+       * @param dmaOffset
+       *   Offset into the DMA buffer used as the transfer area.
+       * @return
+       *   True on success; false otherwise.
+       */
+      static bool FillTrackCache(
+        UInt8 driveIndex,
+        UInt8 cylinder,
+        UInt32 sectorSize,
+        UInt8 sizeCode,
+        UInt8 sectorsPerTrack,
+        UInt8 headCount,
+        UInt32 dmaOffset
+      );
+
+      /**
+       * Reads sectors within one cylinder to a physical address, retrying
+       * on failure.
+       * @param driveIndex
+       *   Target drive index.
+       * @param cylinder
+       *   Cylinder number.
+       * @param head
+       *   Starting head.
+       * @param sector
+       *   Starting sector (1-based).
+       * @param count
+       *   Number of sectors to read.
+       * @param sectorSize
+       *   Sector size in bytes.
+       * @param sizeCode
+       *   Controller sector size code.
+       * @param sectorsPerTrack
+       *   Sectors per track for the drive.
+       * @param headCount
+       *   Head count for the drive.
+       * @param physicalAddress
+       *   DMA destination physical address.
+       * @return
+       *   True on success; false otherwise.
+       */
+      static bool ReadSegment(
+        UInt8 driveIndex,
+        UInt8 cylinder,
+        UInt8 head,
+        UInt8 sector,
+        UInt32 count,
+        UInt32 sectorSize,
+        UInt8 sizeCode,
+        UInt8 sectorsPerTrack,
+        UInt8 headCount,
+        UInt32 physicalAddress
+      );
+
       /**
        * Reads one or more sectors into the DMA buffer.
        * @param driveIndex
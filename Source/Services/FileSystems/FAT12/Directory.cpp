@@ -18,6 +18,12 @@ namespace Quantum::Services::FileSystems::FAT12 {
 
   void Directory::Initialize(Volume& volume) {
     _volume = &volume;
+
+    InvalidateAllLookups();
+
+    ++_generation;
+    _lookupHits = 0;
+    _lookupMisses = 0;
   }
 
   bool Directory::ReadRootRecord(
@@ -25,97 +31,11 @@ namespace Quantum::Services::FileSystems::FAT12 {
     Record& record,
     bool& end
   ) {
-    end = false;
-
-    if (!_volume || !_volume->_valid) {
-      return false;
-    }
-
-    UInt32 bytesPerSector = _volume->_info.sectorSize;
-
-    if (bytesPerSector != 512) {
-      // only support 512-byte sectors for now
-      return false;
-    }
-
-    UInt8 sector[512] = {};
-    UInt32 entriesPerSector = bytesPerSector / 32;
-    UInt32 rawCount = _volume->_rootEntryCount;
-    UInt32 currentSector = 0xFFFFFFFF;
-    UInt32 logicalIndex = 0;
-    LFNState lfn {};
-
-    ClearLFN(lfn);
-
-    for (UInt32 rawIndex = 0; rawIndex < rawCount; ++rawIndex) {
-      UInt32 sectorIndex = rawIndex / entriesPerSector;
-      UInt32 entryIndex = rawIndex % entriesPerSector;
-
-      if (sectorIndex >= _volume->_rootDirectorySectors) {
-        end = true;
-
-        return false;
-      }
-
-      if (sectorIndex != currentSector) {
-        BlockDevices::Request request {};
-
-        request.deviceId = _volume->GetDeviceToken();
-        request.lba = _volume->_rootDirectoryStartLBA + sectorIndex;
-        request.count = 1;
-        request.buffer = sector;
-
-        if (BlockDevices::Read(request) != 0) {
-          return false;
-        }
-
-        currentSector = sectorIndex;
-      }
-
-      const UInt8* base = sector + (entryIndex * 32);
-      UInt8 first = base[0];
-
-      if (first == 0x00) {
-        end = true;
-
-        return false;
-      }
-
-      if (first == 0xE5) {
-        ClearLFN(lfn);
-
-        continue;
-      }
-
-      UInt8 attributes = base[11];
-
-      if (attributes == 0x0F) {
-        ParseLFNEntry(base, lfn);
-
-        continue;
-      }
-
-      if ((attributes & 0x08) != 0) {
-        ClearLFN(lfn);
-
-        continue;
-      }
-
-      if (logicalIndex == index) {
-        PopulateRecord(_volume, base, lfn, record);
-        ClearLFN(lfn);
-
-        return true;
-      }
-
-      ++logicalIndex;
+    Cursor cursor {};
 
-      ClearLFN(lfn);
-    }
-
-    end = true;
+    ResetCursor(cursor);
 
-    return false;
+    return ReadCursor(cursor, 0, true, index, record, end);
   }
 
   bool Directory::BuildShortName(CString name, UInt8* outName) {
@@ -168,6 +88,31 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32 index,
     Record& record,
     bool& end
+  ) {
+    Cursor cursor {};
+
+    ResetCursor(cursor);
+
+    return ReadCursor(cursor, startCluster, false, index, record, end);
+  }
+
+  void Directory::ResetCursor(Cursor& cursor) {
+    cursor.valid = false;
+    cursor.generation = 0;
+    cursor.index = 0;
+    cursor.cluster = 0;
+    cursor.slot = 0;
+
+    ClearLFN(cursor.lfn);
+  }
+
+  bool Directory::ReadCursor(
+    Cursor& cursor,
+    UInt32 startCluster,
+    bool isRoot,
+    UInt32 index,
+    Record& record,
+    bool& end
   ) {
     end = false;
 
@@ -182,106 +127,129 @@ namespace Quantum::Services::FileSystems::FAT12 {
       return false;
     }
 
-    if (startCluster < 2) {
+    if (!isRoot && startCluster < 2) {
       end = true;
 
       return false;
     }
 
-    UInt32 entriesPerSector = bytesPerSector / 32;
-    UInt32 cluster = startCluster;
-    UInt32 logicalIndex = 0;
-    LFNState lfn {};
+    if (
+      !cursor.valid
+      || cursor.generation != _generation
+      || cursor.index > index
+    ) {
+      ResetCursor(cursor);
 
-    ClearLFN(lfn);
+      cursor.valid = true;
+      cursor.generation = _generation;
+      cursor.cluster = isRoot ? 0 : startCluster;
+    }
+
+    UInt8 sector[512] = {};
+    UInt32 entriesPerSector = bytesPerSector / 32;
+    UInt32 slotsPerCluster = entriesPerSector * _volume->_sectorsPerCluster;
+    UInt32 loadedLBA = 0;
 
     for (;;) {
-      UInt32 baseLBA
-        = _volume->_dataStartLBA
-        + (cluster - 2) * _volume->_sectorsPerCluster;
+      UInt32 lba = 0;
 
-      for (
-        UInt32 sectorIndex = 0;
-        sectorIndex < _volume->_sectorsPerCluster;
-        ++sectorIndex
-      ) {
-        UInt8 sector[512] = {};
-        BlockDevices::Request request {};
+      if (isRoot) {
+        UInt32 sectorIndex = cursor.slot / entriesPerSector;
 
-        request.deviceId = _volume->GetDeviceToken();
-        request.lba = baseLBA + sectorIndex;
-        request.count = 1;
-        request.buffer = sector;
+        if (
+          cursor.slot >= _volume->_rootEntryCount
+          || sectorIndex >= _volume->_rootDirectorySectors
+        ) {
+          end = true;
 
-        if (BlockDevices::Read(request) != 0) {
           return false;
         }
 
-        for (
-          UInt32 entryIndex = 0;
-          entryIndex < entriesPerSector;
-          ++entryIndex
-        ) {
-          const UInt8* base = sector + (entryIndex * 32);
-          UInt8 first = base[0];
+        lba = _volume->_rootDirectoryStartLBA + sectorIndex;
+      } else {
+        if (cursor.slot >= slotsPerCluster) {
+          UInt32 nextCluster = 0;
 
-          if (first == 0x00) {
+          if (!_volume->ReadFATEntry(cursor.cluster, nextCluster)) {
+            return false;
+          }
+
+          if (FAT::IsEndOfChain(nextCluster)) {
             end = true;
 
             return false;
           }
 
-          if (first == 0xE5) {
-            ClearLFN(lfn);
+          cursor.cluster = nextCluster;
+          cursor.slot = 0;
+        }
 
-            continue;
-          }
+        lba
+          = _volume->_dataStartLBA
+          + (cursor.cluster - 2) * _volume->_sectorsPerCluster
+          + cursor.slot / entriesPerSector;
+      }
 
-          UInt8 attributes = base[11];
+      if (lba != loadedLBA) {
+        BlockDevices::Request request {};
 
-          if (attributes == 0x0F) {
-            ParseLFNEntry(base, lfn);
+        request.deviceId = _volume->GetDeviceToken();
+        request.lba = lba;
+        request.count = 1;
+        request.buffer = sector;
 
-            continue;
-          }
+        if (BlockDevices::Read(request) != 0) {
+          return false;
+        }
 
-          if ((attributes & 0x08) != 0) {
-            ClearLFN(lfn);
+        loadedLBA = lba;
+      }
 
-            continue;
-          }
+      const UInt8* base = sector + (cursor.slot % entriesPerSector) * 32;
+      UInt8 first = base[0];
 
-          if (logicalIndex == index) {
-            PopulateRecord(_volume, base, lfn, record);
-            ClearLFN(lfn);
+      // the end marker leaves the cursor in place so later reads end too
+      if (first == 0x00) {
+        end = true;
 
-            return true;
-          }
+        return false;
+      }
 
-          ++logicalIndex;
+      ++cursor.slot;
 
-          ClearLFN(lfn);
-        }
+      if (first == 0xE5) {
+        ClearLFN(cursor.lfn);
+
+        continue;
       }
 
-      UInt32 nextCluster = 0;
+      UInt8 attributes = base[11];
 
-      if (!_volume || !_volume->ReadFATEntry(cluster, nextCluster)) {
-        return false;
+      if (attributes == 0x0F) {
+        ParseLFNEntry(base, cursor.lfn);
+
+        continue;
       }
 
-      if (FAT::IsEndOfChain(nextCluster)) {
-        end = true;
+      if ((attributes & 0x08) != 0) {
+        ClearLFN(cursor.lfn);
 
-        return false;
+        continue;
       }
 
-      cluster = nextCluster;
-    }
+      if (cursor.index == index) {
+        PopulateRecord(_volume, base, cursor.lfn, record);
+        ClearLFN(cursor.lfn);
 
-    end = true;
+        ++cursor.index;
 
-    return false;
+        return true;
+      }
+
+      ++cursor.index;
+
+      ClearLFN(cursor.lfn);
+    }
   }
 
   bool Directory::ReadRecordAt(UInt32 lba, UInt32 offset, Record& record) {
@@ -446,14 +414,12 @@ namespace Quantum::Services::FileSystems::FAT12 {
       return false;
     };
 
-    for (;;) {
-      bool ok = false;
+    Cursor cursor {};
 
-      if (isRoot) {
-        ok = ReadRootRecord(index, record, end);
-      } else {
-        ok = ReadRecord(startCluster, index, record, end);
-      }
+    ResetCursor(cursor);
+
+    for (;;) {
+      bool ok = ReadCursor(cursor, startCluster, isRoot, index, record, end);
 
       if (ok && matchesName(record)) {
         outCluster = record.startCluster;
@@ -473,6 +439,159 @@ namespace Quantum::Services::FileSystems::FAT12 {
     return false;
   }
 
+  bool Directory::LookupEntry(
+    UInt32 parentCluster,
+    bool parentIsRoot,
+    CString name,
+    UInt32& outCluster,
+    UInt8& outAttributes,
+    UInt32& outSize,
+    UInt32& outLBA,
+    UInt32& outOffset
+  ) {
+    if (!_volume || !name || name[0] == '\0') {
+      return false;
+    }
+
+    CachedLookup* cached = FindLookup(parentCluster, parentIsRoot, name);
+
+    if (cached) {
+      ++_lookupHits;
+      cached->lastUse = ++_lookupSequence;
+
+      if (!cached->found) {
+        return false;
+      }
+
+      outCluster = cached->startCluster;
+      outAttributes = cached->attributes;
+      outSize = cached->sizeBytes;
+      outLBA = cached->lba;
+      outOffset = cached->offset;
+
+      return true;
+    }
+
+    ++_lookupMisses;
+
+    Record record {};
+    UInt32 lba = 0;
+    UInt32 offset = 0;
+    bool found = FindEntryLocation(
+      parentCluster,
+      parentIsRoot,
+      name,
+      record,
+      lba,
+      offset
+    );
+
+    if (found) {
+      outCluster = record.startCluster;
+      outAttributes = record.attributes;
+      outSize = record.sizeBytes;
+      outLBA = lba;
+      outOffset = offset;
+    }
+
+    UInt32 length = 0;
+
+    while (name[length] != '\0') {
+      ++length;
+    }
+
+    // a failed read is not proof the name is absent
+    if (
+      (!found && _lookupScanFailed)
+      || length >= FileSystem::maxDirectoryLength
+    ) {
+      return found;
+    }
+
+    CachedLookup* slot = &_lookups[0];
+
+    for (UInt32 i = 0; i < _lookupCacheEntries; ++i) {
+      if (!_lookups[i].valid) {
+        slot = &_lookups[i];
+
+        break;
+      }
+
+      if (_lookups[i].lastUse < slot->lastUse) {
+        slot = &_lookups[i];
+      }
+    }
+
+    for (UInt32 i = 0; i <= length; ++i) {
+      char c = name[i];
+
+      if (c >= 'a' && c <= 'z') {
+        c = static_cast<char>(c - 'a' + 'A');
+      }
+
+      slot->name[i] = c;
+    }
+
+    slot->valid = true;
+    slot->found = found;
+    slot->parentIsRoot = parentIsRoot;
+    slot->parentCluster = parentCluster;
+    slot->attributes = found ? record.attributes : 0;
+    slot->startCluster = found ? record.startCluster : 0;
+    slot->sizeBytes = found ? record.sizeBytes : 0;
+    slot->lba = lba;
+    slot->offset = offset;
+    slot->lastUse = ++_lookupSequence;
+
+    return found;
+  }
+
+  void Directory::GetLookupStats(UInt32& outHits, UInt32& outMisses) const {
+    outHits = _lookupHits;
+    outMisses = _lookupMisses;
+  }
+
+  Directory::CachedLookup* Directory::FindLookup(
+    UInt32 parentCluster,
+    bool parentIsRoot,
+    CString name
+  ) {
+    for (UInt32 i = 0; i < _lookupCacheEntries; ++i) {
+      CachedLookup& entry = _lookups[i];
+
+      if (
+        entry.valid
+        && entry.parentIsRoot == parentIsRoot
+        && entry.parentCluster == parentCluster
+        && _volume->MatchName(entry.name, name)
+      ) {
+        return &entry;
+      }
+    }
+
+    return nullptr;
+  }
+
+  void Directory::InvalidateLookups(UInt32 parentCluster, bool parentIsRoot) {
+    for (UInt32 i = 0; i < _lookupCacheEntries; ++i) {
+      CachedLookup& entry = _lookups[i];
+
+      if (
+        entry.valid
+        && entry.parentIsRoot == parentIsRoot
+        && entry.parentCluster == parentCluster
+      ) {
+        entry.valid = false;
+      }
+    }
+  }
+
+  void Directory::InvalidateAllLookups() {
+    for (UInt32 i = 0; i < _lookupCacheEntries; ++i) {
+      _lookups[i].valid = false;
+    }
+  }
+
   bool Directory::FindEntryLocation(
     UInt32 parentCluster,
     bool parentIsRoot,
@@ -481,6 +600,9 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32& outLBA,
     UInt32& outOffset
   ) {
+    // cleared only once the scan can reach a definite answer
+    _lookupScanFailed = true;
+
     if (!_volume) {
       return false;
     }
@@ -499,6 +621,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32 entriesPerSector = bytesPerSector / 32;
     LFNState lfn {};
 
+    _lookupScanFailed = false;
+
     ClearLFN(lfn);
 
     auto matchesName = [&](const Record& candidate) -> bool {
@@ -547,6 +671,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
           request.buffer = sector;
 
           if (BlockDevices::Read(request) != 0) {
+            _lookupScanFailed = true;
+
             return false;
           }
 
@@ -598,6 +724,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
     }
 
     if (parentCluster < 2) {
+      _lookupScanFailed = true;
+
       return false;
     }
 
@@ -622,6 +750,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
         request.buffer = sector;
 
         if (BlockDevices::Read(request) != 0) {
+          _lookupScanFailed = true;
+
           return false;
         }
 
@@ -675,6 +805,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
       UInt32 nextCluster = 0;
 
       if (!_volume || !_volume->ReadFATEntry(cluster, nextCluster)) {
+        _lookupScanFailed = true;
+
         return false;
       }
 
@@ -718,7 +850,26 @@ namespace Quantum::Services::FileSystems::FAT12 {
     request.lba = lba;
     request.buffer = sector;
 
-    return BlockDevices::Write(request) == 0;
+    if (BlockDevices::Write(request) != 0) {
+      return false;
+    }
+
+    // keep cached lookups of this entry in step with the new extent
+    for (UInt32 i = 0; i < _lookupCacheEntries; ++i) {
+      CachedLookup& entry = _lookups[i];
+
+      if (
+        entry.valid
+        && entry.found
+        && entry.lba == lba
+        && entry.offset == offset
+      ) {
+        entry.startCluster = startCluster;
+        entry.sizeBytes = sizeBytes;
+      }
+    }
+
+    return true;
   }
 
   bool Directory::WriteEntry(
@@ -874,9 +1025,12 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool end = false;
     Record record {};
     UInt32 index = 0;
+    Cursor cursor {};
+
+    ResetCursor(cursor);
 
     for (;;) {
-      if (ReadRecord(startCluster, index, record, end)) {
+      if (ReadCursor(cursor, startCluster, false, index, record, end)) {
         if (!IsDotRecord(record)) {
           return false;
         }
@@ -909,6 +1063,10 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool parentIsRoot,
     CString name
   ) {
+    InvalidateLookups(parentCluster, parentIsRoot);
+
+    ++_generation;
+
     if (!_volume || !_volume->_valid) {
       return false;
     }
@@ -1095,6 +1253,10 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool parentIsRoot,
     CString name
   ) {
+    InvalidateLookups(parentCluster, parentIsRoot);
+
+    ++_generation;
+
     if (!_volume || !_volume->_valid) {
       return false;
     }
@@ -1206,6 +1368,12 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool parentIsRoot,
     CString name
   ) {
+    // a removed directory frees its cluster for reuse by a new one, so
+    // lookups keyed on it must go as well
+    InvalidateAllLookups();
+
+    ++_generation;
+
     Record record {};
     UInt32 lba = 0;
     UInt32 offset = 0;
@@ -1261,6 +1429,10 @@ namespace Quantum::Services::FileSystems::FAT12 {
     CString name,
     CString newName
   ) {
+    InvalidateLookups(parentCluster, parentIsRoot);
+
+    ++_generation;
+
     Record record {};
     UInt32 lba = 0;
     UInt32 offset = 0;
@@ -32,7 +32,13 @@ namespace Quantum::Services::FileSystems::FAT12 {
 
     UInt32 fatBytes = _volume->_fatSectors * bytesPerSector;
 
-    if (fatBytes == 0 || fatBytes > sizeof(_volume->_fatCache)) {
+    _freeBitmapValid = false;
+
+    if (
+      fatBytes == 0
+      || fatBytes > sizeof(_volume->_fatCache)
+      || _volume->_fatSectors > _maxCachedSectors
+    ) {
       return false;
     }
 
@@ -50,6 +56,14 @@ namespace Quantum::Services::FileSystems::FAT12 {
     _volume->_fatCacheBytes = fatBytes;
     _volume->_fatCached = true;
 
+    for (UInt32 i = 0; i < _dirtyBitmapWords; ++i) {
+      _dirtySectors[i] = 0;
+    }
+
+    _dirtyCount = 0;
+
+    BuildFreeBitmap();
+
     return true;
   }
 
@@ -183,6 +197,22 @@ namespace Quantum::Services::FileSystems::FAT12 {
       _volume->_fatCache[fatOffset] = static_cast<UInt8>(existing & 0xFF);
       _volume->_fatCache[fatOffset + 1]
         = static_cast<UInt8>((existing >> 8) & 0xFF);
+
+      SetClusterFree(cluster, packed == 0);
+      SetClusterReserved(cluster, false);
+
+      // the cache is authoritative; disk copies catch up on flush
+      MarkDirty(sectorOffset);
+
+      if (byteOffset == bytesPerSector - 1) {
+        MarkDirty(sectorOffset + 1);
+      }
+
+      if (_dirtyCount >= _flushThresholdSectors) {
+        return Flush();
+      }
+
+      return true;
     }
 
     for (UInt32 fatIndex = 0; fatIndex < _volume->_fatCount; ++fatIndex) {
@@ -266,6 +296,92 @@ namespace Quantum::Services::FileSystems::FAT12 {
     return true;
   }
 
+  bool FAT::Flush() {
+    if (!_volume || !_volume->_valid) {
+      return false;
+    }
+
+    if (_dirtyCount == 0) {
+      return true;
+    }
+
+    UInt32 bytesPerSector = _volume->_info.sectorSize;
+    UInt32 sectorOffset = 0;
+    bool ok = true;
+
+    while (sectorOffset < _volume->_fatSectors) {
+      if (!IsSectorDirty(sectorOffset)) {
+        ++sectorOffset;
+
+        continue;
+      }
+
+      UInt32 runEnd = sectorOffset + 1;
+
+      while (runEnd < _volume->_fatSectors && IsSectorDirty(runEnd)) {
+        ++runEnd;
+      }
+
+      // each run of dirty sectors goes to every copy in one request
+      bool written = true;
+
+      for (UInt32 fatIndex = 0; fatIndex < _volume->_fatCount; ++fatIndex) {
+        BlockDevices::Request request {};
+
+        request.deviceId = _volume->GetDeviceToken();
+        request.lba
+          = _volume->_fatStartLBA
+          + fatIndex * _volume->_fatSectors
+          + sectorOffset;
+        request.count = runEnd - sectorOffset;
+        request.buffer = _volume->_fatCache + sectorOffset * bytesPerSector;
+
+        if (BlockDevices::Write(request) != 0) {
+          written = false;
+        }
+      }
+
+      if (written) {
+        for (UInt32 i = sectorOffset; i < runEnd; ++i) {
+          _dirtySectors[i / 32] &= ~(1u << (i % 32));
+          --_dirtyCount;
+        }
+      } else {
+        ok = false;
+      }
+
+      sectorOffset = runEnd;
+    }
+
+    return ok;
+  }
+
+  bool FAT::IsDirty() const {
+    return _dirtyCount != 0;
+  }
+
+  UInt32 FAT::GetDirtyCount() const {
+    return _dirtyCount;
+  }
+
+  void FAT::MarkDirty(UInt32 sectorOffset) {
+    if (sectorOffset >= _maxCachedSectors || IsSectorDirty(sectorOffset)) {
+      return;
+    }
+
+    _dirtySectors[sectorOffset / 32] |= 1u << (sectorOffset % 32);
+    ++_dirtyCount;
+  }
+
+  bool FAT::IsSectorDirty(UInt32 sectorOffset) const {
+    if (sectorOffset >= _maxCachedSectors) {
+      return false;
+    }
+
+    return (_dirtySectors[sectorOffset / 32] & (1u << (sectorOffset % 32)))
+      != 0;
+  }
+
   bool FAT::FindFreeCluster(UInt32& outCluster) {
     if (!_volume || !_volume->_valid || _volume->_clusterCount == 0) {
       return false;
@@ -278,6 +394,48 @@ namespace Quantum::Services::FileSystems::FAT12 {
       start = 2;
     }
 
+    if (_freeBitmapValid) {
+      UInt32 limit = GetMaxCluster();
+      UInt32 span = limit - 1;
+
+      if (start > limit) {
+        start = 2;
+      }
+
+      // scan round from the rover, skipping fully allocated words; clusters
+      // reserved for growing other files are only taken on the second pass
+      for (UInt32 pass = 0; pass < 2; ++pass) {
+        for (UInt32 step = 0; step < span; ) {
+          UInt32 cluster = 2 + (start - 2 + step) % span;
+
+          if ((cluster % 32) == 0 && _freeBitmap[cluster / 32] == 0) {
+            UInt32 skip = limit + 1 - cluster;
+
+            step += skip < 32 ? skip : 32;
+
+            continue;
+          }
+
+          if (
+            pass == 0
+              ? IsClusterAvailable(cluster)
+              : IsClusterFree(cluster)
+          ) {
+            SetClusterReserved(cluster, false);
+
+            outCluster = cluster;
+            _volume->_nextFreeCluster = cluster + 1;
+
+            return true;
+          }
+
+          ++step;
+        }
+      }
+
+      return false;
+    }
+
     for (UInt32 cluster = start; cluster <= maxCluster; ++cluster) {
       UInt32 nextCluster = 0;
 
@@ -323,6 +481,135 @@ namespace Quantum::Services::FileSystems::FAT12 {
     return false;
   }
 
+  bool FAT::ReserveRun(
+    UInt32 wanted,
+    UInt32 goal,
+    UInt32& outCluster,
+    UInt32& outLength
+  ) {
+    if (!_volume || !_volume->_valid || _volume->_clusterCount == 0) {
+      return false;
+    }
+
+    if (!_freeBitmapValid) {
+      // without the bitmap, fall back to one cluster at a time
+      outLength = 1;
+
+      return FindFreeCluster(outCluster);
+    }
+
+    UInt32 maxCluster = GetMaxCluster();
+    UInt32 runStart = 0;
+    UInt32 runLength = 0;
+
+    if (wanted == 0) {
+      wanted = 1;
+    }
+
+    if (goal >= 2 && goal <= maxCluster && IsClusterAvailable(goal)) {
+      runStart = goal;
+
+      while (
+        runLength < wanted
+        && goal + runLength <= maxCluster
+        && IsClusterAvailable(goal + runLength)
+      ) {
+        ++runLength;
+      }
+    } else {
+      UInt32 largestStart = 0;
+      UInt32 largestLength = 0;
+      UInt32 cluster = 2;
+
+      while (cluster <= maxCluster) {
+        if ((cluster % 32) == 0 && _freeBitmap[cluster / 32] == 0) {
+          cluster += 32;
+
+          continue;
+        }
+
+        if (!IsClusterAvailable(cluster)) {
+          ++cluster;
+
+          continue;
+        }
+
+        UInt32 start = cluster;
+
+        while (cluster <= maxCluster && IsClusterAvailable(cluster)) {
+          ++cluster;
+        }
+
+        UInt32 length = cluster - start;
+
+        if (length >= wanted) {
+          if (runLength == 0 || length < runLength) {
+            runStart = start;
+            runLength = length;
+          }
+
+          if (length == wanted) {
+            break;
+          }
+        } else if (length > largestLength) {
+          largestStart = start;
+          largestLength = length;
+        }
+      }
+
+      if (runLength == 0) {
+        runStart = largestStart;
+        runLength = largestLength;
+      }
+    }
+
+    // only other files' reservations are left; take a single cluster
+    if (runLength == 0) {
+      outLength = 1;
+
+      return FindFreeCluster(outCluster);
+    }
+
+    if (runLength > wanted) {
+      runLength = wanted;
+    }
+
+    for (UInt32 i = 0; i < runLength; ++i) {
+      SetClusterReserved(runStart + i, true);
+    }
+
+    outCluster = runStart;
+    outLength = runLength;
+
+    return true;
+  }
+
+  void FAT::ReleaseRun(UInt32 cluster, UInt32 length) {
+    if (!_freeBitmapValid) {
+      return;
+    }
+
+    // reserved clusters never left the free bitmap; dropping the mark is
+    // enough, and linked ones already lost it in WriteEntry
+    for (UInt32 i = 0; i < length; ++i) {
+      SetClusterReserved(cluster + i, false);
+    }
+  }
+
+  bool FAT::ClaimReserved(UInt32 cluster) {
+    if (
+      !_freeBitmapValid
+      || !IsClusterFree(cluster)
+      || (_reservedBitmap[cluster / 32] & (1u << (cluster % 32))) == 0
+    ) {
+      return false;
+    }
+
+    SetClusterReserved(cluster, false);
+
+    return true;
+  }
+
   bool FAT::CountFreeClusters(UInt32& outCount) {
     outCount = 0;
 
@@ -334,6 +621,19 @@ namespace Quantum::Services::FileSystems::FAT12 {
       return true;
     }
 
+    if (_freeBitmapValid) {
+      for (UInt32 i = 0; i < _freeBitmapWords; ++i) {
+        UInt32 word = _freeBitmap[i];
+
+        while (word != 0) {
+          word &= word - 1;
+          ++outCount;
+        }
+      }
+
+      return true;
+    }
+
     UInt32 maxCluster = _volume->_clusterCount + 1;
 
     for (UInt32 cluster = 2; cluster <= maxCluster; ++cluster) {
@@ -393,4 +693,83 @@ namespace Quantum::Services::FileSystems::FAT12 {
   bool FAT::IsEndOfChain(UInt32 value) {
     return value >= 0xFF8;
   }
+
+  void FAT::BuildFreeBitmap() {
+    for (UInt32 i = 0; i < _freeBitmapWords; ++i) {
+      _freeBitmap[i] = 0;
+      _reservedBitmap[i] = 0;
+    }
+
+    _freeBitmapValid = false;
+
+    if (!_volume || !_volume->_fatCached || _volume->_clusterCount == 0) {
+      return;
+    }
+
+    UInt32 maxCluster = _volume->_clusterCount + 1;
+
+    if (maxCluster >= _maxClusters) {
+      maxCluster = _maxClusters - 1;
+    }
+
+    for (UInt32 cluster = 2; cluster <= maxCluster; ++cluster) {
+      UInt32 value = 0;
+
+      if (!ReadEntryCached(cluster, value)) {
+        return;
+      }
+
+      if (value == 0x000) {
+        _freeBitmap[cluster / 32] |= 1u << (cluster % 32);
+      }
+    }
+
+    _freeBitmapValid = true;
+  }
+
+  void FAT::SetClusterFree(UInt32 cluster, bool free) {
+    if (!_freeBitmapValid || cluster < 2 || cluster > GetMaxCluster()) {
+      return;
+    }
+
+    if (free) {
+      _freeBitmap[cluster / 32] |= 1u << (cluster % 32);
+    } else {
+      _freeBitmap[cluster / 32] &= ~(1u << (cluster % 32));
+    }
+  }
+
+  bool FAT::IsClusterFree(UInt32 cluster) const {
+    if (cluster >= _maxClusters) {
+      return false;
+    }
+
+    return (_freeBitmap[cluster / 32] & (1u << (cluster % 32))) != 0;
+  }
+
+  void FAT::SetClusterReserved(UInt32 cluster, bool reserved) {
+    if (cluster < 2 || cluster > GetMaxCluster()) {
+      return;
+    }
+
+    if (reserved) {
+      _reservedBitmap[cluster / 32] |= 1u << (cluster % 32);
+    } else {
+      _reservedBitmap[cluster / 32] &= ~(1u << (cluster % 32));
+    }
+  }
+
+  bool FAT::IsClusterAvailable(UInt32 cluster) const {
+    if (!IsClusterFree(cluster)) {
+      return false;
+    }
+
+    return (_reservedBitmap[cluster / 32] & (1u << (cluster % 32))) == 0;
+  }
+
+  UInt32 FAT::GetMaxCluster() const {
+    UInt32 maxCluster = _volume->_clusterCount + 1;
+
+    return maxCluster < _maxClusters ? maxCluster : _maxClusters - 1;
+  }
 }
@@ -19,13 +19,32 @@ namespace Quantum::Services::FileSystems::FAT12 {
     _volume = &volume;
   }
 
+  void File::ResetExtents(ExtentMap& map) {
+    map.startCluster = 0;
+    map.clusterCount = 0;
+    map.extentCount = 0;
+    map.reservedCluster = 0;
+    map.reservedCount = 0;
+    map.sizeHint = 0;
+  }
+
+  void File::ReleaseReservation(ExtentMap& map) {
+    if (_volume && map.reservedCount > 0) {
+      _volume->ReleaseClusters(map.reservedCluster, map.reservedCount);
+    }
+
+    map.reservedCluster = 0;
+    map.reservedCount = 0;
+  }
+
   bool File::Read(
     UInt32 startCluster,
     UInt32 offset,
     UInt8* buffer,
     UInt32 length,
     UInt32& outRead,
-    UInt32 fileSize
+    UInt32 fileSize,
+    ExtentMap& extents
   ) {
     outRead = 0;
 
@@ -56,73 +75,102 @@ namespace Quantum::Services::FileSystems::FAT12 {
     }
 
     UInt32 clusterSize = bytesPerSector * _volume->_sectorsPerCluster;
-    UInt32 skipClusters = offset / clusterSize;
+    UInt32 clusterIndex = offset / clusterSize;
     UInt32 clusterOffset = offset % clusterSize;
-    UInt32 cluster = startCluster;
-
-    for (UInt32 i = 0; i < skipClusters; ++i) {
-      UInt32 nextCluster = 0;
-
-      if (!_volume || !_volume->ReadFATEntry(cluster, nextCluster)) {
-        return false;
-      }
+    UInt32 cluster = 0;
+    UInt32 reached = 0;
 
-      if (FAT::IsEndOfChain(nextCluster)) {
-        return true;
-      }
+    if (!WalkExtents(extents, startCluster, clusterIndex, cluster, reached)) {
+      return false;
+    }
 
-      cluster = nextCluster;
+    if (reached != clusterIndex) {
+      return true;
     }
 
+    UInt32 sectorsPerCluster = _volume->_sectorsPerCluster;
     UInt32 sectorOffset = clusterOffset / bytesPerSector;
     UInt32 byteOffset = clusterOffset % bytesPerSector;
 
     while (remaining > 0) {
-      UInt8 sector[512] = {};
       UInt32 lba
         = _volume->_dataStartLBA
-        + (cluster - 2) * _volume->_sectorsPerCluster
+        + (cluster - 2) * sectorsPerCluster
         + sectorOffset;
       BlockDevices::Request request {};
 
       request.deviceId = _volume->GetDeviceToken();
       request.lba = lba;
-      request.count = 1;
-      request.buffer = sector;
 
-      if (BlockDevices::Read(request) != 0) {
-        return false;
-      }
+      if (byteOffset == 0 && remaining >= bytesPerSector) {
+        // whole sectors go straight to the caller, one request per run
+        UInt32 count = 0;
+
+        if (
+          !MeasureRun(
+            extents,
+            startCluster,
+            clusterIndex,
+            cluster,
+            sectorOffset,
+            remaining / bytesPerSector,
+            count
+          )
+        ) {
+          return false;
+        }
 
-      UInt32 remainingSector = bytesPerSector - byteOffset;
-      UInt32 chunk = remaining < remainingSector ? remaining : remainingSector;
+        request.count = count;
+        request.buffer = buffer + outRead;
 
-      for (UInt32 i = 0; i < chunk; ++i) {
-        buffer[outRead + i] = sector[byteOffset + i];
-      }
+        if (BlockDevices::Read(request) != 0) {
+          return false;
+        }
+
+        outRead += count * bytesPerSector;
+        remaining -= count * bytesPerSector;
+        sectorOffset += count;
+      } else {
+        UInt8 sector[512] = {};
+
+        request.count = 1;
+        request.buffer = sector;
+
+        if (BlockDevices::Read(request) != 0) {
+          return false;
+        }
+
+        UInt32 remainingSector = bytesPerSector - byteOffset;
+        UInt32 chunk
+          = remaining < remainingSector ? remaining : remainingSector;
 
-      outRead += chunk;
-      remaining -= chunk;
-      byteOffset = 0;
-      ++sectorOffset;
+        for (UInt32 i = 0; i < chunk; ++i) {
+          buffer[outRead + i] = sector[byteOffset + i];
+        }
+
+        outRead += chunk;
+        remaining -= chunk;
+        byteOffset = 0;
+        ++sectorOffset;
+      }
 
       if (remaining == 0) {
         break;
       }
 
-      if (sectorOffset >= _volume->_sectorsPerCluster) {
-        UInt32 nextCluster = 0;
+      if (sectorOffset >= sectorsPerCluster) {
+        clusterIndex += sectorOffset / sectorsPerCluster;
+        sectorOffset %= sectorsPerCluster;
 
-        if (!_volume || !_volume->ReadFATEntry(cluster, nextCluster)) {
+        if (
+          !WalkExtents(extents, startCluster, clusterIndex, cluster, reached)
+        ) {
           return false;
         }
 
-        if (FAT::IsEndOfChain(nextCluster)) {
+        if (reached != clusterIndex) {
           break;
         }
-
-        cluster = nextCluster;
-        sectorOffset = 0;
       }
     }
 
@@ -136,7 +184,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32 length,
     UInt32& outWritten,
     UInt32 fileSize,
-    UInt32& outSize
+    UInt32& outSize,
+    ExtentMap& extents
   ) {
     outWritten = 0;
     outSize = fileSize;
@@ -154,11 +203,18 @@ namespace Quantum::Services::FileSystems::FAT12 {
 
     UInt32 clusterSize = bytesPerSector * _volume->_sectorsPerCluster;
     UInt32 endOffset = offset + length;
+    UInt32 clustersNeeded = (endOffset + clusterSize - 1) / clusterSize;
+    UInt32 clustersExpected = (extents.sizeHint + clusterSize - 1)
+      / clusterSize;
+
+    if (clustersExpected < clustersNeeded) {
+      clustersExpected = clustersNeeded;
+    }
 
     if (startCluster == 0) {
       UInt32 firstCluster = 0;
 
-      if (!_volume || !_volume->FindFreeCluster(firstCluster)) {
+      if (!TakeCluster(extents, 0, clustersExpected, firstCluster)) {
         return false;
       }
 
@@ -174,32 +230,29 @@ namespace Quantum::Services::FileSystems::FAT12 {
       }
     }
 
-    UInt32 clustersNeeded = (endOffset + clusterSize - 1) / clusterSize;
-    UInt32 clusterCount = 0;
-    UInt32 cluster = startCluster;
-    UInt32 lastCluster = startCluster;
-
-    for (;;) {
-      ++clusterCount;
-
-      UInt32 nextCluster = 0;
-
-      if (!_volume || !_volume->ReadFATEntry(cluster, nextCluster)) {
-        return false;
-      }
+    UInt32 lastCluster = 0;
+    UInt32 lastIndex = 0;
 
-      if (FAT::IsEndOfChain(nextCluster)) {
-        lastCluster = cluster;
-        break;
-      }
-
-      cluster = nextCluster;
+    // the map jumps straight to the tail instead of rewalking the chain
+    if (
+      !WalkExtents(extents, startCluster, 0xFFFFFFFF, lastCluster, lastIndex)
+    ) {
+      return false;
     }
 
+    UInt32 clusterCount = lastIndex + 1;
+
     while (clusterCount < clustersNeeded) {
       UInt32 newCluster = 0;
 
-      if (!_volume || !_volume->FindFreeCluster(newCluster)) {
+      if (
+        !TakeCluster(
+          extents,
+          lastCluster + 1,
+          clustersExpected - clusterCount,
+          newCluster
+        )
+      ) {
         return false;
       }
 
@@ -211,6 +264,10 @@ namespace Quantum::Services::FileSystems::FAT12 {
         return false;
       }
 
+      if (extents.clusterCount == clusterCount) {
+        AppendExtent(extents, newCluster);
+      }
+
       lastCluster = newCluster;
       ++clusterCount;
       if (_volume->_freeClusters > 0) {
@@ -220,88 +277,290 @@ namespace Quantum::Services::FileSystems::FAT12 {
       }
     }
 
-    UInt32 skipClusters = offset / clusterSize;
+    UInt32 clusterIndex = offset / clusterSize;
     UInt32 clusterOffset = offset % clusterSize;
-    UInt32 currentCluster = startCluster;
-
-    for (UInt32 i = 0; i < skipClusters; ++i) {
-      UInt32 nextCluster = 0;
-
-      if (!_volume || !_volume->ReadFATEntry(currentCluster, nextCluster)) {
-        return false;
-      }
-
-      if (FAT::IsEndOfChain(nextCluster)) {
-        return false;
-      }
+    UInt32 currentCluster = 0;
+    UInt32 reached = 0;
 
-      currentCluster = nextCluster;
+    if (
+      !WalkExtents(extents, startCluster, clusterIndex, currentCluster, reached)
+      || reached != clusterIndex
+    ) {
+      return false;
     }
 
+    UInt32 sectorsPerCluster = _volume->_sectorsPerCluster;
     UInt32 sectorOffset = clusterOffset / bytesPerSector;
     UInt32 byteOffset = clusterOffset % bytesPerSector;
     UInt32 remaining = length;
 
     while (remaining > 0) {
-      UInt8 sector[512] = {};
+      // sectors being fully overwritten need no read first; only a partial
+      // head or tail sector is read-modify-written
+      bool wholeSectors = byteOffset == 0 && remaining >= bytesPerSector;
+      UInt32 wanted = wholeSectors ? remaining / bytesPerSector : 1;
+      UInt32 count = 0;
+
+      if (
+        !MeasureRun(
+          extents,
+          startCluster,
+          clusterIndex,
+          currentCluster,
+          sectorOffset,
+          wanted,
+          count
+        )
+      ) {
+        return false;
+      }
+
       UInt32 lba
         = _volume->_dataStartLBA
-        + (currentCluster - 2) * _volume->_sectorsPerCluster
+        + (currentCluster - 2) * sectorsPerCluster
         + sectorOffset;
       BlockDevices::Request request {};
 
       request.deviceId = _volume->GetDeviceToken();
       request.lba = lba;
-      request.count = 1;
-      request.buffer = sector;
+      request.count = count;
 
-      if (BlockDevices::Read(request) != 0) {
-        return false;
-      }
+      if (wholeSectors) {
+        request.buffer = const_cast<UInt8*>(buffer + outWritten);
 
-      UInt32 remainingSector = bytesPerSector - byteOffset;
-      UInt32 chunk = remaining < remainingSector ? remaining : remainingSector;
+        if (BlockDevices::Write(request) != 0) {
+          return false;
+        }
 
-      for (UInt32 i = 0; i < chunk; ++i) {
-        sector[byteOffset + i] = buffer[outWritten + i];
-      }
+        outWritten += count * bytesPerSector;
+        remaining -= count * bytesPerSector;
+      } else {
+        UInt8 sector[512] = {};
 
-      request.lba = lba;
-      request.buffer = sector;
+        request.buffer = sector;
 
-      if (BlockDevices::Write(request) != 0) {
-        return false;
+        if (BlockDevices::Read(request) != 0) {
+          return false;
+        }
+
+        UInt32 span = bytesPerSector - byteOffset;
+        UInt32 chunk = remaining < span ? remaining : span;
+
+        for (UInt32 i = 0; i < chunk; ++i) {
+          sector[byteOffset + i] = buffer[outWritten + i];
+        }
+
+        if (BlockDevices::Write(request) != 0) {
+          return false;
+        }
+
+        outWritten += chunk;
+        remaining -= chunk;
+        byteOffset = 0;
       }
 
-      outWritten += chunk;
-      remaining -= chunk;
-      byteOffset = 0;
-      ++sectorOffset;
+      sectorOffset += count;
 
       if (remaining == 0) {
         break;
       }
 
-      if (sectorOffset >= _volume->_sectorsPerCluster) {
-        UInt32 nextCluster = 0;
-
-        if (!_volume || !_volume->ReadFATEntry(currentCluster, nextCluster)) {
+      if (sectorOffset >= sectorsPerCluster) {
+        clusterIndex += sectorOffset / sectorsPerCluster;
+        sectorOffset %= sectorsPerCluster;
+
+        if (
+          !WalkExtents(
+            extents,
+            startCluster,
+            clusterIndex,
+            currentCluster,
+            reached
+          )
+          || reached != clusterIndex
+        ) {
           return false;
         }
+      }
+    }
 
-        if (FAT::IsEndOfChain(nextCluster)) {
-          return false;
+    if (endOffset > fileSize) {
+      outSize = endOffset;
+    }
+
+    return true;
+  }
+
+  bool File::AppendExtent(ExtentMap& map, UInt32 diskCluster) {
+    if (map.extentCount > 0) {
+      Extent& last = map.extents[map.extentCount - 1];
+
+      if (last.diskCluster + last.length == diskCluster) {
+        ++last.length;
+        ++map.clusterCount;
+
+        return true;
+      }
+    }
+
+    if (map.extentCount >= maxExtents) {
+      return false;
+    }
+
+    Extent& extent = map.extents[map.extentCount];
+
+    extent.fileCluster = map.clusterCount;
+    extent.diskCluster = diskCluster;
+    extent.length = 1;
+
+    ++map.extentCount;
+    ++map.clusterCount;
+
+    return true;
+  }
+
+  bool File::WalkExtents(
+    ExtentMap& map,
+    UInt32 startCluster,
+    UInt32 index,
+    UInt32& outCluster,
+    UInt32& outIndex
+  ) {
+    if (map.startCluster != startCluster || map.clusterCount == 0) {
+      // a new chain keeps any reservation made for its first cluster
+      map.clusterCount = 0;
+      map.extentCount = 0;
+      map.startCluster = startCluster;
+
+      AppendExtent(map, startCluster);
+    }
+
+    if (index < map.clusterCount) {
+      UInt32 low = 0;
+      UInt32 high = map.extentCount;
+
+      // extents are sorted by file cluster; find the last one at or below
+      while (high - low > 1) {
+        UInt32 middle = low + (high - low) / 2;
+
+        if (map.extents[middle].fileCluster <= index) {
+          low = middle;
+        } else {
+          high = middle;
         }
+      }
 
-        currentCluster = nextCluster;
-        sectorOffset = 0;
+      const Extent& extent = map.extents[low];
+
+      outCluster = extent.diskCluster + (index - extent.fileCluster);
+      outIndex = index;
+
+      return true;
+    }
+
+    const Extent& tail = map.extents[map.extentCount - 1];
+    UInt32 cluster = tail.diskCluster + tail.length - 1;
+    UInt32 position = map.clusterCount - 1;
+
+    while (position < index) {
+      UInt32 nextCluster = 0;
+
+      if (!_volume || !_volume->ReadFATEntry(cluster, nextCluster)) {
+        return false;
+      }
+
+      if (FAT::IsEndOfChain(nextCluster)) {
+        break;
+      }
+
+      cluster = nextCluster;
+      ++position;
+
+      // once the table is full the rest of the chain stays unmapped
+      if (position == map.clusterCount) {
+        AppendExtent(map, cluster);
       }
     }
 
-    if (endOffset > fileSize) {
-      outSize = endOffset;
+    outCluster = cluster;
+    outIndex = position;
+
+    return true;
+  }
+
+  bool File::TakeCluster(
+    ExtentMap& map,
+    UInt32 goal,
+    UInt32 wanted,
+    UInt32& outCluster
+  ) {
+    if (map.reservedCount > 0 && map.reservedCluster == goal) {
+      bool claimed = _volume && _volume->ClaimReservedCluster(goal);
+
+      ++map.reservedCluster;
+      --map.reservedCount;
+
+      if (claimed) {
+        outCluster = goal;
+
+        return true;
+      }
+
+      // another file took the rest of the run; reserve afresh below
     }
 
+    UInt32 runStart = 0;
+    UInt32 runLength = 0;
+
+    ReleaseReservation(map);
+
+    if (
+      !_volume
+      || !_volume->ReserveClusters(wanted, goal, runStart, runLength)
+    ) {
+      return false;
+    }
+
+    outCluster = runStart;
+    map.reservedCluster = runStart + 1;
+    map.reservedCount = runLength - 1;
+
+    return true;
+  }
+
+  bool File::MeasureRun(
+    ExtentMap& map,
+    UInt32 startCluster,
+    UInt32 index,
+    UInt32 cluster,
+    UInt32 sectorOffset,
+    UInt32 maxSectors,
+    UInt32& outSectors
+  ) {
+    UInt32 sectorsPerCluster = _volume->_sectorsPerCluster;
+    UInt32 run = sectorsPerCluster - sectorOffset;
+    UInt32 length = 1;
+
+    while (run < maxSectors) {
+      UInt32 nextCluster = 0;
+      UInt32 reached = 0;
+
+      if (
+        !WalkExtents(map, startCluster, index + length, nextCluster, reached)
+      ) {
+        return false;
+      }
+
+      if (reached != index + length || nextCluster != cluster + length) {
+        break;
+      }
+
+      run += sectorsPerCluster;
+      ++length;
+    }
+
+    outSectors = run < maxSectors ? run : maxSectors;
+
     return true;
   }
 }
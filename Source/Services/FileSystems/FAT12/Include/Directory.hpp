@@ -75,6 +75,53 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt32 sizeBytes;
       };
 
+      /**
+       * Long filename tracking state.
+       */
+      struct LFNState {
+        char name[ABI::FileSystem::maxDirectoryLength];
+        UInt8 checksum;
+        UInt8 expected;
+        UInt8 seenMask;
+        bool active;
+      };
+
+      /**
+       * Resumable position within a directory, so sequential reads continue
+       * from the last record instead of rescanning from the first slot.
+       */
+      struct Cursor {
+        /**
+         * Whether the cursor holds a position.
+         */
+        bool valid;
+
+        /**
+         * Directory generation the position was taken in.
+         */
+        UInt32 generation;
+
+        /**
+         * Logical index of the next record.
+         */
+        UInt32 index;
+
+        /**
+         * Current cluster; unused for the root directory.
+         */
+        UInt32 cluster;
+
+        /**
+         * Raw slot within the root directory or the current cluster.
+         */
+        UInt32 slot;
+
+        /**
+         * Long name fragments gathered ahead of the next record.
+         */
+        LFNState lfn;
+      };
+
       /**
        * Initializes with a volume.
        * @param volume
@@ -82,6 +129,42 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       void Initialize(Volume& volume);
 
+      /**
+       * Empties a directory cursor.
+       * @param cursor
+       *   Cursor to reset.
+       */
+      static void ResetCursor(Cursor& cursor);
+
+      /**
+       * Reads a directory record by index, resuming from a cursor when the
+       * index is at or after it. The cursor restarts from the first slot
+       * if it is empty, behind the index, or the volume's directories were
+       * modified since it was positioned.
+       * @param cursor
+       *   Cursor to resume from; left after the returned record.
+       * @param startCluster
+       *   First cluster of the directory; ignored for the root.
+       * @param isRoot
+       *   True for the root directory.
+       * @param index
+       *   Record index.
+       * @param record
+       *   Output record.
+       * @param end
+       *   True if end of directory reached.
+       * @return
+       *   True on success.
+       */
+      bool ReadCursor(
+        Cursor& cursor,
+        UInt32 startCluster,
+        bool isRoot,
+        UInt32 index,
+        Record& record,
+        bool& end
+      );
+
       /**
        * Reads a root directory entry by index.
        * @param index
@@ -179,6 +262,49 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt32& outSize
       );
 
+      /**
+       * Looks up an entry through the lookup cache, scanning the directory
+       * once on a miss. Misses are cached too, so repeated lookups of
+       * missing names also avoid disk I/O.
+       * @param parentCluster
+       *   Parent directory cluster.
+       * @param parentIsRoot
+       *   True if parent is root.
+       * @param name
+       *   Entry name.
+       * @param outCluster
+       *   Receives start cluster.
+       * @param outAttributes
+       *   Receives attributes.
+       * @param outSize
+       *   Receives size in bytes.
+       * @param outLBA
+       *   Receives sector LBA.
+       * @param outOffset
+       *   Receives byte offset within sector.
+       * @return
+       *   True if found.
+       */
+      bool LookupEntry(
+        UInt32 parentCluster,
+        bool parentIsRoot,
+        CString name,
+        UInt32& outCluster,
+        UInt8& outAttributes,
+        UInt32& outSize,
+        UInt32& outLBA,
+        UInt32& outOffset
+      );
+
+      /**
+       * Retrieves lookup cache counters.
+       * @param outHits
+       *   Receives lookups answered from the cache.
+       * @param outMisses
+       *   Receives lookups that scanned the directory.
+       */
+      void GetLookupStats(UInt32& outHits, UInt32& outMisses) const;
+
       /**
        * Finds a directory entry and its location.
        * @param parentCluster
@@ -339,16 +465,70 @@ namespace Quantum::Services::FileSystems::FAT12 {
 
     private:
       /**
-       * Long filename tracking state.
+       * Cached result of a name lookup in one directory.
        */
-      struct LFNState {
+      struct CachedLookup {
+        /**
+         * Whether the slot holds a lookup.
+         */
+        bool valid;
+
+        /**
+         * Whether the name exists; false for a negative entry.
+         */
+        bool found;
+
+        /**
+         * True if the parent is the root directory.
+         */
+        bool parentIsRoot;
+
+        /**
+         * Entry attributes.
+         */
+        UInt8 attributes;
+
+        /**
+         * Parent directory cluster.
+         */
+        UInt32 parentCluster;
+
+        /**
+         * Upper-cased entry name.
+         */
         char name[ABI::FileSystem::maxDirectoryLength];
-        UInt8 checksum;
-        UInt8 expected;
-        UInt8 seenMask;
-        bool active;
+
+        /**
+         * Entry start cluster.
+         */
+        UInt32 startCluster;
+
+        /**
+         * Entry size in bytes.
+         */
+        UInt32 sizeBytes;
+
+        /**
+         * Directory sector holding the entry.
+         */
+        UInt32 lba;
+
+        /**
+         * Byte offset of the entry within its sector.
+         */
+        UInt32 offset;
+
+        /**
+         * Lookup sequence of the last use, for replacement.
+         */
+        UInt32 lastUse;
       };
 
+      /**
+       * Number of cached lookups.
+       */
+      static constexpr UInt32 _lookupCacheEntries = 32;
+
       /**
        * Clears LFN tracking state.
        * @param state
@@ -555,9 +735,71 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt32& outOffset
       );
 
+      /**
+       * Finds a cached lookup.
+       * @param parentCluster
+       *   Parent directory cluster.
+       * @param parentIsRoot
+       *   True if parent is root.
+       * @param name
+       *   Entry name.
+       * @return
+       *   Cached lookup, or nullptr if absent.
+       */
+      CachedLookup* FindLookup(
+        UInt32 parentCluster,
+        bool parentIsRoot,
+        CString name
+      );
+
+      /**
+       * Drops cached lookups under one directory.
+       * @param parentCluster
+       *   Parent directory cluster.
+       * @param parentIsRoot
+       *   True if parent is root.
+       */
+      void InvalidateLookups(UInt32 parentCluster, bool parentIsRoot);
+
+      /**
+       * Drops every cached lookup.
+       */
+      void InvalidateAllLookups();
+
       /**
        * Associated volume.
        */
       Volume* _volume;
+
+      /**
+       * Cached name lookups.
+       */
+      CachedLookup _lookups[_lookupCacheEntries] = {};
+
+      /**
+       * Lookup sequence counter.
+       */
+      UInt32 _lookupSequence = 0;
+
+      /**
+       * Bumped whenever a directory's slots change, invalidating cursors.
+       */
+      UInt32 _generation = 0;
+
+      /**
+       * Whether the last location scan stopped on an error rather than an
+       * answer.
+       */
+      bool _lookupScanFailed = false;
+
+      /**
+       * Lookups answered from the cache.
+       */
+      UInt32 _lookupHits = 0;
+
+      /**
+       * Lookups that scanned the directory.
+       */
+      UInt32 _lookupMisses = 0;
   };
 }
@@ -55,7 +55,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
       bool ReadEntryCached(UInt32 cluster, UInt32& nextCluster) const;
 
       /**
-       * Writes a FAT entry.
+       * Writes a FAT entry. With the FAT cached the change is kept in
+       * memory and written back by `Flush`.
        * @param cluster
        *   Cluster to write.
        * @param value
@@ -65,6 +66,27 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       bool WriteEntry(UInt32 cluster, UInt32 value);
 
+      /**
+       * Writes every dirty FAT sector to all FAT copies.
+       * @return
+       *   True on success.
+       */
+      bool Flush();
+
+      /**
+       * Checks whether the cached FAT has unwritten changes.
+       * @return
+       *   True if any FAT sector is dirty.
+       */
+      bool IsDirty() const;
+
+      /**
+       * Counts cached FAT sectors with unwritten changes.
+       * @return
+       *   Number of dirty FAT sectors.
+       */
+      UInt32 GetDirtyCount() const;
+
       /**
        * Finds a free cluster.
        * @param outCluster
@@ -75,7 +97,51 @@ namespace Quantum::Services::FileSystems::FAT12 {
       bool FindFreeCluster(UInt32& outCluster);
 
       /**
-       * Counts free clusters.
+       * Reserves a run of contiguous free clusters. A free cluster at
+       * `goal` is extended first; otherwise the smallest free run that
+       * fits is chosen, or the largest one if none does. Reserved clusters
+       * stay free, but later allocations only take them once no other free
+       * cluster is left; one taken this way is lost to its reservation.
+       * @param wanted
+       *   Number of clusters wanted.
+       * @param goal
+       *   Preferred first cluster, or 0 for none.
+       * @param outCluster
+       *   Receives the first cluster of the run.
+       * @param outLength
+       *   Receives the run length, between 1 and `wanted`.
+       * @return
+       *   True on success.
+       */
+      bool ReserveRun(
+        UInt32 wanted,
+        UInt32 goal,
+        UInt32& outCluster,
+        UInt32& outLength
+      );
+
+      /**
+       * Returns reserved clusters that were never linked.
+       * @param cluster
+       *   First cluster of the run.
+       * @param length
+       *   Number of clusters in the run.
+       */
+      void ReleaseRun(UInt32 cluster, UInt32 length);
+
+      /**
+       * Takes a reserved cluster for linking, unless another allocation
+       * already took it.
+       * @param cluster
+       *   Reserved cluster to take.
+       * @return
+       *   True if the cluster was still reserved and free.
+       */
+      bool ClaimReserved(UInt32 cluster);
+
+      /**
+       * Counts free clusters. Clusters reserved by `ReserveRun` count as
+       * free, since any allocation may still take them.
        * @param outCount
        *   Receives the free cluster count.
        * @return
@@ -102,9 +168,126 @@ namespace Quantum::Services::FileSystems::FAT12 {
       static bool IsEndOfChain(UInt32 value);
 
     private:
+      /**
+       * Largest FAT the cache holds, in 512-byte sectors.
+       */
+      static constexpr UInt32 _maxCachedSectors = 16;
+
+      /**
+       * Number of words in the dirty-sector bitmap.
+       */
+      static constexpr UInt32 _dirtyBitmapWords = (_maxCachedSectors + 31) / 32;
+
+      /**
+       * Dirty sector count that forces a flush.
+       */
+      static constexpr UInt32 _flushThresholdSectors = 4;
+
+      /**
+       * Largest cluster number the free bitmap covers, plus one.
+       */
+      static constexpr UInt32 _maxClusters = 4096;
+
+      /**
+       * Number of words in the free-cluster bitmap.
+       */
+      static constexpr UInt32 _freeBitmapWords = _maxClusters / 32;
+
       /**
        * Associated volume.
        */
       Volume* _volume;
+
+      /**
+       * Bitmap of clusters available for allocation, built from the FAT
+       * cache.
+       */
+      UInt32 _freeBitmap[_freeBitmapWords] = {};
+
+      /**
+       * True if the free-cluster bitmap mirrors the FAT cache.
+       */
+      bool _freeBitmapValid = false;
+
+      /**
+       * Bitmap of free clusters reserved by `ReserveRun` for growing a
+       * file.
+       */
+      UInt32 _reservedBitmap[_freeBitmapWords] = {};
+
+      /**
+       * Bitmap of cached FAT sectors not yet written to disk.
+       */
+      UInt32 _dirtySectors[_dirtyBitmapWords] = {};
+
+      /**
+       * Number of set bits in the dirty-sector bitmap.
+       */
+      UInt32 _dirtyCount = 0;
+
+      /**
+       * Marks a cached FAT sector dirty.
+       * @param sectorOffset
+       *   Sector index within the FAT.
+       */
+      void MarkDirty(UInt32 sectorOffset);
+
+      /**
+       * Checks whether a cached FAT sector is dirty.
+       * @param sectorOffset
+       *   Sector index within the FAT.
+       * @return
+       *   True if the sector is dirty.
+       */
+      bool IsSectorDirty(UInt32 sectorOffset) const;
+
+      /**
+       * Rebuilds the free-cluster bitmap from the FAT cache.
+       */
+      void BuildFreeBitmap();
+
+      /**
+       * Updates a cluster's bit in the free-cluster bitmap.
+       * @param cluster
+       *   Cluster to update.
+       * @param free
+       *   True if the cluster is available.
+       */
+      void SetClusterFree(UInt32 cluster, bool free);
+
+      /**
+       * Checks a cluster's bit in the free-cluster bitmap.
+       * @param cluster
+       *   Cluster to check.
+       * @return
+       *   True if the cluster is available.
+       */
+      bool IsClusterFree(UInt32 cluster) const;
+
+      /**
+       * Updates a cluster's bit in the reserved-cluster bitmap.
+       * @param cluster
+       *   Cluster to update.
+       * @param reserved
+       *   True if the cluster is reserved.
+       */
+      void SetClusterReserved(UInt32 cluster, bool reserved);
+
+      /**
+       * Checks whether a cluster is free and not reserved.
+       * @param cluster
+       *   Cluster to check.
+       * @return
+       *   True if the cluster may be allocated without taking a
+       *   reservation.
+       */
+      bool IsClusterAvailable(UInt32 cluster) const;
+
+      /**
+       * Returns the highest cluster number the bitmap tracks.
+       * @return
+       *   Highest allocatable cluster number.
+       */
+      UInt32 GetMaxCluster() const;
   };
 }
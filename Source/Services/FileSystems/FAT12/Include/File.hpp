@@ -18,6 +18,91 @@ namespace Quantum::Services::FileSystems::FAT12 {
    */
   class File {
     public:
+      /**
+       * Maximum number of extents tracked per open file.
+       */
+      static constexpr UInt32 maxExtents = 16;
+
+      /**
+       * Run of physically contiguous clusters within a file.
+       */
+      struct Extent {
+        /**
+         * Index of the first cluster within the file.
+         */
+        UInt32 fileCluster;
+
+        /**
+         * First cluster on disk.
+         */
+        UInt32 diskCluster;
+
+        /**
+         * Number of clusters in the run.
+         */
+        UInt32 length;
+      };
+
+      /**
+       * Cluster map of an open file, built lazily as its chain is walked.
+       * It covers a prefix of the chain; clusters past the prefix (once the
+       * extent table is full, or after another handle extended the file)
+       * are found by walking the FAT from the last mapped cluster.
+       */
+      struct ExtentMap {
+        /**
+         * First cluster of the chain the map describes; 0 when empty.
+         */
+        UInt32 startCluster;
+
+        /**
+         * Number of clusters covered by the map.
+         */
+        UInt32 clusterCount;
+
+        /**
+         * Number of extents in use.
+         */
+        UInt32 extentCount;
+
+        /**
+         * Extents ordered by file cluster index.
+         */
+        Extent extents[maxExtents];
+
+        /**
+         * First cluster reserved for growing the file, following its tail.
+         */
+        UInt32 reservedCluster;
+
+        /**
+         * Number of reserved clusters not yet linked into the chain. They
+         * still count as free, and other files may take them when the
+         * volume runs short.
+         */
+        UInt32 reservedCount;
+
+        /**
+         * Expected final file size in bytes, used to size reservations; 0
+         * when unknown.
+         */
+        UInt32 sizeHint;
+      };
+
+      /**
+       * Empties an extent map and forgets its reservation.
+       * @param map
+       *   Map to reset.
+       */
+      static void ResetExtents(ExtentMap& map);
+
+      /**
+       * Returns a map's unused reserved clusters to the volume.
+       * @param map
+       *   Map holding the reservation.
+       */
+      void ReleaseReservation(ExtentMap& map);
+
       /**
        * Initializes with a volume.
        * @param volume
@@ -39,6 +124,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
        *   Receives bytes read.
        * @param fileSize
        *   File size in bytes.
+       * @param extents
+       *   Cluster map of the open file.
        * @return
        *   True on success.
        */
@@ -48,7 +135,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt8* buffer,
         UInt32 length,
         UInt32& outRead,
-        UInt32 fileSize
+        UInt32 fileSize,
+        ExtentMap& extents
       );
 
       /**
@@ -67,6 +155,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
        *   Current file size.
        * @param outSize
        *   Receives updated file size.
+       * @param extents
+       *   Cluster map of the open file; extended as clusters are added.
        * @return
        *   True on success.
        */
@@ -77,10 +167,99 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt32 length,
         UInt32& outWritten,
         UInt32 fileSize,
-        UInt32& outSize
+        UInt32& outSize,
+        ExtentMap& extents
       );
 
     private:
+      /**
+       * Appends the cluster that follows the mapped prefix.
+       * @param map
+       *   Map to extend.
+       * @param diskCluster
+       *   Cluster at index `map.clusterCount`.
+       * @return
+       *   True if the map now covers the cluster.
+       */
+      static bool AppendExtent(ExtentMap& map, UInt32 diskCluster);
+
+      /**
+       * Finds the disk cluster at a file cluster index, walking the FAT
+       * past the mapped prefix when needed.
+       * @param map
+       *   Cluster map of the file.
+       * @param startCluster
+       *   First cluster of the file.
+       * @param index
+       *   File cluster index; `0xFFFFFFFF` walks to the end of the chain.
+       * @param outCluster
+       *   Receives the cluster at `outIndex`.
+       * @param outIndex
+       *   Receives the index reached; less than `index` if the chain ends
+       *   first.
+       * @return
+       *   True on success; false on a FAT read failure.
+       */
+      bool WalkExtents(
+        ExtentMap& map,
+        UInt32 startCluster,
+        UInt32 index,
+        UInt32& outCluster,
+        UInt32& outIndex
+      );
+
+      /**
+       * Allocates the next cluster for a file, taking it from the map's
+       * reservation when that continues at `goal` and reserving a new run
+       * otherwise.
+       * @param map
+       *   Cluster map of the file.
+       * @param goal
+       *   Cluster following the file's tail, or 0 for a new chain.
+       * @param wanted
+       *   Number of clusters the file is expected to need from here.
+       * @param outCluster
+       *   Receives the allocated cluster.
+       * @return
+       *   True on success.
+       */
+      bool TakeCluster(
+        ExtentMap& map,
+        UInt32 goal,
+        UInt32 wanted,
+        UInt32& outCluster
+      );
+
+      /**
+       * Counts the sectors from a position that are physically contiguous
+       * on disk, following the chain across cluster boundaries.
+       * @param map
+       *   Cluster map of the file.
+       * @param startCluster
+       *   First cluster of the file.
+       * @param index
+       *   File cluster index of the position.
+       * @param cluster
+       *   Disk cluster at `index`.
+       * @param sectorOffset
+       *   Sector offset within `cluster`.
+       * @param maxSectors
+       *   Maximum number of sectors wanted.
+       * @param outSectors
+       *   Receives the run length, between 1 and `maxSectors`.
+       * @return
+       *   True on success; false on a FAT read failure.
+       */
+      bool MeasureRun(
+        ExtentMap& map,
+        UInt32 startCluster,
+        UInt32 index,
+        UInt32 cluster,
+        UInt32 sectorOffset,
+        UInt32 maxSectors,
+        UInt32& outSectors
+      );
+
       /**
        * Associated volume.
        */
@@ -69,6 +69,11 @@ namespace Quantum::Services::FileSystems::FAT12 {
          */
         UInt32 nextIndex;
 
+        /**
+         * Position after the last directory entry read.
+         */
+        Directory::Cursor cursor;
+
         /**
          * File size in bytes.
          */
@@ -93,6 +98,11 @@ namespace Quantum::Services::FileSystems::FAT12 {
          * Directory entry offset.
          */
         UInt32 entryOffset;
+
+        /**
+         * Cluster extents of the file, built lazily on first access.
+         */
+        File::ExtentMap extents;
       };
 
       /**
@@ -130,6 +140,22 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       inline static UInt32 _pendingReplySender = 0;
 
+      /**
+       * Shared memory handle of the bulk buffer mapped for the request
+       * being served.
+       */
+      inline static UInt32 _bulkHandle = 0;
+
+      /**
+       * Base of the mapped bulk buffer.
+       */
+      inline static UInt8* _bulkBuffer = nullptr;
+
+      /**
+       * Size of the mapped bulk buffer in bytes.
+       */
+      inline static UInt32 _bulkBytes = 0;
+
       /**
        * Initializes the FAT12 volume list.
        */
@@ -142,6 +168,19 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       static void SendReadySignal(UInt8 deviceTypeId);
 
+      /**
+       * Builds a bare failure reply for a request that cannot be served, so
+       * a caller blocked in `IPC::Call` is always answered.
+       * @param reply
+       *   Message to build the reply in.
+       * @param request
+       *   Request being failed.
+       */
+      static void BuildFailureReply(
+        ABI::IPC::Message& reply,
+        const ABI::FileSystem::ServiceMessage& request
+      );
+
       /**
        * Finds a volume by handle.
        * @param handle
@@ -198,6 +237,56 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       static HandleState* GetHandleState(ABI::FileSystem::Handle handle);
 
+      /**
+       * Reads the next directory entry at or after an index, skipping
+       * unreadable slots.
+       * @param state
+       *   Directory handle state.
+       * @param index
+       *   Entry index to start at; advanced past the returned entry.
+       * @param entry
+       *   Receives the entry.
+       * @return
+       *   True if an entry was returned; false at the end of the directory.
+       */
+      static bool ReadNextEntry(
+        HandleState& state,
+        UInt32& index,
+        ABI::FileSystem::DirectoryEntry& entry
+      );
+
+      /**
+       * Maps the shared memory object named by a bulk request. The object
+       * must belong to the task that sent the request, so a client can not
+       * have the service read or write another task's buffer. The mapping
+       * lasts until ReleaseBulkBuffer.
+       * @param sharedId
+       *   Shared memory id from the request.
+       * @param requesterId
+       *   Task that sent the request.
+       * @param writable
+       *   Whether the service writes into the buffer.
+       * @param outBuffer
+       *   Receives the mapped buffer.
+       * @param outBytes
+       *   Receives the buffer size in bytes.
+       * @return
+       *   True if the buffer is mapped.
+       */
+      static bool MapBulkBuffer(
+        UInt32 sharedId,
+        UInt32 requesterId,
+        bool writable,
+        UInt8*& outBuffer,
+        UInt32& outBytes
+      );
+
+      /**
+       * Unmaps and closes the bulk buffer of the request just served, if
+       * any.
+       */
+      static void ReleaseBulkBuffer();
+
       /**
        * Resolves the parent directory for a path.
        * @param path
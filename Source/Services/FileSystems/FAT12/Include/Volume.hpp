@@ -58,6 +58,22 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       const ABI::FileSystem::VolumeInfo& GetInfo() const;
 
+      /**
+       * Retrieves the directory lookup cache counters.
+       * @param outHits
+       *   Receives lookups answered from the cache.
+       * @param outMisses
+       *   Receives lookups that scanned the directory.
+       */
+      void GetLookupStats(UInt32& outHits, UInt32& outMisses) const;
+
+      /**
+       * Counts cached FAT sectors not yet written to disk.
+       * @return
+       *   Number of dirty FAT sectors.
+       */
+      UInt32 GetDirtySectorCount() const;
+
       /**
        * Returns the fixed volume handle.
        * @return
@@ -103,13 +119,16 @@ namespace Quantum::Services::FileSystems::FAT12 {
        *   Output entry to populate.
        * @param end
        *   True if the end of directory was reached.
+       * @param cursor
+       *   Cursor of the reading handle, resumed when possible.
        * @return
        *   True if a valid entry was returned.
        */
       bool ReadRootEntry(
         UInt32 index,
         ABI::FileSystem::DirectoryEntry& entry,
-        bool& end
+        bool& end,
+        Directory::Cursor& cursor
       );
 
       /**
@@ -122,6 +141,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
        *   Output entry to populate.
        * @param end
        *   True if the end of directory was reached.
+       * @param cursor
+       *   Cursor of the reading handle, resumed when possible.
        * @return
        *   True if a valid entry was returned.
        */
@@ -129,7 +150,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt32 startCluster,
         UInt32 index,
         ABI::FileSystem::DirectoryEntry& entry,
-        bool& end
+        bool& end,
+        Directory::Cursor& cursor
       );
 
       /**
@@ -153,7 +175,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
       );
 
       /**
-       * Finds a directory entry by name.
+       * Finds a directory entry by name, answering repeated lookups from
+       * the directory lookup cache.
        * @param startCluster
        *   First cluster of the directory.
        * @param isRoot
@@ -190,6 +213,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
        *   Receives the number of bytes read.
        * @param fileSize
        *   File size in bytes.
+       * @param extents
+       *   Cluster extent map of the open file.
        * @return
        *   True if the read completed.
        */
@@ -199,7 +224,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt8* buffer,
         UInt32 length,
         UInt32& outRead,
-        UInt32 fileSize
+        UInt32 fileSize,
+        File::ExtentMap& extents
       );
 
       /**
@@ -218,6 +244,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
        *   Current file size in bytes.
        * @param outSize
        *   Receives the updated file size.
+       * @param extents
+       *   Cluster extent map of the open file.
        * @return
        *   True if the write completed.
        */
@@ -228,7 +256,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
         UInt32 length,
         UInt32& outWritten,
         UInt32 fileSize,
-        UInt32& outSize
+        UInt32& outSize,
+        File::ExtentMap& extents
       );
 
       /**
@@ -380,7 +409,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
       bool ReadFATEntry(UInt32 cluster, UInt32& nextCluster);
 
       /**
-       * Writes a FAT12 entry to disk.
+       * Writes a FAT12 entry. When the FAT is cached the entry reaches the
+       * disk on the next `FlushFAT`.
        * @param cluster
        *   Cluster to update.
        * @param value
@@ -399,6 +429,62 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       bool FindFreeCluster(UInt32& outCluster);
 
+      /**
+       * Reserves a run of contiguous free clusters.
+       * @param wanted
+       *   Number of clusters wanted.
+       * @param goal
+       *   Preferred first cluster, or 0 for none.
+       * @param outCluster
+       *   Receives the first cluster of the run.
+       * @param outLength
+       *   Receives the run length, between 1 and `wanted`.
+       * @return
+       *   True if a run was reserved.
+       */
+      bool ReserveClusters(
+        UInt32 wanted,
+        UInt32 goal,
+        UInt32& outCluster,
+        UInt32& outLength
+      );
+
+      /**
+       * Returns reserved clusters that were never linked.
+       * @param cluster
+       *   First cluster of the run.
+       * @param length
+       *   Number of clusters in the run.
+       */
+      void ReleaseClusters(UInt32 cluster, UInt32 length);
+
+      /**
+       * Takes a reserved cluster for linking.
+       * @param cluster
+       *   Reserved cluster to take.
+       * @return
+       *   True if no other allocation took the cluster first.
+       */
+      bool ClaimReservedCluster(UInt32 cluster);
+
+      /**
+       * Returns an open file's unused reserved clusters.
+       * @param extents
+       *   Cluster extent map of the file.
+       */
+      void ReleaseExtents(File::ExtentMap& extents);
+
+      /**
+       * Counts the contiguous cluster runs in a chain.
+       * @param startCluster
+       *   First cluster of the chain, or 0 for an empty file.
+       * @param outCount
+       *   Receives the run count.
+       * @return
+       *   True if the whole chain was walked.
+       */
+      bool CountExtents(UInt32 startCluster, UInt32& outCount);
+
       /**
        * Counts free clusters in the FAT.
        * @param outCount
@@ -408,6 +494,20 @@ namespace Quantum::Services::FileSystems::FAT12 {
        */
       bool CountFreeClusters(UInt32& outCount);
 
+      /**
+       * Writes dirty cached FAT sectors to every FAT copy.
+       * @return
+       *   True if the FAT is clean on disk.
+       */
+      bool FlushFAT();
+
+      /**
+       * Flushes the FAT and the device's buffered blocks to the medium.
+       * @return
+       *   True on success.
+       */
+      bool Sync();
+
       /**
        * Loads the FAT into a local cache.
        * @return
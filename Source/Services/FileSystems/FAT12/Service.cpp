@@ -10,7 +10,9 @@
 #include <ABI/Coordinator.hpp>
 #include <ABI/Devices/BlockDevices.hpp>
 #include <ABI/FileSystem.hpp>
+#include <ABI/Handle.hpp>
 #include <ABI/IPC.hpp>
+#include <ABI/SharedMemory.hpp>
 #include <ABI/Task.hpp>
 
 #include "Service.hpp"
@@ -21,6 +23,7 @@ namespace Quantum::Services::FileSystems::FAT12 {
   using ABI::Devices::BlockDevices;
   using ABI::FileSystem;
   using ABI::IPC;
+  using ABI::SharedMemory;
   using ABI::Task;
 
   static constexpr UInt8 _deviceTypeId = 3;
@@ -53,6 +56,23 @@ namespace Quantum::Services::FileSystems::FAT12 {
     IPC::CloseHandle(readyHandle);
   }
 
+  void Service::BuildFailureReply(
+    IPC::Message& reply,
+    const FileSystem::ServiceMessage& request
+  ) {
+    FileSystem::ServiceMessage response {};
+
+    response.op = request.op;
+    response.status = FileSystem::Status::Failed;
+    response.requestId = request.requestId;
+
+    reply.length = FileSystem::messageHeaderBytes;
+
+    for (UInt32 i = 0; i < reply.length; ++i) {
+      reply.payload[i] = reinterpret_cast<UInt8*>(&response)[i];
+    }
+  }
+
   void Service::InitializeVolumes() {
     _volumesHead = nullptr;
     _volumeCount = 0;
@@ -166,6 +186,9 @@ namespace Quantum::Services::FileSystems::FAT12 {
         _handles[i].entryLBA = 0;
         _handles[i].entryOffset = 0;
 
+        Directory::ResetCursor(_handles[i].cursor);
+        File::ResetExtents(_handles[i].extents);
+
         return static_cast<FileSystem::Handle>(_handleBase + i);
       }
     }
@@ -180,6 +203,10 @@ namespace Quantum::Services::FileSystems::FAT12 {
       return;
     }
 
+    if (state->volume) {
+      state->volume->ReleaseExtents(state->extents);
+    }
+
     state->inUse = false;
     state->volume = nullptr;
     state->isDirectory = false;
@@ -191,6 +218,9 @@ namespace Quantum::Services::FileSystems::FAT12 {
     state->attributes = 0;
     state->entryLBA = 0;
     state->entryOffset = 0;
+
+    Directory::ResetCursor(state->cursor);
+    File::ResetExtents(state->extents);
   }
 
   Service::HandleState* Service::GetHandleState(FileSystem::Handle handle) {
@@ -207,6 +237,49 @@ namespace Quantum::Services::FileSystems::FAT12 {
     return &_handles[index];
   }
 
+  bool Service::ReadNextEntry(
+    HandleState& state,
+    UInt32& index,
+    FileSystem::DirectoryEntry& entry
+  ) {
+    Volume* volume = state.volume;
+
+    if (!volume) {
+      return false;
+    }
+
+    for (;;) {
+      bool end = false;
+      bool found = false;
+
+      if (state.isRoot) {
+        if (index >= volume->GetRootEntryCount()) {
+          return false;
+        }
+
+        found = volume->ReadRootEntry(index, entry, end, state.cursor);
+      } else {
+        found = volume->ReadDirectoryEntry(
+          state.startCluster,
+          index,
+          entry,
+          end,
+          state.cursor
+        );
+      }
+
+      ++index;
+
+      if (found) {
+        return true;
+      }
+
+      if (end) {
+        return false;
+      }
+    }
+  }
+
   static void NormalizeSegment(char* segment) {
     if (!segment || segment[0] == '\0') {
       return;
@@ -244,6 +317,76 @@ namespace Quantum::Services::FileSystems::FAT12 {
     segment[out] = '\0';
   }
 
+  bool Service::MapBulkBuffer(
+    UInt32 sharedId,
+    UInt32 requesterId,
+    bool writable,
+    UInt8*& outBuffer,
+    UInt32& outBytes
+  ) {
+    if (sharedId == 0) {
+      return false;
+    }
+
+    ReleaseBulkBuffer();
+
+    UInt32 rights = static_cast<UInt32>(SharedMemory::Right::Read);
+
+    if (writable) {
+      rights |= static_cast<UInt32>(SharedMemory::Right::Write);
+    }
+
+    UInt32 handle = SharedMemory::Open(sharedId, rights);
+
+    if (handle == 0) {
+      return false;
+    }
+
+    SharedMemory::Info info {};
+
+    // the service may hold grants from several clients; only serve the
+    // requester's own buffer
+    if (
+      SharedMemory::GetInfo(handle, info) != 0
+      || info.ownerId != requesterId
+    ) {
+      ABI::Handle::Close(handle);
+
+      return false;
+    }
+
+    void* buffer = SharedMemory::Map(handle);
+
+    if (!buffer) {
+      ABI::Handle::Close(handle);
+
+      return false;
+    }
+
+    _bulkHandle = handle;
+    _bulkBuffer = reinterpret_cast<UInt8*>(buffer);
+    _bulkBytes = info.size;
+
+    outBuffer = _bulkBuffer;
+    outBytes = _bulkBytes;
+
+    return true;
+  }
+
+  void Service::ReleaseBulkBuffer() {
+    if (_bulkBuffer) {
+      SharedMemory::Unmap(_bulkBuffer);
+    }
+
+    if (_bulkHandle != 0) {
+      ABI::Handle::Close(_bulkHandle);
+    }
+
+    _bulkHandle = 0;
+    _bulkBuffer = nullptr;
+    _bulkBytes = 0;
+  }
+
   bool Service::ResolveParent(
     Volume* volume,
     CString path,
@@ -426,10 +569,17 @@ namespace Quantum::Services::FileSystems::FAT12 {
     Console::WriteLine("FAT12 service ready");
     SendReadySignal(_deviceTypeId);
 
+    IPC::Message msg {};
+    UInt32 replyToken = 0;
+
     for (;;) {
-      IPC::Message msg {};
+      // answer the previous call (if any) and wait for the next request in a
+      // single trap
+      UInt32 received = IPC::ReplyWait(portHandle, replyToken, msg);
+
+      replyToken = 0;
 
-      if (IPC::Receive(portHandle, msg) != 0) {
+      if (received != 0) {
         continue;
       }
 
@@ -447,6 +597,13 @@ namespace Quantum::Services::FileSystems::FAT12 {
       }
 
       if (msg.length < FileSystem::messageHeaderBytes) {
+        // a caller blocked in IPC::Call still needs an answer
+        if (msg.replyToken != 0) {
+          replyToken = msg.replyToken;
+
+          BuildFailureReply(msg, FileSystem::ServiceMessage {});
+        }
+
         continue;
       }
 
@@ -462,19 +619,25 @@ namespace Quantum::Services::FileSystems::FAT12 {
         reinterpret_cast<UInt8*>(&request)[i] = msg.payload[i];
       }
 
+      UInt32 callToken = msg.replyToken;
+      UInt32 senderId = msg.senderId;
       IPC::Handle replyHandle = 0;
 
-      if (request.replyPortId != 0) {
-        replyHandle = IPC::OpenPort(request.replyPortId, static_cast<UInt32>(IPC::Right::Send));
-      } else if (_pendingReplyHandle != 0 && _pendingReplySender == msg.senderId)
-      {
-        replyHandle = _pendingReplyHandle;
-        _pendingReplyHandle = 0;
-        _pendingReplySender = 0;
-      }
+      if (callToken == 0) {
+        if (request.replyPortId != 0) {
+          replyHandle = IPC::OpenPort(request.replyPortId, static_cast<UInt32>(IPC::Right::Send));
+        } else if (
+          _pendingReplyHandle != 0
+          && _pendingReplySender == msg.senderId
+        ) {
+          replyHandle = _pendingReplyHandle;
+          _pendingReplyHandle = 0;
+          _pendingReplySender = 0;
+        }
 
-      if (replyHandle == 0) {
-        continue;
+        if (replyHandle == 0) {
+          continue;
+        }
       }
 
       FileSystem::ServiceMessage response {};
@@ -482,6 +645,7 @@ namespace Quantum::Services::FileSystems::FAT12 {
       response.op = request.op;
       response.status = static_cast<FileSystem::Status>(1);
       response.replyPortId = 0;
+      response.requestId = request.requestId;
       response.arg0 = 0;
       response.arg1 = 0;
       response.arg2 = 0;
@@ -541,6 +705,9 @@ namespace Quantum::Services::FileSystems::FAT12 {
           FileSystem::VolumeInfo info = volume->GetInfo();
           UInt32 bytes = static_cast<UInt32>(sizeof(FileSystem::VolumeInfo));
 
+          volume->GetLookupStats(info.lookupHits, info.lookupMisses);
+          info.dirtySectors = volume->GetDirtySectorCount();
+
           if (bytes <= FileSystem::messageDataBytes) {
             for (UInt32 i = 0; i < bytes; ++i) {
               response.data[i] = reinterpret_cast<UInt8*>(&info)[i];
@@ -556,6 +723,12 @@ namespace Quantum::Services::FileSystems::FAT12 {
         if (volume) {
           response.status = static_cast<FileSystem::Status>(0);
         }
+      } else if (request.op == FileSystem::Operation::Sync) {
+        Volume* volume = FindVolumeByHandle(request.arg0);
+
+        if (volume && volume->Sync()) {
+          response.status = static_cast<FileSystem::Status>(0);
+        }
       } else if (request.op == FileSystem::Operation::Open) {
         CString path = reinterpret_cast<CString>(request.data);
         Volume* volume = FindVolumeByHandle(request.arg0);
@@ -845,6 +1018,11 @@ namespace Quantum::Services::FileSystems::FAT12 {
         if (!state || !state->inUse) {
           response.status = static_cast<FileSystem::Status>(1);
         } else {
+          // cluster allocations made through this handle reach the disk
+          if (state->volume) {
+            state->volume->FlushFAT();
+          }
+
           ReleaseHandle(request.arg0);
 
           response.status = static_cast<FileSystem::Status>(0);
@@ -858,56 +1036,7 @@ namespace Quantum::Services::FileSystems::FAT12 {
         } else {
           FileSystem::DirectoryEntry entry {};
 
-          bool found = false;
-
-          if (state->isRoot) {
-            while (state->nextIndex < volume->GetRootEntryCount()) {
-              bool end = false;
-
-              if (
-                volume->ReadRootEntry(
-                  state->nextIndex,
-                  entry,
-                  end
-                )
-              ) {
-                found = true;
-                state->nextIndex++;
-
-                break;
-              }
-
-              state->nextIndex++;
-
-              if (end) {
-                break;
-              }
-            }
-          } else {
-            for (;;) {
-              bool end = false;
-
-              if (
-                volume->ReadDirectoryEntry(
-                  state->startCluster,
-                  state->nextIndex,
-                  entry,
-                  end
-                )
-              ) {
-                found = true;
-                state->nextIndex++;
-
-                break;
-              }
-
-              state->nextIndex++;
-
-              if (end) {
-                break;
-              }
-            }
-          }
+          bool found = ReadNextEntry(*state, state->nextIndex, entry);
 
           if (found) {
             UInt32 bytes
@@ -936,20 +1065,96 @@ namespace Quantum::Services::FileSystems::FAT12 {
             }
           }
         }
-      } else if (request.op == FileSystem::Operation::Read) {
+      } else if (request.op == FileSystem::Operation::ReadDirectoryBatch) {
         HandleState* state = GetHandleState(request.arg0);
         Volume* volume = state ? state->volume : nullptr;
 
-        if (!volume || !state || !state->inUse || state->isDirectory) {
+        if (!volume || !state || !state->inUse || !state->isDirectory) {
+          response.status = static_cast<FileSystem::Status>(1);
+        } else {
+          UInt32 entryBytes
+            = static_cast<UInt32>(sizeof(FileSystem::DirectoryEntry));
+          UInt32 maxEntries = request.arg1;
+          UInt32 index = request.arg2;
+          UInt32 count = 0;
+
+          if (maxEntries > FileSystem::directoryBatchEntries) {
+            maxEntries = FileSystem::directoryBatchEntries;
+          }
+
+          // the cookie is the next entry index, so the handle's cursor lets
+          // each batch resume without rescanning
+          while (
+            index != FileSystem::directoryEndCookie
+            && count < maxEntries
+          ) {
+            FileSystem::DirectoryEntry entry {};
+
+            if (!ReadNextEntry(*state, index, entry)) {
+              index = FileSystem::directoryEndCookie;
+
+              break;
+            }
+
+            UInt8* target = response.data + count * entryBytes;
+
+            for (UInt32 i = 0; i < entryBytes; ++i) {
+              target[i] = reinterpret_cast<UInt8*>(&entry)[i];
+            }
+
+            ++count;
+          }
+
+          if (index != FileSystem::directoryEndCookie) {
+            state->nextIndex = index;
+          }
+
+          response.arg0 = count;
+          response.arg1 = index;
+          response.dataLength = count * entryBytes;
+          response.status = static_cast<FileSystem::Status>(0);
+        }
+      } else if (
+        request.op == FileSystem::Operation::Read
+        || request.op == FileSystem::Operation::ReadAt
+        || request.op == FileSystem::Operation::ReadBulk
+      ) {
+        HandleState* state = GetHandleState(request.arg0);
+        Volume* volume = state ? state->volume : nullptr;
+
+        // ReadBulk lands in a shared buffer instead of the reply
+        bool bulk = request.op == FileSystem::Operation::ReadBulk;
+        UInt8* target = response.data;
+        UInt32 targetBytes = FileSystem::messageDataBytes;
+
+        if (
+          !volume
+          || !state
+          || !state->inUse
+          || state->isDirectory
+          || (
+            bulk
+            && !MapBulkBuffer(
+              request.arg2,
+              senderId,
+              true,
+              target,
+              targetBytes
+            )
+          )
+        ) {
           response.status = static_cast<FileSystem::Status>(0);
         } else {
+          // ReadAt names its offset and leaves the handle position alone
+          bool positional = request.op == FileSystem::Operation::ReadAt;
+          UInt32 offset = positional ? request.arg2 : state->fileOffset;
           UInt32 maxBytes = request.arg1;
 
-          if (maxBytes > FileSystem::messageDataBytes) {
-            maxBytes = FileSystem::messageDataBytes;
+          if (maxBytes > targetBytes) {
+            maxBytes = targetBytes;
           }
 
-          if (maxBytes == 0 || state->fileOffset >= state->fileSize) {
+          if (maxBytes == 0 || offset >= state->fileSize) {
             response.status = static_cast<FileSystem::Status>(0);
           } else {
             UInt32 bytesRead = 0;
@@ -957,32 +1162,63 @@ namespace Quantum::Services::FileSystems::FAT12 {
             if (
               volume->ReadFile(
                 state->startCluster,
-                state->fileOffset,
-                response.data,
+                offset,
+                target,
                 maxBytes,
                 bytesRead,
-                state->fileSize
+                state->fileSize,
+                state->extents
               )
             ) {
-              state->fileOffset += bytesRead;
-              response.dataLength = bytesRead;
+              if (!positional) {
+                state->fileOffset += bytesRead;
+              }
+
+              response.dataLength = bulk ? 0 : bytesRead;
               response.status = static_cast<FileSystem::Status>(bytesRead);
             } else {
               response.status = static_cast<FileSystem::Status>(0);
             }
           }
         }
-      } else if (request.op == FileSystem::Operation::Write) {
+      } else if (
+        request.op == FileSystem::Operation::Write
+        || request.op == FileSystem::Operation::WriteAt
+        || request.op == FileSystem::Operation::WriteBulk
+      ) {
         HandleState* state = GetHandleState(request.arg0);
         Volume* volume = state ? state->volume : nullptr;
 
-        if (!volume || !state || !state->inUse || state->isDirectory) {
+        // WriteBulk takes its data from a shared buffer, sized by arg1
+        bool bulk = request.op == FileSystem::Operation::WriteBulk;
+        UInt8* source = request.data;
+        UInt32 sourceBytes = FileSystem::messageDataBytes;
+
+        if (
+          !volume
+          || !state
+          || !state->inUse
+          || state->isDirectory
+          || (
+            bulk
+            && !MapBulkBuffer(
+              request.arg2,
+              senderId,
+              false,
+              source,
+              sourceBytes
+            )
+          )
+        ) {
           response.status = static_cast<FileSystem::Status>(0);
         } else {
-          UInt32 dataBytes = request.dataLength;
+          // WriteAt names its offset and leaves the handle position alone
+          bool positional = request.op == FileSystem::Operation::WriteAt;
+          UInt32 offset = positional ? request.arg2 : state->fileOffset;
+          UInt32 dataBytes = bulk ? request.arg1 : request.dataLength;
 
-          if (dataBytes > FileSystem::messageDataBytes) {
-            dataBytes = FileSystem::messageDataBytes;
+          if (dataBytes > sourceBytes) {
+            dataBytes = sourceBytes;
           }
 
           if (dataBytes == 0) {
@@ -992,20 +1228,30 @@ namespace Quantum::Services::FileSystems::FAT12 {
             UInt32 newSize = state->fileSize;
             UInt32 startCluster = state->startCluster;
 
+            // for Write, arg2 optionally carries the expected final size
+            if (!positional && !bulk && request.arg2 != 0) {
+              state->extents.sizeHint = request.arg2;
+            }
+
             if (
               volume->WriteFileData(
                 startCluster,
-                state->fileOffset,
-                request.data,
+                offset,
+                source,
                 dataBytes,
                 bytesWritten,
                 state->fileSize,
-                newSize
+                newSize,
+                state->extents
               )
             ) {
               state->startCluster = startCluster;
               state->fileSize = newSize;
-              state->fileOffset += bytesWritten;
+
+              if (!positional) {
+                state->fileOffset += bytesWritten;
+              }
+
               response.status = static_cast<FileSystem::Status>(bytesWritten);
 
               if (state->entryLBA != 0) {
@@ -1053,6 +1299,10 @@ namespace Quantum::Services::FileSystems::FAT12 {
             state->attributes = attributes;
           }
 
+          if (!volume->CountExtents(state->startCluster, info.extentCount)) {
+            info.extentCount = 0;
+          }
+
           UInt32 bytes
             = static_cast<UInt32>(sizeof(FileSystem::FileInfo));
 
@@ -1227,20 +1477,31 @@ namespace Quantum::Services::FileSystems::FAT12 {
         }
       }
 
-      IPC::Message reply {};
+      // keep no client buffer mapped between requests
+      ReleaseBulkBuffer();
+
+      // the request has been consumed, so the reply is built in place
+      IPC::Message& reply = msg;
 
       reply.length = FileSystem::messageHeaderBytes + response.dataLength;
 
+      // never drop the request; fail it with a header-only reply instead
       if (reply.length > IPC::maxPayloadBytes) {
-        continue;
+        response.status = FileSystem::Status::Failed;
+        response.dataLength = 0;
+        reply.length = FileSystem::messageHeaderBytes;
       }
 
       for (UInt32 i = 0; i < reply.length; ++i) {
         reply.payload[i] = reinterpret_cast<UInt8*>(&response)[i];
       }
 
-      IPC::Send(replyHandle, reply);
-      IPC::CloseHandle(replyHandle);
+      if (callToken != 0) {
+        replyToken = callToken;
+      } else {
+        IPC::Send(replyHandle, reply);
+        IPC::CloseHandle(replyHandle);
+      }
     }
   }
 }
@@ -137,6 +137,14 @@ namespace Quantum::Services::FileSystems::FAT12 {
     return _info;
   }
 
+  void Volume::GetLookupStats(UInt32& outHits, UInt32& outMisses) const {
+    _directory.GetLookupStats(outHits, outMisses);
+  }
+
+  UInt32 Volume::GetDirtySectorCount() const {
+    return _fat.GetDirtyCount();
+  }
+
   FileSystem::VolumeHandle Volume::GetHandle() const {
     return _handle;
   }
@@ -186,11 +194,12 @@ namespace Quantum::Services::FileSystems::FAT12 {
   bool Volume::ReadRootEntry(
     UInt32 index,
     FileSystem::DirectoryEntry& entry,
-    bool& end
+    bool& end,
+    Directory::Cursor& cursor
   ) {
     Directory::Record record {};
 
-    if (!_directory.ReadRootRecord(index, record, end)) {
+    if (!_directory.ReadCursor(cursor, 0, true, index, record, end)) {
       return false;
     }
 
@@ -201,11 +210,14 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32 startCluster,
     UInt32 index,
     FileSystem::DirectoryEntry& entry,
-    bool& end
+    bool& end,
+    Directory::Cursor& cursor
   ) {
     Directory::Record record {};
 
-    if (!_directory.ReadRecord(startCluster, index, record, end)) {
+    if (
+      !_directory.ReadCursor(cursor, startCluster, false, index, record, end)
+    ) {
       return false;
     }
 
@@ -220,13 +232,18 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt8& outAttributes,
     UInt32& outSize
   ) {
-    return _directory.FindEntry(
+    UInt32 lba = 0;
+    UInt32 offset = 0;
+
+    return _directory.LookupEntry(
       startCluster,
       isRoot,
       name,
       outCluster,
       outAttributes,
-      outSize
+      outSize,
+      lba,
+      offset
     );
   }
 
@@ -236,7 +253,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt8* buffer,
     UInt32 length,
     UInt32& outRead,
-    UInt32 fileSize
+    UInt32 fileSize,
+    File::ExtentMap& extents
   ) {
     return _file.Read(
       startCluster,
@@ -244,7 +262,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
       buffer,
       length,
       outRead,
-      fileSize
+      fileSize,
+      extents
     );
   }
 
@@ -255,7 +274,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32 length,
     UInt32& outWritten,
     UInt32 fileSize,
-    UInt32& outSize
+    UInt32& outSize,
+    File::ExtentMap& extents
   ) {
     return _file.Write(
       startCluster,
@@ -264,7 +284,8 @@ namespace Quantum::Services::FileSystems::FAT12 {
       length,
       outWritten,
       fileSize,
-      outSize
+      outSize,
+      extents
     );
   }
 
@@ -315,13 +336,17 @@ namespace Quantum::Services::FileSystems::FAT12 {
     UInt32& outLBA,
     UInt32& outOffset
   ) {
-    Directory::Record record {};
+    UInt32 cluster = 0;
+    UInt8 attributes = 0;
+    UInt32 sizeBytes = 0;
 
-    return _directory.FindEntryLocation(
+    return _directory.LookupEntry(
       parentCluster,
       parentIsRoot,
       name,
-      record,
+      cluster,
+      attributes,
+      sizeBytes,
       outLBA,
       outOffset
     );
@@ -346,7 +371,14 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool parentIsRoot,
     CString name
   ) {
-    return _directory.CreateDirectory(parentCluster, parentIsRoot, name);
+    bool created = _directory.CreateDirectory(
+      parentCluster,
+      parentIsRoot,
+      name
+    );
+
+    // namespace changes take their cluster updates with them
+    return _fat.Flush() && created;
   }
 
   bool Volume::CreateFile(
@@ -354,7 +386,9 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool parentIsRoot,
     CString name
   ) {
-    return _directory.CreateFile(parentCluster, parentIsRoot, name);
+    bool created = _directory.CreateFile(parentCluster, parentIsRoot, name);
+
+    return _fat.Flush() && created;
   }
 
   bool Volume::RemoveEntry(
@@ -362,7 +396,9 @@ namespace Quantum::Services::FileSystems::FAT12 {
     bool parentIsRoot,
     CString name
   ) {
-    return _directory.RemoveEntry(parentCluster, parentIsRoot, name);
+    bool removed = _directory.RemoveEntry(parentCluster, parentIsRoot, name);
+
+    return _fat.Flush() && removed;
   }
 
   bool Volume::RenameEntry(
@@ -386,10 +422,77 @@ namespace Quantum::Services::FileSystems::FAT12 {
     return _fat.FindFreeCluster(outCluster);
   }
 
+  bool Volume::ReserveClusters(
+    UInt32 wanted,
+    UInt32 goal,
+    UInt32& outCluster,
+    UInt32& outLength
+  ) {
+    return _fat.ReserveRun(wanted, goal, outCluster, outLength);
+  }
+
+  void Volume::ReleaseClusters(UInt32 cluster, UInt32 length) {
+    _fat.ReleaseRun(cluster, length);
+  }
+
+  bool Volume::ClaimReservedCluster(UInt32 cluster) {
+    return _fat.ClaimReserved(cluster);
+  }
+
+  void Volume::ReleaseExtents(File::ExtentMap& extents) {
+    _file.ReleaseReservation(extents);
+  }
+
+  bool Volume::CountExtents(UInt32 startCluster, UInt32& outCount) {
+    outCount = 0;
+
+    if (startCluster == 0) {
+      return true;
+    }
+
+    UInt32 cluster = startCluster;
+    UInt32 count = 1;
+
+    // bound the walk by the cluster count so a looped chain still ends
+    for (UInt32 i = 0; i < _clusterCount; ++i) {
+      UInt32 next = 0;
+
+      if (!ReadFATEntry(cluster, next) || next < 2) {
+        return false;
+      }
+
+      if (IsEndOfChain(next)) {
+        outCount = count;
+
+        return true;
+      }
+
+      if (next != cluster + 1) {
+        ++count;
+      }
+
+      cluster = next;
+    }
+
+    return false;
+  }
+
   bool Volume::CountFreeClusters(UInt32& outCount) {
     return _fat.CountFreeClusters(outCount);
   }
 
+  bool Volume::FlushFAT() {
+    return _fat.Flush();
+  }
+
+  bool Volume::Sync() {
+    if (!_fat.Flush()) {
+      return false;
+    }
+
+    return BlockDevices::Flush(GetDeviceToken()) == 0;
+  }
+
   bool Volume::LoadFATCache() {
     return _fat.LoadCache();
   }
@@ -98,6 +98,13 @@ namespace Quantum::System::Coordinator {
         Console::Write("Failed to grant I/O access to ");
         Console::WriteLine(entry.name);
       }
+
+      // set here rather than by the driver, which could ask before the
+      // grant above and be refused
+      if (Task::SetTaskPriority(taskId, Task::highestPriority) != 0) {
+        Console::Write("Failed to raise priority of ");
+        Console::WriteLine(entry.name);
+      }
     }
 
     return true;
@@ -218,6 +225,23 @@ namespace Quantum::System::Coordinator {
     Input::Initialize();
     Devices::Initialize();
 
+    _portSet = IPC::CreatePortSet();
+
+    if (_portSet == 0) {
+      Console::WriteLine("Coordinator: failed to create port set");
+    } else {
+      UInt32 readyId = _readyHandle != 0 ? _readyHandle : _readyPortId;
+
+      if (readyId != 0 && IPC::AddToPortSet(_portSet, readyId) != 0) {
+        Console::WriteLine("Coordinator: failed to watch readiness port");
+      }
+
+      IRQ::Watch(_portSet);
+      FileSystem::Watch(_portSet);
+      Input::Watch(_portSet);
+      Devices::Watch(_portSet);
+    }
+
     InitBundle::Info info {};
 
     bool ok = InitBundle::GetInfo(info);
@@ -375,8 +399,16 @@ namespace Quantum::System::Coordinator {
         }
       }
 
+      // sleep until a watched port has work; the handlers below drain
+      // every port, so which one woke us does not matter
       if (!progressed) {
-        Task::Yield();
+        if (_portSet != 0) {
+          // wake periodically while requests are outstanding so expired
+          // ones are failed even if no port becomes ready
+          IPC::WaitAny(_portSet, FileSystem::GetWaitTicks());
+        } else {
+          Task::Yield();
+        }
       }
 
       IRQ::ProcessPending();
@@ -12,7 +12,6 @@
 #include <ABI/Devices/InputDevices.hpp>
 #include <ABI/Handle.hpp>
 #include <ABI/IPC.hpp>
-#include <ABI/Task.hpp>
 
 #include "Devices.hpp"
 
@@ -22,7 +21,6 @@ namespace Quantum::System::Coordinator {
   using ABI::Devices::InputDevices;
   using ABI::Devices::DeviceBroker;
   using ABI::IPC;
-  using ABI::Task;
 
   void Devices::Initialize() {
     if (_portId != 0) {
@@ -190,8 +188,18 @@ namespace Quantum::System::Coordinator {
       IPC::Send(replyHandle, reply);
       IPC::CloseHandle(replyHandle);
     }
+  }
 
-    Task::Yield();
+  void Devices::Watch(UInt32 portSet) {
+    if (_portId == 0) {
+      return;
+    }
+
+    UInt32 portId = _portHandle != 0 ? _portHandle : _portId;
+
+    if (IPC::AddToPortSet(portSet, portId) != 0) {
+      Console::WriteLine("Coordinator: failed to watch device broker port");
+    }
   }
 }
 
@@ -42,6 +42,20 @@ namespace Quantum::System::Coordinator {
     if (_portHandle == 0) {
       Console::WriteLine("Coordinator: failed to open file system port handle");
     }
+
+    _replyPortId = IPC::CreatePort();
+
+    if (_replyPortId == 0) {
+      Console::WriteLine("Coordinator: failed to create FS reply port");
+
+      return;
+    }
+
+    _replyPortHandle = IPC::OpenPort(
+      _replyPortId,
+      static_cast<UInt32>(IPC::Right::Receive)
+        | static_cast<UInt32>(IPC::Right::Manage)
+    );
   }
 
   FileSystem::Service* FileSystem::FindFirstService() {
@@ -199,384 +213,604 @@ namespace Quantum::System::Coordinator {
     return 0;
   }
 
-  void FileSystem::ProcessPending() {
-    if (_portId == 0) {
-      return;
+  FileSystem::InFlight* FileSystem::FindFreeInFlight() {
+    for (UInt32 i = 0; i < _maxInFlight; ++i) {
+      if (!_inFlight[i].inUse) {
+        return &_inFlight[i];
+      }
     }
 
-    UInt32 receiveId = _portHandle != 0 ? _portHandle : _portId;
+    return nullptr;
+  }
 
-    for (;;) {
-      IPC::Message msg {};
+  void FileSystem::BeginInFlight(
+    InFlight& entry,
+    const ABI::FileSystem::ServiceMessage& request,
+    UInt32 clientToken,
+    UInt32 clientReplyHandle
+  ) {
+    UInt32 requestId = _nextRequestId++;
 
-      if (IPC::TryReceive(receiveId, msg) != 0) {
-        break;
-      }
+    if (requestId == 0) {
+      requestId = _nextRequestId++;
+    }
 
-      IPC::Handle transferHandle = 0;
+    entry.inUse = true;
+    entry.requestId = requestId;
+    entry.serviceIndex = 0;
+    entry.servicePort = 0;
+    entry.clientToken = clientToken;
+    entry.clientReplyHandle = clientReplyHandle;
+    entry.userHandle = request.arg0;
+    entry.limit = 0;
+    entry.count = 0;
+    entry.deadline = Task::GetNanoseconds()
+      + static_cast<UInt64>(_inFlightTimeoutTicks) * GetTickNanoseconds();
+    entry.request = request;
+    entry.response.op = request.op;
+    entry.response.status = ABI::FileSystem::Status::Failed;
+    entry.response.replyPortId = 0;
+    entry.response.requestId = 0;
+    entry.response.arg0 = 0;
+    entry.response.arg1 = 0;
+    entry.response.arg2 = 0;
+    entry.response.dataLength = 0;
+  }
 
-      if (IPC::TryGetHandleMessage(msg, transferHandle)) {
-        StorePendingReply(msg.senderId, transferHandle);
+  bool FileSystem::SendToService(InFlight& entry, UInt32 servicePort) {
+    if (servicePort == 0 || _replyPortId == 0) {
+      return false;
+    }
+
+    IPC::Message forward {};
+
+    entry.servicePort = servicePort;
+    entry.request.replyPortId = _replyPortId;
+    entry.request.requestId = entry.requestId;
+
+    forward.length
+      = ABI::FileSystem::messageHeaderBytes + entry.request.dataLength;
+
+    for (UInt32 i = 0; i < forward.length; ++i) {
+      forward.payload[i] = reinterpret_cast<const UInt8*>(&entry.request)[i];
+    }
+
+    // a service with a full queue fails the request instead of stalling
+    // the coordinator
+    return IPC::SendNoWait(servicePort, forward) == 0;
+  }
 
+  bool FileSystem::SendToNextService(InFlight& entry, UInt32 firstIndex) {
+    for (UInt32 i = firstIndex; i < _maxServices; ++i) {
+      if (_services[i].portId == 0) {
         continue;
       }
 
+      // listings only ask each service for what is still wanted
+      if (entry.request.op == ABI::FileSystem::Operation::ListVolumes) {
+        entry.request.arg1 = entry.limit - entry.count;
+      }
+
+      entry.serviceIndex = i;
+
+      if (SendToService(entry, _services[i].portId)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void FileSystem::ProcessReplies() {
+    UInt32 receiveId = _replyPortHandle != 0 ? _replyPortHandle : _replyPortId;
+
+    if (receiveId == 0) {
+      return;
+    }
+
+    for (;;) {
+      IPC::Message msg {};
+
+      if (IPC::TryReceive(receiveId, msg) != 0) {
+        break;
+      }
+
       if (msg.length < ABI::FileSystem::messageHeaderBytes) {
         continue;
       }
 
-      ABI::FileSystem::ServiceMessage request {};
+      ABI::FileSystem::ServiceMessage serviceResponse {};
       UInt32 copyBytes = msg.length;
 
-      if (copyBytes > sizeof(request)) {
-        copyBytes = sizeof(request);
+      if (copyBytes > sizeof(serviceResponse)) {
+        copyBytes = sizeof(serviceResponse);
       }
 
       for (UInt32 i = 0; i < copyBytes; ++i) {
-        reinterpret_cast<UInt8*>(&request)[i] = msg.payload[i];
+        reinterpret_cast<UInt8*>(&serviceResponse)[i] = msg.payload[i];
       }
 
-      if (request.op == ABI::FileSystem::Operation::RegisterService) {
-        RegisterService(
-          static_cast<ABI::FileSystem::Type>(request.arg0),
-          request.arg1
-        );
+      // replies may arrive in any order across services; the echoed id
+      // names the request they answer
+      bool matched = false;
 
-        IPC::Handle replyHandle = 0;
+      for (UInt32 i = 0; i < _maxInFlight; ++i) {
+        InFlight& entry = _inFlight[i];
 
-        if (request.replyPortId != 0) {
-          replyHandle = IPC::OpenPort(request.replyPortId, static_cast<UInt32>(IPC::Right::Send));
-        } else {
-          replyHandle = TakePendingReply(msg.senderId);
+        if (entry.inUse && entry.requestId == serviceResponse.requestId) {
+          HandleServiceReply(entry, serviceResponse);
+          matched = true;
+
+          break;
         }
+      }
 
-        if (replyHandle != 0) {
-          ABI::FileSystem::ServiceMessage response {};
-          IPC::Message reply {};
+      if (!matched) {
+        HandleLateReply(serviceResponse);
+      }
+    }
+  }
 
-          response.op = request.op;
-          response.status = ABI::FileSystem::Status::Ok;
-          response.replyPortId = 0;
-          response.arg0 = 0;
-          response.arg1 = 0;
-          response.arg2 = 0;
-          response.dataLength = 0;
+  void FileSystem::HandleServiceReply(
+    InFlight& entry,
+    const ABI::FileSystem::ServiceMessage& serviceResponse
+  ) {
+    ABI::FileSystem::Operation op = entry.request.op;
+    UInt32 status = static_cast<UInt32>(serviceResponse.status);
 
-          reply.length = ABI::FileSystem::messageHeaderBytes;
+    if (op == ABI::FileSystem::Operation::ListVolumes) {
+      UInt32 entryBytes
+        = static_cast<UInt32>(sizeof(ABI::FileSystem::VolumeEntry));
+      UInt32 entries = serviceResponse.dataLength / entryBytes;
 
-          for (UInt32 i = 0; i < reply.length; ++i) {
-            reply.payload[i] = reinterpret_cast<UInt8*>(&response)[i];
-          }
+      for (UInt32 j = 0; j < entries && entry.count < entry.limit; ++j) {
+        UInt32 destOffset = entry.count * entryBytes;
+        UInt32 srcOffset = j * entryBytes;
 
-          IPC::Send(replyHandle, reply);
-          IPC::CloseHandle(replyHandle);
+        for (UInt32 k = 0; k < entryBytes; ++k) {
+          entry.response.data[destOffset + k]
+            = serviceResponse.data[srcOffset + k];
         }
 
-        continue;
+        ++entry.count;
       }
 
-      ABI::FileSystem::Operation op = request.op;
-      IPC::Handle clientReplyHandle = 0;
+      if (
+        entry.count < entry.limit
+        && SendToNextService(entry, entry.serviceIndex + 1)
+      ) {
+        return;
+      }
 
-      if (request.replyPortId != 0) {
-        clientReplyHandle = IPC::OpenPort(request.replyPortId, static_cast<UInt32>(IPC::Right::Send));
-      } else {
-        clientReplyHandle = TakePendingReply(msg.senderId);
+      entry.response.status
+        = static_cast<ABI::FileSystem::Status>(entry.count);
+      entry.response.dataLength = entry.count * entryBytes;
+
+      CompleteInFlight(entry);
+
+      return;
+    }
+
+    if (op == ABI::FileSystem::Operation::OpenVolume) {
+      if (status != 0) {
+        UInt32 servicePort = entry.servicePort;
+        ABI::FileSystem::Handle serviceHandle
+          = static_cast<ABI::FileSystem::Handle>(status);
+        ABI::FileSystem::Handle handle
+          = AllocateHandle(servicePort, serviceHandle, true);
+
+        entry.response.status = static_cast<ABI::FileSystem::Status>(handle);
+
+        // a client that gave up never learns the handle; close it again
+        if (!CompleteInFlight(entry) || handle == 0) {
+          ReleaseHandle(handle);
+          CloseOrphan(servicePort, op, serviceHandle);
+        }
+
+        return;
       }
 
-      if (clientReplyHandle == 0) {
-        continue;
+      // this service does not know the volume; ask the next one
+      if (SendToNextService(entry, entry.serviceIndex + 1)) {
+        return;
       }
 
-      ABI::FileSystem::ServiceMessage response {};
+      entry.response.status = static_cast<ABI::FileSystem::Status>(0);
 
-      response.op = request.op;
-      response.status = ABI::FileSystem::Status::Failed;
-      response.replyPortId = 0;
-      response.arg0 = 0;
-      response.arg1 = 0;
-      response.arg2 = 0;
-      response.dataLength = 0;
+      CompleteInFlight(entry);
 
-      auto sendReply = [&]() {
-        IPC::Message reply {};
+      return;
+    }
 
-        reply.length
-          = ABI::FileSystem::messageHeaderBytes + response.dataLength;
+    entry.response = serviceResponse;
+    entry.response.requestId = 0;
 
-        if (reply.length > IPC::maxPayloadBytes) {
-          reply.length = ABI::FileSystem::messageHeaderBytes;
-          response.dataLength = 0;
-        }
+    if (status != 0 && op == ABI::FileSystem::Operation::Open) {
+      UInt32 servicePort = entry.servicePort;
+      ABI::FileSystem::Handle serviceHandle
+        = static_cast<ABI::FileSystem::Handle>(status);
+      ABI::FileSystem::Handle handle
+        = AllocateHandle(servicePort, serviceHandle, false);
 
-        for (UInt32 i = 0; i < reply.length; ++i) {
-          reply.payload[i] = reinterpret_cast<UInt8*>(&response)[i];
-        }
+      entry.response.status = static_cast<ABI::FileSystem::Status>(handle);
 
-        if (clientReplyHandle != 0) {
-          IPC::Send(clientReplyHandle, reply);
-          IPC::CloseHandle(clientReplyHandle);
-          clientReplyHandle = 0;
-        }
-      };
+      // hand the client the owning service so data operations on the
+      // file can go to it directly instead of through this relay
+      entry.response.arg0 = handle != 0 ? servicePort : 0;
+      entry.response.arg1 = handle != 0 ? serviceHandle : 0;
 
-      if (op == ABI::FileSystem::Operation::ListVolumes) {
-        UInt32 entryBytes
-          = static_cast<UInt32>(sizeof(ABI::FileSystem::VolumeEntry));
-        UInt32 maxEntries = request.arg1;
-        UInt32 maxPayloadEntries = entryBytes == 0
-          ? 0
-          : (ABI::FileSystem::messageDataBytes / entryBytes);
-        UInt32 remaining = maxEntries;
-
-        if (maxPayloadEntries < remaining) {
-          remaining = maxPayloadEntries;
-        }
+      // a client that gave up never learns the handle; close it again
+      if (!CompleteInFlight(entry) || handle == 0) {
+        ReleaseHandle(handle);
+        CloseOrphan(servicePort, op, serviceHandle);
+      }
 
-        UInt32 count = 0;
+      return;
+    }
 
-        for (UInt32 i = 0; i < _maxServices && remaining > 0; ++i) {
-          if (_services[i].portId == 0) {
-            continue;
-          }
+    if (
+      status == 0 && (
+        op == ABI::FileSystem::Operation::Close
+        || op == ABI::FileSystem::Operation::CloseVolume
+      )
+    ) {
+      ReleaseHandle(entry.userHandle);
+    }
 
-          UInt32 replyPortId = IPC::CreatePort();
+    CompleteInFlight(entry);
+  }
 
-          if (replyPortId == 0) {
-            continue;
-          }
+  bool FileSystem::CompleteInFlight(InFlight& entry) {
+    bool delivered = SendReply(
+      entry.clientToken,
+      entry.clientReplyHandle,
+      entry.response
+    );
 
-          IPC::Handle replyHandle = IPC::OpenPort(
-            replyPortId,
-            static_cast<UInt32>(IPC::Right::Receive) | static_cast<UInt32>(IPC::Right::Manage) | static_cast<UInt32>(IPC::Right::Send)
-          );
+    entry.inUse = false;
+    entry.requestId = 0;
+    entry.clientToken = 0;
+    entry.clientReplyHandle = 0;
+    entry.deadline = 0;
 
-          if (replyHandle == 0) {
-            IPC::DestroyPort(replyPortId);
+    return delivered;
+  }
 
-            continue;
-          }
+  void FileSystem::ExpireInFlight() {
+    UInt64 now = Task::GetNanoseconds();
 
-          ABI::FileSystem::ServiceMessage serviceRequest = request;
+    for (UInt32 i = 0; i < _maxInFlight; ++i) {
+      InFlight& entry = _inFlight[i];
 
-          serviceRequest.replyPortId = 0;
-          serviceRequest.arg1 = remaining;
+      if (!entry.inUse || entry.deadline == 0 || now < entry.deadline) {
+        continue;
+      }
 
-          IPC::Message forward {};
+      ABI::FileSystem::Operation op = entry.request.op;
 
-          forward.length
-            = ABI::FileSystem::messageHeaderBytes + serviceRequest.dataLength;
+      // fan-out requests keep what earlier services answered; a late reply
+      // no longer matches the freed request id and is dropped
+      if (op == ABI::FileSystem::Operation::ListVolumes) {
+        entry.response.status
+          = static_cast<ABI::FileSystem::Status>(entry.count);
+        entry.response.dataLength = entry.count
+          * static_cast<UInt32>(sizeof(ABI::FileSystem::VolumeEntry));
+      } else if (op == ABI::FileSystem::Operation::OpenVolume) {
+        entry.response.status = static_cast<ABI::FileSystem::Status>(0);
+      } else if (op == ABI::FileSystem::Operation::Open) {
+        entry.response.status = static_cast<ABI::FileSystem::Status>(0);
+        entry.response.dataLength = 0;
+      } else {
+        entry.response.status = ABI::FileSystem::Status::Failed;
+        entry.response.dataLength = 0;
+      }
 
-          for (UInt32 j = 0; j < forward.length; ++j) {
-            forward.payload[j]
-              = reinterpret_cast<UInt8*>(&serviceRequest)[j];
-          }
+      // the open may still succeed later; remember it so the handle a late
+      // reply carries gets closed
+      if (
+        op == ABI::FileSystem::Operation::Open
+        || op == ABI::FileSystem::Operation::OpenVolume
+      ) {
+        Expired& expired = _expired[_nextExpired];
 
-          IPC::Handle serviceHandle = IPC::OpenPort(
-            _services[i].portId,
-            static_cast<UInt32>(IPC::Right::Send)
-          );
+        expired.requestId = entry.requestId;
+        expired.op = op;
+        expired.servicePort = entry.servicePort;
 
-          if (serviceHandle == 0) {
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+        _nextExpired = (_nextExpired + 1) % _maxExpired;
+      }
 
-            continue;
-          }
+      Console::WriteLine("Coordinator: file system request timed out");
 
-          if (IPC::SendHandle(
-            serviceHandle,
-            replyHandle,
-            static_cast<UInt32>(IPC::Right::Send)
-          ) != 0) {
-            IPC::CloseHandle(serviceHandle);
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+      CompleteInFlight(entry);
+    }
+  }
 
-            continue;
-          }
+  void FileSystem::HandleLateReply(
+    const ABI::FileSystem::ServiceMessage& serviceResponse
+  ) {
+    if (serviceResponse.requestId == 0) {
+      return;
+    }
 
-          if (IPC::Send(serviceHandle, forward) != 0) {
-            IPC::CloseHandle(serviceHandle);
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+    for (UInt32 i = 0; i < _maxExpired; ++i) {
+      Expired& expired = _expired[i];
 
-            continue;
-          }
+      if (expired.requestId != serviceResponse.requestId) {
+        continue;
+      }
 
-          IPC::CloseHandle(serviceHandle);
+      UInt32 status = static_cast<UInt32>(serviceResponse.status);
 
-          IPC::Message serviceReply {};
+      expired.requestId = 0;
 
-          if (IPC::Receive(replyHandle, serviceReply) != 0) {
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+      if (status != 0) {
+        CloseOrphan(
+          expired.servicePort,
+          expired.op,
+          static_cast<ABI::FileSystem::Handle>(status)
+        );
+      }
 
-            continue;
-          }
+      return;
+    }
+  }
 
-          ABI::FileSystem::ServiceMessage serviceResponse {};
-          UInt32 serviceBytes = serviceReply.length;
+  void FileSystem::CloseOrphan(
+    UInt32 servicePort,
+    ABI::FileSystem::Operation openOp,
+    ABI::FileSystem::Handle serviceHandle
+  ) {
+    if (servicePort == 0 || serviceHandle == 0) {
+      return;
+    }
 
-          if (serviceBytes > sizeof(serviceResponse)) {
-            serviceBytes = sizeof(serviceResponse);
-          }
+    ABI::FileSystem::ServiceMessage request {};
+    IPC::Message msg {};
 
-          for (UInt32 j = 0; j < serviceBytes; ++j) {
-            reinterpret_cast<UInt8*>(&serviceResponse)[j]
-              = serviceReply.payload[j];
-          }
+    request.op = openOp == ABI::FileSystem::Operation::OpenVolume
+      ? ABI::FileSystem::Operation::CloseVolume
+      : ABI::FileSystem::Operation::Close;
+    request.replyPortId = _replyPortId;
+    request.requestId = 0;
+    request.arg0 = serviceHandle;
+    request.dataLength = 0;
 
-          UInt32 availableBytes = serviceResponse.dataLength;
-          UInt32 entries = entryBytes == 0 ? 0 : (availableBytes / entryBytes);
+    msg.length = ABI::FileSystem::messageHeaderBytes;
 
-          for (UInt32 j = 0; j < entries && remaining > 0; ++j) {
-            UInt32 destOffset = count * entryBytes;
-            UInt32 srcOffset = j * entryBytes;
+    for (UInt32 i = 0; i < msg.length; ++i) {
+      msg.payload[i] = reinterpret_cast<UInt8*>(&request)[i];
+    }
 
-            for (UInt32 k = 0; k < entryBytes; ++k) {
-              response.data[destOffset + k]
-                = serviceResponse.data[srcOffset + k];
-            }
+    if (IPC::SendNoWait(servicePort, msg) != 0) {
+      Console::WriteLine("Coordinator: failed to close orphaned handle");
+    }
+  }
 
-            ++count;
-            --remaining;
-          }
+  UInt32 FileSystem::GetTickNanoseconds() {
+    UInt32 hz = Task::GetTickRate();
 
-          IPC::DestroyPort(replyHandle);
-          IPC::CloseHandle(replyHandle);
-        }
+    return 1000000000 / (hz != 0 ? hz : _defaultTickRate);
+  }
 
-        response.status = static_cast<ABI::FileSystem::Status>(count);
-        response.dataLength = count * entryBytes;
+  UInt32 FileSystem::GetWaitTicks() {
+    UInt64 now = Task::GetNanoseconds();
+    UInt64 earliest = 0;
 
-        sendReply();
+    for (UInt32 i = 0; i < _maxInFlight; ++i) {
+      const InFlight& entry = _inFlight[i];
 
-        continue;
+      if (
+        entry.inUse
+        && entry.deadline != 0
+        && (earliest == 0 || entry.deadline < earliest)
+      ) {
+        earliest = entry.deadline;
       }
+    }
 
-      if (op == ABI::FileSystem::Operation::OpenVolume) {
-        response.status = static_cast<ABI::FileSystem::Status>(0);
+    if (earliest == 0) {
+      return 0;
+    }
 
-        for (UInt32 i = 0; i < _maxServices; ++i) {
-          if (_services[i].portId == 0) {
-            continue;
-          }
+    if (earliest <= now) {
+      return 1;
+    }
 
-          UInt32 replyPortId = IPC::CreatePort();
+    // deadlines lie at most `_inFlightTimeoutTicks` ahead, so the
+    // remainder fits in 32 bits
+    UInt64 remaining = earliest - now;
+    UInt32 tickNanoseconds = GetTickNanoseconds();
 
-          if (replyPortId == 0) {
-            continue;
-          }
+    if (remaining > 0xFFFFFFFFULL) {
+      return _inFlightTimeoutTicks;
+    }
 
-          IPC::Handle replyHandle = IPC::OpenPort(
-            replyPortId,
-            static_cast<UInt32>(IPC::Right::Receive) | static_cast<UInt32>(IPC::Right::Manage) | static_cast<UInt32>(IPC::Right::Send)
-          );
+    return static_cast<UInt32>(remaining) / tickNanoseconds + 1;
+  }
 
-          if (replyHandle == 0) {
-            IPC::DestroyPort(replyPortId);
+  bool FileSystem::SendReply(
+    UInt32 clientToken,
+    UInt32 clientReplyHandle,
+    ABI::FileSystem::ServiceMessage& response
+  ) {
+    IPC::Message reply {};
 
-            continue;
-          }
+    reply.length = ABI::FileSystem::messageHeaderBytes + response.dataLength;
 
-          ABI::FileSystem::ServiceMessage serviceRequest = request;
+    if (reply.length > IPC::maxPayloadBytes) {
+      reply.length = ABI::FileSystem::messageHeaderBytes;
+      response.dataLength = 0;
+    }
 
-          serviceRequest.replyPortId = 0;
+    for (UInt32 i = 0; i < reply.length; ++i) {
+      reply.payload[i] = reinterpret_cast<UInt8*>(&response)[i];
+    }
 
-          IPC::Message forward {};
+    if (clientToken != 0) {
+      // fails once the client stopped waiting and its token went stale
+      return IPC::Reply(clientToken, reply) == 0;
+    }
 
-          forward.length
-            = ABI::FileSystem::messageHeaderBytes + serviceRequest.dataLength;
+    if (clientReplyHandle != 0) {
+      // the reply port belongs to the client; never wait on it
+      bool sent = IPC::SendNoWait(clientReplyHandle, reply) == 0;
 
-          for (UInt32 j = 0; j < forward.length; ++j) {
-            forward.payload[j]
-              = reinterpret_cast<UInt8*>(&serviceRequest)[j];
-          }
+      IPC::CloseHandle(clientReplyHandle);
 
-          IPC::Handle serviceHandle = IPC::OpenPort(
-            _services[i].portId,
-            static_cast<UInt32>(IPC::Right::Send)
-          );
+      return sent;
+    }
 
-          if (serviceHandle == 0) {
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+    return false;
+  }
 
-            continue;
-          }
+  void FileSystem::ProcessPending() {
+    if (_portId == 0) {
+      return;
+    }
 
-          if (
-            IPC::SendHandle(
-              serviceHandle,
-              replyHandle,
-              static_cast<UInt32>(IPC::Right::Send)
-            ) != 0
-          ) {
-            IPC::CloseHandle(serviceHandle);
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+    ProcessReplies();
+    ExpireInFlight();
 
-            continue;
-          }
+    UInt32 receiveId = _portHandle != 0 ? _portHandle : _portId;
 
-          if (IPC::Send(serviceHandle, forward) != 0) {
-            IPC::CloseHandle(serviceHandle);
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+    if (_portSet != 0 && !_brokerWatched && FindFreeInFlight()) {
+      _brokerWatched = IPC::AddToPortSet(_portSet, receiveId) == 0;
+    }
 
-            continue;
-          }
+    for (;;) {
+      // leave further requests queued until a service reply frees an entry
+      InFlight* entry = FindFreeInFlight();
 
-          IPC::CloseHandle(serviceHandle);
+      if (!entry) {
+        // queued requests would keep the port set ready; stop watching the
+        // broker port until a reply frees an entry
+        if (_brokerWatched) {
+          IPC::RemoveFromPortSet(_portSet, receiveId);
 
-          IPC::Message serviceReply {};
+          _brokerWatched = false;
+        }
 
-          if (IPC::Receive(replyHandle, serviceReply) != 0) {
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+        break;
+      }
+
+      IPC::Message msg {};
+
+      if (IPC::TryReceive(receiveId, msg) != 0) {
+        break;
+      }
 
-            continue;
+      IPC::Handle transferHandle = 0;
+
+      if (IPC::TryGetHandleMessage(msg, transferHandle)) {
+        StorePendingReply(msg.senderId, transferHandle);
+
+        continue;
+      }
+
+      if (msg.length < ABI::FileSystem::messageHeaderBytes) {
+        continue;
+      }
+
+      ABI::FileSystem::ServiceMessage request {};
+      UInt32 copyBytes = msg.length;
+
+      if (copyBytes > sizeof(request)) {
+        copyBytes = sizeof(request);
+      }
+
+      for (UInt32 i = 0; i < copyBytes; ++i) {
+        reinterpret_cast<UInt8*>(&request)[i] = msg.payload[i];
+      }
+
+      if (request.op == ABI::FileSystem::Operation::RegisterService) {
+        RegisterService(
+          static_cast<ABI::FileSystem::Type>(request.arg0),
+          request.arg1
+        );
+
+        IPC::Handle replyHandle = 0;
+
+        // callers using IPC::Call are answered through their reply token;
+        // the reply port and handle transfer paths remain for older clients
+        if (msg.replyToken == 0) {
+          if (request.replyPortId != 0) {
+            replyHandle = IPC::OpenPort(request.replyPortId, static_cast<UInt32>(IPC::Right::Send));
+          } else {
+            replyHandle = TakePendingReply(msg.senderId);
           }
+        }
 
-          ABI::FileSystem::ServiceMessage serviceResponse {};
-          UInt32 serviceBytes = serviceReply.length;
+        if (replyHandle != 0 || msg.replyToken != 0) {
+          ABI::FileSystem::ServiceMessage response {};
+          IPC::Message reply {};
 
-          if (serviceBytes > sizeof(serviceResponse)) {
-            serviceBytes = sizeof(serviceResponse);
+          response.op = request.op;
+          response.status = ABI::FileSystem::Status::Ok;
+          response.replyPortId = 0;
+          response.arg0 = 0;
+          response.arg1 = 0;
+          response.arg2 = 0;
+          response.dataLength = 0;
+
+          reply.length = ABI::FileSystem::messageHeaderBytes;
+
+          for (UInt32 i = 0; i < reply.length; ++i) {
+            reply.payload[i] = reinterpret_cast<UInt8*>(&response)[i];
           }
 
-          for (UInt32 j = 0; j < serviceBytes; ++j) {
-            reinterpret_cast<UInt8*>(&serviceResponse)[j]
-              = serviceReply.payload[j];
+          if (msg.replyToken != 0) {
+            IPC::Reply(msg.replyToken, reply);
+          } else {
+            IPC::Send(replyHandle, reply);
+            IPC::CloseHandle(replyHandle);
           }
+        }
 
-          if (static_cast<UInt32>(serviceResponse.status) != 0) {
-            ABI::FileSystem::Handle handle = AllocateHandle(
-              _services[i].portId,
-              static_cast<ABI::FileSystem::Handle>(
-                static_cast<UInt32>(serviceResponse.status)
-              ),
-              true
-            );
+        continue;
+      }
 
-            response.status = static_cast<ABI::FileSystem::Status>(handle);
-            response.dataLength = 0;
+      ABI::FileSystem::Operation op = request.op;
+      UInt32 clientReplyToken = msg.replyToken;
+      IPC::Handle clientReplyHandle = 0;
 
-            IPC::DestroyPort(replyHandle);
-            IPC::CloseHandle(replyHandle);
+      if (clientReplyToken == 0) {
+        if (request.replyPortId != 0) {
+          clientReplyHandle = IPC::OpenPort(request.replyPortId, static_cast<UInt32>(IPC::Right::Send));
+        } else {
+          clientReplyHandle = TakePendingReply(msg.senderId);
+        }
 
-            sendReply();
+        if (clientReplyHandle == 0) {
+          continue;
+        }
+      }
 
-            break;
-          }
+      BeginInFlight(*entry, request, clientReplyToken, clientReplyHandle);
+
+      if (op == ABI::FileSystem::Operation::ListVolumes) {
+        UInt32 entryBytes
+          = static_cast<UInt32>(sizeof(ABI::FileSystem::VolumeEntry));
+        UInt32 maxPayloadEntries
+          = ABI::FileSystem::messageDataBytes / entryBytes;
 
-          IPC::DestroyPort(replyHandle);
-          IPC::CloseHandle(replyHandle);
+        entry->limit = request.arg1 < maxPayloadEntries
+          ? request.arg1
+          : maxPayloadEntries;
+        entry->response.status = static_cast<ABI::FileSystem::Status>(0);
+
+        if (entry->limit == 0 || !SendToNextService(*entry, 0)) {
+          CompleteInFlight(*entry);
         }
 
-        if (static_cast<UInt32>(response.status) == 0) {
-          sendReply();
+        continue;
+      }
+
+      if (op == ABI::FileSystem::Operation::OpenVolume) {
+        entry->response.status = static_cast<ABI::FileSystem::Status>(0);
+
+        if (!SendToNextService(*entry, 0)) {
+          CompleteInFlight(*entry);
         }
 
         continue;
@@ -593,7 +827,8 @@ namespace Quantum::System::Coordinator {
         case ABI::FileSystem::Operation::CreateDirectory:
         case ABI::FileSystem::Operation::CreateFile:
         case ABI::FileSystem::Operation::Remove:
-        case ABI::FileSystem::Operation::Rename: {
+        case ABI::FileSystem::Operation::Rename:
+        case ABI::FileSystem::Operation::Sync: {
           expectVolumeHandle = true;
 
           break;
@@ -601,8 +836,13 @@ namespace Quantum::System::Coordinator {
 
         case ABI::FileSystem::Operation::Close:
         case ABI::FileSystem::Operation::ReadDirectory:
+        case ABI::FileSystem::Operation::ReadDirectoryBatch:
         case ABI::FileSystem::Operation::Read:
         case ABI::FileSystem::Operation::Write:
+        case ABI::FileSystem::Operation::ReadAt:
+        case ABI::FileSystem::Operation::WriteAt:
+        case ABI::FileSystem::Operation::ReadBulk:
+        case ABI::FileSystem::Operation::WriteBulk:
         case ABI::FileSystem::Operation::Stat:
         case ABI::FileSystem::Operation::Seek: {
           expectFileHandle = true;
@@ -624,11 +864,10 @@ namespace Quantum::System::Coordinator {
       }
 
       UInt32 servicePort = 0;
-      ABI::FileSystem::Handle serviceHandle = 0;
 
       if (mapped) {
         servicePort = mapped->servicePort;
-        serviceHandle = mapped->serviceHandle;
+        entry->request.arg0 = mapped->serviceHandle;
       } else if (!expectVolumeHandle && !expectFileHandle) {
         Service* first = FindFirstService();
 
@@ -637,162 +876,31 @@ namespace Quantum::System::Coordinator {
         }
       }
 
-      if (servicePort == 0) {
-        sendReply();
-
-        continue;
-      }
-
-      UInt32 replyPortId = IPC::CreatePort();
-
-      if (replyPortId == 0) {
-        sendReply();
-
-        continue;
-      }
-
-      ABI::FileSystem::ServiceMessage serviceRequest = request;
-
-      serviceRequest.replyPortId = 0;
-
-      if (mapped) {
-        serviceRequest.arg0 = serviceHandle;
-      }
-
-      IPC::Message forward {};
-
-      forward.length
-        = ABI::FileSystem::messageHeaderBytes + serviceRequest.dataLength;
-
-      for (UInt32 i = 0; i < forward.length; ++i) {
-        forward.payload[i] = reinterpret_cast<UInt8*>(&serviceRequest)[i];
-      }
-
-      IPC::Handle replyHandle = IPC::OpenPort(
-        replyPortId,
-        static_cast<UInt32>(IPC::Right::Receive) | static_cast<UInt32>(IPC::Right::Manage) | static_cast<UInt32>(IPC::Right::Send)
-      );
-
-      if (replyHandle == 0) {
-        IPC::DestroyPort(replyPortId);
-
-        sendReply();
-
-        continue;
-      }
-
-      IPC::Handle serviceSendHandle = IPC::OpenPort(
-        servicePort,
-        static_cast<UInt32>(IPC::Right::Send)
-      );
-
-      if (serviceSendHandle == 0) {
-        IPC::DestroyPort(replyHandle);
-        IPC::CloseHandle(replyHandle);
-
-        sendReply();
-
-        continue;
-      }
-
-      if (
-        IPC::SendHandle(
-          serviceSendHandle,
-          replyHandle,
-          static_cast<UInt32>(IPC::Right::Send)
-        ) != 0
-      ) {
-        IPC::CloseHandle(serviceSendHandle);
-        IPC::DestroyPort(replyHandle);
-        IPC::CloseHandle(replyHandle);
-
-        sendReply();
-
-        continue;
-      }
-
-      if (IPC::Send(serviceSendHandle, forward) != 0) {
-        IPC::CloseHandle(serviceSendHandle);
-        IPC::DestroyPort(replyHandle);
-        IPC::CloseHandle(replyHandle);
-
-        sendReply();
-
-        continue;
-      }
-
-      IPC::CloseHandle(serviceSendHandle);
-
-      IPC::Message serviceReply {};
-
-      if (IPC::Receive(replyHandle, serviceReply) != 0) {
-        IPC::DestroyPort(replyHandle);
-        IPC::CloseHandle(replyHandle);
-
-        sendReply();
-
-        continue;
-      }
-
-      UInt32 serviceBytes = serviceReply.length;
-
-      if (serviceBytes > sizeof(response)) {
-        serviceBytes = sizeof(response);
-      }
-
-      for (UInt32 i = 0; i < serviceBytes; ++i) {
-        reinterpret_cast<UInt8*>(&response)[i] = serviceReply.payload[i];
+      // the reply is matched later in ProcessReplies; keep taking requests
+      if (!SendToService(*entry, servicePort)) {
+        CompleteInFlight(*entry);
       }
+    }
+  }
 
-      IPC::DestroyPort(replyHandle);
-      IPC::CloseHandle(replyHandle);
+  void FileSystem::Watch(UInt32 portSet) {
+    if (_portId == 0) {
+      return;
+    }
 
-      if (
-        static_cast<UInt32>(response.status) != 0
-        && op == ABI::FileSystem::Operation::Open
-      ) {
-        ABI::FileSystem::Handle handle = AllocateHandle(
-          servicePort,
-          static_cast<ABI::FileSystem::Handle>(
-            static_cast<UInt32>(response.status)
-          ),
-          false
-        );
+    UInt32 replyId = _replyPortHandle != 0 ? _replyPortHandle : _replyPortId;
+    UInt32 receiveId = _portHandle != 0 ? _portHandle : _portId;
 
-        response.status = static_cast<ABI::FileSystem::Status>(handle);
-      } else if (
-        static_cast<UInt32>(response.status) == 0 && (
-          op == ABI::FileSystem::Operation::Close
-          || op == ABI::FileSystem::Operation::CloseVolume
-        )
-      ) {
-        ReleaseHandle(request.arg0);
-      }
+    _portSet = portSet;
 
-      // if (op == ABI::FileSystem::Operation::Open) {
-      //   if (response.status != 0) {
-      //     ABI::FileSystem::Handle handle = AllocateHandle(
-      //       servicePort,
-      //       static_cast<ABI::FileSystem::Handle>(response.status),
-      //       false
-      //     );
+    if (replyId != 0 && IPC::AddToPortSet(portSet, replyId) != 0) {
+      Console::WriteLine("Coordinator: failed to watch FS reply port");
+    }
 
-      //     response.status = handle;
-      //   }
-      // } else if (op == ABI::FileSystem::Operation::Close) {
-      //   if (response.status == 0) {
-      //     ReleaseHandle(request.arg0);
-      //   }
-      // } else if (op == ABI::FileSystem::Operation::CloseVolume) {
-      //   if (response.status == 0) {
-      //     ReleaseHandle(request.arg0);
-      //   }
-      // }
+    _brokerWatched = IPC::AddToPortSet(portSet, receiveId) == 0;
 
-      sendReply();
+    if (!_brokerWatched) {
+      Console::WriteLine("Coordinator: failed to watch file system port");
     }
-
-    Task::Yield();
   }
 }
-
@@ -10,14 +10,12 @@
 #include <ABI/Handle.hpp>
 #include <ABI/IPC.hpp>
 #include <ABI/IRQ.hpp>
-#include <ABI/Task.hpp>
 
 #include "IRQ.hpp"
 
 namespace Quantum::System::Coordinator {
   using ABI::Console;
   using ABI::IPC;
-  using ABI::Task;
 
   void IRQ::Initialize() {
     if (_portId != 0) {
@@ -187,8 +185,18 @@ namespace Quantum::System::Coordinator {
         IPC::CloseHandle(replyHandle);
       }
     }
+  }
 
-    Task::Yield();
+  void IRQ::Watch(UInt32 portSet) {
+    if (_portId == 0) {
+      return;
+    }
+
+    UInt32 portId = _portHandle != 0 ? _portHandle : _portId;
+
+    if (IPC::AddToPortSet(portSet, portId) != 0) {
+      Console::WriteLine("Coordinator: failed to watch IRQ routing port");
+    }
   }
 }
 
@@ -78,6 +78,11 @@ namespace Quantum::System::Coordinator {
        */
       inline static UInt32 _readyHandle = 0;
 
+      /**
+       * Port set the coordinator sleeps on between rounds of work.
+       */
+      inline static UInt32 _portSet = 0;
+
       /**
        * Maximum INIT.BND entries to process.
        */
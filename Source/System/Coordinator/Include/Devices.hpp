@@ -26,6 +26,13 @@ namespace Quantum::System::Coordinator {
        */
       static void ProcessPending();
 
+      /**
+       * Attaches the device broker port to the coordinator port set.
+       * @param portSet
+       *   Port set handle to attach to.
+       */
+      static void Watch(UInt32 portSet);
+
     private:
       /**
        * Device broker port id.
@@ -27,6 +27,22 @@ namespace Quantum::System::Coordinator {
        */
       static void ProcessPending();
 
+      /**
+       * Attaches the broker and service reply ports to the coordinator port
+       * set.
+       * @param portSet
+       *   Port set handle to attach to.
+       */
+      static void Watch(UInt32 portSet);
+
+      /**
+       * Returns how long the coordinator may sleep before outstanding
+       * requests need to be checked for expiry.
+       * @return
+       *   Timeout in ticks, or 0 if nothing is outstanding.
+       */
+      static UInt32 GetWaitTicks();
+
     private:
       /**
        * File system service descriptor.
@@ -56,6 +72,26 @@ namespace Quantum::System::Coordinator {
        */
       inline static UInt32 _portHandle = 0;
 
+      /**
+       * Port id that services reply to forwarded requests on.
+       */
+      inline static UInt32 _replyPortId = 0;
+
+      /**
+       * Receive handle for the service reply port.
+       */
+      inline static UInt32 _replyPortHandle = 0;
+
+      /**
+       * Coordinator port set the broker ports are attached to.
+       */
+      inline static UInt32 _portSet = 0;
+
+      /**
+       * Whether the broker port is currently attached to `_portSet`.
+       */
+      inline static bool _brokerWatched = false;
+
       /**
        * Registered file system services.
        */
@@ -101,6 +137,138 @@ namespace Quantum::System::Coordinator {
        */
       inline static HandleMap _handles[_maxHandles] = {};
 
+      /**
+       * Request forwarded to a service and awaiting its reply.
+       */
+      struct InFlight {
+        /**
+         * Whether the entry is active.
+         */
+        bool inUse;
+
+        /**
+         * Broker request id echoed by the service.
+         */
+        UInt32 requestId;
+
+        /**
+         * Index of the service the request was last sent to.
+         */
+        UInt32 serviceIndex;
+
+        /**
+         * Port of the service the request was last sent to.
+         */
+        UInt32 servicePort;
+
+        /**
+         * Client reply token (0 when replying through a handle).
+         */
+        UInt32 clientToken;
+
+        /**
+         * Client reply handle for clients not using IPC::Call.
+         */
+        UInt32 clientReplyHandle;
+
+        /**
+         * Coordinator handle named by the client request.
+         */
+        ABI::FileSystem::Handle userHandle;
+
+        /**
+         * Entry limit for volume listings.
+         */
+        UInt32 limit;
+
+        /**
+         * Entries gathered so far for volume listings.
+         */
+        UInt32 count;
+
+        /**
+         * Time, in nanoseconds, after which the request is failed back to
+         * the client. Set once per client request, however many services
+         * it visits.
+         */
+        UInt64 deadline;
+
+        /**
+         * Request as sent to the service.
+         */
+        ABI::FileSystem::ServiceMessage request;
+
+        /**
+         * Reply being built for the client.
+         */
+        ABI::FileSystem::ServiceMessage response;
+      };
+
+      /**
+       * Maximum number of requests outstanding at the services. Kept below
+       * the IPC queue depth so forwarding never blocks on a full port.
+       */
+      static constexpr UInt32 _maxInFlight = 8;
+
+      /**
+       * How long the services may take to answer one client request. Half
+       * the client's default timeout, so an expired request is failed while
+       * the client is still waiting for the answer.
+       */
+      static constexpr UInt32 _inFlightTimeoutTicks
+        = ABI::FileSystem::requestTimeoutTicks / 2;
+
+      /**
+       * Tick rate assumed if the kernel does not report one.
+       */
+      static constexpr UInt32 _defaultTickRate = 100;
+
+      /**
+       * Open request that expired before its service answered. A late
+       * successful reply names a service handle nobody will close.
+       */
+      struct Expired {
+        /**
+         * Broker request id of the expired request (0 = unused).
+         */
+        UInt32 requestId;
+
+        /**
+         * Operation of the expired request.
+         */
+        ABI::FileSystem::Operation op;
+
+        /**
+         * Port of the service the request was last sent to.
+         */
+        UInt32 servicePort;
+      };
+
+      /**
+       * Number of expired open requests remembered.
+       */
+      static constexpr UInt32 _maxExpired = 8;
+
+      /**
+       * Expired open requests whose replies may still arrive.
+       */
+      inline static Expired _expired[_maxExpired] = {};
+
+      /**
+       * Next slot of `_expired` to overwrite.
+       */
+      inline static UInt32 _nextExpired = 0;
+
+      /**
+       * Outstanding forwarded requests.
+       */
+      inline static InFlight _inFlight[_maxInFlight] = {};
+
+      /**
+       * Next broker request id.
+       */
+      inline static UInt32 _nextRequestId = 1;
+
       /**
        * Pending reply handles awaiting a request.
        */
@@ -200,5 +368,135 @@ namespace Quantum::System::Coordinator {
        *   Coordinator-visible handle.
        */
       static void ReleaseHandle(ABI::FileSystem::Handle userHandle);
+
+      /**
+       * Finds a free in-flight entry without claiming it.
+       * @return
+       *   Free entry, or `nullptr` if every entry is busy.
+       */
+      static InFlight* FindFreeInFlight();
+
+      /**
+       * Claims an in-flight entry for a client request.
+       * @param entry
+       *   Free entry from FindFreeInFlight.
+       * @param request
+       *   Client request.
+       * @param clientToken
+       *   Client reply token.
+       * @param clientReplyHandle
+       *   Client reply handle.
+       */
+      static void BeginInFlight(
+        InFlight& entry,
+        const ABI::FileSystem::ServiceMessage& request,
+        UInt32 clientToken,
+        UInt32 clientReplyHandle
+      );
+
+      /**
+       * Sends an in-flight request to a service without waiting.
+       * @param entry
+       *   In-flight entry holding the request.
+       * @param servicePort
+       *   Service port id.
+       * @return
+       *   True if the request was queued at the service.
+       */
+      static bool SendToService(InFlight& entry, UInt32 servicePort);
+
+      /**
+       * Sends an in-flight request to the next registered service at or
+       * after an index, for requests that fan out across services.
+       * @param entry
+       *   In-flight entry holding the request.
+       * @param firstIndex
+       *   First service index to try.
+       * @return
+       *   True if some service accepted the request.
+       */
+      static bool SendToNextService(InFlight& entry, UInt32 firstIndex);
+
+      /**
+       * Drains service replies and advances their in-flight requests.
+       */
+      static void ProcessReplies();
+
+      /**
+       * Advances an in-flight request with a service reply.
+       * @param entry
+       *   Matching in-flight entry.
+       * @param serviceResponse
+       *   Reply from the service.
+       */
+      static void HandleServiceReply(
+        InFlight& entry,
+        const ABI::FileSystem::ServiceMessage& serviceResponse
+      );
+
+      /**
+       * Answers the client of an in-flight request and frees the entry.
+       * @param entry
+       *   Entry to complete.
+       * @return
+       *   True if the reply reached the client.
+       */
+      static bool CompleteInFlight(InFlight& entry);
+
+      /**
+       * Fails in-flight requests whose services missed the deadline, so a
+       * dead or silent service cannot hold entries forever.
+       */
+      static void ExpireInFlight();
+
+      /**
+       * Handles a service reply that matches no in-flight request, closing
+       * the handle a late open reply carries.
+       * @param serviceResponse
+       *   Reply from the service.
+       */
+      static void HandleLateReply(
+        const ABI::FileSystem::ServiceMessage& serviceResponse
+      );
+
+      /**
+       * Asks a service to close a handle that no client will ever learn.
+       * The service's answer matches no request and is dropped.
+       * @param servicePort
+       *   Port of the service owning the handle.
+       * @param openOp
+       *   Operation that opened the handle (Open or OpenVolume).
+       * @param serviceHandle
+       *   Service-local handle to close.
+       */
+      static void CloseOrphan(
+        UInt32 servicePort,
+        ABI::FileSystem::Operation openOp,
+        ABI::FileSystem::Handle serviceHandle
+      );
+
+      /**
+       * Returns the length of one timer tick.
+       * @return
+       *   Nanoseconds per tick.
+       */
+      static UInt32 GetTickNanoseconds();
+
+      /**
+       * Sends a reply to a client.
+       * @param clientToken
+       *   Client reply token, or 0 to use the reply handle.
+       * @param clientReplyHandle
+       *   Client reply handle; closed after sending.
+       * @param response
+       *   Reply to send.
+       * @return
+       *   True if the reply was delivered.
+       */
+      static bool SendReply(
+        UInt32 clientToken,
+        UInt32 clientReplyHandle,
+        ABI::FileSystem::ServiceMessage& response
+      );
   };
 }
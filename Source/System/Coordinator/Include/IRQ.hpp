@@ -27,6 +27,13 @@ namespace Quantum::System::Coordinator {
        */
       static void ProcessPending();
 
+      /**
+       * Attaches the IRQ routing port to the coordinator port set.
+       * @param portSet
+       *   Port set handle to attach to.
+       */
+      static void Watch(UInt32 portSet);
+
     private:
       /**
        * IRQ routing port id.
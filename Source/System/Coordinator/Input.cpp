@@ -11,7 +11,6 @@
 #include <ABI/Input.hpp>
 #include <ABI/IPC.hpp>
 #include <Bytes.hpp>
-#include <ABI/Task.hpp>
 
 #include "Input.hpp"
 
@@ -19,7 +18,6 @@ namespace Quantum::System::Coordinator {
   using ABI::Console;
   using ABI::Devices::InputDevices;
   using ABI::IPC;
-  using ABI::Task;
 
   void Input::Initialize() {
     if (_portId != 0) {
@@ -188,8 +186,18 @@ namespace Quantum::System::Coordinator {
         }
       }
     }
+  }
 
-    Task::Yield();
+  void Input::Watch(UInt32 portSet) {
+    if (_portId == 0) {
+      return;
+    }
+
+    UInt32 portId = _portHandle != 0 ? _portHandle : _portId;
+
+    if (IPC::AddToPortSet(portSet, portId) != 0) {
+      Console::WriteLine("Coordinator: failed to watch input broker port");
+    }
   }
 }
 
@@ -13,6 +13,7 @@
 #include "Arch/IA32/MemoryMap.hpp"
 #include "Arch/IA32/Paging.hpp"
 #include "Arch/IA32/PhysicalAllocator.hpp"
+#include "Arch/IA32/SMP.hpp"
 #include "Panic.hpp"
 
 namespace Quantum::System::Kernel::Arch::IA32 {
@@ -149,6 +150,7 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       | (writable ? Paging::pageWrite : 0)
       | (user ? Paging::pageUser : 0)
       | (global ? Paging::pageGlobal : 0);
+    bool replaced = (table[pageTableIndex] & Paging::pagePresent) != 0;
 
     table[pageTableIndex] = (physicalAddress & ~0xFFFu) | flags;
 
@@ -156,7 +158,9 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       directory[pageDirectoryIndex] |= Paging::pageUser;
     }
 
-    if (
+    if (replaced) {
+      SMP::InvalidatePage(virtualAddress);
+    } else if (
       pageDirectoryPhysicalAddress
         == Paging::GetKernelPageDirectoryPhysicalAddress()
     ) {
@@ -164,6 +168,32 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     }
   }
 
+  void AddressSpace::UnmapPage(
+    UInt32 pageDirectoryPhysicalAddress,
+    UInt32 virtualAddress
+  ) {
+    if (pageDirectoryPhysicalAddress == 0) {
+      return;
+    }
+
+    UInt32* directory = reinterpret_cast<UInt32*>(pageDirectoryPhysicalAddress);
+    UInt32 pageDirectoryIndex = (virtualAddress >> 22) & 0x3FF;
+    UInt32 pageTableIndex = (virtualAddress >> 12) & 0x3FF;
+    UInt32 entry = directory[pageDirectoryIndex];
+
+    if ((entry & Paging::pagePresent) == 0) {
+      return;
+    }
+
+    UInt32* table = reinterpret_cast<UInt32*>(entry & ~0xFFFu);
+
+    table[pageTableIndex] = 0;
+
+    // other processors may be running threads of the same task, and invlpg
+    // on an address a TLB does not hold is harmless
+    SMP::InvalidatePage(virtualAddress);
+  }
+
   void AddressSpace::Activate(UInt32 pageDirectoryPhysicalAddress) {
     if (pageDirectoryPhysicalAddress == 0) {
       return;
@@ -73,6 +73,31 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     asm volatile("sti" ::: "memory");
   }
 
+  UInt32 CPU::SaveAndDisableInterrupts() {
+    UInt32 flags = 0;
+
+    asm volatile(
+      "pushf\n"
+      "pop %0\n"
+      "cli\n"
+      : "=r"(flags)
+      :
+      : "memory"
+    );
+
+    return flags;
+  }
+
+  void CPU::RestoreInterrupts(UInt32 flags) {
+    asm volatile(
+      "push %0\n"
+      "popf\n"
+      :
+      : "r"(flags)
+      : "memory"
+    );
+  }
+
   void CPU::LoadPageDirectory(UInt32 physicalAddress) {
     asm volatile("mov %0, %%cr3" :: "r"(physicalAddress) : "memory");
   }
@@ -95,6 +120,31 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     asm volatile("pause");
   }
 
+  UInt64 CPU::ReadTSC() {
+    UInt32 low = 0;
+    UInt32 high = 0;
+
+    asm volatile("rdtsc" : "=a"(low), "=d"(high));
+
+    return (static_cast<UInt64>(high) << 32) | low;
+  }
+
+  UInt64 CPU::ReadMSR(UInt32 index) {
+    UInt32 low = 0;
+    UInt32 high = 0;
+
+    asm volatile("rdmsr" : "=a"(low), "=d"(high) : "c"(index));
+
+    return (static_cast<UInt64>(high) << 32) | low;
+  }
+
+  void CPU::WriteMSR(UInt32 index, UInt64 value) {
+    UInt32 low = static_cast<UInt32>(value);
+    UInt32 high = static_cast<UInt32>(value >> 32);
+
+    asm volatile("wrmsr" :: "a"(low), "d"(high), "c"(index) : "memory");
+  }
+
   CPU::Info CPU::GetInfo() {
     Info info = {};
 
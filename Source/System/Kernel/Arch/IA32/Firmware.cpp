@@ -0,0 +1,284 @@
+/**
+ * @file System/Kernel/Arch/IA32/Firmware.cpp
+ * @brief IA32 firmware table (ACPI and MP) parsing.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <Align.hpp>
+#include <Types.hpp>
+
+#include "Arch/IA32/Firmware.hpp"
+#include "Arch/IA32/MemoryMap.hpp"
+#include "Arch/IA32/Paging.hpp"
+#include "Logger.hpp"
+
+namespace Quantum::System::Kernel::Arch::IA32 {
+  using ::Quantum::AlignDown;
+  using ::Quantum::AlignUp;
+
+  using LogLevel = Kernel::Logger::Level;
+
+  const UInt8* Firmware::Map(UInt32 physicalAddress, UInt32 length) {
+    UInt32 start = AlignDown(physicalAddress, MemoryMap::pageSize);
+    UInt32 end = AlignUp(physicalAddress + length, MemoryMap::pageSize);
+
+    if (end - start > MemoryMap::firmwareWindowBytes - _windowUsed) {
+      return nullptr;
+    }
+
+    UInt32 virtualBase = MemoryMap::firmwareWindowBase + _windowUsed;
+    UInt32 bytes = end - start;
+
+    for (UInt32 offset = 0; offset < bytes; offset += MemoryMap::pageSize) {
+      Paging::MapPage(virtualBase + offset, start + offset, false);
+    }
+
+    _windowUsed += bytes;
+
+    return reinterpret_cast<const UInt8*>(
+      virtualBase + (physicalAddress - start)
+    );
+  }
+
+  bool Firmware::Checksum(const UInt8* bytes, UInt32 length) {
+    UInt8 sum = 0;
+
+    for (UInt32 i = 0; i < length; ++i) {
+      sum = static_cast<UInt8>(sum + bytes[i]);
+    }
+
+    return sum == 0;
+  }
+
+  bool Firmware::Matches(
+    const UInt8* bytes,
+    const char* signature,
+    UInt32 length
+  ) {
+    for (UInt32 i = 0; i < length; ++i) {
+      if (bytes[i] != static_cast<UInt8>(signature[i])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  UInt16 Firmware::Read16(const UInt8* bytes) {
+    return static_cast<UInt16>(bytes[0] | (bytes[1] << 8));
+  }
+
+  UInt32 Firmware::Read32(const UInt8* bytes) {
+    return static_cast<UInt32>(bytes[0])
+      | (static_cast<UInt32>(bytes[1]) << 8)
+      | (static_cast<UInt32>(bytes[2]) << 16)
+      | (static_cast<UInt32>(bytes[3]) << 24);
+  }
+
+  const UInt8* Firmware::Scan(
+    UInt32 physicalAddress,
+    UInt32 length,
+    const char* signature,
+    UInt32 signatureLength,
+    UInt32 checksumLength
+  ) {
+    const UInt8* area = Map(physicalAddress, length);
+
+    if (area == nullptr) {
+      return nullptr;
+    }
+
+    for (UInt32 offset = 0; offset + checksumLength <= length; offset += 16) {
+      const UInt8* candidate = area + offset;
+
+      if (
+        Matches(candidate, signature, signatureLength)
+        && Checksum(candidate, checksumLength)
+      ) {
+        return candidate;
+      }
+    }
+
+    return nullptr;
+  }
+
+  const UInt8* Firmware::MapTable(
+    UInt32 physicalAddress,
+    const char* signature
+  ) {
+    const UInt8* header = Map(physicalAddress, _acpiHeaderBytes);
+
+    if (header == nullptr || !Matches(header, signature, 4)) {
+      return nullptr;
+    }
+
+    UInt32 length = Read32(header + 4);
+
+    if (length < _acpiHeaderBytes) {
+      return nullptr;
+    }
+
+    const UInt8* table = Map(physicalAddress, length);
+
+    if (table == nullptr || !Checksum(table, length)) {
+      return nullptr;
+    }
+
+    return table;
+  }
+
+  void Firmware::AddProcessor(SMP::Topology& topology, UInt8 apicId) {
+    if (topology.count < SMP::maxProcessors) {
+      topology.apicIds[topology.count++] = apicId;
+    }
+  }
+
+  bool Firmware::FindFromACPI(SMP::Topology& topology) {
+    // the EBDA segment pointer lives in page 0, which stays unmapped to
+    // catch null dereferences, so only the usual EBDA location is scanned
+    const UInt8* rsdp = Scan(_ebdaBase, _ebdaBytes, "RSD PTR ", 8, 20);
+
+    if (rsdp == nullptr) {
+      rsdp = Scan(_biosBase, _biosBytes, "RSD PTR ", 8, 20);
+    }
+
+    if (rsdp == nullptr) {
+      return false;
+    }
+
+    const UInt8* rsdt = MapTable(Read32(rsdp + 16), "RSDT");
+
+    if (rsdt == nullptr) {
+      return false;
+    }
+
+    UInt32 entries = (Read32(rsdt + 4) - _acpiHeaderBytes) / 4;
+
+    for (UInt32 i = 0; i < entries; ++i) {
+      UInt32 address = Read32(rsdt + _acpiHeaderBytes + i * 4);
+      const UInt8* header = Map(address, _acpiHeaderBytes);
+
+      if (header == nullptr || !Matches(header, "APIC", 4)) {
+        continue;
+      }
+
+      const UInt8* madt = MapTable(address, "APIC");
+
+      if (madt == nullptr) {
+        return false;
+      }
+
+      UInt32 length = Read32(madt + 4);
+      UInt32 offset = 44;
+
+      topology.localAPICPhysical = Read32(madt + 36);
+      topology.count = 0;
+
+      while (offset + 2 <= length) {
+        UInt8 type = madt[offset];
+        UInt8 entryLength = madt[offset + 1];
+
+        if (entryLength < 2 || offset + entryLength > length) {
+          break;
+        }
+
+        // processor local APIC: ACPI id, APIC id, flags (bit 0 = enabled)
+        if (type == 0 && entryLength >= 8) {
+          if ((Read32(madt + offset + 4) & 1) != 0) {
+            AddProcessor(topology, madt[offset + 3]);
+          }
+        }
+
+        offset += entryLength;
+      }
+
+      return topology.count > 0;
+    }
+
+    return false;
+  }
+
+  bool Firmware::FindFromMP(SMP::Topology& topology) {
+    const UInt8* floating = Scan(_ebdaBase, _ebdaBytes, "_MP_", 4, 16);
+
+    if (floating == nullptr) {
+      floating = Scan(_biosBase, _biosBytes, "_MP_", 4, 16);
+    }
+
+    if (floating == nullptr) {
+      return false;
+    }
+
+    topology.count = 0;
+
+    // a default configuration has no table: two processors, ids 0 and 1
+    if (floating[11] != 0) {
+      topology.localAPICPhysical = _defaultLocalAPIC;
+
+      AddProcessor(topology, 0);
+      AddProcessor(topology, 1);
+
+      return true;
+    }
+
+    UInt32 address = Read32(floating + 4);
+
+    if (address == 0) {
+      return false;
+    }
+
+    const UInt8* header = Map(address, 44);
+
+    if (header == nullptr || !Matches(header, "PCMP", 4)) {
+      return false;
+    }
+
+    UInt32 length = Read16(header + 4);
+    const UInt8* table = Map(address, length);
+
+    if (table == nullptr || !Checksum(table, length)) {
+      return false;
+    }
+
+    UInt32 entryCount = Read16(table + 34);
+    UInt32 offset = 44;
+
+    topology.localAPICPhysical = Read32(table + 36);
+
+    for (UInt32 i = 0; i < entryCount && offset < length; ++i) {
+      // processor entries are 20 bytes, every other kind is 8
+      if (table[offset] == 0) {
+        if ((table[offset + 3] & 1) != 0) {
+          AddProcessor(topology, table[offset + 1]);
+        }
+
+        offset += 20;
+      } else {
+        offset += 8;
+      }
+    }
+
+    return topology.count > 0;
+  }
+
+  bool Firmware::FindProcessors(SMP::Topology& topology) {
+    topology.localAPICPhysical = 0;
+    topology.count = 0;
+
+    if (FindFromACPI(topology)) {
+      Logger::Write(LogLevel::Debug, "Firmware: processors from ACPI MADT");
+
+      return true;
+    }
+
+    if (FindFromMP(topology)) {
+      Logger::Write(LogLevel::Debug, "Firmware: processors from MP table");
+
+      return true;
+    }
+
+    return false;
+  }
+}
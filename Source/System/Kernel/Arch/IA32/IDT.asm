@@ -59,8 +59,14 @@ global IRQ12
 global IRQ13
 global IRQ14
 global IRQ15
+global ISR240
+global ISR241
+global ISR242
+global ISR243
+global ISR255
 global SYSCALL80
 extern IDTExceptionHandler
+extern IDTContextSwitched
 
 ; void LoadIDT(IDT::Descriptor* desc);
 LoadIDT:
@@ -74,7 +80,9 @@ LoadIDT:
 ; ISR_NOERR creates a stub for interrupts without a hardware error code.
 ; ISR_ERR  creates a stub for interrupts that push a hardware error code.
 ; Both build a consistent stack frame and pass a pointer to it to
-; IDTExceptionHandler(Interrupts::Context*).
+; IDTExceptionHandler(Interrupts::Context*). After a switch to another
+; thread's context, IDTContextSwitched runs on the new stack to release the
+; scheduler lock held across the switch.
 ;------------------------------------------------------------------------------
 %macro ISR_NOERR 2
 %1:
@@ -86,7 +94,10 @@ LoadIDT:
   add esp, 4            ; pop arg
   test eax, eax         ; swap to returned context if provided
   jz .%1_no_swap
+  cmp eax, esp
+  je .%1_no_swap
   mov esp, eax
+  call IDTContextSwitched
 .%1_no_swap:
   popa
   add esp, 8            ; drop vector + error
@@ -166,6 +177,15 @@ ISR_NOERR IRQ15, 47   ; Secondary ATA
 ;------------------------------------------------------------------------------
 ISR_NOERR SYSCALL80, 128
 
+;------------------------------------------------------------------------------
+; Local APIC vectors
+;------------------------------------------------------------------------------
+ISR_NOERR ISR240, 240 ; Yield
+ISR_NOERR ISR241, 241 ; Reschedule IPI
+ISR_NOERR ISR242, 242 ; TLB shootdown IPI
+ISR_NOERR ISR243, 243 ; Local APIC timer
+ISR_NOERR ISR255, 255 ; Local APIC spurious
+
 .hang:
   hlt
   jmp .hang
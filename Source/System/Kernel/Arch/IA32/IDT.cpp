@@ -9,7 +9,9 @@
 #include "Arch/IA32/CPU.hpp"
 #include "Arch/IA32/IDT.hpp"
 #include "Arch/IA32/Interrupts.hpp"
+#include "Arch/IA32/LocalAPIC.hpp"
 #include "Arch/IA32/PIC.hpp"
+#include "Arch/IA32/Thread.hpp"
 #include "Logger.hpp"
 #include "Prelude.hpp"
 
@@ -64,6 +66,11 @@ namespace Quantum::System::Kernel::Arch::IA32 {
   extern "C" void IRQ13();
   extern "C" void IRQ14();
   extern "C" void IRQ15();
+  extern "C" void ISR240();
+  extern "C" void ISR241();
+  extern "C" void ISR242();
+  extern "C" void ISR243();
+  extern "C" void ISR255();
   extern "C" void LoadIDT(IDT::Descriptor*);
 
   void (*const IDT::_exceptionStubs[IDT::_exceptionCount])() = {
@@ -84,6 +91,10 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     IRQ12, IRQ13, IRQ14, IRQ15
   };
 
+  void (*const IDT::_localStubs[IDT::_localVectorCount])() = {
+    ISR240, ISR241, ISR242, ISR243
+  };
+
   void IDT::SetGate(UInt8 vector, void (*stub)(), UInt8 typeAttribute) {
     UInt32 addr = reinterpret_cast<UInt32>(stub);
     IDT::Entry& e = _idtEntries[vector];
@@ -110,21 +121,37 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       IDT::SetGate(_irqBase + i, _irqStubs[i], 0x8E);
     }
 
+    for (UInt8 i = 0; i < _localVectorCount; ++i) {
+      IDT::SetGate(yieldVector + i, _localStubs[i], 0x8E);
+    }
+
+    IDT::SetGate(spuriousVector, ISR255, 0x8E);
+
     _idtDescriptor.limit = sizeof(_idtEntries) - 1;
     _idtDescriptor.base = reinterpret_cast<UInt32>(&_idtEntries[0]);
 
-    LoadIDT(&_idtDescriptor);
+    Load();
 
     PIC::Initialize(_irqBase, _irqBase + 8);
     PIC::MaskAll();
   }
 
+  void IDT::Load() {
+    LoadIDT(&_idtDescriptor);
+  }
+
   void IDT::SetHandler(UInt8 vector, Interrupts::Handler handler) {
     _handlerTable[vector] = handler;
   }
 
   Interrupts::Context* IDT::DispatchInterrupt(Interrupts::Context* ctx) {
     UInt8 vector = static_cast<UInt8>(ctx->vector);
+
+    // the APIC expects no EOI for its spurious vector
+    if (vector == spuriousVector) {
+      return ctx;
+    }
+
     bool isIRQ = vector >= _irqBase && vector < (_irqBase + _irqCount);
     bool spurious
       = !_handlerTable[vector] && (
@@ -149,11 +176,17 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
     if (isIRQ) {
       PIC::SendEOI(vector - _irqBase);
+    } else if (vector > yieldVector && vector <= localTimerVector) {
+      LocalAPIC::EndOfInterrupt();
     }
 
     return nextContext;
   }
 
+  extern "C" void IDTContextSwitched() {
+    Thread::FinishSwitch();
+  }
+
   extern "C" Interrupts::Context* IDTExceptionHandler(Interrupts::Context* ctx) {
     return IDT::DispatchInterrupt(ctx);
   }
@@ -0,0 +1,127 @@
+/**
+ * @file System/Kernel/Arch/IA32/LocalAPIC.cpp
+ * @brief IA32 local APIC driver.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <Types.hpp>
+
+#include "Arch/IA32/CPU.hpp"
+#include "Arch/IA32/IDT.hpp"
+#include "Arch/IA32/LocalAPIC.hpp"
+#include "Arch/IA32/MemoryMap.hpp"
+#include "Arch/IA32/Paging.hpp"
+#include "Arch/IA32/Timer.hpp"
+
+namespace Quantum::System::Kernel::Arch::IA32 {
+  UInt32 LocalAPIC::Read(UInt32 offset) {
+    return *reinterpret_cast<volatile UInt32*>(
+      MemoryMap::localAPICBase + offset
+    );
+  }
+
+  void LocalAPIC::Write(UInt32 offset, UInt32 value) {
+    *reinterpret_cast<volatile UInt32*>(
+      MemoryMap::localAPICBase + offset
+    ) = value;
+  }
+
+  void LocalAPIC::Initialize(UInt32 physicalAddress) {
+    // global so the mapping survives every address space switch
+    Paging::MapPage(
+      MemoryMap::localAPICBase,
+      physicalAddress,
+      true,
+      false,
+      true,
+      true
+    );
+
+    if (CPU::GetInfo().hasMSR) {
+      UInt64 base = CPU::ReadMSR(_baseMSR);
+
+      CPU::WriteMSR(_baseMSR, base | _baseMSREnable);
+    }
+  }
+
+  void LocalAPIC::Enable(bool bootstrap) {
+    // the PIC keeps delivering legacy IRQs to the bootstrap processor
+    if (bootstrap) {
+      Write(_registerLVTLINT0, 0x700); // ExtINT
+      Write(_registerLVTLINT1, 0x400); // NMI
+    } else {
+      Write(_registerLVTLINT0, _lvtMasked);
+      Write(_registerLVTLINT1, _lvtMasked);
+    }
+
+    Write(_registerLVTTimer, _lvtMasked);
+    Write(_registerLVTError, _lvtMasked);
+    Write(_registerTaskPriority, 0);
+    Write(_registerSpurious, 0x100 | IDT::spuriousVector);
+  }
+
+  UInt8 LocalAPIC::GetId() {
+    return static_cast<UInt8>(Read(_registerId) >> 24);
+  }
+
+  void LocalAPIC::EndOfInterrupt() {
+    Write(_registerEOI, 0);
+  }
+
+  void LocalAPIC::SendCommand(UInt8 apicId, UInt32 command) {
+    // an interrupt between the two writes could send its own IPI with our
+    // destination half-written
+    UInt32 flags = CPU::SaveAndDisableInterrupts();
+
+    Write(_registerICRHigh, static_cast<UInt32>(apicId) << 24);
+    Write(_registerICRLow, command);
+
+    while ((Read(_registerICRLow) & _icrPending) != 0) {
+      CPU::Pause();
+    }
+
+    CPU::RestoreInterrupts(flags);
+  }
+
+  void LocalAPIC::SendIPI(UInt8 apicId, UInt8 vector) {
+    SendCommand(apicId, 0x4000 | vector); // fixed, assert
+  }
+
+  void LocalAPIC::SendInit(UInt8 apicId) {
+    SendCommand(apicId, 0x4500); // INIT, assert
+  }
+
+  void LocalAPIC::SendStartup(UInt8 apicId, UInt8 page) {
+    SendCommand(apicId, 0x4600 | page); // startup, assert
+  }
+
+  void LocalAPIC::CalibrateTimer() {
+    Write(_registerTimerDivide, _timerDivideBy16);
+    Write(_registerLVTTimer, _lvtMasked | IDT::localTimerVector);
+
+    UInt64 start = Timer::Now();
+    UInt64 tick = Timer::TicksToCounts(1);
+
+    Write(_registerTimerInitial, 0xFFFFFFFF);
+
+    while (Timer::Now() - start < tick) {
+      CPU::Pause();
+    }
+
+    _countsPerTick = 0xFFFFFFFF - Read(_registerTimerCurrent);
+
+    Write(_registerTimerInitial, 0);
+  }
+
+  void LocalAPIC::ArmTimer(UInt32 ticks) {
+    Write(_registerTimerDivide, _timerDivideBy16);
+    Write(_registerLVTTimer, IDT::localTimerVector); // one-shot
+    Write(_registerTimerInitial, _countsPerTick * ticks);
+  }
+
+  void LocalAPIC::DisarmTimer() {
+    Write(_registerTimerInitial, 0);
+  }
+}
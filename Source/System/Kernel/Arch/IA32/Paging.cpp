@@ -14,6 +14,7 @@
 #include "Arch/IA32/MemoryMap.hpp"
 #include "Arch/IA32/Paging.hpp"
 #include "Arch/IA32/PhysicalAllocator.hpp"
+#include "Arch/IA32/SMP.hpp"
 #include "Heap.hpp"
 #include "Logger.hpp"
 #include "Task.hpp"
@@ -158,7 +159,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     UInt32 physicalAddress,
     bool writable,
     bool user,
-    bool global
+    bool global,
+    bool cacheDisable
   ) {
     UInt32 pageDirectoryIndex = (virtualAddress >> 22) & 0x3FF;
     UInt32 pageTableIndex = (virtualAddress >> 12) & 0x3FF;
@@ -166,7 +168,9 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     UInt32 flags = pagePresent
       | (writable ? pageWrite : 0)
       | (user ? pageUser : 0)
-      | (global ? pageGlobal : 0);
+      | (global ? pageGlobal : 0)
+      | (cacheDisable ? pageCacheDisable : 0);
+    bool replaced = (table[pageTableIndex] & pagePresent) != 0;
 
     table[pageTableIndex] = (physicalAddress & ~0xFFF) | flags;
 
@@ -174,7 +178,12 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       _pageDirectory[pageDirectoryIndex] |= pageUser;
     }
 
-    CPU::InvalidatePage(virtualAddress);
+    // only a mapping that was present can be cached by other processors
+    if (replaced) {
+      SMP::InvalidatePage(virtualAddress);
+    } else {
+      CPU::InvalidatePage(virtualAddress);
+    }
   }
 
   void Paging::UnmapPage(UInt32 virtualAddress) {
@@ -191,7 +200,7 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
     table[pageTableIndex] = 0;
 
-    CPU::InvalidatePage(virtualAddress);
+    SMP::InvalidatePage(virtualAddress);
   }
 
   void Paging::MapRange(
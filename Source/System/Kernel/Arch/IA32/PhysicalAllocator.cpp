@@ -17,6 +17,7 @@
 #include "Logger.hpp"
 #include "Panic.hpp"
 #include "Prelude.hpp"
+#include "Sync/ScopedIRQLock.hpp"
 
 namespace Quantum::System::Kernel::Arch::IA32 {
   using ::Quantum::AlignDown;
@@ -307,6 +308,13 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       }
     }
 
+    // reserve the page application processors start from
+    UInt32 startupPage = MemoryMap::processorStartupPhysical / pageSize;
+
+    if (startupPage < _pageCount) {
+      SetPageUsed(startupPage);
+    }
+
     // if nothing was free (bogus map), fall back to freeing everything except
     // reserved
     if (freePages == 0) {
@@ -361,6 +369,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
   }
 
   UInt32 PhysicalAllocator::AllocatePage(bool zero) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     UInt32 words = _bitmapLengthWords;
 
     for (UInt32 wordIndex = 0; wordIndex < words; ++wordIndex) {
@@ -429,6 +439,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       return 0;
     }
 
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     UInt32 maxPage = maxPhysicalAddress / pageSize;
 
     if (maxPage > _pageCount) {
@@ -467,6 +479,78 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     return 0;
   }
 
+  UInt32 PhysicalAllocator::AllocateContiguousBelow(
+    UInt32 maxPhysicalAddress,
+    UInt32 pageCount,
+    bool zero,
+    UInt32 boundaryBytes
+  ) {
+    if (maxPhysicalAddress == 0 || pageCount == 0) {
+      return 0;
+    }
+
+    UInt32 rangeBytes = pageCount * pageSize;
+
+    if (boundaryBytes != 0 && rangeBytes > boundaryBytes) {
+      return 0;
+    }
+
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    UInt32 maxPage = maxPhysicalAddress / pageSize;
+
+    if (maxPage > _pageCount) {
+      maxPage = _pageCount;
+    }
+
+    UInt32 pageIndex = 0;
+
+    while (pageIndex + pageCount <= maxPage) {
+      UInt32 physical = pageIndex * pageSize;
+
+      if (boundaryBytes != 0) {
+        UInt32 offset = physical % boundaryBytes;
+
+        if (offset + rangeBytes > boundaryBytes) {
+          // skip straight to the next boundary
+          pageIndex += (boundaryBytes - offset) / pageSize;
+
+          continue;
+        }
+      }
+
+      UInt32 run = 0;
+
+      while (run < pageCount && PageFree(pageIndex + run)) {
+        ++run;
+      }
+
+      if (run < pageCount) {
+        pageIndex += run + 1;
+
+        continue;
+      }
+
+      for (UInt32 i = 0; i < pageCount; ++i) {
+        SetPageUsed(pageIndex + i);
+      }
+
+      _usedPages += pageCount;
+
+      if (zero) {
+        UInt8* memory = reinterpret_cast<UInt8*>(physical);
+
+        for (UInt32 b = 0; b < rangeBytes; ++b) {
+          memory[b] = 0;
+        }
+      }
+
+      return physical;
+    }
+
+    return 0;
+  }
+
   void PhysicalAllocator::FreePage(UInt32 physicalAddress) {
     if (physicalAddress % pageSize != 0) {
       Logger::Write(LogLevel::Warning, "FreePage: non-aligned address");
@@ -480,6 +564,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       return;
     }
 
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     if (PageFree(index)) {
       Logger::Write(LogLevel::Warning, "FreePage: double free detected");
       return;
@@ -501,6 +587,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     UInt32 startPage = start / pageSize;
     UInt32 endPage = end / pageSize;
 
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     if (endPage > _pageCount) {
       endPage = _pageCount;
     }
@@ -523,6 +611,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     UInt32 startPage = start / pageSize;
     UInt32 endPage = end / pageSize;
 
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     if (endPage > _pageCount) {
       endPage = _pageCount;
     }
@@ -0,0 +1,273 @@
+/**
+ * @file System/Kernel/Arch/IA32/SMP.cpp
+ * @brief IA32 multiprocessor bring-up and inter-processor interrupts.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <Types.hpp>
+
+#include "Arch/IA32/CPU.hpp"
+#include "Arch/IA32/Firmware.hpp"
+#include "Arch/IA32/IDT.hpp"
+#include "Arch/IA32/LocalAPIC.hpp"
+#include "Arch/IA32/MemoryMap.hpp"
+#include "Arch/IA32/Paging.hpp"
+#include "Arch/IA32/SMP.hpp"
+#include "Arch/IA32/TSS.hpp"
+#include "Arch/IA32/Thread.hpp"
+#include "Arch/IA32/Timer.hpp"
+#include "Logger.hpp"
+
+/**
+ * Start of the real-mode startup trampoline provided by assembly.
+ */
+extern "C" UInt8 SMPTrampolineStart[];
+
+/**
+ * Data block patched before each startup IPI.
+ */
+extern "C" UInt8 SMPTrampolineData[];
+
+/**
+ * End of the startup trampoline.
+ */
+extern "C" UInt8 SMPTrampolineEnd[];
+
+namespace Quantum::System::Kernel::Arch::IA32 {
+  using LogLevel = Kernel::Logger::Level;
+
+  void SMP::Initialize() {
+    _onlineMask.Store(1);
+    _processorCount = 1;
+
+    if (!CPU::GetInfo().hasAPIC) {
+      Logger::Write(LogLevel::Info, "SMP: no local APIC, one processor");
+
+      return;
+    }
+
+    Topology topology {};
+
+    if (
+      !Firmware::FindProcessors(topology)
+      || topology.localAPICPhysical == 0
+    ) {
+      Logger::Write(LogLevel::Info, "SMP: no processor tables, one processor");
+
+      return;
+    }
+
+    LocalAPIC::Initialize(topology.localAPICPhysical);
+    LocalAPIC::Enable(true);
+    LocalAPIC::CalibrateTimer();
+
+    UInt8 bootstrapId = LocalAPIC::GetId();
+
+    _apicIds[0] = bootstrapId;
+
+    Interrupts::RegisterHandler(IDT::invalidateVector, InvalidateHandler);
+
+    // the trampoline is the same for every processor; only its data block
+    // changes between startups
+    UInt8* target
+      = reinterpret_cast<UInt8*>(MemoryMap::processorStartupPhysical);
+    UInt32 size = static_cast<UInt32>(SMPTrampolineEnd - SMPTrampolineStart);
+
+    for (UInt32 i = 0; i < size; ++i) {
+      target[i] = SMPTrampolineStart[i];
+    }
+
+    UInt32 index = 1;
+
+    for (UInt32 i = 0; i < topology.count && index < maxProcessors; ++i) {
+      UInt8 apicId = topology.apicIds[i];
+
+      if (apicId == bootstrapId) {
+        continue;
+      }
+
+      if (!StartProcessor(index, apicId)) {
+        Logger::WriteFormatted(
+          LogLevel::Warning,
+          "SMP: processor with APIC id %u did not start",
+          apicId
+        );
+
+        break;
+      }
+
+      ++index;
+    }
+
+    Logger::WriteFormatted(
+      LogLevel::Info,
+      "SMP: %u processors online",
+      _processorCount
+    );
+  }
+
+  bool SMP::StartProcessor(UInt32 index, UInt8 apicId) {
+    UInt32 stackTop = Thread::InitializeProcessor(index);
+
+    if (stackTop == 0) {
+      return false;
+    }
+
+    StartupData* data = reinterpret_cast<StartupData*>(
+      MemoryMap::processorStartupPhysical
+      + static_cast<UInt32>(SMPTrampolineData - SMPTrampolineStart)
+    );
+    UInt32 cr0 = 0;
+    UInt32 cr4 = 0;
+
+    asm volatile("mov %%cr0, %0" : "=r"(cr0));
+    asm volatile("mov %%cr4, %0" : "=r"(cr4));
+
+    data->cr0 = cr0;
+    data->cr3 = Paging::GetKernelPageDirectoryPhysicalAddress();
+    data->cr4 = cr4;
+    data->stack = stackTop;
+    data->entry = reinterpret_cast<UInt32>(&ProcessorEntry);
+    data->index = index;
+
+    _apicIds[index] = apicId;
+    _bootingIndex = index;
+
+    LocalAPIC::SendInit(apicId);
+    Delay(Timer::NanosecondsToCounts(_initDelay));
+
+    UInt8 page
+      = static_cast<UInt8>(MemoryMap::processorStartupPhysical >> 12);
+    UInt32 bit = 1u << index;
+
+    // a processor that is already running ignores the second startup IPI
+    for (UInt32 attempt = 0; attempt < 2; ++attempt) {
+      UInt64 wait = attempt == 0 ? _firstStartupWait : _secondStartupWait;
+      UInt64 deadline = Timer::Now() + Timer::NanosecondsToCounts(wait);
+
+      LocalAPIC::SendStartup(apicId, page);
+
+      while (Timer::Now() < deadline) {
+        if ((_onlineMask.Load() & bit) != 0) {
+          _processorCount = _processorCount + 1;
+
+          return true;
+        }
+
+        CPU::Pause();
+      }
+    }
+
+    // a processor that starts after the timeout halts in ProcessorEntry
+    _bootingIndex = 0;
+
+    return false;
+  }
+
+  void SMP::ProcessorEntry(UInt32 index) {
+    if (index != _bootingIndex) {
+      CPU::DisableInterrupts();
+
+      for (;;) {
+        CPU::Halt();
+      }
+    }
+
+    TSS::InitializeProcessor(index);
+    IDT::Load();
+    LocalAPIC::Enable(false);
+
+    UInt32 mask = _onlineMask.Load();
+
+    while (!_onlineMask.CompareExchange(mask, mask | (1u << index))) {
+      CPU::Pause();
+    }
+
+    Thread::StartProcessor(index);
+  }
+
+  UInt32 SMP::GetProcessorCount() {
+    return _processorCount;
+  }
+
+  bool SMP::IsOnline(UInt32 index) {
+    return index < maxProcessors
+      && (_onlineMask.Load() & (1u << index)) != 0;
+  }
+
+  void SMP::SendReschedule(UInt32 index) {
+    LocalAPIC::SendIPI(_apicIds[index], IDT::rescheduleVector);
+  }
+
+  void SMP::InvalidatePage(UInt32 address) {
+    CPU::InvalidatePage(address);
+
+    if (_processorCount <= 1) {
+      return;
+    }
+
+    UInt32 flags = CPU::SaveAndDisableInterrupts();
+    UInt32 self = CurrentIndex();
+    UInt32 expected = 0;
+
+    // another processor may be waiting on us while we wait for the slot
+    while (!_shootdownBusy.CompareExchange(expected, 1)) {
+      expected = 0;
+
+      ServiceShootdown();
+      CPU::Pause();
+    }
+
+    UInt32 targets = _onlineMask.Load() & ~(1u << self);
+
+    if (targets != 0) {
+      _shootdownAddress = address;
+      _shootdownPending.Store(targets);
+
+      for (UInt32 i = 0; i < maxProcessors; ++i) {
+        if ((targets & (1u << i)) != 0) {
+          LocalAPIC::SendIPI(_apicIds[i], IDT::invalidateVector);
+        }
+      }
+
+      while (_shootdownPending.Load() != 0) {
+        CPU::Pause();
+      }
+    }
+
+    _shootdownBusy.Store(0);
+
+    CPU::RestoreInterrupts(flags);
+  }
+
+  void SMP::FlushPending() {
+    UInt32 bit = 1u << CurrentIndex();
+    UInt32 pending = _shootdownPending.Load();
+
+    if ((pending & bit) == 0) {
+      return;
+    }
+
+    CPU::InvalidatePage(_shootdownAddress);
+
+    while (!_shootdownPending.CompareExchange(pending, pending & ~bit)) {
+      CPU::Pause();
+    }
+  }
+
+  Interrupts::Context* SMP::InvalidateHandler(Interrupts::Context& context) {
+    FlushPending();
+
+    return &context;
+  }
+
+  void SMP::Delay(UInt64 counts) {
+    UInt64 start = Timer::Now();
+
+    while (Timer::Now() - start < counts) {
+      CPU::Pause();
+    }
+  }
+}
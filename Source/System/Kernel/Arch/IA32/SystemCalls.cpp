@@ -13,6 +13,7 @@
 #include <ABI/IPC.hpp>
 #include <ABI/IRQ.hpp>
 #include <ABI/Prelude.hpp>
+#include <ABI/SharedMemory.hpp>
 #include <ABI/SystemCall.hpp>
 #include <Types.hpp>
 
@@ -33,6 +34,7 @@
 #include "IRQ.hpp"
 #include "Logger.hpp"
 #include "Prelude.hpp"
+#include "SharedMemory.hpp"
 #include "Task.hpp"
 
 namespace Quantum::System::Kernel::Arch::IA32 {
@@ -51,6 +53,9 @@ namespace Quantum::System::Kernel::Arch::IA32 {
   using Kernel::Objects::IRQLineObject;
   using Kernel::Objects::KernelObject;
   using Kernel::Objects::KernelObjectType;
+  using Kernel::Objects::PortSetObject;
+  using Kernel::Objects::SharedMemoryObject;
+  using Kernel::SharedMemory;
 
   using DMABuffer = ABI::Devices::BlockDevices::DMABuffer;
   using LogLevel = Kernel::Logger::Level;
@@ -201,6 +206,67 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     return true;
   }
 
+  static bool ResolvePortSetHandle(
+    UInt32 handle,
+    UInt32 rights,
+    UInt32& outSetId
+  ) {
+    Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+
+    if (!tcb || !tcb->handleTable || !HandleTable::IsHandle(handle)) {
+      return false;
+    }
+
+    KernelObject* object = nullptr;
+
+    if (!tcb->handleTable->Resolve(
+      handle,
+      KernelObjectType::PortSet,
+      rights,
+      object
+    )) {
+      return false;
+    }
+
+    auto* setObject = reinterpret_cast<PortSetObject*>(object);
+
+    outSetId = setObject->portSetId;
+
+    return true;
+  }
+
+  static bool ResolveSharedMemoryHandle(
+    UInt32 handle,
+    UInt32 rights,
+    SharedMemoryObject*& outObject,
+    UInt32& outRights
+  ) {
+    Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+
+    if (!tcb || !tcb->handleTable || !HandleTable::IsHandle(handle)) {
+      return false;
+    }
+
+    KernelObject* object = nullptr;
+    KernelObjectType type = KernelObjectType::None;
+
+    if (
+      !tcb->handleTable->Resolve(
+        handle,
+        KernelObjectType::SharedMemory,
+        rights,
+        object
+      )
+      || !tcb->handleTable->Query(handle, type, outRights)
+    ) {
+      return false;
+    }
+
+    outObject = reinterpret_cast<SharedMemoryObject*>(object);
+
+    return true;
+  }
+
   Interrupts::Context* SystemCalls::OnSystemCall(Interrupts::Context& context) {
     SystemCall id = static_cast<SystemCall>(context.eax);
 
@@ -229,6 +295,67 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         break;
       }
 
+      case SystemCall::Task_GetNanoseconds: {
+        UInt64* out = reinterpret_cast<UInt64*>(context.ebx);
+
+        if (!out) {
+          context.eax = 1;
+
+          break;
+        }
+
+        *out = Timer::Nanoseconds();
+        context.eax = 0;
+
+        break;
+      }
+
+      case SystemCall::Task_SleepNanoseconds: {
+        UInt64 nanoseconds = (static_cast<UInt64>(context.ecx) << 32)
+          | context.ebx;
+
+        Kernel::Task::SleepNanoseconds(nanoseconds);
+
+        break;
+      }
+
+      case SystemCall::Task_SetPriority: {
+        UInt32 priority = context.ebx;
+        UInt32 threadId = context.ecx;
+
+        // only drivers and the coordinator may run ahead of normal tasks
+        bool privileged = Kernel::Task::CurrentTaskHasIOAccess()
+          || Kernel::Task::IsCurrentTaskCoordinator();
+
+        if (priority > Kernel::Thread::defaultPriority && !privileged) {
+          context.eax = 1;
+
+          break;
+        }
+
+        bool ok = Kernel::Task::SetPriority(threadId, priority);
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::Task_SetTaskPriority: {
+        if (!Kernel::Task::IsCurrentTaskCoordinator()) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 targetId = context.ebx;
+        UInt32 priority = context.ecx;
+        bool ok = Kernel::Task::SetTaskPriority(targetId, priority);
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
       case SystemCall::Task_GrantIOAccess: {
         if (!Kernel::Task::IsCurrentTaskCoordinator()) {
           context.eax = 1;
@@ -327,6 +454,42 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         break;
       }
 
+      case SystemCall::IPC_SendNoWait: {
+        UInt32 portId = 0;
+        UInt32 portOrHandle = context.ebx;
+        IPC::Message* msg = reinterpret_cast<IPC::Message*>(context.ecx);
+
+        if (!msg || msg->length == 0 || msg->length > IPC::maxPayloadBytes) {
+          context.eax = 1;
+
+          break;
+        }
+
+        if (
+          !ResolveIPCHandle(
+            portOrHandle,
+            static_cast<UInt32>(IPC::Right::Send),
+            portId
+          )
+        ) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 sender = Kernel::Task::GetCurrentId();
+        bool ok = Kernel::IPC::SendNoWait(
+          portId,
+          sender,
+          msg->payload,
+          msg->length
+        );
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
       case SystemCall::IPC_Receive: {
         UInt32 portId = 0;
         UInt32 portOrHandle = context.ebx;
@@ -346,17 +509,20 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
         UInt32 sender = 0;
         UInt32 length = 0;
+        UInt32 replyToken = 0;
         bool ok = Kernel::IPC::Receive(
           portId,
           sender,
           msg->payload,
           IPC::maxPayloadBytes,
-          length
+          length,
+          &replyToken
         );
 
         if (ok) {
           msg->senderId = sender;
           msg->length = length;
+          msg->replyToken = replyToken;
         }
 
         context.eax = ok ? 0 : 1;
@@ -384,18 +550,63 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
         UInt32 sender = 0;
         UInt32 length = 0;
+        UInt32 replyToken = 0;
         bool ok = Kernel::IPC::ReceiveTimeout(
           portId,
           sender,
           msg->payload,
           IPC::maxPayloadBytes,
           length,
-          timeoutTicks
+          timeoutTicks,
+          &replyToken
+        );
+
+        if (ok) {
+          msg->senderId = sender;
+          msg->length = length;
+          msg->replyToken = replyToken;
+        }
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::IPC_ReceiveTimeoutNanoseconds: {
+        UInt32 portId = 0;
+        UInt32 portOrHandle = context.ebx;
+        IPC::Message* msg = reinterpret_cast<IPC::Message*>(context.ecx);
+        UInt32 timeoutNanoseconds = context.edx;
+
+        if (!msg) {
+          context.eax = 1;
+
+          break;
+        }
+
+        if (!ResolveIPCHandle(portOrHandle, static_cast<UInt32>(IPC::Right::Receive), portId)) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 sender = 0;
+        UInt32 length = 0;
+        UInt32 replyToken = 0;
+        bool ok = Kernel::IPC::ReceiveTimeoutNanoseconds(
+          portId,
+          sender,
+          msg->payload,
+          IPC::maxPayloadBytes,
+          length,
+          timeoutNanoseconds,
+          &replyToken
         );
 
         if (ok) {
           msg->senderId = sender;
           msg->length = length;
+          msg->replyToken = replyToken;
         }
 
         context.eax = ok ? 0 : 1;
@@ -422,17 +633,139 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
         UInt32 sender = 0;
         UInt32 length = 0;
+        UInt32 replyToken = 0;
         bool ok = Kernel::IPC::TryReceive(
           portId,
           sender,
           msg->payload,
           IPC::maxPayloadBytes,
-          length
+          length,
+          &replyToken
+        );
+
+        if (ok) {
+          msg->senderId = sender;
+          msg->length = length;
+          msg->replyToken = replyToken;
+        }
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::IPC_Call: {
+        UInt32 portId = 0;
+        UInt32 portOrHandle = context.ebx;
+        IPC::Message* msg = reinterpret_cast<IPC::Message*>(context.ecx);
+        UInt32 timeoutTicks = context.edx;
+
+        if (!msg || msg->length == 0 || msg->length > IPC::maxPayloadBytes) {
+          context.eax = 1;
+
+          break;
+        }
+
+        if (!ResolveIPCHandle(portOrHandle, static_cast<UInt32>(IPC::Right::Send), portId)) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 sender = Kernel::Task::GetCurrentId();
+        UInt32 replier = 0;
+        UInt32 length = 0;
+        bool ok = Kernel::IPC::Call(
+          portId,
+          sender,
+          msg->payload,
+          msg->length,
+          replier,
+          msg->payload,
+          IPC::maxPayloadBytes,
+          length,
+          timeoutTicks
+        );
+
+        if (ok) {
+          msg->senderId = replier;
+          msg->length = length;
+          msg->replyToken = 0;
+        }
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::IPC_Reply: {
+        UInt32 replyToken = context.ebx;
+        IPC::Message* msg = reinterpret_cast<IPC::Message*>(context.ecx);
+
+        if (!msg || msg->length == 0 || msg->length > IPC::maxPayloadBytes) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 sender = Kernel::Task::GetCurrentId();
+        bool ok = Kernel::IPC::Reply(
+          replyToken,
+          sender,
+          msg->payload,
+          msg->length
+        );
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::IPC_ReplyWait: {
+        UInt32 portId = 0;
+        UInt32 portOrHandle = context.ebx;
+        IPC::Message* msg = reinterpret_cast<IPC::Message*>(context.ecx);
+        UInt32 replyToken = context.edx;
+
+        if (!msg) {
+          context.eax = 1;
+
+          break;
+        }
+
+        if (!ResolveIPCHandle(portOrHandle, static_cast<UInt32>(IPC::Right::Receive), portId)) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 sender = Kernel::Task::GetCurrentId();
+
+        // a failed reply only means the caller stopped waiting; the server
+        // still wants its next request
+        if (
+          replyToken != 0
+          && msg->length != 0
+          && msg->length <= IPC::maxPayloadBytes
+        ) {
+          Kernel::IPC::Reply(replyToken, sender, msg->payload, msg->length);
+        }
+
+        UInt32 length = 0;
+        UInt32 nextToken = 0;
+        bool ok = Kernel::IPC::Receive(
+          portId,
+          sender,
+          msg->payload,
+          IPC::maxPayloadBytes,
+          length,
+          &nextToken
         );
 
         if (ok) {
           msg->senderId = sender;
           msg->length = length;
+          msg->replyToken = nextToken;
         }
 
         context.eax = ok ? 0 : 1;
@@ -555,43 +888,129 @@ namespace Quantum::System::Kernel::Arch::IA32 {
           break;
         }
 
-        Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+        Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+
+        if (!tcb || !tcb->handleTable || !HandleTable::IsHandle(handle)) {
+          context.eax = 1;
+
+          break;
+        }
+
+        KernelObjectType type = KernelObjectType::None;
+        UInt32 entryRights = 0;
+
+        if (!tcb->handleTable->Query(handle, type, entryRights)) {
+          context.eax = 1;
+
+          break;
+        }
+
+        if (rights == 0) {
+          rights = entryRights;
+        } else if ((entryRights & rights) != rights) {
+          context.eax = 1;
+
+          break;
+        }
+
+        KernelObject* object = nullptr;
+
+        if (!tcb->handleTable->Resolve(handle, type, rights, object)) {
+          context.eax = 1;
+
+          break;
+        }
+
+        UInt32 sender = Kernel::Task::GetCurrentId();
+        bool ok = Kernel::IPC::SendHandle(portId, sender, object, rights);
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::IPC_CreatePortSet: {
+        Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+
+        if (!tcb || !tcb->handleTable) {
+          context.eax = 0;
+
+          break;
+        }
+
+        PortSetObject* object = Kernel::IPC::CreatePortSet();
+
+        if (!object) {
+          context.eax = 0;
+
+          break;
+        }
+
+        UInt32 rights
+          = static_cast<UInt32>(IPC::Right::Receive)
+          | static_cast<UInt32>(IPC::Right::Manage);
+        HandleTable::Handle handle = tcb->handleTable->Create(
+          KernelObjectType::PortSet,
+          object,
+          rights
+        );
+
+        // the handle holds its own reference; drop the creation reference
+        object->Release();
 
-        if (!tcb || !tcb->handleTable || !HandleTable::IsHandle(handle)) {
-          context.eax = 1;
+        context.eax = handle;
 
-          break;
-        }
+        break;
+      }
 
-        KernelObjectType type = KernelObjectType::None;
-        UInt32 entryRights = 0;
+      case SystemCall::IPC_AddToPortSet:
+      case SystemCall::IPC_RemoveFromPortSet: {
+        UInt32 setId = 0;
+        UInt32 portId = 0;
+        UInt32 manage = static_cast<UInt32>(IPC::Right::Manage);
+        UInt32 receive = static_cast<UInt32>(IPC::Right::Receive);
 
-        if (!tcb->handleTable->Query(handle, type, entryRights)) {
+        if (
+          !ResolvePortSetHandle(context.ebx, manage, setId)
+          || !ResolveIPCHandle(context.ecx, receive, portId)
+        ) {
           context.eax = 1;
 
           break;
         }
 
-        if (rights == 0) {
-          rights = entryRights;
-        } else if ((entryRights & rights) != rights) {
-          context.eax = 1;
+        UInt32 ownerId = 0;
+        bool ok = false;
 
-          break;
+        // raw port ids skip the rights check, so only the owner may watch
+        if (
+          Kernel::IPC::GetPortOwner(portId, ownerId)
+          && ownerId == Kernel::Task::GetCurrentId()
+        ) {
+          ok = id == SystemCall::IPC_AddToPortSet
+            ? Kernel::IPC::AddToPortSet(setId, portId)
+            : Kernel::IPC::RemoveFromPortSet(setId, portId);
         }
 
-        KernelObject* object = nullptr;
+        context.eax = ok ? 0 : 1;
 
-        if (!tcb->handleTable->Resolve(handle, type, rights, object)) {
-          context.eax = 1;
+        break;
+      }
+
+      case SystemCall::IPC_WaitAny: {
+        UInt32 setId = 0;
+        UInt32 portId = 0;
+        UInt32 receive = static_cast<UInt32>(IPC::Right::Receive);
+
+        if (!ResolvePortSetHandle(context.ebx, receive, setId)) {
+          context.eax = 0;
 
           break;
         }
 
-        UInt32 sender = Kernel::Task::GetCurrentId();
-        bool ok = Kernel::IPC::SendHandle(portId, sender, object, rights);
+        bool ok = Kernel::IPC::WaitAny(setId, context.ecx, portId);
 
-        context.eax = ok ? 0 : 1;
+        context.eax = ok ? portId : 0;
 
         break;
       }
@@ -966,6 +1385,148 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         break;
       }
 
+      case SystemCall::Block_Submit: {
+        BlockDevices::Request* request
+          = reinterpret_cast<BlockDevices::Request*>(context.ebx);
+        auto op = static_cast<BlockDevices::Operation>(context.ecx);
+
+        if (
+          !request
+          || (
+            op != BlockDevices::Operation::Read
+            && op != BlockDevices::Operation::Write
+          )
+        ) {
+          context.eax = 0;
+
+          break;
+        }
+
+        bool write = op == BlockDevices::Operation::Write;
+        UInt32 deviceId = 0;
+        UInt32 portId = 0;
+
+        if (!ResolveBlockDeviceHandle(
+          request->deviceId,
+          static_cast<UInt32>(
+            write
+              ? ABI::Devices::BlockDevices::Right::Write
+              : ABI::Devices::BlockDevices::Right::Read
+          ),
+          deviceId
+        )) {
+          context.eax = 0;
+
+          break;
+        }
+
+        if (
+          context.edx != 0
+          && !ResolveIPCHandle(
+            context.edx,
+            static_cast<UInt32>(IPC::Right::Receive),
+            portId
+          )
+        ) {
+          context.eax = 0;
+
+          break;
+        }
+
+        BlockDevices::Request resolved = *request;
+
+        resolved.deviceId = deviceId;
+
+        context.eax = BlockDevices::Submit(resolved, write, portId);
+
+        break;
+      }
+
+      case SystemCall::Block_Complete: {
+        context.eax = static_cast<UInt32>(
+          BlockDevices::Complete(
+            context.ebx,
+            reinterpret_cast<void*>(context.ecx)
+          )
+        );
+
+        break;
+      }
+
+      case SystemCall::Block_SetScheduler: {
+        UInt32 deviceId = 0;
+
+        if (!ResolveBlockDeviceHandle(
+          context.ebx,
+          static_cast<UInt32>(ABI::Devices::BlockDevices::Right::Control),
+          deviceId
+        )) {
+          context.eax = 1;
+
+          break;
+        }
+
+        bool ok = BlockDevices::SetScheduler(
+          deviceId,
+          static_cast<BlockDevices::Scheduler>(context.ecx)
+        );
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::Block_Flush: {
+        UInt32 deviceId = 0;
+        UInt32 deviceOrHandle = context.ebx;
+
+        if (
+          deviceOrHandle != 0
+          && !ResolveBlockDeviceHandle(
+            deviceOrHandle,
+            static_cast<UInt32>(ABI::Devices::BlockDevices::Right::Write),
+            deviceId
+          )
+        ) {
+          context.eax = 1;
+
+          break;
+        }
+
+        context.eax = BlockDevices::Flush(deviceId) ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::Block_GetCacheStats: {
+        BlockDevices::CacheStats* stats
+          = reinterpret_cast<BlockDevices::CacheStats*>(context.ebx);
+
+        if (!stats) {
+          context.eax = 1;
+
+          break;
+        }
+
+        BlockDevices::GetCacheStats(*stats);
+
+        context.eax = 0;
+
+        break;
+      }
+
+      case SystemCall::Block_ConfigureCache: {
+        if (!Kernel::Task::IsCurrentTaskCoordinator()) {
+          context.eax = 1;
+
+          break;
+        }
+
+        context.eax = BlockDevices::ConfigureCache(context.ebx) ? 0 : 1;
+
+        break;
+      }
+
       case SystemCall::Block_AllocateDMABuffer: {
         UInt32 sizeBytes = context.ebx;
         DMABuffer* buffer = reinterpret_cast<DMABuffer*>(context.ecx);
@@ -1138,6 +1699,40 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         break;
       }
 
+      case SystemCall::Input_ReadEventTimeoutNanoseconds: {
+        UInt32 deviceId = 0;
+        UInt32 deviceOrHandle = context.ebx;
+        InputDevices::Event* event
+          = reinterpret_cast<InputDevices::Event*>(context.ecx);
+        UInt32 timeoutNanoseconds = context.edx;
+
+        if (!event) {
+          context.eax = 1;
+
+          break;
+        }
+
+        if (!ResolveInputDeviceHandle(
+          deviceOrHandle,
+          static_cast<UInt32>(ABI::Devices::InputDevices::Right::Read),
+          deviceId
+        )) {
+          context.eax = 1;
+
+          break;
+        }
+
+        bool ok = InputDevices::ReadEventTimeoutNanoseconds(
+          deviceId,
+          *event,
+          timeoutNanoseconds
+        );
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
       case SystemCall::Input_PushEvent: {
         UInt32 deviceId = 0;
         UInt32 deviceOrHandle = context.ebx;
@@ -1473,6 +2068,175 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         break;
       }
 
+      case SystemCall::Memory_CreateShared: {
+        Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+
+        if (!tcb || !tcb->handleTable) {
+          context.eax = 0;
+
+          break;
+        }
+
+        SharedMemoryObject* object = SharedMemory::Create(
+          context.ebx,
+          Kernel::Task::GetCurrentId()
+        );
+
+        if (!object) {
+          context.eax = 0;
+
+          break;
+        }
+
+        UInt32 rights
+          = static_cast<UInt32>(ABI::SharedMemory::Right::Read)
+          | static_cast<UInt32>(ABI::SharedMemory::Right::Write);
+        HandleTable::Handle handle = tcb->handleTable->Create(
+          KernelObjectType::SharedMemory,
+          object,
+          rights
+        );
+
+        // the handle holds its own reference; drop the creation reference
+        object->Release();
+
+        context.eax = handle;
+
+        break;
+      }
+
+      case SystemCall::Memory_OpenShared: {
+        UInt32 allowed
+          = static_cast<UInt32>(ABI::SharedMemory::Right::Read)
+          | static_cast<UInt32>(ABI::SharedMemory::Right::Write);
+        UInt32 rights = context.ecx & allowed;
+        Kernel::Task::ControlBlock* tcb = Kernel::Task::GetCurrent();
+
+        if (rights == 0 || !tcb || !tcb->handleTable) {
+          context.eax = 0;
+
+          break;
+        }
+
+        SharedMemoryObject* object = SharedMemory::Open(
+          context.ebx,
+          Kernel::Task::GetCurrentId(),
+          rights
+        );
+
+        if (!object) {
+          context.eax = 0;
+
+          break;
+        }
+
+        HandleTable::Handle handle = tcb->handleTable->Create(
+          KernelObjectType::SharedMemory,
+          object,
+          rights
+        );
+
+        object->Release();
+
+        context.eax = handle;
+
+        break;
+      }
+
+      case SystemCall::Memory_MapShared: {
+        SharedMemoryObject* object = nullptr;
+        UInt32 rights = 0;
+
+        if (!ResolveSharedMemoryHandle(
+          context.ebx,
+          static_cast<UInt32>(ABI::SharedMemory::Right::Read),
+          object,
+          rights
+        )) {
+          context.eax = 0;
+
+          break;
+        }
+
+        bool writable
+          = (rights & static_cast<UInt32>(ABI::SharedMemory::Right::Write))
+            != 0;
+
+        context.eax = SharedMemory::Map(
+          Kernel::Task::GetCurrent(),
+          object,
+          writable
+        );
+
+        break;
+      }
+
+      case SystemCall::Memory_UnmapShared: {
+        bool ok = SharedMemory::Unmap(Kernel::Task::GetCurrent(), context.ebx);
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
+      case SystemCall::Memory_GetSharedInfo: {
+        auto* info = reinterpret_cast<ABI::SharedMemory::Info*>(context.ecx);
+        SharedMemoryObject* object = nullptr;
+        UInt32 rights = 0;
+
+        if (
+          !info
+          || !ResolveSharedMemoryHandle(context.ebx, 0, object, rights)
+        ) {
+          context.eax = 1;
+
+          break;
+        }
+
+        info->id = object->sharedId;
+        info->size = object->pageCount * PhysicalAllocator::pageSize;
+        info->ownerId = object->creatorTaskId;
+        context.eax = 0;
+
+        break;
+      }
+
+      case SystemCall::Memory_GrantShared: {
+        UInt32 allowed
+          = static_cast<UInt32>(ABI::SharedMemory::Right::Read)
+          | static_cast<UInt32>(ABI::SharedMemory::Right::Write);
+        UInt32 rights = context.edx & allowed;
+        UInt32 portId = 0;
+        UInt32 granteeId = 0;
+
+        // access is granted to whichever task owns the named port, since
+        // that is how clients address services
+        if (
+          rights == 0
+          || !ResolveIPCHandle(
+            context.ecx,
+            static_cast<UInt32>(IPC::Right::Send),
+            portId
+          )
+          || !Kernel::IPC::GetPortOwner(portId, granteeId)
+        ) {
+          context.eax = 1;
+
+          break;
+        }
+
+        bool ok = SharedMemory::Grant(
+          context.ebx,
+          Kernel::Task::GetCurrentId(),
+          granteeId,
+          rights
+        );
+
+        context.eax = ok ? 0 : 1;
+
+        break;
+      }
+
       default: {
         Logger::WriteFormatted(LogLevel::Warning, "Unknown SystemCall %p", id);
 
@@ -19,9 +19,14 @@ namespace Quantum::System::Kernel::Arch::IA32 {
    */
   extern "C" UInt64 gdt[];
 
-  void TSS::WriteTSSDescriptor(UInt32 base, UInt32 limit) {
-    GDT::Entry* entries = reinterpret_cast<GDT::Entry*>(gdt);
-    GDT::Entry& tssEntry = entries[_tssEntryIndex];
+  void TSS::WriteTSSDescriptor(
+    UInt64* table,
+    UInt32 entryIndex,
+    UInt32 base,
+    UInt32 limit
+  ) {
+    GDT::Entry* entries = reinterpret_cast<GDT::Entry*>(table);
+    GDT::Entry& tssEntry = entries[entryIndex];
 
     tssEntry.limitLow = static_cast<UInt16>(limit & 0xFFFF);
     tssEntry.baseLow = static_cast<UInt16>(base & 0xFFFF);
@@ -31,23 +36,29 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     tssEntry.baseHigh = static_cast<UInt8>((base >> 24) & 0xFF);
   }
 
-  void TSS::Initialize(UInt32 kernelStackTop) {
+  void TSS::Reset(TSS::Structure& tss, UInt32 kernelStackTop) {
     for (UInt32 i = 0; i < sizeof(TSS::Structure); ++i) {
-      reinterpret_cast<UInt8*>(&_tss)[i] = 0;
+      reinterpret_cast<UInt8*>(&tss)[i] = 0;
     }
 
+    tss.ss0 = kernelDataSelector;
+    tss.esp0 = kernelStackTop;
+    tss.ioMapBase = sizeof(TSS::Structure);
+  }
+
+  void TSS::Initialize(UInt32 kernelStackTop) {
     if (kernelStackTop == 0) {
       kernelStackTop
         = reinterpret_cast<UInt32>(_ring0Stack)
         + sizeof(_ring0Stack);
     }
 
-    _tss.ss0 = kernelDataSelector;
-    _tss.esp0 = kernelStackTop;
-    _tss.ioMapBase = sizeof(TSS::Structure);
+    Reset(_tss[0], kernelStackTop);
 
     WriteTSSDescriptor(
-      reinterpret_cast<UInt32>(&_tss),
+      gdt,
+      _tssEntryIndex,
+      reinterpret_cast<UInt32>(&_tss[0]),
       sizeof(TSS::Structure) - 1
     );
 
@@ -56,6 +67,49 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     asm volatile("ltr %0" :: "r"(selector));
   }
 
+  void TSS::InitializeProcessor(UInt32 index) {
+    UInt64* table = _processorGDT[index];
+
+    // code, data and user segments are shared with the bootstrap GDT
+    for (UInt32 i = 0; i < _tssEntryIndex; ++i) {
+      table[i] = gdt[i];
+    }
+
+    Reset(_tss[index], 0);
+
+    WriteTSSDescriptor(
+      table,
+      _tssEntryIndex + index,
+      reinterpret_cast<UInt32>(&_tss[index]),
+      sizeof(TSS::Structure) - 1
+    );
+
+    GDT::Descriptor descriptor {
+      static_cast<UInt16>(sizeof(_processorGDT[index]) - 1),
+      reinterpret_cast<UInt32>(table)
+    };
+
+    // reload every segment register so none refers to the startup GDT
+    asm volatile(
+      "lgdt %0\n"
+      "ljmp $0x08, $1f\n"
+      "1:\n"
+      "mov $0x10, %%ax\n"
+      "mov %%ax, %%ds\n"
+      "mov %%ax, %%es\n"
+      "mov %%ax, %%fs\n"
+      "mov %%ax, %%gs\n"
+      "mov %%ax, %%ss\n"
+      :
+      : "m"(descriptor)
+      : "eax", "memory"
+    );
+
+    UInt16 selector = static_cast<UInt16>(tssSelector + index * 8);
+
+    asm volatile("ltr %0" :: "r"(selector));
+  }
+
   void TSS::SetKernelStack(UInt32 kernelStackTop) {
     if (kernelStackTop == 0) {
       kernelStackTop
@@ -63,6 +117,6 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         + sizeof(_ring0Stack);
     }
 
-    _tss.esp0 = kernelStackTop;
+    _tss[SMP::CurrentIndex()].esp0 = kernelStackTop;
   }
 }
@@ -10,7 +10,10 @@
 
 #include "Arch/IA32/AddressSpace.hpp"
 #include "Arch/IA32/CPU.hpp"
+#include "Arch/IA32/IDT.hpp"
+#include "Arch/IA32/LocalAPIC.hpp"
 #include "Arch/IA32/Paging.hpp"
+#include "Arch/IA32/SMP.hpp"
 #include "Arch/IA32/Thread.hpp"
 #include "Arch/IA32/TSS.hpp"
 #include "Arch/IA32/Timer.hpp"
@@ -19,6 +22,7 @@
 #include "Logger.hpp"
 #include "Panic.hpp"
 #include "Prelude.hpp"
+#include "Sync/ScopedIRQLock.hpp"
 #include "Task.hpp"
 #include "UserMode.hpp"
 
@@ -30,32 +34,59 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
   using LogLevel = Kernel::Logger::Level;
 
+  /**
+   * Returns the highest priority with a non-empty ready queue.
+   * @param bitmap
+   *   Non-zero ready bitmap.
+   * @return
+   *   Priority level.
+   */
+  static UInt32 TopPriority(UInt32 bitmap) {
+    return 31 - static_cast<UInt32>(__builtin_clz(bitmap));
+  }
+
+  Thread::Processor& Thread::CurrentProcessor() {
+    return _processors[SMP::CurrentIndex()];
+  }
+
+  bool Thread::PreemptionAllowed() {
+    return _preemptionEnabled && _preemptDisableCount == 0;
+  }
+
   void Thread::AddToReadyQueue(Thread::ControlBlock* thread) {
+    Thread::Processor& processor = _processors[thread->processor];
+    UInt32 level = thread->priority;
+
     thread->state = Thread::State::Ready;
     thread->next = nullptr;
 
-    if (_readyQueueTail == nullptr) {
+    if (processor.readyTail[level] == nullptr) {
       // empty queue
-      _readyQueueHead = thread;
-      _readyQueueTail = thread;
+      processor.readyHead[level] = thread;
+      processor.readyTail[level] = thread;
+      processor.readyBitmap |= 1u << level;
     } else {
       // append to tail
-      _readyQueueTail->next = thread;
-      _readyQueueTail = thread;
+      processor.readyTail[level]->next = thread;
+      processor.readyTail[level] = thread;
     }
   }
 
-  Thread::ControlBlock* Thread::PopFromReadyQueue() {
-    if (_readyQueueHead == nullptr) {
+  Thread::ControlBlock* Thread::PopFromReadyQueue(
+    Thread::Processor& processor
+  ) {
+    if (processor.readyBitmap == 0) {
       return nullptr;
     }
 
-    Thread::ControlBlock* thread = _readyQueueHead;
+    UInt32 level = TopPriority(processor.readyBitmap);
+    Thread::ControlBlock* thread = processor.readyHead[level];
 
-    _readyQueueHead = thread->next;
+    processor.readyHead[level] = thread->next;
 
-    if (_readyQueueHead == nullptr) {
-      _readyQueueTail = nullptr;
+    if (processor.readyHead[level] == nullptr) {
+      processor.readyTail[level] = nullptr;
+      processor.readyBitmap &= ~(1u << level);
     }
 
     thread->next = nullptr;
@@ -63,6 +94,87 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     return thread;
   }
 
+  Thread::ControlBlock* Thread::Steal(UInt32 index) {
+    UInt32 victim = SMP::maxProcessors;
+    UInt32 victimTop = 0;
+
+    for (UInt32 i = 0; i < SMP::maxProcessors; ++i) {
+      UInt32 bitmap = _processors[i].readyBitmap;
+
+      if (i == index || bitmap == 0 || !SMP::IsOnline(i)) {
+        continue;
+      }
+
+      UInt32 top = TopPriority(bitmap);
+
+      if (victim == SMP::maxProcessors || top > victimTop) {
+        victim = i;
+        victimTop = top;
+      }
+    }
+
+    if (victim == SMP::maxProcessors) {
+      return nullptr;
+    }
+
+    Thread::ControlBlock* thread = PopFromReadyQueue(_processors[victim]);
+
+    thread->processor = index;
+
+    return thread;
+  }
+
+  UInt32 Thread::FindIdleProcessor() {
+    for (UInt32 i = 0; i < SMP::maxProcessors; ++i) {
+      Thread::Processor& processor = _processors[i];
+
+      if (
+        SMP::IsOnline(i)
+        && processor.current != nullptr
+        && processor.current == processor.idle
+        && processor.readyBitmap == 0
+      ) {
+        return i;
+      }
+    }
+
+    return SMP::maxProcessors;
+  }
+
+  bool Thread::RemoveFromReadyQueue(Thread::ControlBlock* thread) {
+    Thread::Processor& processor = _processors[thread->processor];
+    UInt32 level = thread->priority;
+    Thread::ControlBlock* previous = nullptr;
+    Thread::ControlBlock* current = processor.readyHead[level];
+
+    while (current) {
+      if (current == thread) {
+        if (previous) {
+          previous->next = current->next;
+        } else {
+          processor.readyHead[level] = current->next;
+        }
+
+        if (processor.readyTail[level] == current) {
+          processor.readyTail[level] = previous;
+        }
+
+        if (processor.readyHead[level] == nullptr) {
+          processor.readyBitmap &= ~(1u << level);
+        }
+
+        current->next = nullptr;
+
+        return true;
+      }
+
+      previous = current;
+      current = current->next;
+    }
+
+    return false;
+  }
+
   void Thread::AddToAllThreads(Thread::ControlBlock* thread) {
     thread->allNext = _allThreadsHead;
     _allThreadsHead = thread;
@@ -83,50 +195,114 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     }
   }
 
-  void Thread::RemoveFromSleepQueue(Thread::ControlBlock* thread) {
-    if (thread == nullptr) {
+  void Thread::CancelSleep(Thread::ControlBlock* thread) {
+    if (thread == nullptr || thread->wakeTime == 0) {
       return;
     }
 
-    UInt32 flags = 0;
-    _sleepLock.AcquireIRQSave(flags);
+    _timerWheel.Remove(thread->sleepTimer);
+
+    thread->wakeTime = 0;
+  }
 
-    Thread::ControlBlock** current = &_sleepHead;
+  void Thread::OnSleepTimer(void* context) {
+    Thread::ControlBlock* thread
+      = static_cast<Thread::ControlBlock*>(context);
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
 
-    while (*current) {
-      if (*current == thread) {
-        *current = thread->sleepNext;
-        thread->sleepNext = nullptr;
-        thread->wakeTick = 0;
+    // a Wake() that raced with expiry has already cleared the deadline
+    if (thread->wakeTime != 0) {
+      thread->wakeTime = 0;
+
+      if (thread->state == Thread::State::Blocked) {
+        AddToReadyQueue(thread);
+        RequestPreemption(thread);
+      }
+    }
+  }
+
+  void Thread::ArmTimer() {
+    UInt32 index = SMP::CurrentIndex();
+    Thread::Processor& processor = _processors[index];
+    Thread::ControlBlock* current = processor.current;
+    bool sliceNeeded = false;
 
-        break;
+    // a slice only needs to end if someone is waiting to share the CPU
+    if (PreemptionAllowed() && processor.readyBitmap != 0 && current) {
+      UInt32 top = TopPriority(processor.readyBitmap);
+
+      sliceNeeded = current == processor.idle || top >= current->priority;
+
+      // spare work goes to a processor with nothing to do
+      UInt32 idle = FindIdleProcessor();
+
+      if (idle != SMP::maxProcessors && idle != index) {
+        Notify(idle, true);
+      }
+    }
+
+    // the PIT, and with it the timer wheel, belongs to the bootstrap
+    // processor; the others only need their local slice timer
+    if (index != 0) {
+      if (sliceNeeded) {
+        LocalAPIC::ArmTimer(1);
+      } else {
+        LocalAPIC::DisarmTimer();
       }
 
-      current = &((*current)->sleepNext);
+      return;
+    }
+
+    UInt64 deadline = _timerWheel.NextDeadline();
+
+    if (sliceNeeded) {
+      UInt64 sliceEnd = Timer::Now() + _sliceCounts;
+
+      if (deadline == 0 || sliceEnd < deadline) {
+        deadline = sliceEnd;
+      }
     }
 
-    _sleepLock.ReleaseIRQRestore(flags);
+    Timer::SetDeadline(deadline);
   }
 
-  void Thread::ProcessSleepQueue(UInt64 currentTick) {
-    UInt32 flags = 0;
-    _sleepLock.AcquireIRQSave(flags);
+  void Thread::Notify(UInt32 index, bool immediate) {
+    if (index != 0) {
+      // the receiver re-arms its own slice if it does not switch at once
+      SMP::SendReschedule(index);
 
-    while (_sleepHead && _sleepHead->wakeTick <= currentTick) {
-      Thread::ControlBlock* thread = _sleepHead;
-      _sleepHead = thread->sleepNext;
-      thread->sleepNext = nullptr;
-      thread->wakeTick = 0;
+      return;
+    }
 
-      if (thread->state == Thread::State::Blocked) {
-        AddToReadyQueue(thread);
-      }
+    UInt64 now = Timer::Now();
+
+    Timer::RequestDeadline(immediate ? now : now + _sliceCounts);
+  }
+
+  void Thread::RequestPreemption(Thread::ControlBlock* thread) {
+    Thread::Processor& home = _processors[thread->processor];
+    Thread::ControlBlock* current = home.current;
+
+    if (!_schedulerActive || current == nullptr) {
+      return;
     }
 
-    _sleepLock.ReleaseIRQRestore(flags);
+    if (current == home.idle || thread->priority > current->priority) {
+      Notify(thread->processor, true);
+    } else if (PreemptionAllowed()) {
+      UInt32 idle = FindIdleProcessor();
+
+      if (idle != SMP::maxProcessors) {
+        Notify(idle, true);
+      } else {
+        Notify(thread->processor, false);
+      }
+    }
   }
 
   Thread::ControlBlock* Thread::FindById(UInt32 id) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
     Thread::ControlBlock* current = _allThreadsHead;
 
     while (current) {
@@ -166,31 +342,52 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     }
   }
 
-  Thread::Context* Thread::Schedule(Thread::Context* currentContext) {
-    if (_pendingCleanup && _pendingCleanup != _currentThread) {
-      TaskControlBlock* cleanupTask = _pendingCleanup->task;
+  void Thread::FinishSwitch() {
+    Thread::Processor& processor = CurrentProcessor();
+    Thread::ControlBlock* cleanup = processor.pendingCleanup;
 
-      RemoveFromAllThreads(_pendingCleanup);
-      RemoveFromTaskList(cleanupTask, _pendingCleanup);
+    processor.pendingCleanup = nullptr;
 
-      Heap::Free(_pendingCleanup->stackBase);
-      Heap::Free(_pendingCleanup);
+    _schedulerLock.Release();
 
-      if (cleanupTask && cleanupTask->threadCount == 0) {
-        Task::Destroy(cleanupTask);
-      }
+    if (cleanup == nullptr) {
+      return;
+    }
 
-      _pendingCleanup = nullptr;
+    TaskControlBlock* cleanupTask = cleanup->task;
+    bool lastThread = false;
+
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+      RemoveFromAllThreads(cleanup);
+      RemoveFromTaskList(cleanupTask, cleanup);
+
+      lastThread = cleanupTask && cleanupTask->threadCount == 0;
+    }
+
+    Heap::Free(cleanup->stackBase);
+    Heap::Free(cleanup);
+
+    if (lastThread) {
+      Task::Destroy(cleanupTask);
     }
+  }
 
-    Thread::ControlBlock* previousThread = _currentThread;
+  Thread::Context* Thread::Schedule(Thread::Context* currentContext) {
+    UInt32 index = SMP::CurrentIndex();
+    Thread::Processor& processor = _processors[index];
+    Thread::ControlBlock* previousThread = processor.current;
 
     if (previousThread != nullptr && currentContext != nullptr) {
       previousThread->context = currentContext;
 
+      // an IRQ boost only covers the run that follows the wakeup
+      previousThread->priority = previousThread->basePriority;
+
       if (
         previousThread->state == Thread::State::Running
-        && previousThread != _idleThread
+        && previousThread != processor.idle
       ) {
         previousThread->state = Thread::State::Ready;
 
@@ -198,13 +395,18 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       }
     }
 
-    Thread::ControlBlock* nextThread = PopFromReadyQueue();
+    Thread::ControlBlock* nextThread = PopFromReadyQueue(processor);
+
+    // balancing is left to preemption, so cooperative runs stay put
+    if (nextThread == nullptr && PreemptionAllowed()) {
+      nextThread = Steal(index);
+    }
 
     if (nextThread == nullptr) {
-      nextThread = _idleThread;
+      nextThread = processor.idle;
     }
 
-    _currentThread = nextThread;
+    processor.current = nextThread;
     nextThread->state = Thread::State::Running;
 
     TaskControlBlock* previousTask
@@ -225,11 +427,11 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
     if (
       previousThread
-      && previousThread != _idleThread
+      && previousThread != processor.idle
       && previousThread->state == Thread::State::Terminated
       && previousThread != nextThread
     ) {
-      _pendingCleanup = previousThread;
+      processor.pendingCleanup = previousThread;
     }
 
     return nextThread->context;
@@ -321,8 +523,13 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       return nullptr;
     }
 
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+      tcb->id = _nextThreadId++;
+    }
+
     // initialize TCB fields
-    tcb->id = _nextThreadId++;
     tcb->task = task;
     tcb->state = Thread::State::Ready;
     tcb->stackBase = stack;
@@ -336,8 +543,13 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     tcb->next = nullptr;
     tcb->allNext = nullptr;
     tcb->waitNext = nullptr;
-    tcb->wakeTick = 0;
-    tcb->sleepNext = nullptr;
+    tcb->waitQueued = false;
+    tcb->wakeTime = 0;
+    tcb->sleepTimer = {};
+    tcb->basePriority = task->priority;
+    tcb->priority = task->priority;
+    tcb->processor = SMP::CurrentIndex();
+    tcb->wakePending = false;
 
     // ensure stack can hold the bootstrap frame
     const UInt32 minFrame = sizeof(Thread::Context) + 8;
@@ -382,17 +594,20 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
   void Thread::Initialize() {
     _preemptionEnabled = false;
-    _forceReschedule = false;
-    _pendingCleanup = nullptr;
     _schedulerActive = false;
     _preemptDisableCount = 0;
     _nextThreadId = 1;
-    _currentThread = nullptr;
-    _readyQueueHead = nullptr;
-    _readyQueueTail = nullptr;
     _allThreadsHead = nullptr;
-    _sleepHead = nullptr;
-    _sleepLock.Initialize();
+    _timerWheel.Initialize();
+    _schedulerLock.Initialize();
+
+    for (UInt32 i = 0; i < SMP::maxProcessors; ++i) {
+      _processors[i] = Thread::Processor {};
+    }
+
+    Interrupts::RegisterHandler(IDT::yieldVector, YieldHandler);
+    Interrupts::RegisterHandler(IDT::rescheduleVector, Reschedule);
+    Interrupts::RegisterHandler(IDT::localTimerVector, Tick);
 
     Logger::Write(LogLevel::Debug, "Creating idle thread");
 
@@ -407,18 +622,58 @@ namespace Quantum::System::Kernel::Arch::IA32 {
 
     // keep idle thread out of the ready queue; it is used as a fallback when
     // nothing else is runnable
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
     idleThread->state = Thread::State::Ready;
-    _idleThread = idleThread;
+    _processors[0].idle = idleThread;
 
     // remove the idle thread from the queue; Create() enqueues by default
     // we want the ready queue to hold only runnable work, with idle as a
     // separate fallback
-    _readyQueueHead = nullptr;
-    _readyQueueTail = nullptr;
+    RemoveFromReadyQueue(idleThread);
 
     Logger::Write(LogLevel::Debug, "Idle thread created successfully");
   }
 
+  UInt32 Thread::InitializeProcessor(UInt32 index) {
+    TaskControlBlock* idleTask = Task::Create(IdleThread, 4096);
+
+    if (idleTask == nullptr || idleTask->mainThread == nullptr) {
+      Logger::Write(LogLevel::Error, "Failed to create processor idle thread");
+
+      return 0;
+    }
+
+    Thread::ControlBlock* idleThread = idleTask->mainThread;
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+    RemoveFromReadyQueue(idleThread);
+
+    idleThread->processor = index;
+    _processors[index].idle = idleThread;
+
+    return idleThread->kernelStackTop;
+  }
+
+  void Thread::StartProcessor(UInt32 index) {
+    Thread::Processor& processor = _processors[index];
+
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+      // the processor is already on the idle stack, so idle is simply
+      // marked as running; its context is saved at the first interrupt
+      processor.idle->state = Thread::State::Running;
+      processor.current = processor.idle;
+    }
+
+    CPU::EnableInterrupts();
+
+    for (;;) {
+      CPU::Halt();
+    }
+  }
+
   Thread::ControlBlock* Thread::Create(
     TaskControlBlock* task,
     void (*entryPoint)(),
@@ -434,17 +689,23 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       return nullptr;
     }
 
-    // add to ready queue
-    AddToReadyQueue(tcb);
-    AddToAllThreads(tcb);
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
 
-    if (task->mainThread == nullptr) {
-      task->mainThread = tcb;
-    }
+      // add to ready queue
+      AddToReadyQueue(tcb);
+      AddToAllThreads(tcb);
+
+      if (task->mainThread == nullptr) {
+        task->mainThread = tcb;
+      }
+
+      tcb->taskNext = task->threadHead;
+      task->threadHead = tcb;
+      task->threadCount += 1;
 
-    tcb->taskNext = task->threadHead;
-    task->threadHead = tcb;
-    task->threadCount += 1;
+      RequestPreemption(tcb);
+    }
 
     Logger::Write(LogLevel::Debug, "Thread created successfully");
     Logger::WriteFormatted(
@@ -486,17 +747,23 @@ namespace Quantum::System::Kernel::Arch::IA32 {
     tcb->userEntryPoint = entryPoint;
     tcb->userStackTop = userStackTop;
 
-    // add to ready queue
-    AddToReadyQueue(tcb);
-    AddToAllThreads(tcb);
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
 
-    if (task->mainThread == nullptr) {
-      task->mainThread = tcb;
-    }
+      // add to ready queue
+      AddToReadyQueue(tcb);
+      AddToAllThreads(tcb);
 
-    tcb->taskNext = task->threadHead;
-    task->threadHead = tcb;
-    task->threadCount += 1;
+      if (task->mainThread == nullptr) {
+        task->mainThread = tcb;
+      }
+
+      tcb->taskNext = task->threadHead;
+      task->threadHead = tcb;
+      task->threadCount += 1;
+
+      RequestPreemption(tcb);
+    }
 
     Logger::WriteFormatted(
       LogLevel::Debug,
@@ -513,22 +780,28 @@ namespace Quantum::System::Kernel::Arch::IA32 {
   }
 
   void Thread::Exit() {
+    Thread::ControlBlock* thread = GetCurrent();
+
     Logger::WriteFormatted(
       LogLevel::Debug,
       "Thread %u exiting",
-      _currentThread ? _currentThread->id : 0
+      thread ? thread->id : 0
     );
 
+    UInt32 flags = 0;
+
+    // the lock passes to the yield handler, which switches away for good
+    _schedulerLock.AcquireIRQSave(flags);
+
     // mark thread as terminated; defer freeing stack/TCB until after next
     // switch
-    if (_currentThread != nullptr) {
-      _currentThread->state = Thread::State::Terminated;
+    if (thread != nullptr) {
+      thread->state = Thread::State::Terminated;
     }
 
-    _schedulerActive = true;
-    _forceReschedule = true;
+    CurrentProcessor().lockHandedOff = true;
 
-    asm volatile("int $32" ::: "memory");
+    asm volatile("int %0" :: "i"(IDT::yieldVector) : "memory");
 
     // should never reach here
     PANIC("Exit returned from scheduler");
@@ -537,64 +810,184 @@ namespace Quantum::System::Kernel::Arch::IA32 {
   }
 
   void Thread::Yield() {
-    _schedulerActive = true;
-    _forceReschedule = true;
-
-    asm volatile("int $32" ::: "memory");
+    asm volatile("int %0" :: "i"(IDT::yieldVector) : "memory");
   }
 
   Thread::ControlBlock* Thread::GetCurrent() {
-    return _currentThread;
+    // the thread could migrate between reading the index and the slot
+    UInt32 flags = CPU::SaveAndDisableInterrupts();
+    Thread::ControlBlock* current = CurrentProcessor().current;
+
+    CPU::RestoreInterrupts(flags);
+
+    return current;
   }
 
   void Thread::EnablePreemption() {
-    if (_preemptDisableCount > 0) {
-      _preemptDisableCount -= 1;
-    }
+    bool enabled = false;
 
-    if (_preemptDisableCount == 0 && !_preemptionEnabled) {
-      _preemptionEnabled = true;
-      _schedulerActive = true;
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
 
+      if (_preemptDisableCount > 0) {
+        _preemptDisableCount -= 1;
+      }
+
+      if (_preemptDisableCount == 0 && !_preemptionEnabled) {
+        _preemptionEnabled = true;
+        _schedulerActive = true;
+        enabled = true;
+      }
+    }
+
+    if (enabled) {
       Logger::Write(LogLevel::Debug, "Preemptive multitasking enabled");
     }
   }
 
   void Thread::DisablePreemption() {
-    _preemptDisableCount += 1;
+    bool disabled = false;
 
-    if (_preemptionEnabled) {
-      _preemptionEnabled = false;
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+      _preemptDisableCount += 1;
+
+      if (_preemptionEnabled) {
+        _preemptionEnabled = false;
+        disabled = true;
+      }
+    }
 
+    if (disabled) {
       Logger::Write(LogLevel::Debug, "Preemptive multitasking disabled");
     }
   }
 
   Thread::Context* Thread::Tick(Thread::Context& context) {
-    // called from timer interrupt
-    ProcessSleepQueue(Timer::Ticks());
+    // called from the PIT on the bootstrap processor and from the local
+    // APIC timer on the others
+    if (SMP::CurrentIndex() == 0) {
+      _timerWheel.Advance(Timer::Now());
+    }
+
+    _schedulerLock.Acquire();
+
+    Thread::Processor& processor = CurrentProcessor();
+    Thread::Context* next = &context;
+
+    if (
+      _schedulerActive
+      && (PreemptionAllowed() || processor.current == processor.idle)
+    ) {
+      next = Schedule(&context);
+    }
 
-    bool preemptionAllowed
-      = _preemptionEnabled && _preemptDisableCount == 0;
-    bool shouldSchedule
-      = (preemptionAllowed && _schedulerActive) || _forceReschedule;
+    // one-shot timer: nothing fires again unless it is re-armed here
+    ArmTimer();
 
-    _forceReschedule = false;
+    // after a switch the lock is released on the new stack
+    if (next == &context) {
+      _schedulerLock.Release();
+    }
+
+    return next;
+  }
+
+  Thread::Context* Thread::YieldHandler(Thread::Context& context) {
+    Thread::Processor& processor = CurrentProcessor();
 
-    if (!shouldSchedule) {
-      return &context;
+    if (processor.lockHandedOff) {
+      processor.lockHandedOff = false;
+    } else {
+      _schedulerLock.Acquire();
     }
 
-    return Schedule(&context);
+    _schedulerActive = true;
+
+    Thread::Context* next = Schedule(&context);
+
+    ArmTimer();
+
+    if (next == &context) {
+      _schedulerLock.Release();
+    }
+
+    return next;
   }
 
-  void Thread::Wake(Thread::ControlBlock* thread) {
-    if (thread == nullptr || thread->state != Thread::State::Blocked) {
+  Thread::Context* Thread::Reschedule(Thread::Context& context) {
+    _schedulerLock.Acquire();
+
+    Thread::Processor& processor = CurrentProcessor();
+    Thread::ControlBlock* current = processor.current;
+    Thread::Context* next = &context;
+    bool urgent = current == processor.idle;
+
+    if (current != nullptr && !urgent && processor.readyBitmap != 0) {
+      urgent = TopPriority(processor.readyBitmap) > current->priority;
+    }
+
+    // an online processor always has a current thread
+    if (_schedulerActive && current != nullptr && urgent) {
+      next = Schedule(&context);
+    }
+
+    ArmTimer();
+
+    if (next == &context) {
+      _schedulerLock.Release();
+    }
+
+    return next;
+  }
+
+  void Thread::Wake(Thread::ControlBlock* thread, bool boost) {
+    if (thread == nullptr) {
       return;
     }
 
-    RemoveFromSleepQueue(thread);
-    AddToReadyQueue(thread);
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+    if (thread->state == Thread::State::Blocked) {
+      if (boost) {
+        thread->priority = boostPriority;
+      }
+
+      CancelSleep(thread);
+      AddToReadyQueue(thread);
+      RequestPreemption(thread);
+    } else {
+      // the thread is still on its way to blocking on another processor
+      thread->wakePending = true;
+    }
+  }
+
+  bool Thread::SetPriority(Thread::ControlBlock* thread, UInt32 priority) {
+    if (thread == nullptr || priority > maxPriority) {
+      return false;
+    }
+
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_schedulerLock);
+
+    // a pending boost is kept; the new base applies from the next switch
+    bool boosted = thread->priority != thread->basePriority;
+
+    thread->basePriority = priority;
+
+    if (!boosted) {
+      bool queued = thread->state == Thread::State::Ready
+        && thread != _processors[thread->processor].idle
+        && RemoveFromReadyQueue(thread);
+
+      thread->priority = priority;
+
+      if (queued) {
+        AddToReadyQueue(thread);
+      }
+    }
+
+    return true;
   }
 
   void Thread::SleepTicks(UInt32 ticks) {
@@ -602,43 +995,92 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       return;
     }
 
-    Thread::ControlBlock* thread = _currentThread;
+    // measured from now rather than from the last tick boundary
+    UInt64 deadline = Timer::Now() + Timer::TicksToCounts(ticks);
 
-    if (thread == nullptr || thread == _idleThread) {
+    // a stale wakeup can end a block early
+    while (Timer::Now() < deadline) {
+      BlockUntil(deadline);
+    }
+  }
+
+  void Thread::SleepNanoseconds(UInt64 nanoseconds) {
+    if (nanoseconds == 0) {
       return;
     }
 
-    UInt64 wakeTick = Timer::Ticks() + ticks;
+    UInt64 deadline = Timer::Now() + Timer::NanosecondsToCounts(nanoseconds);
+
+    while (Timer::Now() < deadline) {
+      BlockUntil(deadline);
+    }
+  }
+
+  void Thread::Block(UInt64 wakeTick) {
+    BlockUntil(wakeTick != 0 ? Timer::TicksToCounts(wakeTick) : 0);
+  }
+
+  void Thread::BlockUntil(UInt64 wakeTime) {
     UInt32 flags = 0;
 
-    _sleepLock.AcquireIRQSave(flags);
+    _schedulerLock.AcquireIRQSave(flags);
 
-    thread->state = Thread::State::Blocked;
-    thread->wakeTick = wakeTick;
-    thread->sleepNext = nullptr;
+    Thread::Processor& processor = CurrentProcessor();
+    Thread::ControlBlock* thread = processor.current;
 
-    if (_sleepHead == nullptr || wakeTick < _sleepHead->wakeTick) {
-      thread->sleepNext = _sleepHead;
-      _sleepHead = thread;
-    } else {
-      Thread::ControlBlock* current = _sleepHead;
+    if (thread == nullptr || thread == processor.idle) {
+      _schedulerLock.ReleaseIRQRestore(flags);
 
-      while (
-        current->sleepNext != nullptr
-        && current->sleepNext->wakeTick <= wakeTick
-      ) {
-        current = current->sleepNext;
-      }
+      return;
+    }
+
+    if (thread->wakePending) {
+      thread->wakePending = false;
 
-      thread->sleepNext = current->sleepNext;
-      current->sleepNext = thread;
+      _schedulerLock.ReleaseIRQRestore(flags);
+
+      return;
     }
 
-    _sleepLock.ReleaseIRQRestore(flags);
+    if (wakeTime != 0 && wakeTime <= Timer::Now()) {
+      _schedulerLock.ReleaseIRQRestore(flags);
 
-    _schedulerActive = true;
-    _forceReschedule = true;
+      return;
+    }
+
+    thread->state = Thread::State::Blocked;
+    thread->wakeTime = wakeTime;
+
+    // without a deadline only an explicit Wake() makes the thread runnable
+    if (wakeTime != 0) {
+      _timerWheel.Insert(thread->sleepTimer, wakeTime, OnSleepTimer, thread);
+
+      // the wheel is driven by the bootstrap processor's PIT
+      Timer::RequestDeadline(_timerWheel.NextDeadline());
+    }
+
+    // holding the lock into the yield handler means no Wake() can see the
+    // thread blocked before it is off this CPU
+    processor.lockHandedOff = true;
+
+    asm volatile("int %0" :: "i"(IDT::yieldVector) : "memory");
+
+    CPU::RestoreInterrupts(flags);
+  }
+
+  void Thread::StartTimer(
+    TimerWheel::Entry& entry,
+    UInt64 deadline,
+    TimerWheel::Callback callback,
+    void* context
+  ) {
+    _timerWheel.Insert(entry, deadline, callback, context);
+
+    // the timer may already be armed for a later deadline
+    Timer::RequestDeadline(_timerWheel.NextDeadline());
+  }
 
-    asm volatile("int $32" ::: "memory");
+  bool Thread::CancelTimer(TimerWheel::Entry& entry) {
+    return _timerWheel.Remove(entry);
   }
 }
@@ -8,6 +8,7 @@
 
 #include <Types.hpp>
 
+#include "Arch/IA32/CPU.hpp"
 #include "Arch/IA32/Interrupts.hpp"
 #include "Arch/IA32/IO.hpp"
 #include "Arch/IA32/PIC.hpp"
@@ -16,35 +17,196 @@
 #include "Interrupts.hpp"
 #include "Logger.hpp"
 #include "Prelude.hpp"
+#include "Sync/ScopedIRQLock.hpp"
 
 namespace Quantum::System::Kernel::Arch::IA32 {
   using LogLevel = Kernel::Logger::Level;
 
   Interrupts::Context* Timer::TimerHandler(Interrupts::Context& context) {
-    ++_tickCount;
+    // the PIT may have been re-armed early by another processor, so the
+    // handler reads the clock instead of assuming a deadline expired; the
+    // scheduler re-arms the PIT before returning
+    if (_tickLoggingEnabled) {
+      UInt64 ticks = Ticks();
 
-    // heartbeat every second (at 100 Hz)
-    if (_tickLoggingEnabled && (_tickCount % _pitFreqHz) == 0) {
-      Logger::Write(LogLevel::Trace, "Tick");
+      // heartbeat every second
+      if (ticks >= _nextHeartbeatTick) {
+        Logger::Write(LogLevel::Trace, "Tick");
+
+        _nextHeartbeatTick = ticks + _pitFreqHz;
+      }
     }
 
     return Thread::Tick(context);
   }
 
+  UInt32 Timer::ElapsedSinceArm() {
+    IO::Out8(_pitCommand, _pitReadBack);
+
+    UInt8 status = IO::In8(_pitChannel0);
+    UInt32 count = IO::In8(_pitChannel0);
+
+    count |= static_cast<UInt32>(IO::In8(_pitChannel0)) << 8;
+
+    // null count: the programmed value has not reached the counter yet
+    if ((status & 0x40) != 0) {
+      return 0;
+    }
+
+    // OUT stays low until terminal count
+    if ((status & 0x80) == 0) {
+      return count <= _armedCounts ? _armedCounts - count : 0;
+    }
+
+    // past terminal count the counter wraps and keeps running
+    return _armedCounts + ((0x10000 - count) & 0xFFFF);
+  }
+
+  void Timer::Arm(UInt64 deadline) {
+    UInt32 elapsed = ElapsedSinceArm();
+
+    _baseCounts += elapsed;
+    _basePhase += elapsed;
+    _baseTicks += _basePhase / _countsPerTick;
+    _basePhase %= _countsPerTick;
+
+    UInt32 counts = _maxCounts;
+
+    if (deadline != 0) {
+      if (deadline <= _baseCounts + _minCounts) {
+        counts = _minCounts;
+      } else if (deadline - _baseCounts < _maxCounts) {
+        counts = static_cast<UInt32>(deadline - _baseCounts);
+      }
+    }
+
+    IO::Out8(_pitCommand, _pitMode);
+    IO::Out8(_pitChannel0, counts & 0xFF);
+    IO::Out8(_pitChannel0, (counts >> 8) & 0xFF);
+
+    _armedCounts = counts;
+    _armedDeadline = _baseCounts + counts;
+  }
+
   void Timer::Initialize() {
-    // program PIT for desired frequency
-    UInt16 divisor = static_cast<UInt16>(_pitInputHz / _pitFreqHz);
+    _lock.Initialize();
+
+    _baseCounts = 0;
+    _baseTicks = 0;
+    _basePhase = 0;
+    _armedCounts = _maxCounts;
+    _armedDeadline = _maxCounts;
+
+    // the firmware left the PIT periodic; start the first one-shot without
+    // reading back a count that belongs to that mode
     IO::Out8(_pitCommand, _pitMode);
-    IO::Out8(_pitChannel0, divisor & 0xFF);
-    IO::Out8(_pitChannel0, (divisor >> 8) & 0xFF);
+    IO::Out8(_pitChannel0, _maxCounts & 0xFF);
+    IO::Out8(_pitChannel0, (_maxCounts >> 8) & 0xFF);
+
+    CalibrateTSC();
 
     // register IRQ0 handler and unmask
     Interrupts::RegisterHandler(32, TimerHandler); // IRQ0 vector
     PIC::Unmask(0);
   }
 
+  UInt64 Timer::Scale(UInt64 value, UInt32 mult, UInt32 shift) {
+    UInt64 low = static_cast<UInt64>(static_cast<UInt32>(value)) * mult;
+    UInt64 high = static_cast<UInt64>(static_cast<UInt32>(value >> 32)) * mult;
+
+    return (high << (32 - shift)) + (low >> shift);
+  }
+
+  void Timer::CalibrateTSC() {
+    if (!CPU::GetInfo().hasTSC) {
+      Logger::Write(LogLevel::Info, "Timer: no TSC, using PIT clock");
+
+      return;
+    }
+
+    // the first one-shot runs for about 55 ms, longer than the window, so
+    // the PIT count stays readable without interrupts
+    UInt64 startCounts = Now();
+    UInt64 startTSC = CPU::ReadTSC();
+    UInt64 counts = 0;
+
+    while (counts < _calibrationCounts) {
+      counts = Now() - startCounts;
+    }
+
+    UInt64 cycles = CPU::ReadTSC() - startTSC;
+    UInt64 nanoseconds = Scale(counts, _countNsMult, _countNsShift);
+    UInt64 dividend = nanoseconds << _tscNsShift;
+
+    // the quotient must fit in 32 bits, which holds for any TSC faster
+    // than about 4 MHz
+    if (cycles == 0 || (cycles >> 32) != 0 || (dividend >> 32) >= cycles) {
+      Logger::Write(LogLevel::Warning, "Timer: TSC unusable, using PIT clock");
+
+      return;
+    }
+
+    UInt32 divisor = static_cast<UInt32>(cycles);
+    UInt32 quotient = 0;
+    UInt32 remainder = 0;
+
+    asm volatile(
+      "divl %4"
+      : "=a"(quotient), "=d"(remainder)
+      : "a"(static_cast<UInt32>(dividend)),
+        "d"(static_cast<UInt32>(dividend >> 32)),
+        "rm"(divisor)
+    );
+
+    _tscBaseNs = Scale(Now(), _countNsMult, _countNsShift);
+    _tscBase = CPU::ReadTSC();
+    _tscNsMult = quotient;
+
+    Logger::WriteFormatted(
+      LogLevel::Info,
+      "Timer: TSC calibrated at %u MHz",
+      divisor / (static_cast<UInt32>(nanoseconds) / 1000)
+    );
+  }
+
   UInt64 Timer::Ticks() {
-    return _tickCount;
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    return _baseTicks + (_basePhase + ElapsedSinceArm()) / _countsPerTick;
+  }
+
+  UInt64 Timer::Now() {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    return _baseCounts + ElapsedSinceArm();
+  }
+
+  UInt64 Timer::NanosecondsToCounts(UInt64 nanoseconds) {
+    return Scale(nanoseconds, _nsCountMult, 32) + 1;
+  }
+
+  UInt64 Timer::Nanoseconds() {
+    if (_tscNsMult == 0) {
+      return Scale(Now(), _countNsMult, _countNsShift);
+    }
+
+    UInt64 cycles = CPU::ReadTSC() - _tscBase;
+
+    return _tscBaseNs + Scale(cycles, _tscNsMult, _tscNsShift);
+  }
+
+  void Timer::SetDeadline(UInt64 deadline) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    Arm(deadline);
+  }
+
+  void Timer::RequestDeadline(UInt64 deadline) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    if (deadline < _armedDeadline) {
+      Arm(deadline);
+    }
   }
 
   void Timer::SetTickLoggingEnabled(bool enabled) {
@@ -0,0 +1,90 @@
+;-------------------------------------------------------------------------------
+; Quantum
+;-------------------------------------------------------------------------------
+; File: System/Kernel/Arch/IA32/Trampoline.asm
+; Brief: Real-mode startup code for application processors.
+; Author: Brandon Belna <bbelna@aol.com>
+; Copyright: © 2025-2026 The Quantum OS Project
+; License: GPL 2.0
+;-------------------------------------------------------------------------------
+; The bootstrap processor copies this code to TRAMPOLINE_BASE and points the
+; startup IPI at it. The processor starts in real mode with CS = base >> 4,
+; switches to protected mode with a temporary flat GDT, loads the kernel
+; control registers from the data block and calls the kernel entry on the
+; given stack. Everything after the copy runs at TRAMPOLINE_BASE, so
+; absolute addresses are computed with RELOCATE.
+;-------------------------------------------------------------------------------
+
+%define TRAMPOLINE_BASE 0x7000
+%define RELOCATE(label) (TRAMPOLINE_BASE + (label) - SMPTrampolineStart)
+
+global SMPTrampolineStart
+global SMPTrampolineData
+global SMPTrampolineEnd
+
+SECTION .text
+
+BITS 16
+SMPTrampolineStart:
+  cli
+  cld
+  mov ax, cs
+  mov ds, ax
+  lgdt [TrampolineGDTR - SMPTrampolineStart]
+  mov eax, cr0
+  or eax, 1                     ; PE
+  mov cr0, eax
+  jmp dword 0x08:RELOCATE(TrampolineProtected)
+
+BITS 32
+TrampolineProtected:
+  mov ax, 0x10
+  mov ds, ax
+  mov es, ax
+  mov fs, ax
+  mov gs, ax
+  mov ss, ax
+
+  ; CR4 and CR3 must be in place before CR0 turns paging on
+  mov eax, [RELOCATE(TrampolineCR4)]
+  mov cr4, eax
+  mov eax, [RELOCATE(TrampolineCR3)]
+  mov cr3, eax
+  mov eax, [RELOCATE(TrampolineCR0)]
+  mov cr0, eax
+
+  mov esp, [RELOCATE(TrampolineStack)]
+  push dword [RELOCATE(TrampolineIndex)]
+  mov eax, [RELOCATE(TrampolineEntry)]
+  call eax                      ; SMP::ProcessorEntry(index), never returns
+
+.hang:
+  cli
+  hlt
+  jmp .hang
+
+align 8
+TrampolineGDT:
+  dq 0x0000000000000000         ; null
+  dq 0x00CF9A000000FFFF         ; 0x08: flat ring0 code
+  dq 0x00CF92000000FFFF         ; 0x10: flat ring0 data
+TrampolineGDTR:
+  dw TrampolineGDTR - TrampolineGDT - 1
+  dd RELOCATE(TrampolineGDT)
+
+; layout must match SMP::StartupData
+align 4
+SMPTrampolineData:
+TrampolineCR0:
+  dd 0
+TrampolineCR3:
+  dd 0
+TrampolineCR4:
+  dd 0
+TrampolineStack:
+  dd 0
+TrampolineEntry:
+  dd 0
+TrampolineIndex:
+  dd 0
+SMPTrampolineEnd:
@@ -11,13 +11,16 @@
 #include "Arch/AddressSpace.hpp"
 #include "Arch/PhysicalAllocator.hpp"
 #include "Devices/BlockDevices.hpp"
+#include "Heap.hpp"
 #include "IPC.hpp"
 #include "Logger.hpp"
 #include "Sync/ScopedLock.hpp"
 #include "Task.hpp"
+#include "Timer.hpp"
 
 namespace Quantum::System::Kernel::Devices {
   using ::Quantum::CopyBytes;
+  using Kernel::Heap;
   using Kernel::IPC;
   using Kernel::Task;
   using Objects::Devices::BlockDeviceObject;
@@ -35,6 +38,36 @@ namespace Quantum::System::Kernel::Devices {
       _deviceStorage[i].info.id = 0;
       _deviceStorage[i].portId = 0;
       _deviceStorage[i].object = nullptr;
+      _deviceStorage[i].sharedBuffer = false;
+      _deviceStorage[i].queueHead = _noRequest;
+      _deviceStorage[i].queueTail = _noRequest;
+      _deviceStorage[i].queueLength = 0;
+      _deviceStorage[i].scheduler = Scheduler::Noop;
+      _deviceStorage[i].headLBA = 0;
+    }
+
+    for (UInt32 i = 0; i < _maxQueuedRequests; ++i) {
+      _queuedRequests[i].id = 0;
+      _queuedRequests[i].state = RequestState::Free;
+      _queuedRequests[i].buffer = nullptr;
+      _queuedRequests[i].wait.Initialize();
+    }
+
+    _requestGeneration = 0;
+    _dispatcherStarted = false;
+    _dispatchCursor = 0;
+    _dispatchWait.Initialize();
+    _queueSpaceWait.Initialize();
+
+    _dmaBufferBusy = false;
+    _dmaBufferWait.Initialize();
+
+    _cacheLock.Initialize();
+    _cacheFlushBusy = false;
+    _cacheFlushWait.Initialize();
+
+    if (!ConfigureCache(_cacheDefaultBlocks)) {
+      Logger::Write(LogLevel::Warning, "BlockDevices: buffer cache disabled");
     }
   }
 
@@ -91,14 +124,11 @@ namespace Quantum::System::Kernel::Devices {
     UInt32& outVirtual,
     UInt32& outSize
   ) {
-    if (sizeBytes == 0) {
-      return false;
-    }
-
-    if (sizeBytes > Arch::PhysicalAllocator::pageSize) {
+    if (sizeBytes == 0 || sizeBytes > _dmaMaxBufferBytes) {
       return false;
     }
 
+    UInt32 pageSize = Arch::PhysicalAllocator::pageSize;
     UInt32 dmaPhysical = 0;
     UInt32 dmaBytes = 0;
 
@@ -106,18 +136,43 @@ namespace Quantum::System::Kernel::Devices {
       Sync::ScopedLock<Sync::SpinLock> guard(_lock);
 
       if (_dmaBufferPhysical == 0) {
-        UInt32 page = Arch::PhysicalAllocator::AllocatePageBelow(
-          _dmaMaxPhysicalAddress,
+        UInt32 pageCount = (sizeBytes + pageSize - 1) / pageSize;
+
+        // prefer memory the kernel can reach from any address space so bulk
+        // requests can fill and drain the buffer directly; the range must
+        // stay inside one 64 KB window for the ISA DMA page register
+        UInt32 base = Arch::PhysicalAllocator::AllocateContiguousBelow(
+          _dmaKernelVisibleLimit,
+          pageCount,
           true,
-          0x10000
+          _dmaMaxBufferBytes
         );
 
-        if (page == 0) {
+        if (base == 0) {
+          base = Arch::PhysicalAllocator::AllocateContiguousBelow(
+            _dmaMaxPhysicalAddress,
+            pageCount,
+            true,
+            _dmaMaxBufferBytes
+          );
+        }
+
+        if (base == 0 && pageCount > 1) {
+          pageCount = 1;
+          base = Arch::PhysicalAllocator::AllocatePageBelow(
+            _dmaMaxPhysicalAddress,
+            true,
+            _dmaMaxBufferBytes
+          );
+        }
+
+        if (base == 0) {
           return false;
         }
 
-        _dmaBufferPhysical = page;
-        _dmaBufferBytes = Arch::PhysicalAllocator::pageSize;
+        _dmaBufferPhysical = base;
+        _dmaBufferBytes = pageCount * pageSize;
+        _dmaBufferOwnerId = Task::GetCurrentId();
       }
 
       dmaPhysical = _dmaBufferPhysical;
@@ -130,14 +185,16 @@ namespace Quantum::System::Kernel::Devices {
       return false;
     }
 
-    Arch::AddressSpace::MapPage(
-      directory,
-      _dmaBufferVirtualBase,
-      dmaPhysical,
-      true,
-      true,
-      false
-    );
+    for (UInt32 offset = 0; offset < dmaBytes; offset += pageSize) {
+      Arch::AddressSpace::MapPage(
+        directory,
+        _dmaBufferVirtualBase + offset,
+        dmaPhysical + offset,
+        true,
+        true,
+        false
+      );
+    }
 
     outPhysical = dmaPhysical;
     outVirtual = _dmaBufferVirtualBase;
@@ -156,6 +213,15 @@ namespace Quantum::System::Kernel::Devices {
 
     device->info.id = id;
     device->portId = 0;
+    device->sharedBuffer = false;
+    device->queueHead = _noRequest;
+    device->queueTail = _noRequest;
+    device->queueLength = 0;
+    device->scheduler = device->info.sectorsPerTrack != 0
+      && device->info.headCount != 0
+        ? Scheduler::Deadline
+        : Scheduler::Noop;
+    device->headLBA = 0;
     device->object = new BlockDeviceObject(id);
 
     if (!device->object) {
@@ -219,6 +285,15 @@ namespace Quantum::System::Kernel::Devices {
     storage->info.id = id;
     storage->info.flags &= ~static_cast<UInt32>(BlockDevices::Flag::Ready);
     storage->portId = 0;
+    storage->sharedBuffer = false;
+    storage->queueHead = _noRequest;
+    storage->queueTail = _noRequest;
+    storage->queueLength = 0;
+    storage->asyncLength = 0;
+    storage->scheduler = info.sectorsPerTrack != 0 && info.headCount != 0
+      ? Scheduler::Deadline
+      : Scheduler::Noop;
+    storage->headLBA = 0;
     storage->object = new BlockDeviceObject(id);
 
     if (!storage->object) {
@@ -233,26 +308,56 @@ namespace Quantum::System::Kernel::Devices {
   }
 
   bool BlockDevices::Unregister(UInt32 deviceId) {
-    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+    UInt32 aborted[_queueDepth] = {};
+    UInt32 abortedCount = 0;
+    UInt32 dropped = 0;
+    bool found = false;
 
-    for (UInt32 i = 0; i < _deviceCount; ++i) {
-      if (_devices[i] && _devices[i]->info.id == deviceId) {
-        if (_devices[i]->object) {
-          _devices[i]->object->Release();
-          _devices[i]->object = nullptr;
-        }
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
 
-        _devices[i]->info.id = 0;
-        _devices[i]->portId = 0;
-        _devices[i] = _devices[_deviceCount - 1];
-        _devices[_deviceCount - 1] = nullptr;
-        _deviceCount--;
+      for (UInt32 i = 0; i < _deviceCount; ++i) {
+        if (_devices[i] && _devices[i]->info.id == deviceId) {
+          {
+            Sync::ScopedLock<Sync::SpinLock> cacheGuard(_cacheLock);
 
-        return true;
+            dropped = CacheInvalidate(deviceId);
+          }
+
+          abortedCount = DetachQueued(*_devices[i], aborted);
+
+          if (_devices[i]->object) {
+            _devices[i]->object->Release();
+            _devices[i]->object = nullptr;
+          }
+
+          _devices[i]->info.id = 0;
+          _devices[i]->portId = 0;
+          _devices[i]->sharedBuffer = false;
+          _devices[i] = _devices[_deviceCount - 1];
+          _devices[_deviceCount - 1] = nullptr;
+          _deviceCount--;
+          found = true;
+
+          break;
+        }
       }
     }
 
-    return false;
+    for (UInt32 i = 0; i < abortedCount; ++i) {
+      FinishQueued(aborted[i], false);
+    }
+
+    if (dropped > 0) {
+      Logger::WriteFormatted(
+        LogLevel::Warning,
+        "BlockDevices: dropped %u unwritten blocks of device %u",
+        dropped,
+        deviceId
+      );
+    }
+
+    return found;
   }
 
   UInt32 BlockDevices::GetCount() {
@@ -309,8 +414,41 @@ namespace Quantum::System::Kernel::Devices {
       return false;
     }
 
+    if (
+      device->info.sectorSize != info.sectorSize
+      || device->info.sectorCount != info.sectorCount
+    ) {
+      Sync::ScopedLock<Sync::SpinLock> cacheGuard(_cacheLock);
+
+      CacheInvalidate(deviceId);
+    }
+
     device->info.sectorSize = info.sectorSize;
     device->info.sectorCount = info.sectorCount;
+    device->info.sectorsPerTrack = info.sectorsPerTrack;
+    device->info.headCount = info.headCount;
+
+    return true;
+  }
+
+  bool BlockDevices::SetScheduler(UInt32 deviceId, Scheduler scheduler) {
+    if (
+      scheduler != Scheduler::Noop
+      && scheduler != Scheduler::Deadline
+      && scheduler != Scheduler::Elevator
+    ) {
+      return false;
+    }
+
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    BlockDevices::Device* device = Find(deviceId);
+
+    if (!device) {
+      return false;
+    }
+
+    device->scheduler = scheduler;
 
     return true;
   }
@@ -329,6 +467,7 @@ namespace Quantum::System::Kernel::Devices {
 
       snapshot.info = device->info;
       snapshot.portId = device->portId;
+      snapshot.sharedBuffer = device->sharedBuffer;
     }
 
     if ((snapshot.info.flags & static_cast<UInt32>(BlockDevices::Flag::Ready)) == 0) {
@@ -339,46 +478,83 @@ namespace Quantum::System::Kernel::Devices {
       return false;
     }
 
-    if (snapshot.portId != 0) {
-      UInt32 sectorSize = snapshot.info.sectorSize;
-      UInt32 maxPerChunk = 0;
+    if (!IsCacheable(snapshot)) {
+      return TransferQueued(request.deviceId, request, false);
+    }
 
-      if (sectorSize != 0) {
-        maxPerChunk = messageDataBytes / sectorSize;
-      }
+    UInt8* buffer = reinterpret_cast<UInt8*>(request.buffer);
+    UInt32 done = 0;
 
-      if (maxPerChunk == 0) {
-        return false;
-      }
+    while (done < request.count) {
+      UInt32 missCount = 0;
+      UInt32 generation = 0;
 
-      UInt32 remaining = request.count;
-      UInt32 lba = request.lba;
-      UInt8* buffer = reinterpret_cast<UInt8*>(request.buffer);
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
 
-      while (remaining > 0) {
-        UInt32 toRead = remaining < maxPerChunk ? remaining : maxPerChunk;
-        Request chunk {};
+        // serve leading hits, then measure the run of misses that follows
+        while (done < request.count) {
+          UInt32 index = CacheFind(request.deviceId, request.lba + done);
 
-        chunk.deviceId = request.deviceId;
-        chunk.lba = lba;
-        chunk.count = toRead;
-        chunk.buffer = buffer;
+          if (index == _cacheNone) {
+            break;
+          }
 
-        if (!SendRequest(snapshot, chunk, false)) {
-          return false;
+          CopyBytes(
+            buffer + done * cacheBlockBytes,
+            _cacheEntries[index].data,
+            cacheBlockBytes
+          );
+          CacheTouch(index, true);
+
+          _cacheHits++;
+          done++;
+        }
+
+        while (
+          done + missCount < request.count
+          && CacheFind(request.deviceId, request.lba + done + missCount)
+            == _cacheNone
+        ) {
+          missCount++;
         }
 
-        UInt32 bytes = toRead * sectorSize;
+        _cacheMisses += missCount;
+        generation = _cacheWriteGeneration;
+      }
+
+      if (missCount == 0) {
+        break;
+      }
+
+      Request run {};
+
+      run.deviceId = request.deviceId;
+      run.lba = request.lba + done;
+      run.count = missCount;
+      run.buffer = buffer + done * cacheBlockBytes;
+      run.timeoutTicks = request.timeoutTicks;
+
+      if (!TransferQueued(request.deviceId, run, false)) {
+        return false;
+      }
 
-        remaining -= toRead;
-        lba += toRead;
-        buffer += bytes;
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+        CacheFill(
+          request.deviceId,
+          run.lba,
+          missCount,
+          buffer + done * cacheBlockBytes,
+          generation
+        );
       }
 
-      return true;
+      done += missCount;
     }
 
-    return false;
+    return true;
   }
 
   bool BlockDevices::Write(const BlockDevices::Request& request) {
@@ -395,6 +571,7 @@ namespace Quantum::System::Kernel::Devices {
 
       snapshot.info = device->info;
       snapshot.portId = device->portId;
+      snapshot.sharedBuffer = device->sharedBuffer;
     }
 
     if ((snapshot.info.flags & static_cast<UInt32>(BlockDevices::Flag::Ready)) == 0) {
@@ -409,211 +586,1849 @@ namespace Quantum::System::Kernel::Devices {
       return false;
     }
 
-    if (snapshot.portId != 0) {
-      UInt32 sectorSize = snapshot.info.sectorSize;
-      UInt32 maxPerChunk = 0;
-
-      if (sectorSize != 0) {
-        maxPerChunk = messageDataBytes / sectorSize;
-      }
+    if (!IsCacheable(snapshot)) {
+      return TransferQueued(request.deviceId, request, true);
+    }
 
-      if (maxPerChunk == 0) {
-        return false;
-      }
+    const UInt8* buffer = reinterpret_cast<const UInt8*>(request.buffer);
 
-      UInt32 remaining = request.count;
-      UInt32 lba = request.lba;
-      const UInt8* buffer
-        = reinterpret_cast<const UInt8*>(request.buffer);
+    for (UInt32 i = 0; i < request.count; ++i) {
+      const UInt8* sector = buffer + i * cacheBlockBytes;
+      UInt32 lba = request.lba + i;
+      bool stored = false;
 
-      while (remaining > 0) {
-        UInt32 toWrite = remaining < maxPerChunk ? remaining : maxPerChunk;
-        Request chunk {};
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
 
-        chunk.deviceId = request.deviceId;
-        chunk.lba = lba;
-        chunk.count = toWrite;
-        chunk.buffer = const_cast<UInt8*>(buffer);
+        stored = CacheStore(
+          request.deviceId,
+          lba,
+          sector,
+          cacheBlockBytes,
+          true
+        );
+      }
 
-        if (!SendRequest(snapshot, chunk, true)) {
-          return false;
-        }
+      if (!stored) {
+        // every entry is dirty; write back to free one up
+        Flush(0);
 
-        UInt32 bytes = toWrite * sectorSize;
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
 
-        remaining -= toWrite;
-        lba += toWrite;
-        buffer += bytes;
+        stored = CacheStore(
+          request.deviceId,
+          lba,
+          sector,
+          cacheBlockBytes,
+          true
+        );
       }
 
-      return true;
-    }
+      if (!stored) {
+        Request single {};
 
-    return false;
-  }
+        single.deviceId = request.deviceId;
+        single.lba = lba;
+        single.count = 1;
+        single.buffer = const_cast<UInt8*>(sector);
+        single.timeoutTicks = request.timeoutTicks;
 
-  BlockDevices::Device* BlockDevices::Find(UInt32 deviceId) {
-    for (UInt32 i = 0; i < _deviceCount; ++i) {
-      if (_devices[i] && _devices[i]->info.id == deviceId) {
-        return _devices[i];
+        if (!TransferQueued(request.deviceId, single, true)) {
+          return false;
+        }
       }
     }
 
-    return nullptr;
-  }
+    bool overThreshold = false;
 
-  BlockDeviceObject* BlockDevices::GetObject(UInt32 deviceId) {
-    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
 
-    BlockDevices::Device* device = Find(deviceId);
+      overThreshold = _cacheDirty > _cacheCapacity / 2;
+    }
 
-    if (!device) {
-      return nullptr;
+    if (overThreshold) {
+      Flush(0);
     }
 
-    return device->object;
+    return true;
   }
 
-  bool BlockDevices::ValidateRequest(
-    const BlockDevices::Device& device,
+  bool BlockDevices::ReadDevice(
+    BlockDevices::Device& device,
     const BlockDevices::Request& request
   ) {
-    if (request.count == 0 || request.buffer == nullptr) {
+    if (device.portId == 0) {
       return false;
     }
 
-    if (device.info.sectorSize == 0 || device.info.sectorCount == 0) {
-      return false;
+    if (device.sharedBuffer) {
+      return TransferBulk(device, request, false);
     }
 
-    UInt64 start = request.lba;
-    UInt64 count = request.count;
-    UInt64 end = start + count;
-    UInt64 max = device.info.sectorCount;
+    UInt32 sectorSize = device.info.sectorSize;
+    UInt32 maxPerChunk = 0;
 
-    if (start >= max || count > max || end > max) {
+    if (sectorSize != 0) {
+      maxPerChunk = messageDataBytes / sectorSize;
+    }
+
+    if (maxPerChunk == 0) {
       return false;
     }
 
-    return true;
-  }
+    UInt32 remaining = request.count;
+    UInt32 lba = request.lba;
+    UInt8* buffer = reinterpret_cast<UInt8*>(request.buffer);
 
-  bool BlockDevices::Bind(UInt32 deviceId, UInt32 portId) {
-    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+    while (remaining > 0) {
+      UInt32 toRead = remaining < maxPerChunk ? remaining : maxPerChunk;
+      Request chunk {};
 
-    BlockDevices::Device* device = Find(deviceId);
+      chunk.deviceId = request.deviceId;
+      chunk.lba = lba;
+      chunk.count = toRead;
+      chunk.buffer = buffer;
+      chunk.timeoutTicks = request.timeoutTicks;
 
-    if (!device || portId == 0) {
-      return false;
+      if (!SendRequest(device, chunk, false, false)) {
+        return false;
+      }
+
+      UInt32 bytes = toRead * sectorSize;
+
+      remaining -= toRead;
+      lba += toRead;
+      buffer += bytes;
     }
 
-    UInt32 ownerId = 0;
+    return true;
+  }
 
-    if (!IPC::GetPortOwner(portId, ownerId)) {
+  bool BlockDevices::WriteDevice(
+    BlockDevices::Device& device,
+    const BlockDevices::Request& request
+  ) {
+    if (device.portId == 0) {
       return false;
     }
 
-    if (ownerId != Task::GetCurrentId()) {
+    if (device.sharedBuffer) {
+      return TransferBulk(device, request, true);
+    }
+
+    UInt32 sectorSize = device.info.sectorSize;
+    UInt32 maxPerChunk = 0;
+
+    if (sectorSize != 0) {
+      maxPerChunk = messageDataBytes / sectorSize;
+    }
+
+    if (maxPerChunk == 0) {
       return false;
     }
 
-    device->portId = portId;
-    device->info.flags |= static_cast<UInt32>(BlockDevices::Flag::Ready);
+    UInt32 remaining = request.count;
+    UInt32 lba = request.lba;
+    const UInt8* buffer
+      = reinterpret_cast<const UInt8*>(request.buffer);
+
+    while (remaining > 0) {
+      UInt32 toWrite = remaining < maxPerChunk ? remaining : maxPerChunk;
+      Request chunk {};
+
+      chunk.deviceId = request.deviceId;
+      chunk.lba = lba;
+      chunk.count = toWrite;
+      chunk.buffer = const_cast<UInt8*>(buffer);
+      chunk.timeoutTicks = request.timeoutTicks;
+
+      if (!SendRequest(device, chunk, true, false)) {
+        return false;
+      }
+
+      UInt32 bytes = toWrite * sectorSize;
+
+      remaining -= toWrite;
+      lba += toWrite;
+      buffer += bytes;
+    }
 
     return true;
   }
 
-  bool BlockDevices::SendRequest(
-    BlockDevices::Device& device,
+  void BlockDevices::StartDispatcher() {
+    if (_dispatcherStarted) {
+      return;
+    }
+
+    if (!Task::Create(DispatchTask, _dispatcherStackBytes)) {
+      Logger::Write(
+        LogLevel::Warning,
+        "BlockDevices: dispatcher unavailable, requests run inline"
+      );
+
+      return;
+    }
+
+    _dispatcherStarted = true;
+  }
+
+  UInt32 BlockDevices::Submit(
     const BlockDevices::Request& request,
-    bool write
+    bool write,
+    UInt32 completionPortId
   ) {
-    if (device.portId == 0) {
-      return false;
+    BlockDevices::Device snapshot {};
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      BlockDevices::Device* device = Find(request.deviceId);
+
+      if (!device) {
+        return 0;
+      }
+
+      snapshot.info = device->info;
+      snapshot.portId = device->portId;
     }
 
-    UInt32 bytes = request.count * device.info.sectorSize;
+    if (!_dispatcherStarted) {
+      return 0;
+    }
 
-    if (bytes > messageDataBytes) {
-      return false;
+    if ((snapshot.info.flags & static_cast<UInt32>(BlockDevices::Flag::Ready)) == 0) {
+      return 0;
     }
 
-    UInt32 replyPortId = IPC::CreatePort();
+    if (
+      write
+      && (snapshot.info.flags & static_cast<UInt32>(BlockDevices::Flag::ReadOnly)) != 0
+    ) {
+      return 0;
+    }
 
-    if (replyPortId == 0) {
-      return false;
+    if (!ValidateRequest(snapshot, request)) {
+      return 0;
     }
 
-    Message msg {};
+    UInt32 bytes = request.count * snapshot.info.sectorSize;
 
-    msg.op = write ? Operation::Write : Operation::Read;
-    msg.deviceId = request.deviceId;
-    msg.lba = request.lba;
-    msg.count = request.count;
-    msg.replyPortId = replyPortId;
-    msg.status = 0;
-    msg.dataLength = write ? bytes : 0;
+    if (bytes > maxQueuedBytes) {
+      return 0;
+    }
 
-    if (write && bytes > 0) {
-      CopyBytes(msg.data, request.buffer, bytes);
+    UInt8* data = reinterpret_cast<UInt8*>(Heap::Allocate(bytes));
+
+    if (!data) {
+      return 0;
     }
 
-    UInt32 length = messageHeaderBytes + msg.dataLength;
-    bool sent = IPC::Send(
-      device.portId,
-      Task::GetCurrentId(),
-      &msg,
-      length
-    );
+    bool cacheable = IsCacheable(snapshot);
+    bool cached = false;
+    UInt32 generation = 0;
 
-    if (!sent) {
-      IPC::DestroyPort(replyPortId);
+    if (write) {
+      CopyBytes(data, request.buffer, bytes);
 
-      return false;
-    }
+      if (cacheable) {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
 
-    Message response {};
+        CacheUpdate(request.deviceId, request.lba, request.count, data);
+      }
+    } else if (cacheable) {
+      Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
 
-    UInt32 senderId = 0;
-    UInt32 responseLength = 0;
-    UInt32 timeoutTicks = request.timeoutTicks != 0
-      ? request.timeoutTicks
-      : _requestTimeoutTicks;
+      cached = true;
 
-    bool received = IPC::ReceiveTimeout(
-      replyPortId,
-      senderId,
-      &response,
-      IPC::maxPayloadBytes,
-      responseLength,
-      timeoutTicks
-    );
+      for (UInt32 i = 0; i < request.count; ++i) {
+        if (CacheFind(request.deviceId, request.lba + i) == _cacheNone) {
+          cached = false;
+
+          break;
+        }
+      }
 
-    IPC::DestroyPort(replyPortId);
+      if (cached) {
+        for (UInt32 i = 0; i < request.count; ++i) {
+          UInt32 index = CacheFind(request.deviceId, request.lba + i);
 
-    (void)senderId;
-    (void)responseLength;
+          CopyBytes(
+            data + i * cacheBlockBytes,
+            _cacheEntries[index].data,
+            cacheBlockBytes
+          );
+          CacheTouch(index, true);
+        }
 
-    if (!received) {
-      return false;
-    }
+        _cacheHits += request.count;
+      } else {
+        _cacheMisses += request.count;
+      }
 
-    if (response.op != Operation::Response || response.status != 0) {
-      return false;
+      generation = _cacheWriteGeneration;
     }
 
-    if (!write) {
-      if (response.dataLength != bytes) {
-        return false;
+    UInt32 index = _noRequest;
+    UInt32 requestId = 0;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      BlockDevices::Device* device = Find(request.deviceId);
+
+      if (device) {
+        index = AllocateQueued(*device, false);
       }
 
-      if (bytes > 0) {
-        CopyBytes(request.buffer, response.data, bytes);
+      if (index != _noRequest) {
+        QueuedRequest& slot = _queuedRequests[index];
+
+        slot.write = write;
+        slot.lba = request.lba;
+        slot.count = request.count;
+        slot.timeoutTicks = request.timeoutTicks;
+        slot.buffer = data;
+        slot.bytes = bytes;
+        slot.completionPortId = completionPortId;
+        slot.cacheFill = !write && cacheable;
+        slot.generation = generation;
+        requestId = slot.id;
+
+        if (!cached) {
+          EnqueueQueued(*device, index);
+        }
       }
     }
 
-    return true;
+    if (index == _noRequest) {
+      Heap::Free(data);
+
+      return 0;
+    }
+
+    // fully cached reads never reach the device
+    if (cached) {
+      FinishQueued(index, true);
+    }
+
+    return requestId;
   }
-}
 
+  BlockDevices::CompletionStatus BlockDevices::Complete(
+    UInt32 requestId,
+    void* buffer
+  ) {
+    UInt8* data = nullptr;
+    UInt32 bytes = 0;
+    bool write = false;
+    bool ok = false;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
 
+      QueuedRequest* slot = FindQueued(requestId);
+
+      if (
+        !slot
+        || slot->synchronous
+        || slot->ownerId != Task::GetCurrentId()
+      ) {
+        return CompletionStatus::Failed;
+      }
+
+      if (slot->state != RequestState::Complete) {
+        return CompletionStatus::Pending;
+      }
+
+      bytes = slot->bytes;
+      write = slot->write;
+      ok = slot->ok;
+      data = ReleaseQueued(static_cast<UInt32>(slot - _queuedRequests));
+    }
+
+    if (ok && !write && buffer) {
+      CopyBytes(buffer, data, bytes);
+    }
+
+    Heap::Free(data);
+
+    return ok ? CompletionStatus::Success : CompletionStatus::Failed;
+  }
+
+  void BlockDevices::ReleaseTask(UInt32 taskId) {
+    UInt8* buffers[_maxQueuedRequests] = {};
+    UInt32 count = 0;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      for (UInt32 i = 0; i < _maxQueuedRequests; ++i) {
+        QueuedRequest& slot = _queuedRequests[i];
+
+        if (
+          slot.state == RequestState::Free
+          || slot.synchronous
+          || slot.ownerId != taskId
+        ) {
+          continue;
+        }
+
+        if (slot.state == RequestState::Complete) {
+          buffers[count++] = ReleaseQueued(i);
+        } else {
+          // still owned by the dispatcher; FinishQueued frees it
+          slot.orphaned = true;
+          slot.completionPortId = 0;
+        }
+      }
+    }
+
+    for (UInt32 i = 0; i < count; ++i) {
+      if (buffers[i]) {
+        Heap::Free(buffers[i]);
+      }
+    }
+  }
+
+  bool BlockDevices::TransferQueued(
+    UInt32 deviceId,
+    const BlockDevices::Request& request,
+    bool write
+  ) {
+    BlockDevices::Device snapshot {};
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      BlockDevices::Device* device = Find(deviceId);
+
+      if (!device) {
+        return false;
+      }
+
+      snapshot.info = device->info;
+      snapshot.portId = device->portId;
+      snapshot.sharedBuffer = device->sharedBuffer;
+    }
+
+    if (!_dispatcherStarted) {
+      return write
+        ? WriteDevice(snapshot, request)
+        : ReadDevice(snapshot, request);
+    }
+
+    UInt32 bytes = request.count * snapshot.info.sectorSize;
+    UInt8* data = reinterpret_cast<UInt8*>(Heap::Allocate(bytes));
+
+    if (!data) {
+      return false;
+    }
+
+    // the dispatcher runs in the kernel address space, so it works on a
+    // heap copy rather than the caller's buffer
+    if (write) {
+      CopyBytes(data, request.buffer, bytes);
+    }
+
+    UInt32 index = _noRequest;
+    bool missing = false;
+
+    for (;;) {
+      _queueSpaceWait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+        BlockDevices::Device* device = Find(deviceId);
+
+        if (!device) {
+          missing = true;
+        } else {
+          index = AllocateQueued(*device, true);
+        }
+
+        if (missing || index != _noRequest) {
+          _queueSpaceWait.Cancel();
+        }
+
+        if (index != _noRequest) {
+          QueuedRequest& slot = _queuedRequests[index];
+
+          slot.write = write;
+          slot.lba = request.lba;
+          slot.count = request.count;
+          slot.timeoutTicks = request.timeoutTicks;
+          slot.buffer = data;
+          slot.bytes = bytes;
+
+          EnqueueQueued(*device, index);
+        }
+      }
+
+      if (missing || index != _noRequest) {
+        break;
+      }
+
+      _queueSpaceWait.Wait(0);
+    }
+
+    if (missing) {
+      Heap::Free(data);
+
+      return false;
+    }
+
+    // the slot stays ours until released, so it is safe to hold onto
+    QueuedRequest& slot = _queuedRequests[index];
+
+    for (;;) {
+      slot.wait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+        if (slot.state == RequestState::Complete) {
+          slot.wait.Cancel();
+
+          break;
+        }
+      }
+
+      slot.wait.Wait(0);
+    }
+
+    bool ok = slot.ok;
+
+    if (ok && !write) {
+      CopyBytes(request.buffer, data, bytes);
+    }
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      ReleaseQueued(index);
+    }
+
+    Heap::Free(data);
+
+    return ok;
+  }
+
+  BlockDevices::QueuedRequest* BlockDevices::FindQueued(UInt32 requestId) {
+    UInt32 index = (requestId & 0xFF) - 1;
+
+    if (requestId == 0 || index >= _maxQueuedRequests) {
+      return nullptr;
+    }
+
+    QueuedRequest& slot = _queuedRequests[index];
+
+    if (slot.state == RequestState::Free || slot.id != requestId) {
+      return nullptr;
+    }
+
+    return &slot;
+  }
+
+  UInt32 BlockDevices::AllocateQueued(
+    BlockDevices::Device& device,
+    bool synchronous
+  ) {
+    if (device.queueLength >= _queueDepth) {
+      return _noRequest;
+    }
+
+    // uncollected asynchronous requests must never starve synchronous I/O
+    if (
+      !synchronous
+      && (
+        device.asyncLength >= _asyncQueueDepth
+        || _asyncRequests >= _maxAsyncRequests
+      )
+    ) {
+      return _noRequest;
+    }
+
+    for (UInt32 i = 0; i < _maxQueuedRequests; ++i) {
+      QueuedRequest& slot = _queuedRequests[i];
+
+      if (slot.state != RequestState::Free) {
+        continue;
+      }
+
+      // low byte selects the slot, the rest is a generation so a stale id
+      // can never collect a later request
+      _requestGeneration = (_requestGeneration + 1) & 0x00FFFFFF;
+
+      if (_requestGeneration == 0) {
+        _requestGeneration = 1;
+      }
+
+      slot.id = (_requestGeneration << 8) | (i + 1);
+      slot.state = RequestState::Queued;
+      slot.deviceId = device.info.id;
+      slot.write = false;
+      slot.lba = 0;
+      slot.count = 0;
+      slot.timeoutTicks = 0;
+      slot.buffer = nullptr;
+      slot.bytes = 0;
+      slot.ownerId = Task::GetCurrentId();
+      slot.completionPortId = 0;
+      slot.synchronous = synchronous;
+      slot.orphaned = false;
+      slot.cacheFill = false;
+      slot.generation = 0;
+      slot.ok = false;
+      slot.queuedTick = Timer::Ticks();
+      slot.next = _noRequest;
+      slot.wait.Initialize();
+
+      device.queueLength++;
+
+      if (!synchronous) {
+        device.asyncLength++;
+        _asyncRequests++;
+      }
+
+      return i;
+    }
+
+    return _noRequest;
+  }
+
+  UInt8* BlockDevices::ReleaseQueued(UInt32 index) {
+    QueuedRequest& slot = _queuedRequests[index];
+    UInt8* buffer = slot.buffer;
+    BlockDevices::Device* device = Find(slot.deviceId);
+
+    if (device && device->queueLength > 0) {
+      device->queueLength--;
+    }
+
+    if (!slot.synchronous) {
+      if (device && device->asyncLength > 0) {
+        device->asyncLength--;
+      }
+
+      if (_asyncRequests > 0) {
+        _asyncRequests--;
+      }
+    }
+
+    slot.id = 0;
+    slot.state = RequestState::Free;
+    slot.buffer = nullptr;
+
+    _queueSpaceWait.WakeAll();
+
+    return buffer;
+  }
+
+  void BlockDevices::EnqueueQueued(BlockDevices::Device& device, UInt32 index) {
+    QueuedRequest& slot = _queuedRequests[index];
+
+    slot.state = RequestState::Queued;
+    slot.next = _noRequest;
+
+    if (device.queueTail == _noRequest) {
+      device.queueHead = index;
+    } else {
+      _queuedRequests[device.queueTail].next = index;
+    }
+
+    device.queueTail = index;
+
+    _dispatchWait.WakeOne();
+  }
+
+  UInt32 BlockDevices::DequeueQueued(
+    BlockDevices::Device& outDevice,
+    UInt32* outIndices
+  ) {
+    for (UInt32 n = 0; n < _deviceCount; ++n) {
+      UInt32 position = (_dispatchCursor + n) % _deviceCount;
+      BlockDevices::Device* device = _devices[position];
+
+      if (!device || device->queueHead == _noRequest) {
+        continue;
+      }
+
+      UInt32 lead = SelectQueued(*device);
+      bool write = _queuedRequests[lead].write;
+      UInt32 startLBA = _queuedRequests[lead].lba;
+      UInt32 endLBA = startLBA + _queuedRequests[lead].count;
+      UInt32 bytes = _queuedRequests[lead].bytes;
+      UInt32 count = 1;
+      bool grown = true;
+
+      outIndices[0] = lead;
+      UnlinkQueued(*device, lead);
+
+      // absorb queued requests of the same direction that continue the
+      // batch exactly, in either direction
+      while (grown && count < _queueDepth) {
+        grown = false;
+
+        for (
+          UInt32 index = device->queueHead;
+          index != _noRequest;
+          index = _queuedRequests[index].next
+        ) {
+          QueuedRequest& slot = _queuedRequests[index];
+          bool after = slot.lba == endLBA;
+          bool before = slot.lba + slot.count == startLBA;
+
+          if (
+            slot.write != write
+            || (!after && !before)
+            || bytes + slot.bytes > _mergeMaxBytes
+            || IsQueuedBlocked(*device, index)
+          ) {
+            continue;
+          }
+
+          UnlinkQueued(*device, index);
+
+          if (after) {
+            outIndices[count] = index;
+            endLBA += slot.count;
+          } else {
+            for (UInt32 i = count; i > 0; --i) {
+              outIndices[i] = outIndices[i - 1];
+            }
+
+            outIndices[0] = index;
+            startLBA = slot.lba;
+          }
+
+          bytes += slot.bytes;
+          count++;
+          grown = true;
+
+          break;
+        }
+      }
+
+      for (UInt32 i = 0; i < count; ++i) {
+        _queuedRequests[outIndices[i]].state = RequestState::Active;
+      }
+
+      device->headLBA = endLBA;
+
+      outDevice.info = device->info;
+      outDevice.portId = device->portId;
+      outDevice.sharedBuffer = device->sharedBuffer;
+
+      // start after this device next time so one busy device cannot
+      // starve the others
+      _dispatchCursor = position + 1;
+
+      return count;
+    }
+
+    return 0;
+  }
+
+  UInt32 BlockDevices::SelectQueued(const BlockDevices::Device& device) {
+    switch (device.scheduler) {
+      case Scheduler::Deadline: {
+        UInt64 now = Timer::Ticks();
+
+        // the queue is in arrival order, so the first expired request is
+        // the oldest one
+        for (
+          UInt32 index = device.queueHead;
+          index != _noRequest;
+          index = _queuedRequests[index].next
+        ) {
+          QueuedRequest& slot = _queuedRequests[index];
+          UInt32 expire = slot.write ? _writeExpireTicks : _readExpireTicks;
+
+          if (
+            now - slot.queuedTick >= expire
+            && !IsQueuedBlocked(device, index)
+          ) {
+            return index;
+          }
+        }
+
+        return SelectElevator(device);
+      }
+
+      case Scheduler::Elevator:
+        return SelectElevator(device);
+
+      default:
+        return device.queueHead;
+    }
+  }
+
+  UInt32 BlockDevices::SelectElevator(const BlockDevices::Device& device) {
+    UInt32 headCylinder = CylinderOf(
+      device,
+      device.headLBA > 0 ? device.headLBA - 1 : 0
+    );
+    UInt32 ahead = _noRequest;
+    UInt32 wrapped = _noRequest;
+
+    for (
+      UInt32 index = device.queueHead;
+      index != _noRequest;
+      index = _queuedRequests[index].next
+    ) {
+      if (IsQueuedBlocked(device, index)) {
+        continue;
+      }
+
+      UInt32 lba = _queuedRequests[index].lba;
+      UInt32& best = CylinderOf(device, lba) >= headCylinder
+        ? ahead
+        : wrapped;
+
+      if (best == _noRequest || lba < _queuedRequests[best].lba) {
+        best = index;
+      }
+    }
+
+    if (ahead != _noRequest) {
+      return ahead;
+    }
+
+    // nothing left on the way out; sweep again from the lowest cylinder
+    return wrapped != _noRequest ? wrapped : device.queueHead;
+  }
+
+  bool BlockDevices::IsQueuedBlocked(
+    const BlockDevices::Device& device,
+    UInt32 index
+  ) {
+    QueuedRequest& target = _queuedRequests[index];
+
+    for (
+      UInt32 i = device.queueHead;
+      i != _noRequest && i != index;
+      i = _queuedRequests[i].next
+    ) {
+      QueuedRequest& earlier = _queuedRequests[i];
+
+      if (!earlier.write && !target.write) {
+        continue;
+      }
+
+      if (
+        earlier.lba < target.lba + target.count
+        && target.lba < earlier.lba + earlier.count
+      ) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void BlockDevices::UnlinkQueued(BlockDevices::Device& device, UInt32 index) {
+    UInt32 previous = _noRequest;
+    UInt32 current = device.queueHead;
+
+    while (current != _noRequest && current != index) {
+      previous = current;
+      current = _queuedRequests[current].next;
+    }
+
+    if (current == _noRequest) {
+      return;
+    }
+
+    UInt32 next = _queuedRequests[index].next;
+
+    if (previous == _noRequest) {
+      device.queueHead = next;
+    } else {
+      _queuedRequests[previous].next = next;
+    }
+
+    if (device.queueTail == index) {
+      device.queueTail = previous;
+    }
+
+    _queuedRequests[index].next = _noRequest;
+  }
+
+  UInt32 BlockDevices::CylinderOf(
+    const BlockDevices::Device& device,
+    UInt32 lba
+  ) {
+    UInt32 perCylinder = device.info.sectorsPerTrack * device.info.headCount;
+
+    return perCylinder != 0 ? lba / perCylinder : lba;
+  }
+
+  void BlockDevices::ExecuteQueued(
+    BlockDevices::Device& device,
+    const UInt32* indices,
+    UInt32 count
+  ) {
+    UInt32 bytes = 0;
+    UInt32 sectors = 0;
+
+    for (UInt32 i = 0; i < count; ++i) {
+      bytes += _queuedRequests[indices[i]].bytes;
+      sectors += _queuedRequests[indices[i]].count;
+    }
+
+    UInt8* merged = nullptr;
+
+    if (count > 1) {
+      merged = reinterpret_cast<UInt8*>(Heap::Allocate(bytes));
+
+      if (!merged) {
+        // no room to merge; run the requests back to back instead
+        for (UInt32 i = 0; i < count; ++i) {
+          ExecuteQueued(device, &indices[i], 1);
+        }
+
+        return;
+      }
+    }
+
+    // dequeued slots belong to the dispatcher, so they can be read unlocked
+    QueuedRequest& first = _queuedRequests[indices[0]];
+    bool write = first.write;
+    UInt32 offset = 0;
+
+    if (merged && write) {
+      for (UInt32 i = 0; i < count; ++i) {
+        QueuedRequest& slot = _queuedRequests[indices[i]];
+
+        CopyBytes(merged + offset, slot.buffer, slot.bytes);
+
+        offset += slot.bytes;
+      }
+    }
+
+    Request request {};
+
+    request.deviceId = first.deviceId;
+    request.lba = first.lba;
+    request.count = sectors;
+    request.buffer = merged ? merged : first.buffer;
+    request.timeoutTicks = first.timeoutTicks;
+
+    bool ok = write
+      ? WriteDevice(device, request)
+      : ReadDevice(device, request);
+
+    offset = 0;
+
+    for (UInt32 i = 0; i < count; ++i) {
+      QueuedRequest& slot = _queuedRequests[indices[i]];
+
+      if (merged && ok && !write) {
+        CopyBytes(slot.buffer, merged + offset, slot.bytes);
+      }
+
+      offset += slot.bytes;
+
+      if (ok && slot.cacheFill) {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+        CacheFill(
+          slot.deviceId,
+          slot.lba,
+          slot.count,
+          slot.buffer,
+          slot.generation
+        );
+      }
+
+      FinishQueued(indices[i], ok);
+    }
+
+    Heap::Free(merged);
+  }
+
+  void BlockDevices::FinishQueued(UInt32 index, bool ok) {
+    CompletionMessage notice {};
+    UInt32 portId = 0;
+    UInt8* orphanBuffer = nullptr;
+    bool orphaned = false;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      QueuedRequest& slot = _queuedRequests[index];
+
+      // the submitter exited, so nobody is left to collect the result
+      if (slot.orphaned) {
+        orphaned = true;
+        orphanBuffer = ReleaseQueued(index);
+      }
+    }
+
+    if (orphaned) {
+      if (orphanBuffer) {
+        Heap::Free(orphanBuffer);
+      }
+
+      return;
+    }
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      QueuedRequest& slot = _queuedRequests[index];
+
+      slot.ok = ok;
+      slot.state = RequestState::Complete;
+
+      notice.op = Operation::Complete;
+      notice.requestId = slot.id;
+      notice.deviceId = slot.deviceId;
+      notice.status = ok ? 0 : 1;
+      portId = slot.completionPortId;
+
+      slot.wait.WakeOne();
+    }
+
+    // never block the dispatcher on a client port; a dropped notice still
+    // leaves the result for Complete to collect
+    if (portId != 0) {
+      if (
+        !IPC::SendNoWait(portId, Task::GetCurrentId(), &notice, sizeof(notice))
+      ) {
+        Logger::WriteFormatted(
+          LogLevel::Debug,
+          "BlockDevices: completion notice for request %u dropped",
+          notice.requestId
+        );
+      }
+    }
+  }
+
+  UInt32 BlockDevices::DetachQueued(
+    BlockDevices::Device& device,
+    UInt32* outIndices
+  ) {
+    UInt32 count = 0;
+    UInt32 index = device.queueHead;
+
+    while (index != _noRequest && count < _queueDepth) {
+      QueuedRequest& slot = _queuedRequests[index];
+
+      // detached slots look active so nothing else touches them until
+      // they are failed
+      slot.state = RequestState::Active;
+      outIndices[count++] = index;
+      index = slot.next;
+      slot.next = _noRequest;
+    }
+
+    device.queueHead = _noRequest;
+    device.queueTail = _noRequest;
+
+    return count;
+  }
+
+  void BlockDevices::DispatchTask() {
+    for (;;) {
+      BlockDevices::Device device {};
+      UInt32 indices[_queueDepth] = {};
+      UInt32 count = 0;
+
+      _dispatchWait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+        count = DequeueQueued(device, indices);
+
+        if (count > 0) {
+          _dispatchWait.Cancel();
+        }
+      }
+
+      if (count == 0) {
+        _dispatchWait.Wait(0);
+
+        continue;
+      }
+
+      ExecuteQueued(device, indices, count);
+    }
+  }
+
+  BlockDevices::Device* BlockDevices::Find(UInt32 deviceId) {
+    for (UInt32 i = 0; i < _deviceCount; ++i) {
+      if (_devices[i] && _devices[i]->info.id == deviceId) {
+        return _devices[i];
+      }
+    }
+
+    return nullptr;
+  }
+
+  BlockDeviceObject* BlockDevices::GetObject(UInt32 deviceId) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    BlockDevices::Device* device = Find(deviceId);
+
+    if (!device) {
+      return nullptr;
+    }
+
+    return device->object;
+  }
+
+  bool BlockDevices::ValidateRequest(
+    const BlockDevices::Device& device,
+    const BlockDevices::Request& request
+  ) {
+    if (request.count == 0 || request.buffer == nullptr) {
+      return false;
+    }
+
+    if (device.info.sectorSize == 0 || device.info.sectorCount == 0) {
+      return false;
+    }
+
+    UInt64 start = request.lba;
+    UInt64 count = request.count;
+    UInt64 end = start + count;
+    UInt64 max = device.info.sectorCount;
+
+    if (start >= max || count > max || end > max) {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool BlockDevices::Bind(UInt32 deviceId, UInt32 portId) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    BlockDevices::Device* device = Find(deviceId);
+
+    if (!device || portId == 0) {
+      return false;
+    }
+
+    UInt32 ownerId = 0;
+
+    if (!IPC::GetPortOwner(portId, ownerId)) {
+      return false;
+    }
+
+    if (ownerId != Task::GetCurrentId()) {
+      return false;
+    }
+
+    device->portId = portId;
+    device->info.flags |= static_cast<UInt32>(BlockDevices::Flag::Ready);
+    device->sharedBuffer = _dmaBufferPhysical != 0
+      && _dmaBufferOwnerId == ownerId
+      && _dmaBufferPhysical + _dmaBufferBytes <= _dmaKernelVisibleLimit;
+
+    return true;
+  }
+
+  bool BlockDevices::SendRequest(
+    BlockDevices::Device& device,
+    const BlockDevices::Request& request,
+    bool write,
+    bool bulk
+  ) {
+    if (device.portId == 0) {
+      return false;
+    }
+
+    UInt32 bytes = request.count * device.info.sectorSize;
+
+    if (bytes > (bulk ? _dmaBufferBytes : messageDataBytes)) {
+      return false;
+    }
+
+    Message msg {};
+
+    if (bulk) {
+      msg.op = write ? Operation::WriteBulk : Operation::ReadBulk;
+    } else {
+      msg.op = write ? Operation::Write : Operation::Read;
+    }
+
+    msg.deviceId = request.deviceId;
+    msg.lba = request.lba;
+    msg.count = request.count;
+    msg.replyPortId = 0;
+    msg.status = 0;
+    msg.dataLength = write && !bulk ? bytes : 0;
+
+    if (msg.dataLength > 0) {
+      CopyBytes(msg.data, request.buffer, bytes);
+    }
+
+    UInt32 length = messageHeaderBytes + msg.dataLength;
+    UInt32 senderId = 0;
+    UInt32 responseLength = 0;
+    UInt32 timeoutTicks = request.timeoutTicks != 0
+      ? request.timeoutTicks
+      : _requestTimeoutTicks;
+
+    // the driver answers through the call's reply slot, which overwrites the
+    // request in place
+    bool replied = IPC::Call(
+      device.portId,
+      Task::GetCurrentId(),
+      &msg,
+      length,
+      senderId,
+      &msg,
+      sizeof(msg),
+      responseLength,
+      timeoutTicks
+    );
+
+    (void)senderId;
+    (void)responseLength;
+
+    if (!replied) {
+      return false;
+    }
+
+    Message& response = msg;
+
+    if (response.op != Operation::Response || response.status != 0) {
+      return false;
+    }
+
+    if (!write && !bulk) {
+      if (response.dataLength != bytes) {
+        return false;
+      }
+
+      if (bytes > 0) {
+        CopyBytes(request.buffer, response.data, bytes);
+      }
+    }
+
+    return true;
+  }
+
+  bool BlockDevices::TransferBulk(
+    BlockDevices::Device& device,
+    const BlockDevices::Request& request,
+    bool write
+  ) {
+    UInt32 sectorSize = device.info.sectorSize;
+    UInt32 maxPerChunk = sectorSize != 0 ? _dmaBufferBytes / sectorSize : 0;
+
+    if (maxPerChunk == 0) {
+      return false;
+    }
+
+    AcquireSharedBuffer();
+
+    // the buffer sits below the kernel-visible limit, so it is reachable
+    // through the identity map regardless of the current address space
+    UInt8* shared = reinterpret_cast<UInt8*>(_dmaBufferPhysical);
+    UInt8* buffer = reinterpret_cast<UInt8*>(request.buffer);
+    UInt32 remaining = request.count;
+    UInt32 lba = request.lba;
+    bool ok = true;
+
+    while (remaining > 0) {
+      UInt32 toTransfer = remaining < maxPerChunk ? remaining : maxPerChunk;
+      UInt32 bytes = toTransfer * sectorSize;
+      Request chunk {};
+
+      chunk.deviceId = request.deviceId;
+      chunk.lba = lba;
+      chunk.count = toTransfer;
+      chunk.buffer = buffer;
+      chunk.timeoutTicks = request.timeoutTicks;
+
+      if (write) {
+        CopyBytes(shared, buffer, bytes);
+      }
+
+      if (!SendRequest(device, chunk, write, true)) {
+        // without a reply the driver may still be moving this chunk, so the
+        // buffer is not handed to anyone else until it is confirmed idle
+        _dmaBufferFencePort = device.portId;
+        ok = false;
+
+        break;
+      }
+
+      if (!write) {
+        CopyBytes(buffer, shared, bytes);
+      }
+
+      remaining -= toTransfer;
+      lba += toTransfer;
+      buffer += bytes;
+    }
+
+    ReleaseSharedBuffer();
+
+    return ok;
+  }
+
+  void BlockDevices::AcquireSharedBuffer() {
+    for (;;) {
+      _dmaBufferWait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+        if (!_dmaBufferBusy) {
+          _dmaBufferBusy = true;
+          _dmaBufferWait.Cancel();
+
+          break;
+        }
+      }
+
+      _dmaBufferWait.Wait(0);
+    }
+
+    if (_dmaBufferFencePort != 0) {
+      FenceSharedBuffer();
+    }
+  }
+
+  void BlockDevices::FenceSharedBuffer() {
+    UInt32 portId = _dmaBufferFencePort;
+    UInt32 ownerId = 0;
+
+    while (IPC::GetPortOwner(portId, ownerId)) {
+      Message msg {};
+
+      msg.op = Operation::Read;
+      msg.count = 0;
+
+      UInt32 senderId = 0;
+      UInt32 responseLength = 0;
+
+      // any reply will do, including an error status
+      if (
+        IPC::Call(
+          portId,
+          Task::GetCurrentId(),
+          &msg,
+          messageHeaderBytes,
+          senderId,
+          &msg,
+          sizeof(msg),
+          responseLength,
+          _requestTimeoutTicks
+        )
+      ) {
+        break;
+      }
+
+      Logger::Write(
+        LogLevel::Warning,
+        "BlockDevices: waiting for driver to release DMA buffer"
+      );
+    }
+
+    _dmaBufferFencePort = 0;
+  }
+
+  void BlockDevices::ReleaseSharedBuffer() {
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    _dmaBufferBusy = false;
+    _dmaBufferWait.WakeOne();
+  }
+
+  void BlockDevices::AcquireCacheFlush() {
+    for (;;) {
+      _cacheFlushWait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+        if (!_cacheFlushBusy) {
+          _cacheFlushBusy = true;
+          _cacheFlushWait.Cancel();
+
+          return;
+        }
+      }
+
+      _cacheFlushWait.Wait(0);
+    }
+  }
+
+  void BlockDevices::ReleaseCacheFlush() {
+    Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+    _cacheFlushBusy = false;
+    _cacheFlushWait.WakeOne();
+  }
+
+  bool BlockDevices::ConfigureCache(UInt32 blocks) {
+    if (blocks > _cacheMaxBlocks) {
+      return false;
+    }
+
+    if (!Flush(0)) {
+      return false;
+    }
+
+    CacheEntry* entries = nullptr;
+    UInt8* data = nullptr;
+
+    if (blocks > 0) {
+      entries = reinterpret_cast<CacheEntry*>(
+        Heap::Allocate(sizeof(CacheEntry) * blocks)
+      );
+      data = reinterpret_cast<UInt8*>(Heap::Allocate(blocks * cacheBlockBytes));
+
+      if (!entries || !data) {
+        Heap::Free(entries);
+        Heap::Free(data);
+
+        return false;
+      }
+
+      for (UInt32 i = 0; i < blocks; ++i) {
+        entries[i].deviceId = 0;
+        entries[i].lba = 0;
+        entries[i].valid = false;
+        entries[i].dirty = false;
+        entries[i].flushing = false;
+        entries[i].hashNext = _cacheNone;
+        entries[i].lruPrev = i == 0 ? _cacheNone : i - 1;
+        entries[i].lruNext = i + 1 == blocks ? _cacheNone : i + 1;
+        entries[i].data = data + i * cacheBlockBytes;
+      }
+    }
+
+    CacheEntry* oldEntries = nullptr;
+    UInt8* oldData = nullptr;
+    bool swapped = false;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+      // a write may have dirtied the cache again since the flush above
+      if (_cacheDirty == 0) {
+        oldEntries = _cacheEntries;
+        oldData = _cacheData;
+
+        _cacheEntries = entries;
+        _cacheData = data;
+        _cacheCapacity = blocks;
+        _cacheUsed = 0;
+        _cacheHead = blocks > 0 ? 0 : _cacheNone;
+        _cacheTail = blocks > 0 ? blocks - 1 : _cacheNone;
+
+        for (UInt32 i = 0; i < _cacheBucketCount; ++i) {
+          _cacheBuckets[i] = _cacheNone;
+        }
+
+        swapped = true;
+      }
+    }
+
+    if (!swapped) {
+      Heap::Free(entries);
+      Heap::Free(data);
+
+      return false;
+    }
+
+    Heap::Free(oldEntries);
+    Heap::Free(oldData);
+
+    return true;
+  }
+
+  bool BlockDevices::Flush(UInt32 deviceId) {
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+      if (_cacheDirty == 0) {
+        return true;
+      }
+    }
+
+    AcquireCacheFlush();
+
+    bool ok = true;
+
+    for (;;) {
+      UInt32 targetId = 0;
+      UInt32 startLBA = 0;
+      UInt32 count = 0;
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+        UInt32 first = _cacheNone;
+
+        // start from the lowest dirty block so the batch can grow upward
+        for (UInt32 i = 0; i < _cacheCapacity; ++i) {
+          CacheEntry& entry = _cacheEntries[i];
+
+          if (!entry.valid || !entry.dirty) {
+            continue;
+          }
+
+          if (deviceId != 0 && entry.deviceId != deviceId) {
+            continue;
+          }
+
+          if (
+            first == _cacheNone
+            || (
+              entry.deviceId == _cacheEntries[first].deviceId
+              && entry.lba < _cacheEntries[first].lba
+            )
+          ) {
+            first = i;
+          }
+        }
+
+        if (first == _cacheNone) {
+          break;
+        }
+
+        targetId = _cacheEntries[first].deviceId;
+        startLBA = _cacheEntries[first].lba;
+
+        // staged blocks stay dirty, and so stay cached, until the write
+        // reaches the device; evicting one earlier would let a miss read
+        // back the old sectors
+        while (count < _cacheFlushBatch) {
+          UInt32 index = CacheFind(targetId, startLBA + count);
+
+          if (index == _cacheNone || !_cacheEntries[index].dirty) {
+            break;
+          }
+
+          CopyBytes(
+            _cacheFlushBuffer + count * cacheBlockBytes,
+            _cacheEntries[index].data,
+            cacheBlockBytes
+          );
+
+          _cacheEntries[index].flushing = true;
+          count++;
+        }
+      }
+
+      bool found = false;
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+        found = Find(targetId) != nullptr;
+      }
+
+      if (!found) {
+        Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+        CacheInvalidate(targetId);
+
+        continue;
+      }
+
+      Request request {};
+
+      request.deviceId = targetId;
+      request.lba = startLBA;
+      request.count = count;
+      request.buffer = _cacheFlushBuffer;
+
+      bool written = TransferQueued(targetId, request, true);
+      Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+      // blocks rewritten during the transfer lost their flag and stay dirty
+      for (UInt32 i = 0; i < count; ++i) {
+        UInt32 index = CacheFind(targetId, startLBA + i);
+
+        if (index == _cacheNone || !_cacheEntries[index].flushing) {
+          continue;
+        }
+
+        _cacheEntries[index].flushing = false;
+
+        if (written) {
+          _cacheEntries[index].dirty = false;
+          _cacheDirty--;
+        }
+      }
+
+      if (!written) {
+        ok = false;
+
+        break;
+      }
+
+      _cacheWriteBacks += count;
+    }
+
+    ReleaseCacheFlush();
+
+    if (!ok) {
+      Logger::Write(LogLevel::Warning, "BlockDevices: cache write-back failed");
+    }
+
+    return ok;
+  }
+
+  void BlockDevices::GetCacheStats(BlockDevices::CacheStats& outStats) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_cacheLock);
+
+    outStats.capacity = _cacheCapacity;
+    outStats.used = _cacheUsed;
+    outStats.dirty = _cacheDirty;
+    outStats.hits = _cacheHits;
+    outStats.misses = _cacheMisses;
+    outStats.writeBacks = _cacheWriteBacks;
+    outStats.evictions = _cacheEvictions;
+  }
+
+  bool BlockDevices::IsCacheable(const BlockDevices::Device& device) {
+    return _cacheCapacity != 0 && device.info.sectorSize == cacheBlockBytes;
+  }
+
+  UInt32 BlockDevices::CacheHash(UInt32 deviceId, UInt32 lba) {
+    return (deviceId * 131 + lba) % _cacheBucketCount;
+  }
+
+  UInt32 BlockDevices::CacheFind(UInt32 deviceId, UInt32 lba) {
+    if (_cacheCapacity == 0) {
+      return _cacheNone;
+    }
+
+    UInt32 index = _cacheBuckets[CacheHash(deviceId, lba)];
+
+    while (index != _cacheNone) {
+      CacheEntry& entry = _cacheEntries[index];
+
+      if (entry.deviceId == deviceId && entry.lba == lba) {
+        return index;
+      }
+
+      index = entry.hashNext;
+    }
+
+    return _cacheNone;
+  }
+
+  void BlockDevices::CacheTouch(UInt32 index, bool mostRecent) {
+    CacheEntry& entry = _cacheEntries[index];
+
+    if (mostRecent ? _cacheHead == index : _cacheTail == index) {
+      return;
+    }
+
+    if (entry.lruPrev != _cacheNone) {
+      _cacheEntries[entry.lruPrev].lruNext = entry.lruNext;
+    } else {
+      _cacheHead = entry.lruNext;
+    }
+
+    if (entry.lruNext != _cacheNone) {
+      _cacheEntries[entry.lruNext].lruPrev = entry.lruPrev;
+    } else {
+      _cacheTail = entry.lruPrev;
+    }
+
+    if (mostRecent) {
+      entry.lruPrev = _cacheNone;
+      entry.lruNext = _cacheHead;
+
+      if (_cacheHead != _cacheNone) {
+        _cacheEntries[_cacheHead].lruPrev = index;
+      }
+
+      _cacheHead = index;
+
+      if (_cacheTail == _cacheNone) {
+        _cacheTail = index;
+      }
+    } else {
+      entry.lruNext = _cacheNone;
+      entry.lruPrev = _cacheTail;
+
+      if (_cacheTail != _cacheNone) {
+        _cacheEntries[_cacheTail].lruNext = index;
+      }
+
+      _cacheTail = index;
+
+      if (_cacheHead == _cacheNone) {
+        _cacheHead = index;
+      }
+    }
+  }
+
+  void BlockDevices::CacheRemove(UInt32 index) {
+    CacheEntry& entry = _cacheEntries[index];
+    UInt32* link = &_cacheBuckets[CacheHash(entry.deviceId, entry.lba)];
+
+    while (*link != _cacheNone) {
+      if (*link == index) {
+        *link = entry.hashNext;
+
+        break;
+      }
+
+      link = &_cacheEntries[*link].hashNext;
+    }
+
+    if (entry.dirty) {
+      _cacheDirty--;
+    }
+
+    entry.hashNext = _cacheNone;
+    entry.valid = false;
+    entry.dirty = false;
+    entry.flushing = false;
+    _cacheUsed--;
+
+    // free entries collect at the tail so they are reused first
+    CacheTouch(index, false);
+  }
+
+  bool BlockDevices::CacheStore(
+    UInt32 deviceId,
+    UInt32 lba,
+    const UInt8* data,
+    UInt32 bytes,
+    bool dirty
+  ) {
+    UInt32 index = CacheFind(deviceId, lba);
+
+    if (index == _cacheNone) {
+      // reuse the least recently used entry that is free or clean
+      for (
+        UInt32 i = _cacheTail;
+        i != _cacheNone;
+        i = _cacheEntries[i].lruPrev
+      ) {
+        if (!_cacheEntries[i].valid || !_cacheEntries[i].dirty) {
+          index = i;
+
+          break;
+        }
+      }
+
+      if (index == _cacheNone) {
+        return false;
+      }
+
+      if (_cacheEntries[index].valid) {
+        CacheRemove(index);
+
+        _cacheEvictions++;
+      }
+
+      CacheEntry& entry = _cacheEntries[index];
+      UInt32 bucket = CacheHash(deviceId, lba);
+
+      entry.deviceId = deviceId;
+      entry.lba = lba;
+      entry.valid = true;
+      entry.dirty = false;
+      entry.flushing = false;
+      entry.hashNext = _cacheBuckets[bucket];
+      _cacheBuckets[bucket] = index;
+      _cacheUsed++;
+    }
+
+    CacheEntry& entry = _cacheEntries[index];
+
+    CopyBytes(entry.data, data, bytes);
+
+    if (dirty) {
+      if (!entry.dirty) {
+        entry.dirty = true;
+        _cacheDirty++;
+      }
+
+      // a staged write-back now carries old data
+      entry.flushing = false;
+      _cacheWriteGeneration++;
+    }
+
+    CacheTouch(index, true);
+
+    return true;
+  }
+
+  void BlockDevices::CacheFill(
+    UInt32 deviceId,
+    UInt32 lba,
+    UInt32 count,
+    UInt8* buffer,
+    UInt32 generation
+  ) {
+    // a cached write that landed while the read was in flight is newer
+    // than what the device returned, and one that has since been written
+    // back and evicted makes the fetched copy unsafe to keep
+    bool keep = generation == _cacheWriteGeneration;
+
+    for (UInt32 i = 0; i < count; ++i) {
+      UInt8* sector = buffer + i * cacheBlockBytes;
+      UInt32 index = CacheFind(deviceId, lba + i);
+
+      if (index != _cacheNone) {
+        CopyBytes(sector, _cacheEntries[index].data, cacheBlockBytes);
+        CacheTouch(index, true);
+      } else if (keep) {
+        CacheStore(deviceId, lba + i, sector, cacheBlockBytes, false);
+      }
+    }
+  }
+
+  void BlockDevices::CacheUpdate(
+    UInt32 deviceId,
+    UInt32 lba,
+    UInt32 count,
+    const UInt8* data
+  ) {
+    for (UInt32 i = 0; i < count; ++i) {
+      UInt32 index = CacheFind(deviceId, lba + i);
+
+      if (index != _cacheNone) {
+        CopyBytes(
+          _cacheEntries[index].data,
+          data + i * cacheBlockBytes,
+          cacheBlockBytes
+        );
+        CacheTouch(index, true);
+      }
+    }
+
+    _cacheWriteGeneration++;
+  }
+
+  UInt32 BlockDevices::CacheInvalidate(UInt32 deviceId) {
+    UInt32 dropped = 0;
+
+    for (UInt32 i = 0; i < _cacheCapacity; ++i) {
+      CacheEntry& entry = _cacheEntries[i];
+
+      if (!entry.valid || entry.deviceId != deviceId) {
+        continue;
+      }
+
+      if (entry.dirty) {
+        dropped++;
+      }
+
+      CacheRemove(i);
+    }
+
+    return dropped;
+  }
+}
@@ -17,4 +17,8 @@ namespace Quantum::System::Kernel::Devices {
     BlockDevices::Initialize();
     InputDevices::Initialize();
   }
+
+  void DeviceManager::Start() {
+    BlockDevices::StartDispatcher();
+  }
 }
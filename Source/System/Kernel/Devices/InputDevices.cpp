@@ -9,6 +9,7 @@
 #include "Devices/InputDevices.hpp"
 #include "Task.hpp"
 #include "Sync/ScopedLock.hpp"
+#include "Timer.hpp"
 
 namespace Quantum::System::Kernel::Devices {
   using Kernel::Task;
@@ -236,11 +237,35 @@ namespace Quantum::System::Kernel::Devices {
     InputDevices::Event& outEvent,
     UInt32 timeoutTicks
   ) {
-    UInt32 remaining = timeoutTicks;
+    return ReadEventUntil(
+      deviceId,
+      outEvent,
+      Timer::Now() + Timer::TicksToCounts(timeoutTicks)
+    );
+  }
 
-    for (;;) {
-      InputDevices::Device* device = nullptr;
+  bool InputDevices::ReadEventTimeoutNanoseconds(
+    UInt32 deviceId,
+    InputDevices::Event& outEvent,
+    UInt64 timeoutNanoseconds
+  ) {
+    UInt64 now = Timer::Now();
+    UInt64 deadline = timeoutNanoseconds != 0
+      ? now + Timer::NanosecondsToCounts(timeoutNanoseconds)
+      : now;
 
+    return ReadEventUntil(deviceId, outEvent, deadline);
+  }
+
+  bool InputDevices::ReadEventUntil(
+    UInt32 deviceId,
+    InputDevices::Event& outEvent,
+    UInt64 deadline
+  ) {
+    bool expired = deadline <= Timer::Now();
+    InputDevices::Device* device = nullptr;
+
+    for (;;) {
       {
         Sync::ScopedLock<Sync::SpinLock> guard(_lock);
 
@@ -254,7 +279,11 @@ namespace Quantum::System::Kernel::Devices {
           return false;
         }
 
+        device->waitQueue.Prepare();
+
         if (device->head != device->tail) {
+          device->waitQueue.Cancel();
+
           outEvent = device->events[device->tail];
           device->tail = (device->tail + 1) % eventQueueSize;
 
@@ -262,15 +291,13 @@ namespace Quantum::System::Kernel::Devices {
         }
       }
 
-      if (remaining == 0) {
+      if (expired) {
+        device->waitQueue.Cancel();
+
         return false;
       }
 
-      bool woken = device->waitQueue.WaitTicks(1);
-
-      if (!woken && remaining > 0) {
-        remaining -= 1;
-      }
+      expired = !device->waitQueue.WaitUntil(deadline);
     }
   }
 
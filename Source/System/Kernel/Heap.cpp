@@ -16,6 +16,7 @@
 #include "Logger.hpp"
 #include "Panic.hpp"
 #include "Prelude.hpp"
+#include "Sync/ScopedIRQLock.hpp"
 
 namespace Quantum::System::Kernel {
   using ::Quantum::AlignDown;
@@ -396,6 +397,8 @@ namespace Quantum::System::Kernel {
   }
 
   void* Heap::Allocate(Size size) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     UInt32 requested = AlignUp(static_cast<UInt32>(size), 8);
     int binIndex = BinIndexForSize(requested);
     UInt32 binSize = (binIndex >= 0) ? _binSizes[binIndex] : requested;
@@ -569,6 +572,8 @@ namespace Quantum::System::Kernel {
   void Heap::Free(void* pointer) {
     if (!pointer) return;
 
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     UInt8* bytePointer = reinterpret_cast<UInt8*>(pointer);
 
     if (
@@ -679,8 +684,8 @@ namespace Quantum::System::Kernel {
         LogLevel::Error,
         "Heap state: mapped=%p freeBytes=%p freeBlocks=%p",
         _heapMappedBytes,
-        GetHeapState().freeBytes,
-        GetHeapState().freeBlocks
+        CollectHeapState().freeBytes,
+        CollectHeapState().freeBlocks
       );
 
       PANIC("Heap free: canary corrupted");
@@ -698,6 +703,12 @@ namespace Quantum::System::Kernel {
   }
 
   Heap::HeapState Heap::GetHeapState() {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    return CollectHeapState();
+  }
+
+  Heap::HeapState Heap::CollectHeapState() {
     Heap::HeapState state {};
     UInt32 freeBytes = 0;
     UInt32 blocks = 0;
@@ -729,6 +740,8 @@ namespace Quantum::System::Kernel {
   }
 
   bool Heap::VerifyHeap() {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     EnsureHeapInitialized();
 
     bool ok = true;
@@ -825,6 +838,8 @@ namespace Quantum::System::Kernel {
   }
 
   void Heap::ResetHeap() {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
     EnsureHeapInitialized();
 
     // clear bin free lists
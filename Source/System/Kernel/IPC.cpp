@@ -14,12 +14,14 @@
 #include "Sync/ScopedLock.hpp"
 #include "Sync/ScopedIRQLock.hpp"
 #include "Task.hpp"
+#include "Timer.hpp"
 #include "WaitQueue.hpp"
 
 namespace Quantum::System::Kernel {
   using ::Quantum::CopyBytes;
   using Objects::IPCPortObject;
   using Objects::KernelObject;
+  using Objects::PortSetObject;
 
   bool IPC::ConsumeIRQPending(IPC::Port& port, IPC::Message& msg) {
     if (port.irqPayloadLength == 0) {
@@ -34,6 +36,7 @@ namespace Quantum::System::Kernel {
       if (port.irqPending.CompareExchange(expected, desired)) {
         msg.senderId = port.irqSenderId;
         msg.length = port.irqPayloadLength;
+        msg.replyToken = 0;
         msg.hasTransfer = false;
         msg.transferObject = nullptr;
         msg.transferRights = 0;
@@ -57,6 +60,28 @@ namespace Quantum::System::Kernel {
     return nullptr;
   }
 
+  IPC::PortSet* IPC::FindPortSet(UInt32 id) {
+    for (UInt32 i = 0; i < _maxPortSets; ++i) {
+      if (_portSets[i].used && _portSets[i].id == id) {
+        return &_portSets[i];
+      }
+    }
+
+    return nullptr;
+  }
+
+  void IPC::WakeReceivers(IPC::Port& port, bool boost) {
+    port.recvWait.WakeOne(boost);
+
+    // read without the set lock; a stale pointer only costs the set waiter a
+    // spurious wakeup, since it rechecks its ports before returning
+    PortSet* set = port.portSet;
+
+    if (set) {
+      set->wait.WakeOne(boost);
+    }
+  }
+
   UInt32 IPC::CreatePort() {
     Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
 
@@ -75,6 +100,7 @@ namespace Quantum::System::Kernel {
         _ports[i].irqPending.Store(0);
         _ports[i].irqSenderId = 0;
         _ports[i].irqPayloadLength = 0;
+        _ports[i].portSet = nullptr;
 
         if (!_ports[i].object) {
           _ports[i].used = false;
@@ -91,67 +117,187 @@ namespace Quantum::System::Kernel {
     return 0;
   }
 
-  bool IPC::Send(
-    UInt32 portId,
-    UInt32 senderId,
-    const void* buffer,
-    UInt32 length
-  ) {
-    if (!buffer || length == 0 || length > maxPayloadBytes) {
-      return false;
+  bool IPC::Dequeue(IPC::Port& port, IPC::Message& msg) {
+    if (port.count > 0) {
+      msg = port.queue[port.head];
+
+      port.head = (port.head + 1) % maxQueueDepth;
+      --port.count;
+
+      port.sendWait.WakeOne();
+
+      return true;
     }
 
-    Port* port = nullptr;
+    return ConsumeIRQPending(port, msg);
+  }
 
-    {
-      Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
-      port = FindPort(portId);
+  void IPC::Deliver(
+    IPC::Message& msg,
+    UInt32& outSenderId,
+    void* outBuffer,
+    UInt32 bufferCapacity,
+    UInt32& outLength,
+    UInt32* outReplyToken
+  ) {
+    outSenderId = msg.senderId;
+    outLength = msg.length;
+
+    if (msg.replyToken != 0) {
+      if (outReplyToken) {
+        Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+        ReplySlot* slot = FindReplySlot(msg.replyToken);
+
+        if (slot) {
+          slot->replierTaskId = Task::GetCurrentId();
+        }
+      } else {
+        // the receiver cannot reply, so fail the caller now rather than
+        // leaving it to time out
+        AbandonReply(msg.replyToken);
+      }
     }
 
-    if (!port) {
-      return false;
+    if (outReplyToken) {
+      *outReplyToken = msg.replyToken;
+    }
+
+    if (msg.hasTransfer && msg.transferObject) {
+      KernelObject* obj = msg.transferObject;
+      UInt32 rights = msg.transferRights;
+      UInt32 handleValue = 0;
+
+      Task::ControlBlock* tcb = Task::GetCurrent();
+
+      if (tcb && tcb->handleTable) {
+        handleValue = tcb->handleTable->Create(obj->type, obj, rights);
+      }
+
+      obj->Release();
+
+      UInt32 payload[2] = { 1, handleValue };
+
+      CopyBytes(msg.data, payload, sizeof(payload));
+
+      msg.length = sizeof(payload);
+      outLength = msg.length;
     }
 
+    UInt32 toCopy = msg.length < bufferCapacity ? msg.length : bufferCapacity;
+
+    CopyBytes(outBuffer, msg.data, toCopy);
+  }
+
+  bool IPC::Enqueue(
+    IPC::Port& port,
+    UInt32 senderId,
+    const void* buffer,
+    UInt32 length,
+    UInt32 replyToken,
+    UInt64 deadlineTick
+  ) {
     for (;;) {
+      port.sendWait.Prepare();
+
       {
-        Sync::ScopedLock<Sync::SpinLock> guard(port->lock);
+        Sync::ScopedLock<Sync::SpinLock> guard(port.lock);
+
+        if (!port.used) {
+          port.sendWait.Cancel();
 
-        if (!port->used) {
           return false;
         }
 
-        if (port->count < maxQueueDepth) {
-          Message& msg = port->queue[port->tail];
+        if (port.count < maxQueueDepth) {
+          port.sendWait.Cancel();
+
+          Message& msg = port.queue[port.tail];
 
           msg.senderId = senderId;
           msg.length = length;
+          msg.replyToken = replyToken;
           msg.hasTransfer = false;
           msg.transferObject = nullptr;
           msg.transferRights = 0;
 
           CopyBytes(msg.data, buffer, length);
 
-          port->tail = (port->tail + 1) % maxQueueDepth;
-          ++port->count;
+          port.tail = (port.tail + 1) % maxQueueDepth;
+          ++port.count;
 
-          port->recvWait.WakeOne();
+          WakeReceivers(port, false);
 
           return true;
         }
+
+        if (deadlineTick != 0 && Timer::Ticks() >= deadlineTick) {
+          port.sendWait.Cancel();
+
+          return false;
+        }
       }
 
-      port->sendWait.WaitTicks(1);
+      port.sendWait.Wait(deadlineTick);
     }
 
     return true;
   }
 
+  bool IPC::Send(
+    UInt32 portId,
+    UInt32 senderId,
+    const void* buffer,
+    UInt32 length
+  ) {
+    if (!buffer || length == 0 || length > maxPayloadBytes) {
+      return false;
+    }
+
+    Port* port = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
+      port = FindPort(portId);
+    }
+
+    if (!port) {
+      return false;
+    }
+
+    return Enqueue(*port, senderId, buffer, length, 0, 0);
+  }
+
+  bool IPC::SendNoWait(
+    UInt32 portId,
+    UInt32 senderId,
+    const void* buffer,
+    UInt32 length
+  ) {
+    if (!buffer || length == 0 || length > maxPayloadBytes) {
+      return false;
+    }
+
+    Port* port = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
+      port = FindPort(portId);
+    }
+
+    if (!port) {
+      return false;
+    }
+
+    return Enqueue(*port, senderId, buffer, length, 0, Timer::Ticks());
+  }
+
   bool IPC::Receive(
     UInt32 portId,
     UInt32& outSenderId,
     void* outBuffer,
     UInt32 bufferCapacity,
-    UInt32& outLength
+    UInt32& outLength,
+    UInt32* outReplyToken
   ) {
     if (!outBuffer || bufferCapacity == 0) {
       return false;
@@ -171,59 +317,35 @@ namespace Quantum::System::Kernel {
     Message msg = {};
 
     for (;;) {
+      port->recvWait.Prepare();
+
       {
         Sync::ScopedLock<Sync::SpinLock> guard(port->lock);
 
         if (!port->used) {
+          port->recvWait.Cancel();
+
           return false;
         }
 
-        if (port->count > 0) {
-          msg = port->queue[port->head];
-
-          port->head = (port->head + 1) % maxQueueDepth;
-          --port->count;
-
-          port->sendWait.WakeOne();
-
-          break;
-        }
+        if (Dequeue(*port, msg)) {
+          port->recvWait.Cancel();
 
-        if (ConsumeIRQPending(*port, msg)) {
           break;
         }
       }
 
-      port->recvWait.WaitTicks(1);
-    }
-
-    outSenderId = msg.senderId;
-    outLength = msg.length;
-
-    if (msg.hasTransfer && msg.transferObject) {
-      KernelObject* obj = msg.transferObject;
-      UInt32 rights = msg.transferRights;
-      UInt32 handleValue = 0;
-
-      Task::ControlBlock* tcb = Task::GetCurrent();
-
-      if (tcb && tcb->handleTable) {
-        handleValue = tcb->handleTable->Create(obj->type, obj, rights);
-      }
-
-      obj->Release();
-
-      UInt32 payload[2] = { 1, handleValue };
-
-      CopyBytes(msg.data, payload, sizeof(payload));
-
-      msg.length = sizeof(payload);
-      outLength = msg.length;
+      port->recvWait.Wait(0);
     }
 
-    UInt32 toCopy = msg.length < bufferCapacity ? msg.length : bufferCapacity;
-
-    CopyBytes(outBuffer, msg.data, toCopy);
+    Deliver(
+      msg,
+      outSenderId,
+      outBuffer,
+      bufferCapacity,
+      outLength,
+      outReplyToken
+    );
 
     return true;
   }
@@ -234,7 +356,53 @@ namespace Quantum::System::Kernel {
     void* outBuffer,
     UInt32 bufferCapacity,
     UInt32& outLength,
-    UInt32 timeoutTicks
+    UInt32 timeoutTicks,
+    UInt32* outReplyToken
+  ) {
+    return ReceiveUntil(
+      portId,
+      outSenderId,
+      outBuffer,
+      bufferCapacity,
+      outLength,
+      Timer::Now() + Timer::TicksToCounts(timeoutTicks),
+      outReplyToken
+    );
+  }
+
+  bool IPC::ReceiveTimeoutNanoseconds(
+    UInt32 portId,
+    UInt32& outSenderId,
+    void* outBuffer,
+    UInt32 bufferCapacity,
+    UInt32& outLength,
+    UInt64 timeoutNanoseconds,
+    UInt32* outReplyToken
+  ) {
+    UInt64 now = Timer::Now();
+    UInt64 deadline = timeoutNanoseconds != 0
+      ? now + Timer::NanosecondsToCounts(timeoutNanoseconds)
+      : now;
+
+    return ReceiveUntil(
+      portId,
+      outSenderId,
+      outBuffer,
+      bufferCapacity,
+      outLength,
+      deadline,
+      outReplyToken
+    );
+  }
+
+  bool IPC::ReceiveUntil(
+    UInt32 portId,
+    UInt32& outSenderId,
+    void* outBuffer,
+    UInt32 bufferCapacity,
+    UInt32& outLength,
+    UInt64 deadline,
+    UInt32* outReplyToken
   ) {
     if (!outBuffer || bufferCapacity == 0) {
       return false;
@@ -252,70 +420,46 @@ namespace Quantum::System::Kernel {
     }
 
     Message msg = {};
-    UInt32 remaining = timeoutTicks;
+    bool expired = deadline <= Timer::Now();
 
     for (;;) {
+      port->recvWait.Prepare();
+
       {
         Sync::ScopedLock<Sync::SpinLock> guard(port->lock);
 
         if (!port->used) {
+          port->recvWait.Cancel();
+
           return false;
         }
 
-        if (port->count > 0) {
-          msg = port->queue[port->head];
-
-          port->head = (port->head + 1) % maxQueueDepth;
-          --port->count;
+        if (Dequeue(*port, msg)) {
+          port->recvWait.Cancel();
 
-          port->sendWait.WakeOne();
-
-          break;
-        }
-
-        if (ConsumeIRQPending(*port, msg)) {
           break;
         }
       }
 
-      if (remaining == 0) {
-        return false;
-      }
-
-      bool woken = port->recvWait.WaitTicks(1);
+      if (expired) {
+        port->recvWait.Cancel();
 
-      if (!woken && remaining > 0) {
-        remaining -= 1;
-      }
-    }
-
-    outSenderId = msg.senderId;
-    outLength = msg.length;
-
-    if (msg.hasTransfer && msg.transferObject) {
-      KernelObject* obj = msg.transferObject;
-      UInt32 rights = msg.transferRights;
-      UInt32 handleValue = 0;
-
-      Task::ControlBlock* tcb = Task::GetCurrent();
-
-      if (tcb && tcb->handleTable) {
-        handleValue = tcb->handleTable->Create(obj->type, obj, rights);
+        return false;
       }
 
-      obj->Release();
-
-      UInt32 payload[2] = { 1, handleValue };
-
-      CopyBytes(msg.data, payload, sizeof(payload));
-
-      msg.length = sizeof(payload);
-      outLength = msg.length;
+      // the deadline is absolute, so wakeups that find the queue drained by
+      // another receiver do not extend the total wait
+      expired = !port->recvWait.WaitUntil(deadline);
     }
 
-    UInt32 toCopy = msg.length < bufferCapacity ? msg.length : bufferCapacity;
-
-    CopyBytes(outBuffer, msg.data, toCopy);
+    Deliver(
+      msg,
+      outSenderId,
+      outBuffer,
+      bufferCapacity,
+      outLength,
+      outReplyToken
+    );
 
     return true;
   }
@@ -325,7 +469,8 @@ namespace Quantum::System::Kernel {
     UInt32& outSenderId,
     void* outBuffer,
     UInt32 bufferCapacity,
-    UInt32& outLength
+    UInt32& outLength,
+    UInt32* outReplyToken
   ) {
     if (!outBuffer || bufferCapacity == 0) {
       return false;
@@ -358,47 +503,27 @@ namespace Quantum::System::Kernel {
 
           CopyBytes(outBuffer, msg.data, toCopy);
 
+          if (outReplyToken) {
+            *outReplyToken = 0;
+          }
+
           return true;
         }
 
         return false;
       }
 
-      msg = port->queue[port->head];
-
-      port->head = (port->head + 1) % maxQueueDepth;
-      --port->count;
-
-      port->sendWait.WakeOne();
-    }
-
-    outSenderId = msg.senderId;
-    outLength = msg.length;
-
-    if (msg.hasTransfer && msg.transferObject) {
-      KernelObject* obj = msg.transferObject;
-      UInt32 rights = msg.transferRights;
-      UInt32 handleValue = 0;
-
-      Task::ControlBlock* tcb = Task::GetCurrent();
-
-      if (tcb && tcb->handleTable) {
-        handleValue = tcb->handleTable->Create(obj->type, obj, rights);
-      }
-
-      obj->Release();
-
-      UInt32 payload[2] = { 1, handleValue };
-
-      CopyBytes(msg.data, payload, sizeof(payload));
-
-      msg.length = sizeof(payload);
-      outLength = msg.length;
+      Dequeue(*port, msg);
     }
 
-    UInt32 toCopy = msg.length < bufferCapacity ? msg.length : bufferCapacity;
-
-    CopyBytes(outBuffer, msg.data, toCopy);
+    Deliver(
+      msg,
+      outSenderId,
+      outBuffer,
+      bufferCapacity,
+      outLength,
+      outReplyToken
+    );
 
     return true;
   }
@@ -428,7 +553,7 @@ namespace Quantum::System::Kernel {
     if (!port->lock.TryAcquire()) {
       if (port->irqPayloadLength != 0) {
         port->irqPending.FetchAdd(1);
-        port->recvWait.WakeOne();
+        WakeReceivers(*port, true);
 
         return true;
       }
@@ -447,7 +572,7 @@ namespace Quantum::System::Kernel {
 
       if (port->irqPayloadLength != 0) {
         port->irqPending.FetchAdd(1);
-        port->recvWait.WakeOne();
+        WakeReceivers(*port, true);
 
         return true;
       }
@@ -459,6 +584,7 @@ namespace Quantum::System::Kernel {
 
     msg.senderId = senderId;
     msg.length = length;
+    msg.replyToken = 0;
     msg.hasTransfer = false;
     msg.transferObject = nullptr;
     msg.transferRights = 0;
@@ -469,7 +595,7 @@ namespace Quantum::System::Kernel {
     ++port->count;
     port->lock.Release();
 
-    port->recvWait.WakeOne();
+    WakeReceivers(*port, true);
 
     return true;
   }
@@ -486,15 +612,30 @@ namespace Quantum::System::Kernel {
       return false;
     }
 
+    PortSet* set = nullptr;
+
     {
       Sync::ScopedLock<Sync::SpinLock> guard(port->lock);
 
-      if (port->object) {
-        port->object->Release();
-      }
+      set = port->portSet;
 
-      port->used = false;
-      port->id = 0;
+      while (port->count > 0) {
+        Message& queued = port->queue[port->head];
+
+        if (queued.replyToken != 0) {
+          AbandonReply(queued.replyToken);
+        }
+
+        port->head = (port->head + 1) % maxQueueDepth;
+        --port->count;
+      }
+
+      if (port->object) {
+        port->object->Release();
+      }
+
+      port->used = false;
+      port->id = 0;
       port->ownerTaskId = 0;
       port->object = nullptr;
       port->head = 0;
@@ -503,11 +644,20 @@ namespace Quantum::System::Kernel {
       port->irqPending.Store(0);
       port->irqSenderId = 0;
       port->irqPayloadLength = 0;
+      port->portSet = nullptr;
     }
 
     port->sendWait.WakeAll();
     port->recvWait.WakeAll();
 
+    if (set) {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+
+      if (set->used) {
+        DetachFromPortSet(*set, portId);
+      }
+    }
+
     return true;
   }
 
@@ -587,18 +737,25 @@ namespace Quantum::System::Kernel {
     }
 
     for (;;) {
+      port->sendWait.Prepare();
+
       {
         Sync::ScopedLock<Sync::SpinLock> guard(port->lock);
 
         if (!port->used) {
+          port->sendWait.Cancel();
+
           return false;
         }
 
         if (port->count < maxQueueDepth) {
+          port->sendWait.Cancel();
+
           Message& msg = port->queue[port->tail];
 
           msg.senderId = senderId;
           msg.length = sizeof(UInt32) * 2;
+          msg.replyToken = 0;
           msg.hasTransfer = true;
           msg.transferObject = object;
           msg.transferRights = rights;
@@ -612,13 +769,13 @@ namespace Quantum::System::Kernel {
           port->tail = (port->tail + 1) % maxQueueDepth;
           ++port->count;
 
-          port->recvWait.WakeOne();
+          WakeReceivers(*port, false);
 
           return true;
         }
       }
 
-      port->sendWait.WaitTicks(1);
+      port->sendWait.Wait(0);
     }
 
     return true;
@@ -638,4 +795,469 @@ namespace Quantum::System::Kernel {
 
     return port->object;
   }
+
+  PortSetObject* IPC::CreatePortSet() {
+    Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+
+    for (UInt32 i = 0; i < _maxPortSets; ++i) {
+      PortSet& set = _portSets[i];
+
+      if (set.used) {
+        continue;
+      }
+
+      PortSetObject* object = new PortSetObject(_nextPortSetId);
+
+      if (!object) {
+        return nullptr;
+      }
+
+      set.used = true;
+      set.id = _nextPortSetId++;
+      set.ownerTaskId = Task::GetCurrentId();
+      set.portCount = 0;
+      set.wait.Initialize();
+
+      return object;
+    }
+
+    return nullptr;
+  }
+
+  bool IPC::DestroyPortSet(UInt32 setId) {
+    PortSet* set = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+
+      set = FindPortSet(setId);
+
+      if (!set) {
+        return false;
+      }
+
+      Sync::ScopedLock<Sync::SpinLock> portsGuard(_portsLock);
+
+      for (UInt32 i = 0; i < set->portCount; ++i) {
+        Port* port = FindPort(set->ports[i]);
+
+        if (port && port->portSet == set) {
+          port->portSet = nullptr;
+        }
+      }
+
+      set->used = false;
+      set->id = 0;
+      set->ownerTaskId = 0;
+      set->portCount = 0;
+    }
+
+    set->wait.WakeAll();
+
+    return true;
+  }
+
+  bool IPC::AddToPortSet(UInt32 setId, UInt32 portId) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+    PortSet* set = FindPortSet(setId);
+
+    if (!set || set->portCount >= maxPortSetPorts) {
+      return false;
+    }
+
+    Port* port = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> portsGuard(_portsLock);
+      port = FindPort(portId);
+    }
+
+    if (!port) {
+      return false;
+    }
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> portGuard(port->lock);
+
+      if (!port->used || port->portSet) {
+        return false;
+      }
+
+      port->portSet = set;
+    }
+
+    set->ports[set->portCount++] = portId;
+
+    // the port may already hold messages the waiter has not seen
+    set->wait.WakeOne();
+
+    return true;
+  }
+
+  bool IPC::RemoveFromPortSet(UInt32 setId, UInt32 portId) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+    PortSet* set = FindPortSet(setId);
+
+    if (!set || !DetachFromPortSet(*set, portId)) {
+      return false;
+    }
+
+    Port* port = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> portsGuard(_portsLock);
+      port = FindPort(portId);
+    }
+
+    if (port) {
+      Sync::ScopedLock<Sync::SpinLock> portGuard(port->lock);
+
+      if (port->portSet == set) {
+        port->portSet = nullptr;
+      }
+    }
+
+    return true;
+  }
+
+  bool IPC::DetachFromPortSet(IPC::PortSet& set, UInt32 portId) {
+    for (UInt32 i = 0; i < set.portCount; ++i) {
+      if (set.ports[i] != portId) {
+        continue;
+      }
+
+      set.ports[i] = set.ports[set.portCount - 1];
+      --set.portCount;
+
+      // a waiter left with no ports must be told rather than sleep forever
+      set.wait.WakeAll();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  bool IPC::WaitAny(UInt32 setId, UInt32 timeoutTicks, UInt32& outPortId) {
+    PortSet* set = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+      set = FindPortSet(setId);
+    }
+
+    if (!set) {
+      return false;
+    }
+
+    UInt64 deadline = timeoutTicks != 0 ? Timer::Ticks() + timeoutTicks : 0;
+
+    for (;;) {
+      UInt32 ports[maxPortSetPorts] = {};
+      UInt32 portCount = 0;
+
+      set->wait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_portSetsLock);
+
+        if (!set->used || set->id != setId || set->portCount == 0) {
+          set->wait.Cancel();
+
+          return false;
+        }
+
+        portCount = set->portCount;
+
+        for (UInt32 i = 0; i < portCount; ++i) {
+          ports[i] = set->ports[i];
+        }
+      }
+
+      for (UInt32 i = 0; i < portCount; ++i) {
+        Port* port = nullptr;
+
+        {
+          Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
+          port = FindPort(ports[i]);
+        }
+
+        if (!port) {
+          continue;
+        }
+
+        bool ready = false;
+
+        {
+          Sync::ScopedLock<Sync::SpinLock> guard(port->lock);
+
+          ready = port->used
+            && port->id == ports[i]
+            && (port->count > 0 || port->irqPending.Load() != 0);
+        }
+
+        if (ready) {
+          set->wait.Cancel();
+          outPortId = ports[i];
+
+          return true;
+        }
+      }
+
+      if (!set->wait.Wait(deadline)) {
+        return false;
+      }
+    }
+  }
+
+  IPC::ReplySlot* IPC::FindReplySlot(UInt32 replyToken) {
+    UInt32 index = (replyToken & 0xFF) - 1;
+
+    if (replyToken == 0 || index >= _maxReplySlots) {
+      return nullptr;
+    }
+
+    ReplySlot& slot = _replySlots[index];
+
+    if (!slot.used || slot.token != replyToken) {
+      return nullptr;
+    }
+
+    return &slot;
+  }
+
+  UInt32 IPC::AllocateReplySlot() {
+    Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+
+    for (UInt32 i = 0; i < _maxReplySlots; ++i) {
+      ReplySlot& slot = _replySlots[i];
+
+      if (slot.used) {
+        continue;
+      }
+
+      // low byte selects the slot, the rest is a generation so a token from
+      // an earlier call can never answer a later one
+      _replyGeneration = (_replyGeneration + 1) & 0x00FFFFFF;
+
+      if (_replyGeneration == 0) {
+        _replyGeneration = 1;
+      }
+
+      slot.used = true;
+      slot.token = (_replyGeneration << 8) | (i + 1);
+      slot.replierTaskId = 0;
+      slot.callerTaskId = Task::GetCurrentId();
+      slot.completed = false;
+      slot.abandoned = false;
+      slot.senderId = 0;
+      slot.length = 0;
+      slot.wait.Initialize();
+
+      return slot.token;
+    }
+
+    return 0;
+  }
+
+  void IPC::ReleaseReplySlot(UInt32 replyToken) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+    ReplySlot* slot = FindReplySlot(replyToken);
+
+    if (!slot) {
+      return;
+    }
+
+    slot->used = false;
+    slot->token = 0;
+    slot->replierTaskId = 0;
+    slot->callerTaskId = 0;
+  }
+
+  void IPC::ReleaseTask(UInt32 taskId) {
+    UInt32 ports[_maxPorts] = {};
+    UInt32 portCount = 0;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
+
+      for (UInt32 i = 0; i < _maxPorts; ++i) {
+        if (_ports[i].used && _ports[i].ownerTaskId == taskId) {
+          ports[portCount++] = _ports[i].id;
+        }
+      }
+    }
+
+    // destroying a port fails the calls still queued on it
+    for (UInt32 i = 0; i < portCount; ++i) {
+      DestroyPort(ports[i]);
+    }
+
+    Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+
+    for (UInt32 i = 0; i < _maxReplySlots; ++i) {
+      ReplySlot& slot = _replySlots[i];
+
+      if (!slot.used) {
+        continue;
+      }
+
+      // the caller is gone, so nobody will collect the reply; a late Reply
+      // finds the token stale
+      if (slot.callerTaskId == taskId) {
+        slot.used = false;
+        slot.token = 0;
+        slot.replierTaskId = 0;
+        slot.callerTaskId = 0;
+
+        continue;
+      }
+
+      if (slot.replierTaskId == taskId && !slot.completed) {
+        slot.abandoned = true;
+        slot.completed = true;
+        slot.length = 0;
+
+        slot.wait.WakeOne();
+      }
+    }
+  }
+
+  void IPC::AbandonReply(UInt32 replyToken) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+    ReplySlot* slot = FindReplySlot(replyToken);
+
+    if (!slot || slot->completed) {
+      return;
+    }
+
+    slot->abandoned = true;
+    slot->completed = true;
+    slot->length = 0;
+
+    slot->wait.WakeOne();
+  }
+
+  bool IPC::Call(
+    UInt32 portId,
+    UInt32 senderId,
+    const void* buffer,
+    UInt32 length,
+    UInt32& outSenderId,
+    void* outBuffer,
+    UInt32 bufferCapacity,
+    UInt32& outLength,
+    UInt32 timeoutTicks
+  ) {
+    if (!buffer || length == 0 || length > maxPayloadBytes) {
+      return false;
+    }
+
+    if (!outBuffer || bufferCapacity == 0) {
+      return false;
+    }
+
+    Port* port = nullptr;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_portsLock);
+      port = FindPort(portId);
+    }
+
+    if (!port) {
+      return false;
+    }
+
+    UInt32 token = AllocateReplySlot();
+
+    if (token == 0) {
+      return false;
+    }
+
+    // one deadline covers both waiting for queue space and for the reply
+    UInt64 deadline = timeoutTicks != 0 ? Timer::Ticks() + timeoutTicks : 0;
+
+    if (!Enqueue(*port, senderId, buffer, length, token, deadline)) {
+      ReleaseReplySlot(token);
+
+      return false;
+    }
+
+    // the slot stays ours until released, so it is safe to hold onto
+    ReplySlot& slot = _replySlots[(token & 0xFF) - 1];
+    bool expired = false;
+
+    for (;;) {
+      slot.wait.Prepare();
+
+      {
+        Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+
+        if (slot.completed) {
+          slot.wait.Cancel();
+
+          break;
+        }
+      }
+
+      if (expired) {
+        slot.wait.Cancel();
+        ReleaseReplySlot(token);
+
+        return false;
+      }
+
+      expired = !slot.wait.Wait(deadline);
+    }
+
+    bool ok = !slot.abandoned;
+
+    if (ok) {
+      UInt32 toCopy = slot.length < bufferCapacity
+        ? slot.length
+        : bufferCapacity;
+
+      CopyBytes(outBuffer, slot.data, toCopy);
+
+      outSenderId = slot.senderId;
+      outLength = slot.length;
+    }
+
+    ReleaseReplySlot(token);
+
+    return ok;
+  }
+
+  bool IPC::Reply(
+    UInt32 replyToken,
+    UInt32 senderId,
+    const void* buffer,
+    UInt32 length
+  ) {
+    if (!buffer || length == 0 || length > maxPayloadBytes) {
+      return false;
+    }
+
+    Sync::ScopedLock<Sync::SpinLock> guard(_replyLock);
+    ReplySlot* slot = FindReplySlot(replyToken);
+
+    if (!slot || slot->completed) {
+      return false;
+    }
+
+    if (slot->replierTaskId != Task::GetCurrentId()) {
+      return false;
+    }
+
+    slot->senderId = senderId;
+    slot->length = length;
+
+    CopyBytes(slot->data, buffer, length);
+
+    slot->completed = true;
+
+    slot->wait.WakeOne();
+
+    return true;
+  }
 }
@@ -54,6 +54,19 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         bool global = false
       );
 
+      /**
+       * Removes a page mapping from the specified address space. The
+       * physical page is left to its owner.
+       * @param pageDirectoryPhysicalAddress
+       *   Physical address of the target page directory.
+       * @param virtualAddress
+       *   Virtual address of the page to unmap.
+       */
+      static void UnmapPage(
+        UInt32 pageDirectoryPhysicalAddress,
+        UInt32 virtualAddress
+      );
+
       /**
        * Activates the specified address space.
        * @param pageDirectoryPhysicalAddress
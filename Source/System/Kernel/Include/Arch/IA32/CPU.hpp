@@ -330,6 +330,20 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        */
       static void EnableInterrupts();
 
+      /**
+       * Disables interrupts and returns the previous EFLAGS.
+       * @return
+       *   EFLAGS before interrupts were disabled.
+       */
+      static UInt32 SaveAndDisableInterrupts();
+
+      /**
+       * Restores the interrupt flag saved by `SaveAndDisableInterrupts`.
+       * @param flags
+       *   Saved EFLAGS value.
+       */
+      static void RestoreInterrupts(UInt32 flags);
+
       /**
        * Loads the physical address of the page directory into CR3.
        * @param physicalAddress
@@ -354,6 +368,33 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        */
       static void Pause();
 
+      /**
+       * Reads the time-stamp counter. Only valid when `Info::hasTSC` is set.
+       * @return
+       *   Current TSC value.
+       */
+      static UInt64 ReadTSC();
+
+      /**
+       * Reads a model-specific register. Only valid when `Info::hasMSR` is
+       * set.
+       * @param index
+       *   MSR index.
+       * @return
+       *   Current MSR value.
+       */
+      static UInt64 ReadMSR(UInt32 index);
+
+      /**
+       * Writes a model-specific register. Only valid when `Info::hasMSR` is
+       * set.
+       * @param index
+       *   MSR index.
+       * @param value
+       *   Value to write.
+       */
+      static void WriteMSR(UInt32 index, UInt64 value);
+
       /**
        * Retrieves IA32 CPU information.
        * @return `Info` structure with CPU details.
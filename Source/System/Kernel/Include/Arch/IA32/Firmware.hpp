@@ -0,0 +1,190 @@
+/**
+ * @file System/Kernel/Include/Arch/IA32/Firmware.hpp
+ * @brief IA32 firmware table (ACPI and MP) parsing.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+#include "SMP.hpp"
+
+namespace Quantum::System::Kernel::Arch::IA32 {
+  /**
+   * Reads the processor layout from the BIOS firmware tables.
+   */
+  class Firmware {
+    public:
+      /**
+       * Finds the enabled processors, trying the ACPI MADT first and the
+       * Intel MultiProcessor table second.
+       * @param topology
+       *   Receives the processor layout.
+       * @return
+       *   True if either table was found.
+       */
+      static bool FindProcessors(SMP::Topology& topology);
+
+    private:
+      /**
+       * Physical base of the fallback EBDA window (top of conventional
+       * memory on a 640 KiB machine).
+       */
+      static constexpr UInt32 _ebdaBase = 0x9FC00;
+
+      /**
+       * Bytes scanned in the EBDA window.
+       */
+      static constexpr UInt32 _ebdaBytes = 0x400;
+
+      /**
+       * Physical base of the BIOS read-only area.
+       */
+      static constexpr UInt32 _biosBase = 0xE0000;
+
+      /**
+       * Bytes scanned in the BIOS read-only area.
+       */
+      static constexpr UInt32 _biosBytes = 0x20000;
+
+      /**
+       * Size of an ACPI system description table header.
+       */
+      static constexpr UInt32 _acpiHeaderBytes = 36;
+
+      /**
+       * Local APIC address used by the MP default configurations.
+       */
+      static constexpr UInt32 _defaultLocalAPIC = 0xFEE00000;
+
+      /**
+       * Bytes of the firmware window already mapped.
+       */
+      inline static UInt32 _windowUsed = 0;
+
+      /**
+       * Maps a physical range into the firmware window.
+       * @param physicalAddress
+       *   Start of the range.
+       * @param length
+       *   Length of the range in bytes.
+       * @return
+       *   Virtual address of `physicalAddress`, or `nullptr` if the window
+       *   is exhausted.
+       */
+      static const UInt8* Map(UInt32 physicalAddress, UInt32 length);
+
+      /**
+       * Scans a physical range on 16-byte boundaries for a signature.
+       * @param physicalAddress
+       *   Start of the range.
+       * @param length
+       *   Length of the range in bytes.
+       * @param signature
+       *   Signature to find.
+       * @param signatureLength
+       *   Length of the signature in bytes.
+       * @param checksumLength
+       *   Bytes that must sum to zero from the signature onward.
+       * @return
+       *   Virtual address of the match, or `nullptr` if none.
+       */
+      static const UInt8* Scan(
+        UInt32 physicalAddress,
+        UInt32 length,
+        const char* signature,
+        UInt32 signatureLength,
+        UInt32 checksumLength
+      );
+
+      /**
+       * Checks whether a byte range sums to zero.
+       * @param bytes
+       *   Start of the range.
+       * @param length
+       *   Length in bytes.
+       * @return
+       *   True if the checksum is valid.
+       */
+      static bool Checksum(const UInt8* bytes, UInt32 length);
+
+      /**
+       * Compares a byte range with a signature.
+       * @param bytes
+       *   Start of the range.
+       * @param signature
+       *   Signature to compare.
+       * @param length
+       *   Length of the signature in bytes.
+       * @return
+       *   True if they match.
+       */
+      static bool Matches(
+        const UInt8* bytes,
+        const char* signature,
+        UInt32 length
+      );
+
+      /**
+       * Reads an unaligned little-endian 16-bit value.
+       * @param bytes
+       *   Address of the value.
+       * @return
+       *   The value.
+       */
+      static UInt16 Read16(const UInt8* bytes);
+
+      /**
+       * Reads an unaligned little-endian 32-bit value.
+       * @param bytes
+       *   Address of the value.
+       * @return
+       *   The value.
+       */
+      static UInt32 Read32(const UInt8* bytes);
+
+      /**
+       * Maps a complete ACPI table after validating its header.
+       * @param physicalAddress
+       *   Physical address of the table.
+       * @param signature
+       *   Expected four-byte signature.
+       * @return
+       *   Virtual address of the table, or `nullptr` on mismatch.
+       */
+      static const UInt8* MapTable(
+        UInt32 physicalAddress,
+        const char* signature
+      );
+
+      /**
+       * Reads the processor layout from the ACPI MADT.
+       * @param topology
+       *   Receives the processor layout.
+       * @return
+       *   True if a MADT was found.
+       */
+      static bool FindFromACPI(SMP::Topology& topology);
+
+      /**
+       * Reads the processor layout from the Intel MP table.
+       * @param topology
+       *   Receives the processor layout.
+       * @return
+       *   True if an MP table was found.
+       */
+      static bool FindFromMP(SMP::Topology& topology);
+
+      /**
+       * Appends a processor unless the topology is full.
+       * @param topology
+       *   Topology to update.
+       * @param apicId
+       *   Local APIC id of the processor.
+       */
+      static void AddProcessor(SMP::Topology& topology, UInt8 apicId);
+  };
+}
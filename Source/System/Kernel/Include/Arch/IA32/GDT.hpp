@@ -27,5 +27,20 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         UInt8 granularity;
         UInt8 baseHigh;
       };
+
+      /**
+       * GDT descriptor for the `lgdt` instruction.
+       */
+      struct [[gnu::packed]] Descriptor {
+        /**
+         * Size of the GDT in bytes minus one.
+         */
+        UInt16 limit;
+
+        /**
+         * Linear base address of the GDT.
+         */
+        UInt32 base;
+      };
   };
 }
@@ -65,11 +65,41 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         UInt16 offsetHigh;
       } __attribute__((packed));
 
+      /**
+       * Vector raised with `int` by a thread giving up the CPU.
+       */
+      static constexpr UInt8 yieldVector = 0xF0;
+
+      /**
+       * Inter-processor interrupt asking a processor to reschedule.
+       */
+      static constexpr UInt8 rescheduleVector = 0xF1;
+
+      /**
+       * Inter-processor interrupt requesting a TLB shootdown.
+       */
+      static constexpr UInt8 invalidateVector = 0xF2;
+
+      /**
+       * Local APIC timer vector.
+       */
+      static constexpr UInt8 localTimerVector = 0xF3;
+
+      /**
+       * Local APIC spurious interrupt vector.
+       */
+      static constexpr UInt8 spuriousVector = 0xFF;
+
       /**
        * Initializes the IA32 Interrupt Descriptor Table (IDT).
        */
       static void Initialize();
 
+      /**
+       * Loads the shared IDT on the executing processor.
+       */
+      static void Load();
+
       /**
        * Registers a kernel-level interrupt handler for the given vector.
        * @param vector
@@ -139,5 +169,15 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        * IRQ ISR stub table.
        */
       static void (*const _irqStubs[_irqCount])();
+
+      /**
+       * Number of local APIC vectors (yield through local timer).
+       */
+      static constexpr UInt8 _localVectorCount = 4;
+
+      /**
+       * Local APIC vector ISR stub table, starting at `yieldVector`.
+       */
+      static void (*const _localStubs[_localVectorCount])();
   };
 }
@@ -0,0 +1,212 @@
+/**
+ * @file System/Kernel/Include/Arch/IA32/LocalAPIC.hpp
+ * @brief IA32 local APIC driver.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+namespace Quantum::System::Kernel::Arch::IA32 {
+  /**
+   * IA32 local APIC: per-processor interrupt controller, IPIs and timer.
+   */
+  class LocalAPIC {
+    public:
+      /**
+       * Maps the local APIC registers and enables the APIC globally.
+       * @param physicalAddress
+       *   Physical address of the register page.
+       */
+      static void Initialize(UInt32 physicalAddress);
+
+      /**
+       * Enables the local APIC of the executing processor.
+       * @param bootstrap
+       *   True on the bootstrap processor, which keeps receiving PIC
+       *   interrupts through LINT0 in virtual wire mode.
+       */
+      static void Enable(bool bootstrap);
+
+      /**
+       * Returns the local APIC id of the executing processor.
+       * @return
+       *   Local APIC id.
+       */
+      static UInt8 GetId();
+
+      /**
+       * Signals end of interrupt for an APIC-delivered vector.
+       */
+      static void EndOfInterrupt();
+
+      /**
+       * Sends a fixed interrupt to another processor.
+       * @param apicId
+       *   Destination local APIC id.
+       * @param vector
+       *   Interrupt vector.
+       */
+      static void SendIPI(UInt8 apicId, UInt8 vector);
+
+      /**
+       * Sends an INIT IPI.
+       * @param apicId
+       *   Destination local APIC id.
+       */
+      static void SendInit(UInt8 apicId);
+
+      /**
+       * Sends a startup IPI.
+       * @param apicId
+       *   Destination local APIC id.
+       * @param page
+       *   Physical page number the processor starts executing at.
+       */
+      static void SendStartup(UInt8 apicId, UInt8 page);
+
+      /**
+       * Measures the APIC timer rate against one PIT tick. Must run before
+       * the scheduler starts, with the PIT counting.
+       */
+      static void CalibrateTimer();
+
+      /**
+       * Arms the APIC timer of the executing processor as a one-shot.
+       * @param ticks
+       *   Delay in scheduler ticks.
+       */
+      static void ArmTimer(UInt32 ticks);
+
+      /**
+       * Stops the APIC timer of the executing processor.
+       */
+      static void DisarmTimer();
+
+    private:
+      /**
+       * Local APIC id register.
+       */
+      static constexpr UInt32 _registerId = 0x20;
+
+      /**
+       * Task priority register.
+       */
+      static constexpr UInt32 _registerTaskPriority = 0x80;
+
+      /**
+       * End of interrupt register.
+       */
+      static constexpr UInt32 _registerEOI = 0xB0;
+
+      /**
+       * Spurious interrupt vector register.
+       */
+      static constexpr UInt32 _registerSpurious = 0xF0;
+
+      /**
+       * Interrupt command register, low half.
+       */
+      static constexpr UInt32 _registerICRLow = 0x300;
+
+      /**
+       * Interrupt command register, high half.
+       */
+      static constexpr UInt32 _registerICRHigh = 0x310;
+
+      /**
+       * Timer local vector table entry.
+       */
+      static constexpr UInt32 _registerLVTTimer = 0x320;
+
+      /**
+       * LINT0 local vector table entry.
+       */
+      static constexpr UInt32 _registerLVTLINT0 = 0x350;
+
+      /**
+       * LINT1 local vector table entry.
+       */
+      static constexpr UInt32 _registerLVTLINT1 = 0x360;
+
+      /**
+       * Error local vector table entry.
+       */
+      static constexpr UInt32 _registerLVTError = 0x370;
+
+      /**
+       * Timer initial count register.
+       */
+      static constexpr UInt32 _registerTimerInitial = 0x380;
+
+      /**
+       * Timer current count register.
+       */
+      static constexpr UInt32 _registerTimerCurrent = 0x390;
+
+      /**
+       * Timer divide configuration register.
+       */
+      static constexpr UInt32 _registerTimerDivide = 0x3E0;
+
+      /**
+       * APIC base model-specific register.
+       */
+      static constexpr UInt32 _baseMSR = 0x1B;
+
+      /**
+       * Global enable bit in the APIC base MSR.
+       */
+      static constexpr UInt64 _baseMSREnable = 0x800;
+
+      /**
+       * Local vector table mask bit.
+       */
+      static constexpr UInt32 _lvtMasked = 0x10000;
+
+      /**
+       * ICR delivery status bit (send pending).
+       */
+      static constexpr UInt32 _icrPending = 0x1000;
+
+      /**
+       * Timer divide configuration for a divisor of 16.
+       */
+      static constexpr UInt32 _timerDivideBy16 = 0x3;
+
+      /**
+       * APIC timer counts per scheduler tick.
+       */
+      inline static UInt32 _countsPerTick = 0;
+
+      /**
+       * Reads a local APIC register.
+       * @param offset
+       *   Register offset.
+       * @return
+       *   Register value.
+       */
+      static UInt32 Read(UInt32 offset);
+
+      /**
+       * Writes a local APIC register.
+       * @param offset
+       *   Register offset.
+       * @param value
+       *   Value to write.
+       */
+      static void Write(UInt32 offset, UInt32 value);
+
+      /**
+       * Writes the interrupt command register and waits for delivery.
+       * @param apicId
+       *   Destination local APIC id.
+       * @param command
+       *   Low command word.
+       */
+      static void SendCommand(UInt8 apicId, UInt32 command);
+  };
+}
@@ -42,5 +42,27 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        * Total virtual bytes reserved for the kernel heap region.
        */
       static constexpr UInt32 kernelHeapBytes = 512 * 1024 * 1024;
+
+      /**
+       * Virtual address of the local APIC register page.
+       */
+      static constexpr UInt32 localAPICBase = 0xFF000000;
+
+      /**
+       * Base virtual address of the window used to read firmware tables.
+       */
+      static constexpr UInt32 firmwareWindowBase = 0xFF100000;
+
+      /**
+       * Size of the firmware table window in bytes.
+       */
+      static constexpr UInt32 firmwareWindowBytes = 1024 * 1024;
+
+      /**
+       * Physical page the application processor startup code is copied to.
+       * It must sit below 1 MB, since the startup IPI gives it as a real
+       * mode page number.
+       */
+      static constexpr UInt32 processorStartupPhysical = 0x7000;
   };
 }
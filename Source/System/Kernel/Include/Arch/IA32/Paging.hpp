@@ -34,6 +34,11 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        */
       static constexpr UInt32 pageUser = 0x4;
 
+      /**
+       * Page cache-disable bit, used for device registers.
+       */
+      static constexpr UInt32 pageCacheDisable = 0x10;
+
       /**
        * Page global bit.
        */
@@ -59,13 +64,16 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        *   Whether the page should be user accessible.
        * @param global
        *   Whether the mapping should be marked global.
+       * @param cacheDisable
+       *   Whether accesses through the mapping bypass the cache.
        */
       static void MapPage(
         UInt32 virtualAddress,
         UInt32 physicalAddress,
         bool writable = true,
         bool user = false,
-        bool global = false
+        bool global = false,
+        bool cacheDisable = false
       );
 
       /**
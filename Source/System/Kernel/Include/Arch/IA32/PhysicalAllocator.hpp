@@ -10,6 +10,8 @@
 
 #include <Types.hpp>
 
+#include <Sync/SpinLock.hpp>
+
 namespace Quantum::System::Kernel::Arch::IA32 {
   /**
    * IA32 physical page allocator.
@@ -54,6 +56,26 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         UInt32 boundaryBytes
       );
 
+      /**
+       * Allocates physically contiguous 4 KB pages below a maximum address.
+       * @param maxPhysicalAddress
+       *   Maximum physical address (exclusive).
+       * @param pageCount
+       *   Number of contiguous pages to allocate.
+       * @param zero
+       *   Whether to zero the pages before returning them.
+       * @param boundaryBytes
+       *   Boundary in bytes that the returned range must not cross.
+       * @return
+       *   Physical address of the first page, or 0 on failure.
+       */
+      static UInt32 AllocateContiguousBelow(
+        UInt32 maxPhysicalAddress,
+        UInt32 pageCount,
+        bool zero,
+        UInt32 boundaryBytes
+      );
+
       /**
        * Frees a physical 4 KB page previously allocated.
        * @param physicalAddress
@@ -169,6 +191,11 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        */
       inline static bool _loggedBundleSkip = false;
 
+      /**
+       * Protects the page bitmap and usage counters.
+       */
+      inline static Sync::SpinLock _lock;
+
       /**
        * Computes a bit mask for a specific bit index.
        * @param bit
@@ -0,0 +1,251 @@
+/**
+ * @file System/Kernel/Include/Arch/IA32/SMP.hpp
+ * @brief IA32 multiprocessor bring-up and inter-processor interrupts.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Atomics.hpp>
+#include <Types.hpp>
+
+#include "Interrupts.hpp"
+
+namespace Quantum::System::Kernel::Arch::IA32 {
+  /**
+   * IA32 symmetric multiprocessing support.
+   *
+   * Processors are numbered by index in the order they were started; the
+   * bootstrap processor is index 0. Legacy IRQs stay routed to the
+   * bootstrap processor through the PIC.
+   */
+  class SMP {
+    public:
+      /**
+       * Maximum number of processors the kernel will start.
+       */
+      static constexpr UInt32 maxProcessors = 8;
+
+      /**
+       * Processor layout reported by the firmware tables.
+       */
+      struct Topology {
+        /**
+         * Physical address of the local APIC registers.
+         */
+        UInt32 localAPICPhysical;
+
+        /**
+         * Number of enabled processors found (at most `maxProcessors`).
+         */
+        UInt32 count;
+
+        /**
+         * Local APIC ids of the enabled processors.
+         */
+        UInt8 apicIds[maxProcessors];
+      };
+
+      /**
+       * Finds the application processors and starts them. Without a local
+       * APIC or firmware tables the system stays on one processor.
+       */
+      static void Initialize();
+
+      /**
+       * Returns the index of the executing processor. Each processor loads
+       * its own TSS selector, so the index is read back from the task
+       * register.
+       * @return
+       *   Processor index.
+       */
+      static UInt32 CurrentIndex() {
+        UInt16 selector = 0;
+
+        asm volatile("str %0" : "=r"(selector));
+
+        return selector > _firstTSSSelector
+          ? static_cast<UInt32>(selector - _firstTSSSelector) >> 3
+          : 0;
+      }
+
+      /**
+       * Returns the number of processors online.
+       * @return
+       *   Processor count (at least 1).
+       */
+      static UInt32 GetProcessorCount();
+
+      /**
+       * Checks whether a processor is online.
+       * @param index
+       *   Processor index.
+       * @return
+       *   True if the processor is running the scheduler.
+       */
+      static bool IsOnline(UInt32 index);
+
+      /**
+       * Interrupts another processor so it re-runs the scheduler.
+       * @param index
+       *   Processor index.
+       */
+      static void SendReschedule(UInt32 index);
+
+      /**
+       * Invalidates a page on every online processor, waiting until all of
+       * them have done so.
+       * @param address
+       *   Virtual address of the page.
+       */
+      static void InvalidatePage(UInt32 address);
+
+      /**
+       * Services a pending TLB shootdown. Called from spin loops that run
+       * with interrupts disabled, so a processor waiting on a lock cannot
+       * stall the processor holding it.
+       */
+      static void ServiceShootdown() {
+        if (_shootdownPending.Load() != 0) {
+          FlushPending();
+        }
+      }
+
+    private:
+      /**
+       * Values the startup trampoline loads before entering the kernel.
+       * Matches the data block at the end of `Trampoline.asm`.
+       */
+      struct StartupData {
+        /**
+         * Control register CR0 (paging and protection enabled).
+         */
+        UInt32 cr0;
+
+        /**
+         * Kernel page directory physical address.
+         */
+        UInt32 cr3;
+
+        /**
+         * Control register CR4.
+         */
+        UInt32 cr4;
+
+        /**
+         * Initial stack pointer (top of the idle thread stack).
+         */
+        UInt32 stack;
+
+        /**
+         * Address of `ProcessorEntry`.
+         */
+        UInt32 entry;
+
+        /**
+         * Processor index passed to `ProcessorEntry`.
+         */
+        UInt32 index;
+      };
+
+      /**
+       * TSS selector loaded by the bootstrap processor.
+       */
+      static constexpr UInt16 _firstTSSSelector = 0x28;
+
+      /**
+       * Time allowed for a processor to come online after the first
+       * startup IPI before a second one is sent (1 ms).
+       */
+      static constexpr UInt64 _firstStartupWait = 1000000;
+
+      /**
+       * Time allowed after the second startup IPI (100 ms).
+       */
+      static constexpr UInt64 _secondStartupWait = 100000000;
+
+      /**
+       * Delay between the INIT IPI and the first startup IPI (10 ms).
+       */
+      static constexpr UInt64 _initDelay = 10000000;
+
+      /**
+       * Local APIC ids by processor index.
+       */
+      inline static UInt8 _apicIds[maxProcessors] = {};
+
+      /**
+       * Bit `n` is set once processor `n` is online.
+       */
+      inline static Kernel::Atomic<UInt32> _onlineMask;
+
+      /**
+       * Number of processors online.
+       */
+      inline static volatile UInt32 _processorCount = 1;
+
+      /**
+       * Index of the processor currently being started.
+       */
+      inline static volatile UInt32 _bootingIndex = 0;
+
+      /**
+       * Held by the processor broadcasting a shootdown.
+       */
+      inline static Kernel::Atomic<UInt32> _shootdownBusy;
+
+      /**
+       * Bit `n` is set until processor `n` has flushed the shootdown page.
+       */
+      inline static Kernel::Atomic<UInt32> _shootdownPending;
+
+      /**
+       * Page being shot down.
+       */
+      inline static volatile UInt32 _shootdownAddress = 0;
+
+      /**
+       * Flushes the shootdown page if this processor has not done so yet.
+       */
+      static void FlushPending();
+
+      /**
+       * TLB shootdown IPI handler.
+       * @param context
+       *   Interrupt context.
+       * @return
+       *   The unchanged context.
+       */
+      static Interrupts::Context* InvalidateHandler(
+        Interrupts::Context& context
+      );
+
+      /**
+       * Starts one application processor with INIT-SIPI-SIPI.
+       * @param index
+       *   Processor index to assign.
+       * @param apicId
+       *   Local APIC id of the processor.
+       * @return
+       *   True if the processor came online.
+       */
+      static bool StartProcessor(UInt32 index, UInt8 apicId);
+
+      /**
+       * First C++ code run by an application processor, called by the
+       * startup trampoline on the processor's idle stack.
+       * @param index
+       *   Processor index assigned by `StartProcessor`.
+       */
+      [[noreturn]] static void ProcessorEntry(UInt32 index);
+
+      /**
+       * Busy-waits on the PIT clock.
+       * @param counts
+       *   Duration in timer counts.
+       */
+      static void Delay(UInt64 counts);
+  };
+}
@@ -13,6 +13,7 @@
 
 #include "CPU.hpp"
 #include "Prelude.hpp"
+#include "SMP.hpp"
 
 namespace Quantum::System::Kernel::Arch::IA32 {
   /**
@@ -28,10 +29,13 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       }
 
       /**
-       * Acquires the lock, spinning until available.
+       * Acquires the lock, spinning until available. The holder may be
+       * waiting for this processor to flush a TLB entry, so pending
+       * shootdowns are serviced while spinning.
        */
       void Acquire() {
         while (_state.Exchange(1) != 0) {
+          SMP::ServiceShootdown();
           CPU::Pause();
         }
       }
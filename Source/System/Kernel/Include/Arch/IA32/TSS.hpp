@@ -10,6 +10,8 @@
 
 #include <Types.hpp>
 
+#include "SMP.hpp"
+
 namespace Quantum::System::Kernel::Arch::IA32 {
   /**
    * IA32 Task State Segment setup utilities.
@@ -177,7 +179,8 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static constexpr UInt16 userDataSelector = 0x23;
 
       /**
-       * TSS segment selector.
+       * TSS segment selector of the bootstrap processor. Processor `n` uses
+       * the selector `8 * n` above it.
        */
       static constexpr UInt16 tssSelector = 0x28;
 
@@ -190,7 +193,17 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static void Initialize(UInt32 kernelStackTop);
 
       /**
-       * Updates the ring0 stack pointer used for privilege transitions.
+       * Gives an application processor its own GDT and TSS, and loads them.
+       * The scheduler sets the ring0 stack before the processor first runs
+       * a user thread.
+       * @param index
+       *   Processor index (greater than zero).
+       */
+      static void InitializeProcessor(UInt32 index);
+
+      /**
+       * Updates the ring0 stack pointer of the executing processor used for
+       * privilege transitions.
        * @param kernelStackTop
        *   Top of the ring0 stack.
        */
@@ -203,22 +216,55 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static UInt8 _ring0Stack[4096];
 
       /**
-       * TSS instance.
+       * TSS instances by processor index.
        */
-      inline static Structure _tss = {};
+      inline static Structure _tss[SMP::maxProcessors] = {};
 
       /**
-       * Index of the TSS descriptor in the GDT.
+       * Index of the bootstrap processor TSS descriptor in the GDT.
        */
       static constexpr UInt32 _tssEntryIndex = 5;
 
       /**
-       * Writes the TSS descriptor into the GDT.
+       * Entries in an application processor GDT: the shared segments plus
+       * one TSS slot per processor, so each processor's TR selector is
+       * distinct.
+       */
+      static constexpr UInt32 _processorGDTEntries
+        = _tssEntryIndex + SMP::maxProcessors;
+
+      /**
+       * GDTs of the application processors (the bootstrap processor uses
+       * the one provided by assembly).
+       */
+      alignas(8) inline static UInt64
+        _processorGDT[SMP::maxProcessors][_processorGDTEntries] = {};
+
+      /**
+       * Writes a TSS descriptor into a GDT.
+       * @param table
+       *   GDT to update.
+       * @param entryIndex
+       *   Index of the descriptor.
        * @param base
        *   Base address of the TSS.
        * @param limit
        *   Limit of the TSS segment.
        */
-      static void WriteTSSDescriptor(UInt32 base, UInt32 limit);
+      static void WriteTSSDescriptor(
+        UInt64* table,
+        UInt32 entryIndex,
+        UInt32 base,
+        UInt32 limit
+      );
+
+      /**
+       * Clears a TSS and sets its ring0 stack.
+       * @param tss
+       *   TSS to reset.
+       * @param kernelStackTop
+       *   Top of the ring0 stack.
+       */
+      static void Reset(Structure& tss, UInt32 kernelStackTop);
   };
 }
@@ -12,9 +12,12 @@
 #include <Types.hpp>
 
 #include <Sync/SpinLock.hpp>
+#include <TimerWheel.hpp>
 
 #include "Interrupts.hpp"
 #include "Prelude.hpp"
+#include "SMP.hpp"
+#include "Timer.hpp"
 
 namespace Quantum::System::Kernel {
   struct TaskControlBlock;
@@ -31,6 +34,27 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        */
       using Context = Interrupts::Context;
 
+      /**
+       * Number of scheduling priority levels (higher runs first).
+       */
+      static constexpr UInt32 priorityLevels = 8;
+
+      /**
+       * Priority assigned to new tasks.
+       */
+      static constexpr UInt32 defaultPriority = 3;
+
+      /**
+       * Highest priority a task may request; the level above it is reserved
+       * for threads woken by IRQ delivery.
+       */
+      static constexpr UInt32 maxPriority = priorityLevels - 2;
+
+      /**
+       * Priority given to a thread woken by IRQ delivery for its next run.
+       */
+      static constexpr UInt32 boostPriority = priorityLevels - 1;
+
       /**
        * Thread state enumeration.
        */
@@ -126,14 +150,40 @@ namespace Quantum::System::Kernel::Arch::IA32 {
         ControlBlock* waitNext;
 
         /**
-         * Wake tick for timed sleeps.
+         * Whether the thread is currently linked into a wait queue.
+         */
+        volatile bool waitQueued;
+
+        /**
+         * Wake time for timed sleeps, in timer counts (0 = none).
+         */
+        UInt64 wakeTime;
+
+        /**
+         * Timer that ends a timed sleep.
+         */
+        TimerWheel::Entry sleepTimer;
+
+        /**
+         * Priority the thread returns to after a boost.
+         */
+        UInt32 basePriority;
+
+        /**
+         * Effective priority; selects the ready queue the thread joins.
          */
-        UInt64 wakeTick;
+        UInt32 priority;
 
         /**
-         * Pointer to the next thread in the sleep queue.
+         * Index of the processor whose ready queue the thread joins.
          */
-        ControlBlock* sleepNext;
+        UInt32 processor;
+
+        /**
+         * Set by a `Wake` that arrives before the thread has blocked, so its
+         * next block returns at once.
+         */
+        volatile bool wakePending;
       };
 
       /**
@@ -205,17 +255,45 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static ControlBlock* FindById(UInt32 id);
 
       /**
-       * Enables preemptive multitasking.
+       * Creates the idle thread of an application processor. Runs on the
+       * bootstrap processor before the processor is started.
+       * @param index
+       *   Processor index.
+       * @return
+       *   Top of the idle thread stack, which the processor starts on, or 0
+       *   on failure.
+       */
+      static UInt32 InitializeProcessor(UInt32 index);
+
+      /**
+       * Enters the scheduler on a newly started application processor.
+       * @param index
+       *   Processor index.
+       */
+      [[noreturn]] static void StartProcessor(UInt32 index);
+
+      /**
+       * Completes a context switch on the new thread's stack: releases the
+       * scheduler lock held across the switch and frees a thread that
+       * terminated on this processor.
+       */
+      static void FinishSwitch();
+
+      /**
+       * Enables preemptive multitasking. Calls nest with
+       * `DisablePreemption`.
        */
       static void EnablePreemption();
 
       /**
-       * Disables preemptive multitasking.
+       * Disables preemptive multitasking. The switch is system-wide: while
+       * it is off no processor preempts its current thread or steals work
+       * from another, so newly created threads stay where they were queued.
        */
       static void DisablePreemption();
 
       /**
-       * Scheduler tick handler.
+       * Scheduler tick handler for the PIT and the local APIC timer.
        * @param context
        *   Current interrupt context.
        * @return
@@ -227,8 +305,22 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        * Marks a blocked thread as ready and enqueues it.
        * @param thread
        *   Thread to wake.
+       * @param boost
+       *   Whether to run the thread ahead of all other priorities once
+       *   (used for IRQ delivery).
+       */
+      static void Wake(ControlBlock* thread, bool boost = false);
+
+      /**
+       * Sets the base priority of a thread, requeueing it if it is ready.
+       * @param thread
+       *   Thread to update.
+       * @param priority
+       *   New priority (at most `maxPriority`).
+       * @return
+       *   True on success; false if the priority is out of range.
        */
-      static void Wake(ControlBlock* thread);
+      static bool SetPriority(ControlBlock* thread, UInt32 priority);
 
       /**
        * Sleeps the current thread for the specified number of ticks.
@@ -237,56 +329,127 @@ namespace Quantum::System::Kernel::Arch::IA32 {
        */
       static void SleepTicks(UInt32 ticks);
 
-    private:
       /**
-       * Pointer to the currently executing thread.
+       * Sleeps the current thread for the specified number of nanoseconds.
+       * @param nanoseconds
+       *   Duration to sleep.
        */
-      inline static ControlBlock* _currentThread = nullptr;
+      static void SleepNanoseconds(UInt64 nanoseconds);
 
       /**
-       * Pointer to the idle thread (never exits).
+       * Blocks the current thread until it is woken via `Wake`, or until the
+       * given absolute tick is reached.
+       * @param wakeTick
+       *   Absolute tick at which to wake, or 0 to block until woken.
        */
-      inline static ControlBlock* _idleThread = nullptr;
+      static void Block(UInt64 wakeTick);
 
       /**
-       * Head of the global thread list.
+       * Blocks the current thread until it is woken via `Wake`, or until the
+       * given absolute timer count is reached.
+       * @param wakeTime
+       *   Absolute time in timer counts, or 0 to block until woken.
        */
-      inline static ControlBlock* _allThreadsHead = nullptr;
+      static void BlockUntil(UInt64 wakeTime);
+
+      /**
+       * Starts a kernel timer on the scheduler's timer wheel, restarting it
+       * if it is already pending.
+       * @param entry
+       *   Timer entry, owned by the caller until it fires or is cancelled.
+       * @param deadline
+       *   Absolute expiry time in timer counts.
+       * @param callback
+       *   Function to run from timer interrupt context on expiry.
+       * @param context
+       *   Context passed to `callback`.
+       */
+      static void StartTimer(
+        TimerWheel::Entry& entry,
+        UInt64 deadline,
+        TimerWheel::Callback callback,
+        void* context
+      );
 
       /**
-       * Head of the ready queue.
+       * Cancels a kernel timer.
+       * @param entry
+       *   Timer entry to cancel.
+       * @return
+       *   True if the timer was pending; false if it already fired.
        */
-      inline static ControlBlock* _readyQueueHead = nullptr;
+      static bool CancelTimer(TimerWheel::Entry& entry);
 
+    private:
       /**
-       * Tail of the ready queue.
+       * Per-processor scheduler state.
        */
-      inline static ControlBlock* _readyQueueTail = nullptr;
+      struct Processor {
+        /**
+         * Thread executing on the processor.
+         */
+        ControlBlock* current;
+
+        /**
+         * Idle thread of the processor (never exits).
+         */
+        ControlBlock* idle;
+
+        /**
+         * Thread pending cleanup (deferred until we are on a different
+         * stack).
+         */
+        ControlBlock* pendingCleanup;
+
+        /**
+         * Heads of the per-priority ready queues.
+         */
+        ControlBlock* readyHead[priorityLevels];
+
+        /**
+         * Tails of the per-priority ready queues.
+         */
+        ControlBlock* readyTail[priorityLevels];
+
+        /**
+         * Bit `n` is set while the ready queue for priority `n` is
+         * non-empty.
+         */
+        UInt32 readyBitmap;
+
+        /**
+         * Set when the thread raising the yield vector already holds the
+         * scheduler lock.
+         */
+        bool lockHandedOff;
+      };
 
       /**
-       * Head of the sleep queue.
+       * Scheduler state by processor index.
        */
-      inline static ControlBlock* _sleepHead = nullptr;
+      inline static Processor _processors[SMP::maxProcessors] = {};
 
       /**
-       * Thread pending cleanup (deferred until we are on a different stack).
+       * Head of the global thread list.
        */
-      inline static ControlBlock* _pendingCleanup = nullptr;
+      inline static ControlBlock* _allThreadsHead = nullptr;
 
       /**
-       * Whether preemptive scheduling is enabled.
+       * Timer wheel holding sleep deadlines and kernel timer callbacks.
        */
-      inline static bool _preemptionEnabled = false;
+      inline static TimerWheel _timerWheel;
 
       /**
-       * Preemption disable nesting count.
+       * Whether preemptive scheduling is enabled on every processor.
+       * Guarded by `_schedulerLock`.
        */
-      inline static UInt32 _preemptDisableCount = 0;
+      inline static bool _preemptionEnabled = false;
 
       /**
-       * When true, force a reschedule even if preemption is disabled.
+       * Preemption disable nesting count, shared by all processors.
+       * Guarded by `_schedulerLock`.
        */
-      inline static volatile bool _forceReschedule = false;
+      inline static UInt32 _preemptDisableCount = 0;
 
       /**
        * Becomes true once scheduling should be active.
@@ -299,23 +462,86 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       inline static UInt32 _nextThreadId = 1;
 
       /**
-       * Sleep queue lock.
+       * Length of a time slice in timer counts.
+       */
+      static constexpr UInt64 _sliceCounts = Timer::TicksToCounts(1);
+
+      /**
+       * Protects the ready queues, thread states and the thread lists. It is
+       * held across a context switch and released on the new stack by
+       * `FinishSwitch`, so no other processor can pick up a thread whose
+       * stack is still in use.
+       */
+      inline static Sync::SpinLock _schedulerLock;
+
+      /**
+       * Returns the scheduler state of the executing processor. Interrupts
+       * must be disabled.
+       * @return
+       *   Processor state.
+       */
+      static Processor& CurrentProcessor();
+
+      /**
+       * Checks whether preemption is enabled and not disabled by nesting.
+       * @return
+       *   True if preemption is allowed.
        */
-      inline static Sync::SpinLock _sleepLock;
+      static bool PreemptionAllowed();
 
       /**
-       * Adds a thread to the ready queue.
+       * Adds a thread to the ready queue of its processor.
        * @param thread
        *   Pointer to the thread to add.
        */
       static void AddToReadyQueue(ControlBlock* thread);
 
       /**
-       * Removes and returns the next thread from the ready queue.
+       * Removes and returns the next thread from the highest non-empty ready
+       * queue of a processor.
+       * @param processor
+       *   Processor whose queues to pop.
        * @return
        *   Pointer to the next ready thread, or `nullptr` if none are ready.
        */
-      static ControlBlock* PopFromReadyQueue();
+      static ControlBlock* PopFromReadyQueue(Processor& processor);
+
+      /**
+       * Takes the most urgent ready thread from the busiest other processor
+       * and moves it to this one.
+       * @param index
+       *   Index of the stealing processor.
+       * @return
+       *   The stolen thread, or `nullptr` if no other processor has work.
+       */
+      static ControlBlock* Steal(UInt32 index);
+
+      /**
+       * Finds an online processor running its idle thread with nothing
+       * queued.
+       * @return
+       *   Processor index, or `SMP::maxProcessors` if none is idle.
+       */
+      static UInt32 FindIdleProcessor();
+
+      /**
+       * Makes a processor re-run the scheduler.
+       * @param index
+       *   Processor index.
+       * @param immediate
+       *   True to preempt at once; false to preempt at the end of the
+       *   running thread's time slice.
+       */
+      static void Notify(UInt32 index, bool immediate);
+
+      /**
+       * Unlinks a thread from its ready queue.
+       * @param thread
+       *   Pointer to the thread to remove.
+       * @return
+       *   True if the thread was queued; false otherwise.
+       */
+      static bool RemoveFromReadyQueue(ControlBlock* thread);
 
       /**
        * Adds a thread to the global thread list.
@@ -332,23 +558,61 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static void RemoveFromAllThreads(ControlBlock* thread);
 
       /**
-       * Removes a thread from the sleep queue.
+       * Cancels a thread's sleep timer. Caller must hold `_schedulerLock`.
        * @param thread
-       *   Pointer to the thread to remove.
+       *   Pointer to the thread to update.
+       */
+      static void CancelSleep(ControlBlock* thread);
+
+      /**
+       * Sleep timer callback; makes the sleeping thread ready.
+       * @param context
+       *   Thread control block of the sleeper.
        */
-      static void RemoveFromSleepQueue(ControlBlock* thread);
+      static void OnSleepTimer(void* context);
 
       /**
-       * Wakes any sleeping threads whose wake tick has elapsed.
-       * @param currentTick
-       *   Current timer tick count.
+       * Programs the executing processor's timer for the end of the running
+       * thread's time slice when another thread of at least its priority is
+       * ready. The bootstrap processor also covers the earliest timer wheel
+       * deadline. With neither, no deadline is set.
+       */
+      static void ArmTimer();
+
+      /**
+       * Gets a newly ready thread onto a CPU: its processor is preempted at
+       * once if the thread outranks the running one; otherwise an idle
+       * processor is asked to steal it, or failing that its processor is
+       * preempted at the end of the running thread's time slice. Caller
+       * must hold `_schedulerLock`.
+       * @param thread
+       *   Thread that became ready.
+       */
+      static void RequestPreemption(ControlBlock* thread);
+
+      /**
+       * Yield vector handler; always reschedules.
+       * @param context
+       *   Current interrupt context.
+       * @return
+       *   Thread context to switch to.
+       */
+      static Context* YieldHandler(Context& context);
+
+      /**
+       * Reschedule IPI handler; switches only if a more urgent thread is
+       * ready, otherwise re-arms the time slice.
+       * @param context
+       *   Current interrupt context.
+       * @return
+       *   Thread context to switch to.
        */
-      static void ProcessSleepQueue(UInt64 currentTick);
+      static Context* Reschedule(Context& context);
 
       /**
        * Picks the next thread to run and returns its saved context pointer.
        * If `currentContext` is provided, saves it to the current TCB before
-       * switching.
+       * switching. Caller must hold `_schedulerLock`.
        * @param currentContext
        *   Pointer to the current thread's saved context, or `nullptr` if none.
        * @return
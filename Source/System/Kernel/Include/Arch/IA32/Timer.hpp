@@ -11,14 +11,21 @@
 #include <Interrupts.hpp>
 #include <Types.hpp>
 
+#include <Sync/SpinLock.hpp>
+
 namespace Quantum::System::Kernel::Arch::IA32 {
   /**
    * IA32 PIT timer driver.
+   *
+   * The PIT runs in one-shot mode and is reprogrammed for the next deadline
+   * the scheduler asks for, so no interrupt fires while nothing is due. Time
+   * is kept in PIT input clock counts (about 838 ns each); ticks are a
+   * fixed number of counts and remain the unit of the tick-based APIs.
    */
   class Timer {
     public:
       /**
-       * Initializes the PIT timer to a fixed frequency and registers IRQ0.
+       * Initializes the PIT in one-shot mode and registers IRQ0.
        */
       static void Initialize();
 
@@ -30,14 +37,75 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static UInt64 Ticks();
 
       /**
-       * Returns the timer frequency in Hz.
+       * Returns the tick frequency in Hz.
        * @return
-       *   PIT frequency in Hz.
+       *   Tick frequency in Hz.
        */
       static constexpr UInt32 FrequencyHz() {
         return _pitFreqHz;
       }
 
+      /**
+       * Returns the number of PIT input clock counts since timer init.
+       * @return
+       *   Current time in counts.
+       */
+      static UInt64 Now();
+
+      /**
+       * Returns the PIT input clock frequency.
+       * @return
+       *   Counts per second.
+       */
+      static constexpr UInt32 CounterHz() {
+        return _pitInputHz;
+      }
+
+      /**
+       * Converts a tick count to PIT input clock counts.
+       * @param ticks
+       *   Number of ticks.
+       * @return
+       *   Equivalent number of counts.
+       */
+      static constexpr UInt64 TicksToCounts(UInt64 ticks) {
+        return ticks * _countsPerTick;
+      }
+
+      /**
+       * Converts a duration in nanoseconds to PIT input clock counts,
+       * rounding up so waits never end early.
+       * @param nanoseconds
+       *   Duration in nanoseconds.
+       * @return
+       *   Equivalent number of counts.
+       */
+      static UInt64 NanosecondsToCounts(UInt64 nanoseconds);
+
+      /**
+       * Returns a monotonic nanosecond clock. Backed by the TSC when it could
+       * be calibrated at boot, otherwise by the PIT count.
+       * @return
+       *   Nanoseconds since timer init.
+       */
+      static UInt64 Nanoseconds();
+
+      /**
+       * Programs the next timer interrupt.
+       * @param deadline
+       *   Absolute time in counts, or 0 when nothing is due. Deadlines are
+       *   clamped to the range the PIT can count.
+       */
+      static void SetDeadline(UInt64 deadline);
+
+      /**
+       * Moves the next timer interrupt earlier if `deadline` comes before the
+       * one already programmed.
+       * @param deadline
+       *   Absolute time in counts.
+       */
+      static void RequestDeadline(UInt64 deadline);
+
       /**
        * Enables or disables periodic tick logging to the console.
        * @param enabled
@@ -62,25 +130,159 @@ namespace Quantum::System::Kernel::Arch::IA32 {
       static constexpr UInt32 _pitInputHz = 1193180;
 
       /**
-       * PIT operating mode configuration.
+       * PIT operating mode configuration (channel 0, lobyte/hibyte, mode 0
+       * interrupt on terminal count).
+       */
+      static constexpr UInt16 _pitMode = 0x30;
+
+      /**
+       * PIT read-back command latching channel 0 count and status.
        */
-      static constexpr UInt16 _pitMode = 0x36;
+      static constexpr UInt8 _pitReadBack = 0xC2;
 
       /**
-       * Desired PIT frequency in Hz.
+       * Tick frequency in Hz.
        */
       static constexpr UInt32 _pitFreqHz = 100;
 
       /**
-       * Tick count since timer initialization.
+       * PIT input clock counts per tick.
+       */
+      static constexpr UInt32 _countsPerTick = _pitInputHz / _pitFreqHz;
+
+      /**
+       * Shortest one-shot period, so a past deadline cannot cause an
+       * interrupt storm.
+       */
+      static constexpr UInt32 _minCounts = 64;
+
+      /**
+       * Longest one-shot period the 16-bit counter allows. The timer is
+       * always armed at most this far out so elapsed time stays measurable.
        */
-      inline static volatile UInt64 _tickCount = 0;
+      static constexpr UInt32 _maxCounts = 0xFFFF;
+
+      /**
+       * PIT counts measured against the TSC during calibration (about 20 ms).
+       */
+      static constexpr UInt32 _calibrationCounts = _countsPerTick * 2;
+
+      /**
+       * Fixed-point shift for PIT count to nanosecond conversion.
+       */
+      static constexpr UInt32 _countNsShift = 16;
+
+      /**
+       * Nanoseconds per PIT count, scaled by 2^`_countNsShift`.
+       */
+      static constexpr UInt32 _countNsMult = static_cast<UInt32>(
+        (1000000000ull << _countNsShift) / _pitInputHz
+      );
+
+      /**
+       * PIT counts per nanosecond, scaled by 2^32.
+       */
+      static constexpr UInt32 _nsCountMult = static_cast<UInt32>(
+        (static_cast<UInt64>(_pitInputHz) << 32) / 1000000000ull
+      );
+
+      /**
+       * Fixed-point shift for TSC to nanosecond conversion.
+       */
+      static constexpr UInt32 _tscNsShift = 24;
+
+      /**
+       * Nanoseconds per TSC cycle, scaled by 2^`_tscNsShift` (0 when the TSC
+       * is not used).
+       */
+      inline static UInt32 _tscNsMult = 0;
+
+      /**
+       * TSC value at the end of calibration.
+       */
+      inline static UInt64 _tscBase = 0;
+
+      /**
+       * Clock reading in nanoseconds at `_tscBase`.
+       */
+      inline static UInt64 _tscBaseNs = 0;
+
+      /**
+       * Counts elapsed up to the last time the PIT was armed.
+       */
+      inline static UInt64 _baseCounts = 0;
+
+      /**
+       * Whole ticks contained in `_baseCounts`.
+       */
+      inline static UInt64 _baseTicks = 0;
+
+      /**
+       * Counts in `_baseCounts` past the last whole tick.
+       */
+      inline static UInt32 _basePhase = 0;
+
+      /**
+       * Count programmed into the PIT when it was last armed.
+       */
+      inline static UInt32 _armedCounts = 0;
+
+      /**
+       * Absolute time in counts the PIT is armed to fire at.
+       */
+      inline static UInt64 _armedDeadline = 0;
+
+      /**
+       * Tick at which the next heartbeat is logged.
+       */
+      inline static UInt64 _nextHeartbeatTick = 0;
 
       /**
        * Whether periodic tick logging is enabled.
        */
       inline static volatile bool _tickLoggingEnabled = false;
 
+      /**
+       * Protects the PIT and the time base.
+       */
+      inline static Sync::SpinLock _lock;
+
+      /**
+       * Reads the counts elapsed since the PIT was last armed. Caller must
+       * hold `_lock`.
+       * @return
+       *   Elapsed counts.
+       */
+      static UInt32 ElapsedSinceArm();
+
+      /**
+       * Multiplies a 64-bit value by a fixed-point factor without needing
+       * 64-bit division support.
+       * @param value
+       *   Value to scale.
+       * @param mult
+       *   Fixed-point multiplier.
+       * @param shift
+       *   Fractional bits in `mult` (at most 32).
+       * @return
+       *   `value * mult >> shift`.
+       */
+      static UInt64 Scale(UInt64 value, UInt32 mult, UInt32 shift);
+
+      /**
+       * Measures the TSC rate against the PIT and enables the TSC clock if
+       * the CPU has one.
+       */
+      static void CalibrateTSC();
+
+      /**
+       * Folds elapsed counts into the time base and reprograms the PIT.
+       * Caller must hold `_lock`.
+       * @param deadline
+       *   Absolute time in counts, or 0 when nothing is due.
+       */
+      static void Arm(UInt64 deadline);
+
       /**
        * PIT timer interrupt handler.
        */
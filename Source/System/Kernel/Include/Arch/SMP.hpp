@@ -0,0 +1,24 @@
+/**
+ * @file System/Kernel/Include/Arch/SMP.hpp
+ * @brief Architecture-specific multiprocessor wrapper.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#if defined(QUANTUM_ARCH_AMD64)
+#else
+#include "Arch/IA32/SMP.hpp"
+#include "Arch/IA32/Prelude.hpp"
+
+using ArchSMP = KernelIA32::SMP;
+#endif
+
+namespace Quantum::System::Kernel::Arch {
+  /**
+   * Alias for the architecture-specific multiprocessor implementation.
+   */
+  using SMP = ArchSMP;
+}
@@ -13,6 +13,7 @@
 #include "IPC.hpp"
 #include "Objects/Devices/BlockDeviceObject.hpp"
 #include "Sync/SpinLock.hpp"
+#include "WaitQueue.hpp"
 
 namespace Quantum::System::Kernel::Devices {
   /**
@@ -37,7 +38,44 @@ namespace Quantum::System::Kernel::Devices {
         /**
          * Response payload.
          */
-        Response = 3
+        Response = 3,
+
+        /**
+         * Read into the driver's shared DMA buffer; the message carries only
+         * the descriptor.
+         */
+        ReadBulk = 4,
+
+        /**
+         * Write from the driver's shared DMA buffer; the message carries only
+         * the descriptor.
+         */
+        WriteBulk = 5,
+
+        /**
+         * Completion notice for an asynchronous request.
+         */
+        Complete = 6
+      };
+
+      /**
+       * Result of polling an asynchronous request.
+       */
+      enum class CompletionStatus : UInt32 {
+        /**
+         * The request finished successfully; read data has been copied out.
+         */
+        Success = 0,
+
+        /**
+         * The request failed or the id is unknown.
+         */
+        Failed = 1,
+
+        /**
+         * The request is still queued or in progress.
+         */
+        Pending = 2
       };
 
       /**
@@ -88,6 +126,37 @@ namespace Quantum::System::Kernel::Devices {
          * Controller-specific device index (e.g., floppy A=0, B=1).
          */
         UInt32 deviceIndex;
+
+        /**
+         * Sectors per track (0 if the device has no CHS geometry).
+         */
+        UInt32 sectorsPerTrack;
+
+        /**
+         * Number of heads (0 if the device has no CHS geometry).
+         */
+        UInt32 headCount;
+      };
+
+      /**
+       * Request scheduling policies.
+       */
+      enum class Scheduler : UInt32 {
+        /**
+         * Arrival order.
+         */
+        Noop = 0,
+
+        /**
+         * Elevator order, but serve any request that has waited past its
+         * expiry first.
+         */
+        Deadline = 1,
+
+        /**
+         * One-way (C-SCAN) elevator by cylinder.
+         */
+        Elevator = 2
       };
 
       /**
@@ -138,6 +207,43 @@ namespace Quantum::System::Kernel::Devices {
          * Kernel object for handle-based access.
          */
         Objects::Devices::BlockDeviceObject* object;
+
+        /**
+         * Whether the bound driver owns the shared DMA buffer, allowing
+         * bulk requests.
+         */
+        bool sharedBuffer;
+
+        /**
+         * First queued request slot (`_noRequest` if empty).
+         */
+        UInt32 queueHead;
+
+        /**
+         * Last queued request slot (`_noRequest` if empty).
+         */
+        UInt32 queueTail;
+
+        /**
+         * Request slots held by this device, including completed requests
+         * not yet collected.
+         */
+        UInt32 queueLength;
+
+        /**
+         * Slots in `queueLength` held by asynchronous requests.
+         */
+        UInt32 asyncLength;
+
+        /**
+         * Policy choosing the next queued request.
+         */
+        Scheduler scheduler;
+
+        /**
+         * Block following the last dispatched request (elevator position).
+         */
+        UInt32 headLBA;
       };
 
       /**
@@ -196,6 +302,77 @@ namespace Quantum::System::Kernel::Devices {
         UInt8 data[messageDataBytes];
       };
 
+      /**
+       * Completion notice posted to a submitter's port.
+       */
+      struct CompletionMessage {
+        /**
+         * Always `Operation::Complete`.
+         */
+        Operation op;
+
+        /**
+         * Request id returned by `Submit`.
+         */
+        UInt32 requestId;
+
+        /**
+         * Target device id.
+         */
+        UInt32 deviceId;
+
+        /**
+         * Status code (0 success, non-zero failure).
+         */
+        UInt32 status;
+      };
+
+      /**
+       * Buffer cache statistics.
+       */
+      struct CacheStats {
+        /**
+         * Cache capacity in blocks.
+         */
+        UInt32 capacity;
+
+        /**
+         * Number of blocks currently cached.
+         */
+        UInt32 used;
+
+        /**
+         * Number of cached blocks awaiting write-back.
+         */
+        UInt32 dirty;
+
+        /**
+         * Sectors served from the cache.
+         */
+        UInt32 hits;
+
+        /**
+         * Sectors fetched from the device.
+         */
+        UInt32 misses;
+
+        /**
+         * Sectors written back to the device.
+         */
+        UInt32 writeBacks;
+
+        /**
+         * Valid blocks evicted to make room.
+         */
+        UInt32 evictions;
+      };
+
+      /**
+       * Largest sector size the buffer cache can hold; devices with larger
+       * sectors bypass the cache.
+       */
+      static constexpr UInt32 cacheBlockBytes = 512;
+
       /**
        * Block device capability flags.
        */
@@ -205,11 +382,21 @@ namespace Quantum::System::Kernel::Devices {
         Ready = 1u << 2
       };
 
+      /**
+       * Maximum bytes a single asynchronous request may transfer.
+       */
+      static constexpr UInt32 maxQueuedBytes = 0x8000;
+
       /**
        * Initializes the block device registry.
        */
       static void Initialize();
 
+      /**
+       * Starts the request dispatcher task. Requires the task subsystem.
+       */
+      static void StartDispatcher();
+
       /**
        * Notifies bound drivers of an interrupt for a device type.
        * @param type
@@ -219,8 +406,11 @@ namespace Quantum::System::Kernel::Devices {
 
       /**
        * Allocates a DMA buffer for block device drivers.
+       * The buffer is physically contiguous and never crosses a 64 KB
+       * boundary. Only the first caller picks the size; if a contiguous
+       * range is unavailable a single page is returned instead.
        * @param sizeBytes
-       *   Requested buffer size in bytes.
+       *   Requested buffer size in bytes (at most 64 KB).
        * @param outPhysical
        *   Receives the physical address.
        * @param outVirtual
@@ -323,103 +513,957 @@ namespace Quantum::System::Kernel::Devices {
       static bool Write(const Request& request);
 
       /**
-       * Retrieves the kernel object for a device.
+       * Selects the scheduling policy for a device.
        * @param deviceId
-       *   Identifier of the device to query.
+       *   Device identifier.
+       * @param scheduler
+       *   Policy to use for subsequent requests.
        * @return
-       *   Kernel object pointer, or `nullptr` if not found.
+       *   True on success; false if the device or policy is unknown.
        */
-      static Objects::Devices::BlockDeviceObject* GetObject(UInt32 deviceId);
+      static bool SetScheduler(UInt32 deviceId, Scheduler scheduler);
 
-    private:
       /**
-       * Maximum number of registered devices.
+       * Queues an asynchronous block request.
+       * @param request
+       *   Block I/O request; write data is copied before returning.
+       * @param write
+       *   True for write requests; false for read.
+       * @param completionPortId
+       *   Port to receive a `CompletionMessage`, or 0 to poll with
+       *   `Complete`.
+       * @return
+       *   Request id, or 0 if the request is invalid or the device queue is
+       *   full.
        */
-      static constexpr UInt32 _maxDevices = 8;
+      static UInt32 Submit(
+        const Request& request,
+        bool write,
+        UInt32 completionPortId
+      );
 
       /**
-       * DMA buffer virtual base for driver mappings.
+       * Collects an asynchronous request submitted by the current task.
+       * @param requestId
+       *   Request id returned by `Submit`.
+       * @param buffer
+       *   Receives read data (ignored for writes).
+       * @return
+       *   Completion status; the id is retired unless `Pending`.
        */
-      static constexpr UInt32 _dmaBufferVirtualBase = 0x00600000;
+      static CompletionStatus Complete(UInt32 requestId, void* buffer);
 
       /**
-       * Maximum physical address for DMA buffers.
+       * Reclaims the asynchronous requests of an exiting task. Collected
+       * slots are freed at once; requests still in flight are freed when
+       * they finish.
+       * @param taskId
+       *   Task that is exiting.
        */
-      static constexpr UInt32 _dmaMaxPhysicalAddress = 0x01000000;
+      static void ReleaseTask(UInt32 taskId);
 
       /**
-       * Default timeout in ticks for driver responses.
+       * Retrieves the kernel object for a device.
+       * @param deviceId
+       *   Identifier of the device to query.
+       * @return
+       *   Kernel object pointer, or `nullptr` if not found.
        */
-      static constexpr UInt32 _requestTimeoutTicks = 500;
+      static Objects::Devices::BlockDeviceObject* GetObject(UInt32 deviceId);
 
       /**
-       * Registered device pointers.
+       * Resizes the buffer cache, writing back dirty blocks first.
+       * @param blocks
+       *   New capacity in blocks (0 disables caching).
+       * @return
+       *   True on success; false if allocation or write-back failed.
        */
-      inline static Device* _devices[_maxDevices] = { nullptr };
+      static bool ConfigureCache(UInt32 blocks);
 
       /**
-       * Storage for user-registered devices.
+       * Writes back dirty cached blocks.
+       * @param deviceId
+       *   Device to flush, or 0 for all devices.
+       * @return
+       *   True if every dirty block was written; false otherwise.
        */
-      inline static Device _deviceStorage[_maxDevices] = {};
+      static bool Flush(UInt32 deviceId);
 
       /**
-       * Number of active devices.
+       * Retrieves buffer cache statistics.
+       * @param outStats
+       *   Receives the statistics snapshot.
        */
-      inline static UInt32 _deviceCount = 0;
+      static void GetCacheStats(CacheStats& outStats);
 
+    private:
       /**
-       * Next device id to assign.
+       * Request slot lifecycle states.
        */
-      inline static UInt32 _nextDeviceId = 1;
+      enum class RequestState : UInt32 {
+        /**
+         * Slot is unused.
+         */
+        Free = 0,
 
-      /**
-       * Physical address of the DMA buffer (0 if unallocated).
-       */
-      inline static UInt32 _dmaBufferPhysical = 0;
+        /**
+         * Waiting in a device queue.
+         */
+        Queued = 1,
 
-      /**
-       * Size of the DMA buffer in bytes.
-       */
-      inline static UInt32 _dmaBufferBytes = 0;
+        /**
+         * Being executed by the dispatcher.
+         */
+        Active = 2,
 
-      /**
-       * Protects device registry state.
-       */
-      inline static Sync::SpinLock _lock;
+        /**
+         * Finished; waiting to be collected.
+         */
+        Complete = 3
+      };
 
       /**
-       * Finds a device by id.
-       * @param deviceId
-       *   Identifier to search for.
-       * @return
-       *   Pointer to the device, or `nullptr` if not found.
+       * Queued device request.
        */
-      static Device* Find(UInt32 deviceId);
+      struct QueuedRequest {
+        /**
+         * Request id (0 if the slot is free).
+         */
+        UInt32 id;
+
+        /**
+         * Lifecycle state.
+         */
+        RequestState state;
+
+        /**
+         * Target device id.
+         */
+        UInt32 deviceId;
+
+        /**
+         * True for writes; false for reads.
+         */
+        bool write;
+
+        /**
+         * Starting logical block address.
+         */
+        UInt32 lba;
+
+        /**
+         * Number of sectors to transfer.
+         */
+        UInt32 count;
+
+        /**
+         * Optional timeout in ticks (0 = default).
+         */
+        UInt32 timeoutTicks;
+
+        /**
+         * Kernel heap copy of the transfer data.
+         */
+        UInt8* buffer;
+
+        /**
+         * Transfer size in bytes.
+         */
+        UInt32 bytes;
+
+        /**
+         * Task that submitted the request.
+         */
+        UInt32 ownerId;
+
+        /**
+         * Port notified on completion (0 for none).
+         */
+        UInt32 completionPortId;
+
+        /**
+         * Whether a kernel caller is blocked on `wait`; such slots cannot
+         * be collected with `Complete`.
+         */
+        bool synchronous;
+
+        /**
+         * Whether the submitting task exited; the slot is freed as soon as
+         * the dispatcher is done with it.
+         */
+        bool orphaned;
+
+        /**
+         * Whether a completed read should be reconciled with the buffer
+         * cache.
+         */
+        bool cacheFill;
+
+        /**
+         * Cache write generation when the request was queued.
+         */
+        UInt32 generation;
+
+        /**
+         * Tick at which the request was queued.
+         */
+        UInt64 queuedTick;
+
+        /**
+         * Whether the transfer succeeded.
+         */
+        bool ok;
+
+        /**
+         * Next slot in the device queue.
+         */
+        UInt32 next;
+
+        /**
+         * Synchronous submitter waiting for completion.
+         */
+        WaitQueue wait;
+      };
 
       /**
-       * Validates a block request against the device info.
-       * @param device
-       *   Target device.
-       * @param request
-       *   Block I/O request.
-       * @return
-       *   True if valid; false otherwise.
+       * Cached copy of one device block.
        */
-      static bool ValidateRequest(const Device& device, const Request& request);
+      struct CacheEntry {
+        /**
+         * Owning device id.
+         */
+        UInt32 deviceId;
 
-      /**
-       * Sends a block request to a bound driver via IPC.
+        /**
+         * Logical block address.
+         */
+        UInt32 lba;
+
+        /**
+         * Whether the entry holds a block.
+         */
+        bool valid;
+
+        /**
+         * Whether the block differs from the device copy.
+         */
+        bool dirty;
+
+        /**
+         * Whether the block is staged in a write-back that has not
+         * completed. The entry stays dirty, and so cannot be evicted, until
+         * the write lands; a write in the meantime clears this so the block
+         * stays dirty for the next pass.
+         */
+        bool flushing;
+
+        /**
+         * Next entry in the same hash bucket.
+         */
+        UInt32 hashNext;
+
+        /**
+         * Neighbour closer to the most recently used end.
+         */
+        UInt32 lruPrev;
+
+        /**
+         * Neighbour closer to the least recently used end.
+         */
+        UInt32 lruNext;
+
+        /**
+         * Block data (`cacheBlockBytes` bytes).
+         */
+        UInt8* data;
+      };
+
+
+      /**
+       * Maximum number of registered devices.
+       */
+      static constexpr UInt32 _maxDevices = 8;
+
+      /**
+       * DMA buffer virtual base for driver mappings.
+       */
+      static constexpr UInt32 _dmaBufferVirtualBase = 0x00600000;
+
+      /**
+       * Maximum physical address for DMA buffers.
+       */
+      static constexpr UInt32 _dmaMaxPhysicalAddress = 0x01000000;
+
+      /**
+       * Largest DMA buffer handed to a driver; one ISA DMA page window.
+       */
+      static constexpr UInt32 _dmaMaxBufferBytes = 0x10000;
+
+      /**
+       * Highest physical address the kernel may touch through the identity
+       * map from any address space (user images start at 4 MB).
+       */
+      static constexpr UInt32 _dmaKernelVisibleLimit = 0x00400000;
+
+      /**
+       * Maximum outstanding requests per device.
+       */
+      static constexpr UInt32 _queueDepth = 8;
+
+      /**
+       * Slots per device that asynchronous requests may hold, including
+       * completed ones not yet collected. The rest stay free for
+       * synchronous I/O.
+       */
+      static constexpr UInt32 _asyncQueueDepth = _queueDepth / 2;
+
+      /**
+       * Number of request slots shared by all devices.
+       */
+      static constexpr UInt32 _maxQueuedRequests = 32;
+
+      /**
+       * Slots in the pool that asynchronous requests may hold.
+       */
+      static constexpr UInt32 _maxAsyncRequests = _maxQueuedRequests / 2;
+
+      /**
+       * Sentinel index for empty request links.
+       */
+      static constexpr UInt32 _noRequest = 0xFFFFFFFF;
+
+      /**
+       * Ticks a read may wait before the deadline policy serves it first.
+       */
+      static constexpr UInt32 _readExpireTicks = 50;
+
+      /**
+       * Ticks a write may wait before the deadline policy serves it first.
+       */
+      static constexpr UInt32 _writeExpireTicks = 250;
+
+      /**
+       * Largest transfer built by merging adjacent requests.
+       */
+      static constexpr UInt32 _mergeMaxBytes = maxQueuedBytes;
+
+      /**
+       * Stack size for the dispatcher task.
+       */
+      static constexpr UInt32 _dispatcherStackBytes = 8192;
+
+      /**
+       * Default timeout in ticks for driver responses.
+       */
+      static constexpr UInt32 _requestTimeoutTicks = 500;
+
+      /**
+       * Registered device pointers.
+       */
+      inline static Device* _devices[_maxDevices] = { nullptr };
+
+      /**
+       * Storage for user-registered devices.
+       */
+      inline static Device _deviceStorage[_maxDevices] = {};
+
+      /**
+       * Number of active devices.
+       */
+      inline static UInt32 _deviceCount = 0;
+
+      /**
+       * Next device id to assign.
+       */
+      inline static UInt32 _nextDeviceId = 1;
+
+      /**
+       * Physical address of the DMA buffer (0 if unallocated).
+       */
+      inline static UInt32 _dmaBufferPhysical = 0;
+
+      /**
+       * Size of the DMA buffer in bytes.
+       */
+      inline static UInt32 _dmaBufferBytes = 0;
+
+      /**
+       * Task that first allocated the DMA buffer.
+       */
+      inline static UInt32 _dmaBufferOwnerId = 0;
+
+      /**
+       * Whether a bulk transfer currently owns the DMA buffer.
+       */
+      inline static bool _dmaBufferBusy = false;
+
+      /**
+       * Port of a driver that may still be using the DMA buffer for a
+       * request that failed or timed out (0 if none). Only touched by the
+       * buffer's owner.
+       */
+      inline static UInt32 _dmaBufferFencePort = 0;
+
+      /**
+       * Threads waiting for the DMA buffer.
+       */
+      inline static WaitQueue _dmaBufferWait;
+
+      /**
+       * Protects device registry and request queue state.
+       */
+      inline static Sync::SpinLock _lock;
+
+      /**
+       * Request slot pool.
+       */
+      inline static QueuedRequest _queuedRequests[_maxQueuedRequests] = {};
+
+      /**
+       * Generation counter mixed into request ids.
+       */
+      inline static UInt32 _requestGeneration = 0;
+
+      /**
+       * Pool slots held by asynchronous requests.
+       */
+      inline static UInt32 _asyncRequests = 0;
+
+      /**
+       * Whether the dispatcher task is running.
+       */
+      inline static bool _dispatcherStarted = false;
+
+      /**
+       * Device index the dispatcher examines first on its next pass.
+       */
+      inline static UInt32 _dispatchCursor = 0;
+
+      /**
+       * Dispatcher waiting for queued requests.
+       */
+      inline static WaitQueue _dispatchWait;
+
+      /**
+       * Synchronous submitters waiting for a free slot.
+       */
+      inline static WaitQueue _queueSpaceWait;
+
+      /**
+       * Default buffer cache capacity in blocks.
+       */
+      static constexpr UInt32 _cacheDefaultBlocks = 128;
+
+      /**
+       * Maximum buffer cache capacity in blocks.
+       */
+      static constexpr UInt32 _cacheMaxBlocks = 2048;
+
+      /**
+       * Number of buffer cache hash buckets.
+       */
+      static constexpr UInt32 _cacheBucketCount = 64;
+
+      /**
+       * Maximum contiguous blocks written back per device request.
+       */
+      static constexpr UInt32 _cacheFlushBatch = 8;
+
+      /**
+       * Sentinel index for empty cache links.
+       */
+      static constexpr UInt32 _cacheNone = 0xFFFFFFFF;
+
+      /**
+       * Cache entry table (`_cacheCapacity` entries).
+       */
+      inline static CacheEntry* _cacheEntries = nullptr;
+
+      /**
+       * Backing storage for cached block data.
+       */
+      inline static UInt8* _cacheData = nullptr;
+
+      /**
+       * Cache capacity in blocks.
+       */
+      inline static UInt32 _cacheCapacity = 0;
+
+      /**
+       * Number of valid cache entries.
+       */
+      inline static UInt32 _cacheUsed = 0;
+
+      /**
+       * Number of dirty cache entries.
+       */
+      inline static UInt32 _cacheDirty = 0;
+
+      /**
+       * Hash bucket heads indexed by `CacheHash`.
+       */
+      inline static UInt32 _cacheBuckets[_cacheBucketCount] = {};
+
+      /**
+       * Most recently used entry.
+       */
+      inline static UInt32 _cacheHead = _cacheNone;
+
+      /**
+       * Least recently used entry.
+       */
+      inline static UInt32 _cacheTail = _cacheNone;
+
+      /**
+       * Sectors served from the cache.
+       */
+      inline static UInt32 _cacheHits = 0;
+
+      /**
+       * Sectors fetched from devices.
+       */
+      inline static UInt32 _cacheMisses = 0;
+
+      /**
+       * Sectors written back to devices.
+       */
+      inline static UInt32 _cacheWriteBacks = 0;
+
+      /**
+       * Valid entries evicted to make room.
+       */
+      inline static UInt32 _cacheEvictions = 0;
+
+      /**
+       * Incremented by every cached write; reads that span a change do not
+       * populate the cache.
+       */
+      inline static UInt32 _cacheWriteGeneration = 0;
+
+      /**
+       * Whether a write-back currently owns the flush buffer.
+       */
+      inline static bool _cacheFlushBusy = false;
+
+      /**
+       * Threads waiting to write back.
+       */
+      inline static WaitQueue _cacheFlushWait;
+
+      /**
+       * Staging buffer for write-back batches.
+       */
+      inline static UInt8 _cacheFlushBuffer[
+        _cacheFlushBatch * cacheBlockBytes
+      ] = {};
+
+      /**
+       * Protects buffer cache state. Taken after `_lock` when both are held.
+       */
+      inline static Sync::SpinLock _cacheLock;
+
+      /**
+       * Finds a device by id.
+       * @param deviceId
+       *   Identifier to search for.
+       * @return
+       *   Pointer to the device, or `nullptr` if not found.
+       */
+      static Device* Find(UInt32 deviceId);
+
+      /**
+       * Validates a block request against the device info.
+       * @param device
+       *   Target device.
+       * @param request
+       *   Block I/O request.
+       * @return
+       *   True if valid; false otherwise.
+       */
+      static bool ValidateRequest(const Device& device, const Request& request);
+
+      /**
+       * Runs a device transfer through the request queue and waits for it.
+       * Falls back to a direct transfer before the dispatcher starts.
+       * @param deviceId
+       *   Target device id.
+       * @param request
+       *   Validated block I/O request.
+       * @param write
+       *   True for write requests; false for read.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool TransferQueued(
+        UInt32 deviceId,
+        const Request& request,
+        bool write
+      );
+
+      /**
+       * Finds a request slot by id. Caller must hold `_lock`.
+       * @param requestId
+       *   Request id.
+       * @return
+       *   Slot pointer, or `nullptr` if not found.
+       */
+      static QueuedRequest* FindQueued(UInt32 requestId);
+
+      /**
+       * Claims a request slot charged to a device. Caller must hold
+       * `_lock`.
+       * @param device
+       *   Device the request targets.
+       * @param synchronous
+       *   Whether a kernel caller will wait on the slot; asynchronous
+       *   requests are limited to their own share of slots.
+       * @return
+       *   Slot index, or `_noRequest` if the device queue or pool is full.
+       */
+      static UInt32 AllocateQueued(Device& device, bool synchronous);
+
+      /**
+       * Frees a request slot and its buffer. Caller must hold `_lock`.
+       * @param index
+       *   Slot index.
+       * @return
+       *   Transfer buffer for the caller to free outside the lock.
+       */
+      static UInt8* ReleaseQueued(UInt32 index);
+
+      /**
+       * Appends a claimed slot to its device queue and wakes the
+       * dispatcher. Caller must hold `_lock`.
+       * @param device
+       *   Target device.
+       * @param index
+       *   Slot index.
+       */
+      static void EnqueueQueued(Device& device, UInt32 index);
+
+      /**
+       * Takes the next batch to execute, visiting devices round-robin. The
+       * device's scheduler picks the lead request, and queued requests of
+       * the same direction that extend it contiguously are merged in.
+       * Caller must hold `_lock`.
+       * @param outDevice
+       *   Receives a snapshot of the owning device.
+       * @param outIndices
+       *   Receives up to `_queueDepth` slot indices in ascending LBA order.
+       * @return
+       *   Number of slots taken (0 if every queue is empty).
+       */
+      static UInt32 DequeueQueued(Device& outDevice, UInt32* outIndices);
+
+      /**
+       * Picks the lead request for a device according to its scheduler.
+       * Caller must hold `_lock`.
+       * @param device
+       *   Device with a non-empty queue.
+       * @return
+       *   Slot index.
+       */
+      static UInt32 SelectQueued(const Device& device);
+
+      /**
+       * Picks the eligible request with the lowest cylinder at or past the
+       * elevator position, wrapping to the lowest cylinder overall.
+       * Caller must hold `_lock`.
+       * @param device
+       *   Device with a non-empty queue.
+       * @return
+       *   Slot index.
+       */
+      static UInt32 SelectElevator(const Device& device);
+
+      /**
+       * Returns whether a queued request must wait for an earlier one that
+       * touches the same blocks, so reordering never changes results.
+       * Caller must hold `_lock`.
+       * @param device
+       *   Owning device.
+       * @param index
+       *   Slot index.
+       * @return
+       *   True if an earlier conflicting request is still queued.
+       */
+      static bool IsQueuedBlocked(const Device& device, UInt32 index);
+
+      /**
+       * Removes a slot from its device queue. Caller must hold `_lock`.
+       * @param device
+       *   Owning device.
+       * @param index
+       *   Slot index.
+       */
+      static void UnlinkQueued(Device& device, UInt32 index);
+
+      /**
+       * Maps a block address to its cylinder using the device geometry.
+       * @param device
+       *   Owning device.
+       * @param lba
+       *   Logical block address.
+       * @return
+       *   Cylinder number, or `lba` if the device has no geometry.
+       */
+      static UInt32 CylinderOf(const Device& device, UInt32 lba);
+
+      /**
+       * Executes a batch of dequeued requests as one device transfer and
+       * completes each of them.
+       * @param device
+       *   Snapshot of the owning device.
+       * @param indices
+       *   Slot indices in ascending LBA order.
+       * @param count
+       *   Number of slots.
+       */
+      static void ExecuteQueued(
+        Device& device,
+        const UInt32* indices,
+        UInt32 count
+      );
+
+      /**
+       * Marks a request finished and notifies whoever is waiting on it.
+       * @param index
+       *   Slot index.
+       * @param ok
+       *   Whether the transfer succeeded.
+       */
+      static void FinishQueued(UInt32 index, bool ok);
+
+      /**
+       * Detaches every queued request of a device so it can be failed.
+       * Caller must hold `_lock`.
+       * @param device
+       *   Device being removed.
+       * @param outIndices
+       *   Receives up to `_queueDepth` detached slot indices.
+       * @return
+       *   Number of detached slots.
+       */
+      static UInt32 DetachQueued(Device& device, UInt32* outIndices);
+
+      /**
+       * Dispatcher task entry point; executes queued requests in order.
+       */
+      static void DispatchTask();
+
+      /**
+       * Reads blocks from a device without consulting the cache.
+       * @param device
+       *   Snapshot of the target device.
+       * @param request
+       *   Validated block I/O request.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool ReadDevice(Device& device, const Request& request);
+
+      /**
+       * Writes blocks to a device without consulting the cache.
+       * @param device
+       *   Snapshot of the target device.
+       * @param request
+       *   Validated block I/O request.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool WriteDevice(Device& device, const Request& request);
+
+      /**
+       * Returns whether requests for a device go through the cache.
+       * @param device
+       *   Device to check.
+       * @return
+       *   True if the device's blocks are cacheable.
+       */
+      static bool IsCacheable(const Device& device);
+
+      /**
+       * Computes the hash bucket for a block.
+       * @param deviceId
+       *   Owning device id.
+       * @param lba
+       *   Logical block address.
+       * @return
+       *   Bucket index.
+       */
+      static UInt32 CacheHash(UInt32 deviceId, UInt32 lba);
+
+      /**
+       * Finds a cached block. Caller must hold `_cacheLock`.
+       * @param deviceId
+       *   Owning device id.
+       * @param lba
+       *   Logical block address.
+       * @return
+       *   Entry index, or `_cacheNone` if not cached.
+       */
+      static UInt32 CacheFind(UInt32 deviceId, UInt32 lba);
+
+      /**
+       * Moves an entry to the most recently used position. Caller must hold
+       * `_cacheLock`.
+       * @param index
+       *   Entry index.
+       * @param mostRecent
+       *   True to move to the head; false to move to the tail.
+       */
+      static void CacheTouch(UInt32 index, bool mostRecent);
+
+      /**
+       * Drops an entry from its hash bucket and marks it free. Caller must
+       * hold `_cacheLock`.
+       * @param index
+       *   Entry index.
+       */
+      static void CacheRemove(UInt32 index);
+
+      /**
+       * Stores a block in the cache. Caller must hold `_cacheLock`.
+       * @param deviceId
+       *   Owning device id.
+       * @param lba
+       *   Logical block address.
+       * @param data
+       *   Block contents.
+       * @param bytes
+       *   Block size in bytes.
+       * @param dirty
+       *   True when the block has not reached the device yet.
+       * @return
+       *   True if stored; false if every entry is dirty.
+       */
+      static bool CacheStore(
+        UInt32 deviceId,
+        UInt32 lba,
+        const UInt8* data,
+        UInt32 bytes,
+        bool dirty
+      );
+
+      /**
+       * Reconciles freshly read blocks with the cache: cached blocks win
+       * over the device copy, and uncached blocks are stored clean unless a
+       * write happened since `generation`. Caller must hold `_cacheLock`.
+       * @param deviceId
+       *   Owning device id.
+       * @param lba
+       *   First block address.
+       * @param count
+       *   Number of blocks.
+       * @param buffer
+       *   Data returned by the device; updated in place.
+       * @param generation
+       *   `_cacheWriteGeneration` sampled before the read was issued.
+       */
+      static void CacheFill(
+        UInt32 deviceId,
+        UInt32 lba,
+        UInt32 count,
+        UInt8* buffer,
+        UInt32 generation
+      );
+
+      /**
+       * Overwrites any cached copies of blocks about to be written straight
+       * to the device, keeping their dirty state. Caller must hold
+       * `_cacheLock`.
+       * @param deviceId
+       *   Owning device id.
+       * @param lba
+       *   First block address.
+       * @param count
+       *   Number of blocks.
+       * @param data
+       *   New block contents.
+       */
+      static void CacheUpdate(
+        UInt32 deviceId,
+        UInt32 lba,
+        UInt32 count,
+        const UInt8* data
+      );
+
+      /**
+       * Drops every cached block of a device, discarding dirty data. Caller
+       * must hold `_cacheLock`.
+       * @param deviceId
+       *   Device whose blocks to drop.
+       * @return
+       *   Number of dirty blocks discarded.
+       */
+      static UInt32 CacheInvalidate(UInt32 deviceId);
+
+      /**
+       * Sends a block request to a bound driver via IPC.
        * @param device
        *   Target device.
        * @param request
        *   Block I/O request.
        * @param write
        *   True for write requests; false for read.
+       * @param bulk
+       *   True to transfer through the shared DMA buffer instead of inline
+       *   message data.
+       * @return
+       *   True on success; false on failure.
        */
       static bool SendRequest(
+        Device& device,
+        const Request& request,
+        bool write,
+        bool bulk
+      );
+
+      /**
+       * Transfers a request through the shared DMA buffer, sending one
+       * descriptor per buffer-sized chunk instead of inline sector data.
+       * @param device
+       *   Target device (must have `sharedBuffer` set).
+       * @param request
+       *   Block I/O request.
+       * @param write
+       *   True for write requests; false for read.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool TransferBulk(
         Device& device,
         const Request& request,
         bool write
       );
+
+      /**
+       * Waits for and claims exclusive use of the shared DMA buffer. If a
+       * previous transfer was left unconfirmed, waits for its driver first.
+       */
+      static void AcquireSharedBuffer();
+
+      /**
+       * Waits until the driver named by `_dmaBufferFencePort` has finished
+       * with the DMA buffer. Drivers handle requests in order, so a reply to
+       * an empty read shows the earlier transfer completed or was
+       * abandoned. A driver whose port is gone cannot be using it either.
+       */
+      static void FenceSharedBuffer();
+
+      /**
+       * Releases the shared DMA buffer and wakes the next waiter.
+       */
+      static void ReleaseSharedBuffer();
+
+      /**
+       * Waits for and claims the cache write-back path.
+       */
+      static void AcquireCacheFlush();
+
+      /**
+       * Releases the cache write-back path and wakes the next waiter.
+       */
+      static void ReleaseCacheFlush();
   };
 }
@@ -18,5 +18,10 @@ namespace Quantum::System::Kernel::Devices {
        * Initializes device registries and probes hardware.
        */
       static void Initialize();
+
+      /**
+       * Starts device worker tasks once the task subsystem is running.
+       */
+      static void Start();
   };
 }
@@ -228,6 +228,23 @@ namespace Quantum::System::Kernel::Devices {
         UInt32 timeoutTicks
       );
 
+      /**
+       * Reads the next event for a device with a timeout in nanoseconds.
+       * @param deviceId
+       *   Identifier of the device to read.
+       * @param outEvent
+       *   Receives the event.
+       * @param timeoutNanoseconds
+       *   Maximum number of nanoseconds to wait.
+       * @return
+       *   True on success; false on timeout or failure.
+       */
+      static bool ReadEventTimeoutNanoseconds(
+        UInt32 deviceId,
+        Event& outEvent,
+        UInt64 timeoutNanoseconds
+      );
+
       /**
        * Pushes an event into the device queue.
        * @param deviceId
@@ -327,5 +344,23 @@ namespace Quantum::System::Kernel::Devices {
        *   Pointer to the device, or `nullptr` if not found.
        */
       static Device* Find(UInt32 deviceId);
+
+      /**
+       * Reads the next event for a device, blocking until a deadline.
+       * @param deviceId
+       *   Identifier of the device to read.
+       * @param outEvent
+       *   Receives the event.
+       * @param deadline
+       *   Absolute time in timer counts; a deadline already reached polls
+       *   once without blocking.
+       * @return
+       *   True on success; false on timeout or failure.
+       */
+      static bool ReadEventUntil(
+        UInt32 deviceId,
+        Event& outEvent,
+        UInt64 deadline
+      );
   };
 }
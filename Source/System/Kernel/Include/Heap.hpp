@@ -10,6 +10,8 @@
 
 #include <Types.hpp>
 
+#include "Sync/SpinLock.hpp"
+
 namespace Quantum::System::Kernel {
   /**
    * Kernel heap allocator.
@@ -229,6 +231,19 @@ namespace Quantum::System::Kernel {
       inline static FreeBlock* _binFreeLists[_binCount]
         = { nullptr, nullptr, nullptr, nullptr };
 
+      /**
+       * Protects the heap lists and mapping state across processors.
+       */
+      inline static Sync::SpinLock _lock;
+
+      /**
+       * Walks the free list to build a heap state snapshot. Caller must hold
+       * `_lock`.
+       * @return
+       *   Snapshot of current heap state.
+       */
+      static HeapState CollectHeapState();
+
       /**
        * Writes the canary for a free block at the end of its payload.
        * @param block
@@ -13,6 +13,7 @@
 #include "Atomics.hpp"
 #include "Objects/IPCPortObject.hpp"
 #include "Objects/KernelObject.hpp"
+#include "Objects/PortSetObject.hpp"
 #include "Sync/SpinLock.hpp"
 #include "WaitQueue.hpp"
 
@@ -60,7 +61,29 @@ namespace Quantum::System::Kernel {
       );
 
       /**
-       * Sends a message to the given port without blocking.
+       * Sends a message to the given port, failing instead of blocking if
+       * the queue is full.
+       * @param portId
+       *   Target port.
+       * @param senderId
+       *   Identifier of the sending task.
+       * @param buffer
+       *   Pointer to payload data.
+       * @param length
+       *   Payload length in bytes (<= `maxPayloadBytes`).
+       * @return
+       *   True on success; false if the queue is full or arguments invalid.
+       */
+      static bool SendNoWait(
+        UInt32 portId,
+        UInt32 senderId,
+        const void* buffer,
+        UInt32 length
+      );
+
+      /**
+       * Sends a message to the given port without blocking. Used for IRQ
+       * delivery, so the woken receiver is boosted ahead of other work.
        * @param portId
        *   Target port.
        * @param senderId
@@ -131,6 +154,9 @@ namespace Quantum::System::Kernel {
        *   Capacity of outBuffer in bytes.
        * @param outLength
        *   Receives the payload length.
+       * @param outReplyToken
+       *   Receives the one-shot reply token when the message was sent via
+       *   `Call` (0 otherwise). When null, pending callers are failed.
        * @return
        *   True on success; false on invalid arguments/port.
        */
@@ -139,7 +165,8 @@ namespace Quantum::System::Kernel {
         UInt32& outSenderId,
         void* outBuffer,
         UInt32 bufferCapacity,
-        UInt32& outLength
+        UInt32& outLength,
+        UInt32* outReplyToken = nullptr
       );
 
       /**
@@ -156,6 +183,9 @@ namespace Quantum::System::Kernel {
        *   Receives the payload length.
        * @param timeoutTicks
        *   Maximum number of ticks to wait.
+       * @param outReplyToken
+       *   Receives the one-shot reply token when the message was sent via
+       *   `Call` (0 otherwise). When null, pending callers are failed.
        * @return
        *   True on success; false on timeout or invalid arguments/port.
        */
@@ -165,7 +195,38 @@ namespace Quantum::System::Kernel {
         void* outBuffer,
         UInt32 bufferCapacity,
         UInt32& outLength,
-        UInt32 timeoutTicks
+        UInt32 timeoutTicks,
+        UInt32* outReplyToken = nullptr
+      );
+
+      /**
+       * Receives a message with a timeout given in nanoseconds.
+       * @param portId
+       *   Port to receive from.
+       * @param outSenderId
+       *   Receives the sender task id.
+       * @param outBuffer
+       *   Buffer to copy payload into.
+       * @param bufferCapacity
+       *   Capacity of outBuffer in bytes.
+       * @param outLength
+       *   Receives the payload length.
+       * @param timeoutNanoseconds
+       *   Maximum number of nanoseconds to wait.
+       * @param outReplyToken
+       *   Receives the one-shot reply token when the message was sent via
+       *   `Call` (0 otherwise). When null, pending callers are failed.
+       * @return
+       *   True on success; false on timeout or invalid arguments/port.
+       */
+      static bool ReceiveTimeoutNanoseconds(
+        UInt32 portId,
+        UInt32& outSenderId,
+        void* outBuffer,
+        UInt32 bufferCapacity,
+        UInt32& outLength,
+        UInt64 timeoutNanoseconds,
+        UInt32* outReplyToken = nullptr
       );
 
       /**
@@ -180,6 +241,9 @@ namespace Quantum::System::Kernel {
        *   Capacity of outBuffer in bytes.
        * @param outLength
        *   Receives the payload length.
+       * @param outReplyToken
+       *   Receives the one-shot reply token when the message was sent via
+       *   `Call` (0 otherwise). When null, pending callers are failed.
        * @return
        *   True on success; false if no message or invalid arguments/port.
        */
@@ -188,7 +252,68 @@ namespace Quantum::System::Kernel {
         UInt32& outSenderId,
         void* outBuffer,
         UInt32 bufferCapacity,
-        UInt32& outLength
+        UInt32& outLength,
+        UInt32* outReplyToken = nullptr
+      );
+
+      /**
+       * Sends a request to a port and blocks until the receiver replies via
+       * `Reply`. The reply is delivered to a reply slot owned by the calling
+       * thread, so no reply port is needed.
+       * @param portId
+       *   Target port.
+       * @param senderId
+       *   Identifier of the calling task.
+       * @param buffer
+       *   Pointer to request payload data.
+       * @param length
+       *   Request length in bytes (<= `maxPayloadBytes`).
+       * @param outSenderId
+       *   Receives the replying task id.
+       * @param outBuffer
+       *   Buffer to copy the reply payload into (may alias `buffer`).
+       * @param bufferCapacity
+       *   Capacity of outBuffer in bytes.
+       * @param outLength
+       *   Receives the reply length.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait for the reply; 0 waits forever.
+       * @return
+       *   True if a reply was received; false on timeout, if the receiver
+       *   dropped the request, or on invalid arguments/port.
+       */
+      static bool Call(
+        UInt32 portId,
+        UInt32 senderId,
+        const void* buffer,
+        UInt32 length,
+        UInt32& outSenderId,
+        void* outBuffer,
+        UInt32 bufferCapacity,
+        UInt32& outLength,
+        UInt32 timeoutTicks
+      );
+
+      /**
+       * Replies to a request received from `Call`. Each reply token may be
+       * used once, and only by the task that received the request.
+       * @param replyToken
+       *   Reply token delivered with the request.
+       * @param senderId
+       *   Identifier of the replying task.
+       * @param buffer
+       *   Pointer to reply payload data.
+       * @param length
+       *   Reply length in bytes (<= `maxPayloadBytes`).
+       * @return
+       *   True on success; false if the token is invalid, already used, or
+       *   the caller gave up waiting.
+       */
+      static bool Reply(
+        UInt32 replyToken,
+        UInt32 senderId,
+        const void* buffer,
+        UInt32 length
       );
 
       /**
@@ -220,6 +345,78 @@ namespace Quantum::System::Kernel {
        */
       static Objects::IPCPortObject* GetPortObject(UInt32 portId);
 
+      /**
+       * Maximum number of ports attached to one port set.
+       */
+      static constexpr UInt32 maxPortSetPorts = 8;
+
+      /**
+       * Creates a port set owned by the current task.
+       * @return
+       *   Port set object holding one reference for the caller, or
+       *   `nullptr` on failure.
+       */
+      static Objects::PortSetObject* CreatePortSet();
+
+      /**
+       * Destroys a port set, detaching its ports and failing its waiters.
+       * @param setId
+       *   Port set identifier.
+       * @return
+       *   True on success; false if the set does not exist.
+       */
+      static bool DestroyPortSet(UInt32 setId);
+
+      /**
+       * Releases the IPC state of an exiting task: destroys its ports,
+       * fails calls it received but never answered and frees the reply
+       * slots of its own calls.
+       * @param taskId
+       *   Task that is exiting.
+       */
+      static void ReleaseTask(UInt32 taskId);
+
+      /**
+       * Attaches a port to a port set. A port belongs to at most one set,
+       * and both must be owned by the same task.
+       * @param setId
+       *   Port set identifier.
+       * @param portId
+       *   Port to attach.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool AddToPortSet(UInt32 setId, UInt32 portId);
+
+      /**
+       * Detaches a port from a port set.
+       * @param setId
+       *   Port set identifier.
+       * @param portId
+       *   Port to detach.
+       * @return
+       *   True on success; false if the port was not attached to the set.
+       */
+      static bool RemoveFromPortSet(UInt32 setId, UInt32 portId);
+
+      /**
+       * Blocks until any port in the set has a message or IRQ notification
+       * pending. The message is left queued for the caller to receive.
+       * @param setId
+       *   Port set identifier.
+       * @param timeoutTicks
+       *   Maximum number of ticks to wait (0 waits without a timeout).
+       * @param outPortId
+       *   Receives the id of a ready port.
+       * @return
+       *   True if a port is ready; false on timeout or failure.
+       */
+      static bool WaitAny(
+        UInt32 setId,
+        UInt32 timeoutTicks,
+        UInt32& outPortId
+      );
+
     private:
       /**
        * IPC message descriptor stored in each port queue.
@@ -235,6 +432,11 @@ namespace Quantum::System::Kernel {
          */
         UInt32 length;
 
+        /**
+         * Reply token for messages sent via `Call` (0 otherwise).
+         */
+        UInt32 replyToken;
+
         /**
          * Whether this message transfers a handle.
          */
@@ -256,6 +458,41 @@ namespace Quantum::System::Kernel {
         UInt8 data[maxPayloadBytes];
       };
 
+      /**
+       * IPC port set state tracked by the kernel.
+       */
+      struct PortSet {
+        /**
+         * Whether this port set slot is in use.
+         */
+        bool used;
+
+        /**
+         * Port set identifier.
+         */
+        UInt32 id;
+
+        /**
+         * Owning task identifier.
+         */
+        UInt32 ownerTaskId;
+
+        /**
+         * Attached port identifiers.
+         */
+        UInt32 ports[maxPortSetPorts];
+
+        /**
+         * Number of attached ports.
+         */
+        UInt32 portCount;
+
+        /**
+         * Tasks blocked in `WaitAny`.
+         */
+        WaitQueue wait;
+      };
+
       /**
        * IPC port state tracked by the kernel.
        */
@@ -334,8 +571,88 @@ namespace Quantum::System::Kernel {
          * IRQ notification payload buffer.
          */
         UInt8 irqPayload[maxPayloadBytes];
+
+        /**
+         * Port set this port is attached to, or `nullptr`.
+         */
+        PortSet* portSet;
+      };
+
+      /**
+       * Reply slot backing a blocked `Call`.
+       */
+      struct ReplySlot {
+        /**
+         * Whether this slot is in use.
+         */
+        bool used;
+
+        /**
+         * Token handed to the receiver; changes on every allocation.
+         */
+        UInt32 token;
+
+        /**
+         * Task that received the request and may reply.
+         */
+        UInt32 replierTaskId;
+
+        /**
+         * Task blocked in the call.
+         */
+        UInt32 callerTaskId;
+
+        /**
+         * Whether a reply (or failure) has been posted.
+         */
+        bool completed;
+
+        /**
+         * Whether the request was dropped without a reply.
+         */
+        bool abandoned;
+
+        /**
+         * Identifier of the replying task.
+         */
+        UInt32 senderId;
+
+        /**
+         * Length of the reply in bytes.
+         */
+        UInt32 length;
+
+        /**
+         * Caller waiting for the reply.
+         */
+        WaitQueue wait;
+
+        /**
+         * Reply payload data.
+         */
+        UInt8 data[maxPayloadBytes];
       };
 
+      /**
+       * Maximum number of outstanding calls.
+       */
+      static constexpr UInt32 _maxReplySlots = 32;
+
+      /**
+       * Reply slot table.
+       */
+      inline static ReplySlot _replySlots[_maxReplySlots] = {};
+
+      /**
+       * Generation counter mixed into reply tokens.
+       */
+      inline static UInt32 _replyGeneration = 0;
+
+      /**
+       * Protects the reply slot table.
+       */
+      inline static Sync::SpinLock _replyLock;
+
       /**
        * Maximum number of ports supported by the kernel.
        */
@@ -356,6 +673,59 @@ namespace Quantum::System::Kernel {
        */
       inline static Sync::SpinLock _portsLock;
 
+      /**
+       * Maximum number of port sets supported by the kernel.
+       */
+      static constexpr UInt32 _maxPortSets = 8;
+
+      /**
+       * Global IPC port set table.
+       */
+      inline static PortSet _portSets[_maxPortSets] = {};
+
+      /**
+       * Next port set id to hand out.
+       */
+      inline static UInt32 _nextPortSetId = 1;
+
+      /**
+       * Protects the port set table. Taken before `_portsLock` when both
+       * are held.
+       */
+      inline static Sync::SpinLock _portSetsLock;
+
+      /**
+       * Finds a port set by id. Caller must hold `_portSetsLock`.
+       * @param id
+       *   Port set identifier.
+       * @return
+       *   Pointer to the port set, or `nullptr` if not found.
+       */
+      static PortSet* FindPortSet(UInt32 id);
+
+      /**
+       * Removes a port id from a port set and wakes its waiters. Caller
+       * must hold `_portSetsLock`.
+       * @param set
+       *   Port set to update.
+       * @param portId
+       *   Port identifier to remove.
+       * @return
+       *   True if the port was attached to the set.
+       */
+      static bool DetachFromPortSet(PortSet& set, UInt32 portId);
+
+      /**
+       * Wakes a receiver blocked on a port and any task waiting on its
+       * port set.
+       * @param port
+       *   Port that became ready.
+       * @param boost
+       *   Whether the readiness comes from IRQ delivery, so the woken
+       *   thread runs ahead of other work.
+       */
+      static void WakeReceivers(Port& port, bool boost);
+
       /**
        * Finds a port by id.
        * @param id
@@ -375,5 +745,131 @@ namespace Quantum::System::Kernel {
        *   True if an IRQ notification was consumed.
        */
       static bool ConsumeIRQPending(Port& port, Message& msg);
+
+      /**
+       * Removes the next message from a port, falling back to a pending IRQ
+       * notification. Caller must hold the port lock.
+       * @param port
+       *   Port to dequeue from.
+       * @param msg
+       *   Message to populate on success.
+       * @return
+       *   True if a message was dequeued.
+       */
+      static bool Dequeue(Port& port, Message& msg);
+
+      /**
+       * Receives a message, blocking until an absolute deadline.
+       * @param portId
+       *   Port to receive from.
+       * @param outSenderId
+       *   Receives the sender task id.
+       * @param outBuffer
+       *   Buffer to copy payload into.
+       * @param bufferCapacity
+       *   Capacity of outBuffer in bytes.
+       * @param outLength
+       *   Receives the payload length.
+       * @param deadline
+       *   Absolute time in timer counts; a deadline already reached polls
+       *   once without blocking.
+       * @param outReplyToken
+       *   Receives the reply token; when null, a pending caller is failed.
+       * @return
+       *   True on success; false on timeout or invalid arguments/port.
+       */
+      static bool ReceiveUntil(
+        UInt32 portId,
+        UInt32& outSenderId,
+        void* outBuffer,
+        UInt32 bufferCapacity,
+        UInt32& outLength,
+        UInt64 deadline,
+        UInt32* outReplyToken
+      );
+
+      /**
+       * Appends a message to a port queue, blocking while the queue is full
+       * until a deadline.
+       * @param port
+       *   Target port.
+       * @param senderId
+       *   Identifier of the sending task.
+       * @param buffer
+       *   Pointer to payload data.
+       * @param length
+       *   Payload length in bytes.
+       * @param replyToken
+       *   Reply token to attach (0 for a plain send).
+       * @param deadlineTick
+       *   Absolute tick after which a full queue fails the send (0 waits
+       *   forever; a tick already passed never blocks).
+       * @return
+       *   True on success; false if the port was destroyed, or is still
+       *   full at the deadline.
+       */
+      static bool Enqueue(
+        Port& port,
+        UInt32 senderId,
+        const void* buffer,
+        UInt32 length,
+        UInt32 replyToken,
+        UInt64 deadlineTick
+      );
+
+      /**
+       * Finds the reply slot for a token. Caller must hold `_replyLock`.
+       * @param replyToken
+       *   Token to look up.
+       * @return
+       *   Pointer to the slot, or `nullptr` if the token is stale.
+       */
+      static ReplySlot* FindReplySlot(UInt32 replyToken);
+
+      /**
+       * Allocates a reply slot for a new call.
+       * @return
+       *   Reply token (non-zero) on success; 0 if all slots are busy.
+       */
+      static UInt32 AllocateReplySlot();
+
+      /**
+       * Frees a reply slot, invalidating its token.
+       * @param replyToken
+       *   Token of the slot to free.
+       */
+      static void ReleaseReplySlot(UInt32 replyToken);
+
+      /**
+       * Fails a pending call whose request will never be answered.
+       * @param replyToken
+       *   Token of the abandoned call.
+       */
+      static void AbandonReply(UInt32 replyToken);
+
+      /**
+       * Copies a dequeued message to the receiver, installing any transferred
+       * handle in the current task.
+       * @param msg
+       *   Dequeued message.
+       * @param outSenderId
+       *   Receives the sender task id.
+       * @param outBuffer
+       *   Buffer to copy payload into.
+       * @param bufferCapacity
+       *   Capacity of outBuffer in bytes.
+       * @param outLength
+       *   Receives the payload length.
+       * @param outReplyToken
+       *   Receives the reply token; when null, a pending caller is failed.
+       */
+      static void Deliver(
+        Message& msg,
+        UInt32& outSenderId,
+        void* outBuffer,
+        UInt32 bufferCapacity,
+        UInt32& outLength,
+        UInt32* outReplyToken
+      );
   };
 }
@@ -41,6 +41,13 @@ namespace Quantum::System::Kernel::Objects {
        */
       void AddRef();
 
+      /**
+       * Takes a reference unless the object is already being destroyed.
+       * @return
+       *   True if a reference was taken.
+       */
+      bool TryAddRef();
+
       /**
        * Releases a kernel object reference.
        */
@@ -38,6 +38,16 @@ namespace Quantum::System::Kernel::Objects {
     /**
      * IRQ line object.
      */
-    IRQLine = 4
+    IRQLine = 4,
+
+    /**
+     * Shared memory object.
+     */
+    SharedMemory = 5,
+
+    /**
+     * IPC port set object.
+     */
+    PortSet = 6
   };
 }
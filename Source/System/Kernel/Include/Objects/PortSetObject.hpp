@@ -0,0 +1,38 @@
+/**
+ * @file System/Kernel/Include/Objects/PortSetObject.hpp
+ * @brief IPC port set kernel object.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+#include "Objects/KernelObject.hpp"
+
+namespace Quantum::System::Kernel::Objects {
+  /**
+   * IPC port set kernel object.
+   */
+  class PortSetObject : public KernelObject {
+    public:
+      /**
+       * Constructs an IPC port set object.
+       * @param setId
+       *   IPC port set identifier.
+       */
+      explicit PortSetObject(UInt32 setId);
+
+      /**
+       * Destroys the port set once the last reference is gone.
+       */
+      ~PortSetObject() override;
+
+      /**
+       * IPC port set identifier.
+       */
+      UInt32 portSetId;
+  };
+}
@@ -0,0 +1,89 @@
+/**
+ * @file System/Kernel/Include/Objects/SharedMemoryObject.hpp
+ * @brief Shared memory kernel object.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <ABI/SharedMemory.hpp>
+#include <Types.hpp>
+
+#include "Objects/KernelObject.hpp"
+
+namespace Quantum::System::Kernel::Objects {
+  /**
+   * Shared memory kernel object.
+   */
+  class SharedMemoryObject : public KernelObject {
+    public:
+      /**
+       * Maximum number of pages backing one shared memory object.
+       */
+      static constexpr UInt32 maxPages
+        = ABI::SharedMemory::maxBytes / 4096;
+
+      /**
+       * Maximum number of tasks other than the creator that may open one
+       * object.
+       */
+      static constexpr UInt32 maxGrants = 4;
+
+      /**
+       * Access granted to a task other than the creator.
+       */
+      struct Grant {
+        /**
+         * Task the access was granted to (0 = unused).
+         */
+        UInt32 taskId;
+
+        /**
+         * Rights the task may open the object with.
+         */
+        UInt32 rights;
+      };
+
+      /**
+       * Constructs a shared memory object.
+       * @param id
+       *   Shared memory identifier.
+       * @param creatorTaskId
+       *   Task that created the object.
+       */
+      SharedMemoryObject(UInt32 id, UInt32 creatorTaskId);
+
+      /**
+       * Frees the backing pages and drops the object from the registry.
+       */
+      ~SharedMemoryObject() override;
+
+      /**
+       * Shared memory identifier.
+       */
+      UInt32 sharedId;
+
+      /**
+       * Task that created the object; it may always open it.
+       */
+      UInt32 creatorTaskId;
+
+      /**
+       * Tasks the creator granted access to. Guarded by the shared memory
+       * registry lock.
+       */
+      Grant grants[maxGrants];
+
+      /**
+       * Number of backing pages.
+       */
+      UInt32 pageCount;
+
+      /**
+       * Physical addresses of the backing pages.
+       */
+      UInt32 pages[maxPages];
+  };
+}
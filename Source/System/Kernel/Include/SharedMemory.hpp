@@ -0,0 +1,170 @@
+/**
+ * @file System/Kernel/Include/SharedMemory.hpp
+ * @brief Shared memory objects mapped between tasks.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+#include "Objects/SharedMemoryObject.hpp"
+#include "Sync/SpinLock.hpp"
+#include "Task.hpp"
+
+namespace Quantum::System::Kernel {
+  /**
+   * Shared memory registry and mapping window management.
+   */
+  class SharedMemory {
+    public:
+      /**
+       * Base of the per-task window that shared memory is mapped into.
+       */
+      static constexpr UInt32 windowBase = 0x01000000;
+
+      /**
+       * Size of one window slot; large enough for the largest object.
+       */
+      static constexpr UInt32 slotBytes
+        = Objects::SharedMemoryObject::maxPages * 4096;
+
+      /**
+       * Creates a zero-filled shared memory object.
+       * @param sizeBytes
+       *   Requested size in bytes; rounded up to whole pages.
+       * @param creatorTaskId
+       *   Task creating the object; only it may grant access to others.
+       * @return
+       *   Object holding one reference for the caller, or `nullptr` on
+       *   failure.
+       */
+      static Objects::SharedMemoryObject* Create(
+        UInt32 sizeBytes,
+        UInt32 creatorTaskId
+      );
+
+      /**
+       * Looks up a shared memory object by id on behalf of a task. Only the
+       * creator and tasks it granted access to may open the object.
+       * @param id
+       *   Shared memory identifier.
+       * @param taskId
+       *   Task opening the object.
+       * @param rights
+       *   Rights the task asks for.
+       * @return
+       *   Object with a reference added for the caller, or `nullptr` if no
+       *   such object exists or the task may not open it with `rights`.
+       */
+      static Objects::SharedMemoryObject* Open(
+        UInt32 id,
+        UInt32 taskId,
+        UInt32 rights
+      );
+
+      /**
+       * Lets another task open a shared memory object. Granting a task
+       * again replaces its rights.
+       * @param id
+       *   Shared memory identifier.
+       * @param creatorTaskId
+       *   Task making the grant; must be the creator.
+       * @param granteeTaskId
+       *   Task receiving access.
+       * @param rights
+       *   Rights the grantee may open the object with.
+       * @return
+       *   True on success; false if the object does not exist, the caller
+       *   is not its creator or no grant slot is free.
+       */
+      static bool Grant(
+        UInt32 id,
+        UInt32 creatorTaskId,
+        UInt32 granteeTaskId,
+        UInt32 rights
+      );
+
+      /**
+       * Maps a shared memory object into a free window slot of a task.
+       * @param task
+       *   Task to map into.
+       * @param object
+       *   Object to map; the mapping holds its own reference.
+       * @param writable
+       *   Whether the mapping should be writable.
+       * @return
+       *   Base virtual address of the mapping, or 0 on failure.
+       */
+      static UInt32 Map(
+        Task::ControlBlock* task,
+        Objects::SharedMemoryObject* object,
+        bool writable
+      );
+
+      /**
+       * Removes a mapping created by Map.
+       * @param task
+       *   Task owning the mapping.
+       * @param virtualAddress
+       *   Base virtual address returned by Map.
+       * @return
+       *   True on success; false if no mapping starts at the address.
+       */
+      static bool Unmap(Task::ControlBlock* task, UInt32 virtualAddress);
+
+      /**
+       * Removes every mapping held by a task. Called before its address
+       * space is destroyed.
+       * @param task
+       *   Task being torn down.
+       */
+      static void ReleaseTask(Task::ControlBlock* task);
+
+      /**
+       * Drops a dying object from the registry.
+       * @param object
+       *   Object being destroyed.
+       */
+      static void Unregister(Objects::SharedMemoryObject* object);
+
+    private:
+      /**
+       * Number of window slots per task.
+       */
+      static constexpr UInt32 _maxMappings
+        = Task::ControlBlock::maxSharedMappings;
+
+      /**
+       * Maximum number of live shared memory objects.
+       */
+      static constexpr UInt32 _maxObjects = 32;
+
+      /**
+       * Registered objects, looked up by id.
+       */
+      inline static Objects::SharedMemoryObject* _objects[_maxObjects] = {};
+
+      /**
+       * Next identifier to hand out. Identifiers are never reused, so a
+       * stale id can not name a newer object.
+       */
+      inline static UInt32 _nextId = 1;
+
+      /**
+       * Protects the registry.
+       */
+      inline static Sync::SpinLock _lock;
+
+      /**
+       * Unmaps the pages of one window slot.
+       * @param task
+       *   Task owning the mapping.
+       * @param slot
+       *   Window slot index.
+       */
+      static void UnmapSlot(Task::ControlBlock* task, UInt32 slot);
+  };
+}
@@ -36,6 +36,24 @@ namespace Quantum::System::Kernel::Sync {
         return _count.FetchAdd(1) + 1;
       }
 
+      /**
+       * Increments the reference count unless it has already dropped to
+       * zero.
+       * @return
+       *   True if a reference was taken.
+       */
+      bool TryAddRef() {
+        UInt32 current = _count.Load();
+
+        while (current != 0) {
+          if (_count.CompareExchange(current, current + 1)) {
+            return true;
+          }
+        }
+
+        return false;
+      }
+
       /**
        * Decrements the reference count.
        * @return
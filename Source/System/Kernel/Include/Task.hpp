@@ -11,11 +11,16 @@
 #include <Types.hpp>
 
 #include "Interrupts.hpp"
+#include "Sync/SpinLock.hpp"
 #include "Thread.hpp"
 
 namespace Quantum::System::Kernel {
   class HandleTable;
 
+  namespace Objects {
+    class SharedMemoryObject;
+  }
+
   /**
    * Task control block.
    */
@@ -60,6 +65,16 @@ namespace Quantum::System::Kernel {
      */
     HandleTable* handleTable;
 
+    /**
+     * Number of shared memory window slots per task.
+     */
+    static constexpr UInt32 maxSharedMappings = 8;
+
+    /**
+     * Shared memory objects mapped into the task, indexed by window slot.
+     */
+    Objects::SharedMemoryObject* sharedMappings[maxSharedMappings];
+
     /**
      * Primary thread for this task.
      */
@@ -75,6 +90,11 @@ namespace Quantum::System::Kernel {
      */
     UInt32 threadCount;
 
+    /**
+     * Scheduling priority given to new threads of this task.
+     */
+    UInt32 priority;
+
     /**
      * Pointer to the next task in the global task list.
      */
@@ -146,6 +166,13 @@ namespace Quantum::System::Kernel {
        */
       static void SleepTicks(UInt32 ticks);
 
+      /**
+       * Sleeps the current task for the specified number of nanoseconds.
+       * @param nanoseconds
+       *   Duration to sleep.
+       */
+      static void SleepNanoseconds(UInt64 nanoseconds);
+
       /**
        * Gets the currently executing task.
        * @return
@@ -204,6 +231,29 @@ namespace Quantum::System::Kernel {
        */
       static bool CurrentTaskHasIOAccess();
 
+      /**
+       * Sets the scheduling priority of the current task, or of one of its
+       * threads.
+       * @param threadId
+       *   Thread to update, or 0 for the task and all of its threads.
+       * @param priority
+       *   New priority (at most `Thread::maxPriority`).
+       * @return
+       *   True on success; false otherwise.
+       */
+      static bool SetPriority(UInt32 threadId, UInt32 priority);
+
+      /**
+       * Sets the scheduling priority of a task and all of its threads.
+       * @param taskId
+       *   Task to update.
+       * @param priority
+       *   New priority (at most `Thread::maxPriority`).
+       * @return
+       *   True on success; false otherwise.
+       */
+      static bool SetTaskPriority(UInt32 taskId, UInt32 priority);
+
       /**
        * Enables preemptive multitasking via timer interrupts.
        */
@@ -231,6 +281,15 @@ namespace Quantum::System::Kernel {
       static void Destroy(ControlBlock* task);
 
     private:
+      /**
+       * Sets the priority of a task and all of its threads.
+       * @param task
+       *   Task to update.
+       * @param priority
+       *   New priority (at most `Thread::maxPriority`).
+       */
+      static void ApplyPriority(ControlBlock* task, UInt32 priority);
+
       /**
        * Creates a task control block without creating any threads.
        * @param pageDirectoryPhysical
@@ -277,5 +336,10 @@ namespace Quantum::System::Kernel {
        * Next task ID to assign.
        */
       inline static UInt32 _nextTaskId = 1;
+
+      /**
+       * Protects the global task list and task id assignment.
+       */
+      inline static Sync::SpinLock _registryLock;
   };
 }
@@ -50,6 +50,16 @@ namespace Quantum::System::Kernel::Tests {
        */
       inline static UInt8 _recvBuffer[16] = {};
 
+      /**
+       * Indicates the first reply succeeded for call/reply test.
+       */
+      inline static volatile bool _replyOk = false;
+
+      /**
+       * Indicates a reused reply token was accepted for call/reply test.
+       */
+      inline static volatile bool _replyReused = false;
+
       /**
        * Task function that sends a message.
        */
@@ -60,11 +70,44 @@ namespace Quantum::System::Kernel::Tests {
        */
       static void ReceiverTask();
 
+      /**
+       * Task function that answers a call and retries the same reply token.
+       */
+      static void ReplierTask();
+
       /**
        * Tests sending and receiving a message.
        * @return
        *   True on success; false on failure.
        */
       static bool TestSendReceive();
+
+      /**
+       * Tests that a timed receive on an empty port honors its deadline.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool TestReceiveTimeout();
+
+      /**
+       * Tests a call/reply round trip and one-shot reply tokens.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool TestCallReply();
+
+      /**
+       * Tests that a call to a port with a full queue honors its timeout.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool TestCallFullPort();
+
+      /**
+       * Tests that a port set wait reports the port a message arrived on.
+       * @return
+       *   True on success; false on failure.
+       */
+      static bool TestPortSetWaitAny();
   };
 }
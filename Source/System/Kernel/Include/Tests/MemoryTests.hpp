@@ -26,5 +26,12 @@ namespace Quantum::System::Kernel::Tests {
        *   True if the test passes.
        */
       static bool TestMemoryAllocation();
+
+      /**
+       * Verifies contiguous page allocation honors its boundary.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestContiguousAllocation();
   };
 }
@@ -0,0 +1,61 @@
+/**
+ * @file System/Kernel/Include/Tests/SMPTests.hpp
+ * @brief Multiprocessor kernel tests.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+namespace Quantum::System::Kernel::Tests {
+  /**
+   * Registers multiprocessor kernel tests.
+   */
+  class SMPTests {
+    public:
+      /**
+       * Registers multiprocessor test cases with the harness.
+       */
+      static void RegisterTests();
+
+    private:
+      /**
+       * Flag to stop the spinner task.
+       */
+      inline static volatile bool _stopSpinner = false;
+
+      /**
+       * Iterations completed by the spinner task.
+       */
+      inline static volatile UInt32 _spinnerCount = 0;
+
+      /**
+       * Processor the spinner task last ran on.
+       */
+      inline static volatile UInt32 _spinnerProcessor = 0;
+
+      /**
+       * Spins until stopped, recording the processor it runs on.
+       */
+      static void SpinnerTask();
+
+      /**
+       * Verifies that the processor count and the executing processor's
+       * index are consistent.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestProcessorIndex();
+
+      /**
+       * Verifies that a runnable task is picked up by another processor
+       * while the test thread keeps its own processor busy.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestParallelTasks();
+  };
+}
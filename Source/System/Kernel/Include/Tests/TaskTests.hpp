@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include <Types.hpp>
+
+#include "Atomics.hpp"
+
 namespace Quantum::System::Kernel::Tests {
   /**
    * Registers tasking-related kernel tests.
@@ -26,9 +30,10 @@ namespace Quantum::System::Kernel::Tests {
       inline static volatile bool _stopSpinTasks = false;
 
       /**
-       * Shared counter incremented by cooperating tasks.
+       * Shared counter incremented by cooperating tasks, which may run on
+       * different processors.
        */
-      inline static volatile UInt32 _taskCounter = 0;
+      inline static Atomic<UInt32> _taskCounter;
 
       /**
        * Counter for first preemptive spinner task.
@@ -40,6 +45,16 @@ namespace Quantum::System::Kernel::Tests {
        */
       inline static volatile UInt32 _preemptCounterB = 0;
 
+      /**
+       * Order in which the priority test tasks ran (1 = low, 2 = high).
+       */
+      inline static volatile UInt32 _priorityOrder[2] = {};
+
+      /**
+       * Number of priority test tasks that have run.
+       */
+      inline static Atomic<UInt32> _priorityRuns;
+
       /**
        * First cooperating task increments shared counter and yields.
        */
@@ -61,6 +76,16 @@ namespace Quantum::System::Kernel::Tests {
        */
       static void PreemptTaskB();
 
+      /**
+       * Low priority task that records when it runs.
+       */
+      static void LowPriorityTask();
+
+      /**
+       * High priority task that records when it runs.
+       */
+      static void HighPriorityTask();
+
       /**
        * Verifies cooperative yields between two tasks.
        * @return
@@ -75,5 +100,29 @@ namespace Quantum::System::Kernel::Tests {
        *   True if the test passes.
        */
       static bool TestTaskPreemption();
+
+      /**
+       * Verifies that a higher priority thread runs before an earlier
+       * queued lower priority one.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestTaskPriority();
+
+      /**
+       * Verifies that a timed sleep lasts at least as long as requested and
+       * wakes promptly without a periodic tick.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestTaskSleep();
+
+      /**
+       * Verifies that the nanosecond clock is monotonic and that a
+       * nanosecond sleep is not rounded up to a whole tick.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestTaskNanosecondSleep();
   };
 }
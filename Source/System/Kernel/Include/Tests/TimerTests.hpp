@@ -0,0 +1,55 @@
+/**
+ * @file System/Kernel/Include/Tests/TimerTests.hpp
+ * @brief Timer-related kernel tests.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+#include "TimerWheel.hpp"
+
+namespace Quantum::System::Kernel::Tests {
+  /**
+   * Registers timer-related kernel tests.
+   */
+  class TimerTests {
+    public:
+      /**
+       * Registers timer test cases with the harness.
+       */
+      static void RegisterTests();
+
+    private:
+      /**
+       * Private wheel driven by hand in the cascade test.
+       */
+      inline static TimerWheel _wheel;
+
+      /**
+       * Timer callback that increments the counter passed as context.
+       * @param context
+       *   Pointer to a `volatile UInt32` counter.
+       */
+      static void CountExpiry(void* context);
+
+      /**
+       * Verifies that timers in every wheel level fire on their deadline,
+       * never early, and that cancelled timers do not fire.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestWheelCascade();
+
+      /**
+       * Verifies that kernel timer callbacks run from the scheduler's wheel
+       * and can be cancelled.
+       * @return
+       *   True if the test passes.
+       */
+      static bool TestTimerCallback();
+  };
+}
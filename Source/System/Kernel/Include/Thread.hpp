@@ -24,6 +24,21 @@ namespace Quantum::System::Kernel {
       using ControlBlock = Arch::Thread::ControlBlock;
       using State = Arch::Thread::State;
 
+      /**
+       * Number of scheduling priority levels (higher runs first).
+       */
+      static constexpr UInt32 priorityLevels = Arch::Thread::priorityLevels;
+
+      /**
+       * Priority assigned to new tasks.
+       */
+      static constexpr UInt32 defaultPriority = Arch::Thread::defaultPriority;
+
+      /**
+       * Highest priority a task may request.
+       */
+      static constexpr UInt32 maxPriority = Arch::Thread::maxPriority;
+
       /**
        * Initializes the thread scheduler and creates the idle thread.
        */
@@ -113,8 +128,31 @@ namespace Quantum::System::Kernel {
        * Marks a blocked thread as ready and enqueues it.
        * @param thread
        *   Thread to wake.
+       * @param boost
+       *   Whether to run the thread ahead of all other priorities once
+       *   (used for IRQ delivery).
+       */
+      static void Wake(ControlBlock* thread, bool boost = false);
+
+      /**
+       * Sets the base priority of a thread.
+       * @param thread
+       *   Thread to update.
+       * @param priority
+       *   New priority (at most `maxPriority`).
+       * @return
+       *   True on success; false if the priority is out of range.
        */
-      static void Wake(ControlBlock* thread);
+      static bool SetPriority(ControlBlock* thread, UInt32 priority);
+
+      /**
+       * Finds a thread by id.
+       * @param id
+       *   Thread identifier to locate.
+       * @return
+       *   Pointer to the thread control block, or `nullptr` if not found.
+       */
+      static ControlBlock* FindById(UInt32 id);
 
       /**
        * Sleeps the current thread for the specified number of ticks.
@@ -122,5 +160,29 @@ namespace Quantum::System::Kernel {
        *   Number of timer ticks to sleep.
        */
       static void SleepTicks(UInt32 ticks);
+
+      /**
+       * Sleeps the current thread for the specified number of nanoseconds.
+       * @param nanoseconds
+       *   Duration to sleep.
+       */
+      static void SleepNanoseconds(UInt64 nanoseconds);
+
+      /**
+       * Blocks the current thread until it is woken via `Wake`, or until the
+       * given absolute tick is reached.
+       * @param wakeTick
+       *   Absolute tick at which to wake, or 0 to block until woken.
+       */
+      static void Block(UInt64 wakeTick);
+
+      /**
+       * Blocks the current thread until it is woken via `Wake`, or until the
+       * given absolute timer count is reached.
+       * @param wakeTime
+       *   Absolute time in counts (see `Timer::Now`), or 0 to block until
+       *   woken.
+       */
+      static void BlockUntil(UInt64 wakeTime);
   };
 }
@@ -0,0 +1,96 @@
+/**
+ * @file System/Kernel/Include/Timer.hpp
+ * @brief Architecture-agnostic system timer.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+#include "TimerWheel.hpp"
+
+namespace Quantum::System::Kernel {
+  /**
+   * Architecture-agnostic system timer.
+   */
+  class Timer {
+    public:
+      /**
+       * Returns the current tick count since timer init.
+       * @return
+       *   The current tick count.
+       */
+      static UInt64 Ticks();
+
+      /**
+       * Returns the timer tick frequency in Hz.
+       * @return
+       *   Tick frequency in Hz.
+       */
+      static UInt32 FrequencyHz();
+
+      /**
+       * Returns the current time in timer counts, the unit of wait
+       * deadlines.
+       * @return
+       *   Counts since timer init.
+       */
+      static UInt64 Now();
+
+      /**
+       * Converts a tick count to timer counts.
+       * @param ticks
+       *   Number of ticks.
+       * @return
+       *   Equivalent number of counts.
+       */
+      static UInt64 TicksToCounts(UInt64 ticks);
+
+      /**
+       * Converts a duration in nanoseconds to timer counts, rounding up.
+       * @param nanoseconds
+       *   Duration in nanoseconds.
+       * @return
+       *   Equivalent number of counts.
+       */
+      static UInt64 NanosecondsToCounts(UInt64 nanoseconds);
+
+      /**
+       * Returns the monotonic nanosecond clock.
+       * @return
+       *   Nanoseconds since timer init.
+       */
+      static UInt64 Nanoseconds();
+
+      /**
+       * Starts a one-shot kernel timer, restarting it if it is already
+       * pending. The callback runs from timer interrupt context.
+       * @param entry
+       *   Timer entry, owned by the caller until it fires or is cancelled.
+       * @param deadline
+       *   Absolute expiry time in timer counts (see `Now`).
+       * @param callback
+       *   Function to run on expiry.
+       * @param context
+       *   Context passed to `callback`.
+       */
+      static void Start(
+        TimerWheel::Entry& entry,
+        UInt64 deadline,
+        TimerWheel::Callback callback,
+        void* context
+      );
+
+      /**
+       * Cancels a kernel timer.
+       * @param entry
+       *   Timer entry to cancel.
+       * @return
+       *   True if the timer was pending; false if it already fired.
+       */
+      static bool Cancel(TimerWheel::Entry& entry);
+  };
+}
@@ -0,0 +1,203 @@
+/**
+ * @file System/Kernel/Include/TimerWheel.hpp
+ * @brief Hierarchical timer wheel for kernel deadlines.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <Types.hpp>
+
+#include "Sync/SpinLock.hpp"
+
+namespace Quantum::System::Kernel {
+  /**
+   * Hierarchical timer wheel with O(1) insert and cancel.
+   *
+   * Deadlines are absolute times in timer counts. They are rounded up to a
+   * wheel unit of 2^`unitShift` counts. Level `n` has 64 slots, each
+   * covering 64^n units. Timers in the upper levels move down a level when
+   * their slot comes due, so each timer is touched at most once per level.
+   */
+  class TimerWheel {
+    public:
+      /**
+       * Timer expiry callback. Runs from timer interrupt context with no
+       * wheel lock held, so it may start or cancel timers.
+       * @param context
+       *   Context pointer given when the timer was started.
+       */
+      using Callback = void (*)(void* context);
+
+      /**
+       * Timer entry, embedded in the structure that owns the timer. The
+       * entry must stay valid until it fires or is cancelled.
+       */
+      struct Entry {
+        /**
+         * Next entry in the slot.
+         */
+        Entry* next;
+
+        /**
+         * Previous entry in the slot.
+         */
+        Entry* prev;
+
+        /**
+         * Absolute expiry time in timer counts.
+         */
+        UInt64 expires;
+
+        /**
+         * Function to run on expiry.
+         */
+        Callback callback;
+
+        /**
+         * Context passed to `callback`.
+         */
+        void* context;
+
+        /**
+         * Wheel level the entry is linked into.
+         */
+        UInt8 level;
+
+        /**
+         * Slot within `level`.
+         */
+        UInt8 slot;
+
+        /**
+         * Whether the entry is linked into the wheel.
+         */
+        bool pending;
+      };
+
+      /**
+       * Wheel unit size as a power of two in timer counts (about 215 us).
+       */
+      static constexpr UInt32 unitShift = 8;
+
+      /**
+       * Initializes an empty wheel.
+       */
+      void Initialize();
+
+      /**
+       * Starts a timer, restarting it if it is already pending.
+       * @param entry
+       *   Timer entry to start.
+       * @param expires
+       *   Absolute expiry time in timer counts.
+       * @param callback
+       *   Function to run on expiry.
+       * @param context
+       *   Context passed to `callback`.
+       */
+      void Insert(
+        Entry& entry,
+        UInt64 expires,
+        Callback callback,
+        void* context
+      );
+
+      /**
+       * Cancels a pending timer.
+       * @param entry
+       *   Timer entry to cancel.
+       * @return
+       *   True if the timer was pending; false if it had already fired or
+       *   was never started.
+       */
+      bool Remove(Entry& entry);
+
+      /**
+       * Runs the callbacks of all timers that have expired.
+       * @param now
+       *   Current time in timer counts.
+       */
+      void Advance(UInt64 now);
+
+      /**
+       * Returns the time at which `Advance` next has work to do. This can be
+       * earlier than the first expiry, when a higher level slot needs to
+       * move down.
+       * @return
+       *   Absolute time in timer counts, or 0 if no timers are pending.
+       */
+      UInt64 NextDeadline();
+
+    private:
+      /**
+       * Slot index bits per level.
+       */
+      static constexpr UInt32 _slotBits = 6;
+
+      /**
+       * Slots per level.
+       */
+      static constexpr UInt32 _slotCount = 1u << _slotBits;
+
+      /**
+       * Number of levels. The top level reaches 2^24 units (about an hour);
+       * later timers are parked in its last slot and placed again when it
+       * comes due.
+       */
+      static constexpr UInt32 _levels = 4;
+
+      /**
+       * Protects the wheel.
+       */
+      Sync::SpinLock _lock;
+
+      /**
+       * Last unit processed by `Advance`.
+       */
+      UInt64 _current = 0;
+
+      /**
+       * Slot list heads.
+       */
+      Entry* _slots[_levels][_slotCount] = {};
+
+      /**
+       * Bit `n` is set while slot `n` of the level is non-empty.
+       */
+      UInt64 _occupied[_levels] = {};
+
+      /**
+       * Links an entry into the slot for its expiry relative to `_current`.
+       * Caller must hold `_lock`.
+       * @param entry
+       *   Entry to place.
+       * @param unit
+       *   Expiry unit; must not be earlier than `_current`.
+       */
+      void Place(Entry& entry, UInt64 unit);
+
+      /**
+       * Unlinks a pending entry. Caller must hold `_lock`.
+       * @param entry
+       *   Entry to unlink.
+       */
+      void Unlink(Entry& entry);
+
+      /**
+       * Moves the entries of every upper level slot that starts at
+       * `_current` down the wheel. Caller must hold `_lock`.
+       */
+      void Cascade();
+
+      /**
+       * Finds the next unit after `_current` at which a slot comes due.
+       * Caller must hold `_lock`.
+       * @return
+       *   The unit, or 0 if the wheel is empty.
+       */
+      UInt64 NextUnit();
+  };
+}
@@ -15,6 +15,19 @@
 namespace Quantum::System::Kernel {
   /**
    * FIFO wait queue for threads.
+   *
+   * Waiters follow a prepare/check/wait protocol so that a wakeup issued
+   * between checking a condition and blocking is never lost:
+   *
+   * ```
+   * queue.Prepare();
+   *
+   * if (condition) {
+   *   queue.Cancel();
+   * } else {
+   *   queue.Wait(deadline);
+   * }
+   * ```
    */
   class WaitQueue {
     public:
@@ -24,7 +37,7 @@ namespace Quantum::System::Kernel {
       void Initialize();
 
       /**
-       * Enqueues the current thread and yields.
+       * Enqueues the current thread and blocks until woken.
        */
       void EnqueueCurrent();
 
@@ -37,12 +50,47 @@ namespace Quantum::System::Kernel {
        */
       bool WaitTicks(UInt32 ticks);
 
+      /**
+       * Registers the current thread as a waiter without blocking. Wakeups
+       * delivered after this call are remembered until `Wait` or `Cancel`.
+       */
+      void Prepare();
+
+      /**
+       * Blocks the current thread after `Prepare` until it is woken or the
+       * deadline is reached. Returns immediately if a wakeup already arrived.
+       * @param deadlineTick
+       *   Absolute tick at which to give up, or 0 to wait indefinitely.
+       * @return
+       *   True if woken by a signal; false if the deadline was reached.
+       */
+      bool Wait(UInt64 deadlineTick);
+
+      /**
+       * Like `Wait`, with the deadline given in timer counts.
+       * @param deadline
+       *   Absolute time in counts (see `Timer::Now`) at which to give up, or
+       *   0 to wait indefinitely.
+       * @return
+       *   True if woken by a signal; false if the deadline was reached.
+       */
+      bool WaitUntil(UInt64 deadline);
+
+      /**
+       * Removes the current thread from the queue after `Prepare` when the
+       * awaited condition was satisfied without blocking.
+       */
+      void Cancel();
+
       /**
        * Wakes a single thread from the queue.
+       * @param boost
+       *   Whether the woken thread runs ahead of all other priorities once
+       *   (used for IRQ delivery).
        * @return
        *   True if a thread was woken.
        */
-      bool WakeOne();
+      bool WakeOne(bool boost = false);
 
       /**
        * Wakes all threads from the queue.
@@ -53,5 +101,14 @@ namespace Quantum::System::Kernel {
       Sync::SpinLock _lock;
       Thread::ControlBlock* _head = nullptr;
       Thread::ControlBlock* _tail = nullptr;
+
+      /**
+       * Unlinks a thread from the queue. Caller must hold `_lock`.
+       * @param thread
+       *   Thread to unlink.
+       * @return
+       *   True if the thread was found and removed.
+       */
+      bool Unlink(Thread::ControlBlock* thread);
   };
 }
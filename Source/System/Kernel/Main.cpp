@@ -9,6 +9,7 @@
 #include <Types.hpp>
 
 #include "Arch/Paging.hpp"
+#include "Arch/SMP.hpp"
 #include "BootInfo.hpp"
 #include "Devices/DeviceManager.hpp"
 #include "InitBundle.hpp"
@@ -22,6 +23,7 @@
 namespace Quantum::System::Kernel {
   void Main(UInt32 bootInfoPhysicalAddress) {
     using Arch::Paging;
+    using Arch::SMP;
     using Devices::DeviceManager;
 
     BootInfo::Initialize(bootInfoPhysicalAddress);
@@ -33,6 +35,8 @@ namespace Quantum::System::Kernel {
     DeviceManager::Initialize();
     InitBundle::Initialize();
     Task::Initialize();
+    SMP::Initialize();
+    DeviceManager::Start();
 
     #if defined(KERNEL_TESTS)
     Task::Create(TestRunner::Run, 4096);
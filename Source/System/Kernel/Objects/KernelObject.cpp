@@ -20,6 +20,10 @@ namespace Quantum::System::Kernel::Objects {
     _refCount.AddRef();
   }
 
+  bool KernelObject::TryAddRef() {
+    return _refCount.TryAddRef();
+  }
+
   void KernelObject::Release() {
     if (_refCount.Get() == 0) {
       return;
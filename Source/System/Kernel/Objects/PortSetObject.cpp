@@ -0,0 +1,21 @@
+/**
+ * @file System/Kernel/Objects/PortSetObject.cpp
+ * @brief IPC port set kernel object.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "IPC.hpp"
+#include "Objects/PortSetObject.hpp"
+
+namespace Quantum::System::Kernel::Objects {
+  PortSetObject::PortSetObject(UInt32 setId)
+    : KernelObject(KernelObjectType::PortSet),
+    portSetId(setId)
+  {}
+
+  PortSetObject::~PortSetObject() {
+    IPC::DestroyPortSet(portSetId);
+  }
+}
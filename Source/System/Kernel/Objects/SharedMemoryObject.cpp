@@ -0,0 +1,34 @@
+/**
+ * @file System/Kernel/Objects/SharedMemoryObject.cpp
+ * @brief Shared memory kernel object.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "Arch/PhysicalAllocator.hpp"
+#include "Objects/SharedMemoryObject.hpp"
+#include "SharedMemory.hpp"
+
+namespace Quantum::System::Kernel::Objects {
+  SharedMemoryObject::SharedMemoryObject(UInt32 id, UInt32 creatorTaskId)
+    : KernelObject(KernelObjectType::SharedMemory),
+    sharedId(id),
+    creatorTaskId(creatorTaskId),
+    grants(),
+    pageCount(0),
+    pages()
+  {}
+
+  SharedMemoryObject::~SharedMemoryObject() {
+    SharedMemory::Unregister(this);
+
+    for (UInt32 i = 0; i < pageCount; ++i) {
+      if (pages[i] != 0) {
+        Arch::PhysicalAllocator::FreePage(pages[i]);
+      }
+    }
+
+    pageCount = 0;
+  }
+}
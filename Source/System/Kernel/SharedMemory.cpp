@@ -0,0 +1,279 @@
+/**
+ * @file System/Kernel/SharedMemory.cpp
+ * @brief Shared memory objects mapped between tasks.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <Types.hpp>
+
+#include "Arch/AddressSpace.hpp"
+#include "Arch/PhysicalAllocator.hpp"
+#include "SharedMemory.hpp"
+#include "Sync/ScopedLock.hpp"
+
+namespace Quantum::System::Kernel {
+  using Objects::SharedMemoryObject;
+
+  SharedMemoryObject* SharedMemory::Create(
+    UInt32 sizeBytes,
+    UInt32 creatorTaskId
+  ) {
+    UInt32 pageSize = Arch::PhysicalAllocator::pageSize;
+
+    if (sizeBytes == 0 || sizeBytes > slotBytes) {
+      return nullptr;
+    }
+
+    UInt32 id = 0;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      id = _nextId++;
+    }
+
+    SharedMemoryObject* object = new SharedMemoryObject(id, creatorTaskId);
+
+    if (!object) {
+      return nullptr;
+    }
+
+    UInt32 pageCount = (sizeBytes + pageSize - 1) / pageSize;
+
+    for (UInt32 i = 0; i < pageCount; ++i) {
+      UInt32 physical = Arch::PhysicalAllocator::AllocatePage(true);
+
+      if (physical == 0) {
+        object->Release();
+
+        return nullptr;
+      }
+
+      object->pages[i] = physical;
+      object->pageCount = i + 1;
+    }
+
+    bool registered = false;
+
+    {
+      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+      for (UInt32 i = 0; i < _maxObjects; ++i) {
+        if (!_objects[i]) {
+          _objects[i] = object;
+          registered = true;
+
+          break;
+        }
+      }
+    }
+
+    if (!registered) {
+      object->Release();
+
+      return nullptr;
+    }
+
+    return object;
+  }
+
+  SharedMemoryObject* SharedMemory::Open(
+    UInt32 id,
+    UInt32 taskId,
+    UInt32 rights
+  ) {
+    if (id == 0 || taskId == 0) {
+      return nullptr;
+    }
+
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    for (UInt32 i = 0; i < _maxObjects; ++i) {
+      SharedMemoryObject* object = _objects[i];
+
+      if (!object || object->sharedId != id) {
+        continue;
+      }
+
+      bool allowed = object->creatorTaskId == taskId;
+
+      for (
+        UInt32 j = 0;
+        !allowed && j < SharedMemoryObject::maxGrants;
+        ++j
+      ) {
+        const SharedMemoryObject::Grant& grant = object->grants[j];
+
+        allowed = grant.taskId == taskId && (grant.rights & rights) == rights;
+      }
+
+      // the registry holds no reference; an object whose last reference is
+      // gone stays listed until its destructor unregisters it
+      if (!allowed || !object->TryAddRef()) {
+        return nullptr;
+      }
+
+      return object;
+    }
+
+    return nullptr;
+  }
+
+  bool SharedMemory::Grant(
+    UInt32 id,
+    UInt32 creatorTaskId,
+    UInt32 granteeTaskId,
+    UInt32 rights
+  ) {
+    if (id == 0 || granteeTaskId == 0 || rights == 0) {
+      return false;
+    }
+
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    for (UInt32 i = 0; i < _maxObjects; ++i) {
+      SharedMemoryObject* object = _objects[i];
+
+      if (!object || object->sharedId != id) {
+        continue;
+      }
+
+      if (object->creatorTaskId != creatorTaskId) {
+        return false;
+      }
+
+      if (granteeTaskId == creatorTaskId) {
+        return true;
+      }
+
+      SharedMemoryObject::Grant* free = nullptr;
+
+      for (UInt32 j = 0; j < SharedMemoryObject::maxGrants; ++j) {
+        SharedMemoryObject::Grant& grant = object->grants[j];
+
+        if (grant.taskId == granteeTaskId) {
+          grant.rights = rights;
+
+          return true;
+        }
+
+        if (!free && grant.taskId == 0) {
+          free = &grant;
+        }
+      }
+
+      if (!free) {
+        return false;
+      }
+
+      free->taskId = granteeTaskId;
+      free->rights = rights;
+
+      return true;
+    }
+
+    return false;
+  }
+
+  UInt32 SharedMemory::Map(
+    Task::ControlBlock* task,
+    SharedMemoryObject* object,
+    bool writable
+  ) {
+    if (!task || !object || task->pageDirectoryPhysical == 0) {
+      return 0;
+    }
+
+    UInt32 pageSize = Arch::PhysicalAllocator::pageSize;
+
+    for (UInt32 slot = 0; slot < _maxMappings; ++slot) {
+      if (task->sharedMappings[slot]) {
+        continue;
+      }
+
+      UInt32 base = windowBase + slot * slotBytes;
+
+      for (UInt32 i = 0; i < object->pageCount; ++i) {
+        Arch::AddressSpace::MapPage(
+          task->pageDirectoryPhysical,
+          base + i * pageSize,
+          object->pages[i],
+          writable,
+          true,
+          false
+        );
+      }
+
+      object->AddRef();
+      task->sharedMappings[slot] = object;
+
+      return base;
+    }
+
+    return 0;
+  }
+
+  bool SharedMemory::Unmap(Task::ControlBlock* task, UInt32 virtualAddress) {
+    if (!task || virtualAddress < windowBase) {
+      return false;
+    }
+
+    UInt32 offset = virtualAddress - windowBase;
+    UInt32 slot = offset / slotBytes;
+
+    if (
+      offset % slotBytes != 0
+      || slot >= _maxMappings
+      || !task->sharedMappings[slot]
+    ) {
+      return false;
+    }
+
+    UnmapSlot(task, slot);
+
+    return true;
+  }
+
+  void SharedMemory::ReleaseTask(Task::ControlBlock* task) {
+    if (!task) {
+      return;
+    }
+
+    for (UInt32 slot = 0; slot < _maxMappings; ++slot) {
+      if (task->sharedMappings[slot]) {
+        UnmapSlot(task, slot);
+      }
+    }
+  }
+
+  void SharedMemory::Unregister(SharedMemoryObject* object) {
+    Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+
+    for (UInt32 i = 0; i < _maxObjects; ++i) {
+      if (_objects[i] == object) {
+        _objects[i] = nullptr;
+
+        break;
+      }
+    }
+  }
+
+  void SharedMemory::UnmapSlot(Task::ControlBlock* task, UInt32 slot) {
+    SharedMemoryObject* object = task->sharedMappings[slot];
+    UInt32 pageSize = Arch::PhysicalAllocator::pageSize;
+    UInt32 base = windowBase + slot * slotBytes;
+
+    for (UInt32 i = 0; i < object->pageCount; ++i) {
+      Arch::AddressSpace::UnmapPage(
+        task->pageDirectoryPhysical,
+        base + i * pageSize
+      );
+    }
+
+    task->sharedMappings[slot] = nullptr;
+
+    object->Release();
+  }
+}
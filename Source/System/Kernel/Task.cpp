@@ -10,9 +10,13 @@
 
 #include "Arch/AddressSpace.hpp"
 #include "Arch/Paging.hpp"
+#include "Devices/BlockDevices.hpp"
 #include "Handles.hpp"
 #include "Heap.hpp"
+#include "IPC.hpp"
 #include "Logger.hpp"
+#include "SharedMemory.hpp"
+#include "Sync/ScopedIRQLock.hpp"
 #include "Task.hpp"
 #include "Thread.hpp"
 
@@ -23,6 +27,7 @@ namespace Quantum::System::Kernel {
     _coordinatorTaskId = 0;
     _allTasksHead = nullptr;
     _nextTaskId = 1;
+    _registryLock.Initialize();
 
     Thread::Initialize();
   }
@@ -38,7 +43,11 @@ namespace Quantum::System::Kernel {
       return nullptr;
     }
 
-    task->id = _nextTaskId++;
+    {
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_registryLock);
+
+      task->id = _nextTaskId++;
+    }
     task->caps = 0;
     task->pageDirectoryPhysical = pageDirectoryPhysical;
     task->userHeapBase = 0;
@@ -46,9 +55,15 @@ namespace Quantum::System::Kernel {
     task->userHeapMappedEnd = 0;
     task->userHeapLimit = 0;
     task->handleTable = nullptr;
+
+    for (UInt32 i = 0; i < Task::ControlBlock::maxSharedMappings; ++i) {
+      task->sharedMappings[i] = nullptr;
+    }
+
     task->mainThread = nullptr;
     task->threadHead = nullptr;
     task->threadCount = 0;
+    task->priority = Thread::defaultPriority;
     task->next = nullptr;
 
     HandleTable* handleTable = static_cast<HandleTable*>(
@@ -151,6 +166,10 @@ namespace Quantum::System::Kernel {
     Thread::SleepTicks(ticks);
   }
 
+  void Task::SleepNanoseconds(UInt64 nanoseconds) {
+    Thread::SleepNanoseconds(nanoseconds);
+  }
+
   Task::ControlBlock* Task::GetCurrent() {
     Thread::ControlBlock* thread = Thread::GetCurrent();
 
@@ -205,6 +224,52 @@ namespace Quantum::System::Kernel {
     return task && (task->caps & CapabilityIO) != 0;
   }
 
+  bool Task::SetPriority(UInt32 threadId, UInt32 priority) {
+    Task::ControlBlock* task = GetCurrent();
+
+    if (!task || priority > Thread::maxPriority) {
+      return false;
+    }
+
+    if (threadId != 0) {
+      Thread::ControlBlock* thread = Thread::FindById(threadId);
+
+      if (!thread || thread->task != task) {
+        return false;
+      }
+
+      return Thread::SetPriority(thread, priority);
+    }
+
+    ApplyPriority(task, priority);
+
+    return true;
+  }
+
+  bool Task::SetTaskPriority(UInt32 taskId, UInt32 priority) {
+    Task::ControlBlock* task = FindById(taskId);
+
+    if (!task || priority > Thread::maxPriority) {
+      return false;
+    }
+
+    ApplyPriority(task, priority);
+
+    return true;
+  }
+
+  void Task::ApplyPriority(Task::ControlBlock* task, UInt32 priority) {
+    task->priority = priority;
+
+    for (
+      Thread::ControlBlock* thread = task->threadHead;
+      thread;
+      thread = thread->taskNext
+    ) {
+      Thread::SetPriority(thread, priority);
+    }
+  }
+
   void Task::EnablePreemption() {
     Thread::EnablePreemption();
   }
@@ -224,6 +289,16 @@ namespace Quantum::System::Kernel {
 
     RemoveFromAllTasks(task);
 
+    // shared pages belong to their objects; unmap them so the address space
+    // teardown does not free them underneath other tasks
+    SharedMemory::ReleaseTask(task);
+
+    // asynchronous block requests are only ever collected by their owner
+    Devices::BlockDevices::ReleaseTask(task->id);
+
+    // callers blocked on this task would otherwise wait forever
+    IPC::ReleaseTask(task->id);
+
     if (task->handleTable != nullptr) {
       Heap::Free(task->handleTable);
 
@@ -238,11 +313,15 @@ namespace Quantum::System::Kernel {
   }
 
   void Task::AddToAllTasks(Task::ControlBlock* task) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_registryLock);
+
     task->next = _allTasksHead;
     _allTasksHead = task;
   }
 
   void Task::RemoveFromAllTasks(Task::ControlBlock* task) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_registryLock);
+
     Task::ControlBlock** current = &_allTasksHead;
 
     while (*current) {
@@ -258,6 +337,8 @@ namespace Quantum::System::Kernel {
   }
 
   Task::ControlBlock* Task::FindById(UInt32 id) {
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_registryLock);
+
     Task::ControlBlock* current = _allTasksHead;
 
     while (current) {
@@ -11,7 +11,9 @@
 #include "Logger.hpp"
 #include "Testing.hpp"
 #include "Tests/MemoryTests.hpp"
+#include "Tests/SMPTests.hpp"
 #include "Tests/TaskTests.hpp"
+#include "Tests/TimerTests.hpp"
 #include "Tests/IPCTests.hpp"
 #include "Tests/UserModeTests.hpp"
 
@@ -96,7 +98,9 @@ namespace Quantum::System::Kernel {
   void Testing::RegisterBuiltins() {
     Tests::MemoryTests::RegisterTests();
     Tests::TaskTests::RegisterTests();
+    Tests::TimerTests::RegisterTests();
     Tests::IPCTests::RegisterTests();
     Tests::UserModeTests::RegisterTests();
+    Tests::SMPTests::RegisterTests();
   }
 }
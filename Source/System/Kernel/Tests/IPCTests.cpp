@@ -11,6 +11,7 @@
 #include "IPC.hpp"
 #include "Task.hpp"
 #include "Testing.hpp"
+#include "Timer.hpp"
 #include "Tests/IPCTests.hpp"
 
 namespace Quantum::System::Kernel::Tests {
@@ -51,6 +52,42 @@ namespace Quantum::System::Kernel::Tests {
     Task::Exit();
   }
 
+  void IPCTests::ReplierTask() {
+    UInt32 sender = 0;
+    UInt32 length = 0;
+    UInt32 replyToken = 0;
+    UInt8 request[16] = {};
+
+    bool ok = IPC::Receive(
+      _portId,
+      sender,
+      request,
+      static_cast<UInt32>(sizeof(request)),
+      length,
+      &replyToken
+    );
+
+    if (ok && replyToken != 0) {
+      const UInt8 payload[] = { 'p', 'o', 'n', 'g' };
+      UInt32 replier = Task::GetCurrentId();
+
+      _replyOk = IPC::Reply(
+        replyToken,
+        replier,
+        payload,
+        static_cast<UInt32>(sizeof(payload))
+      );
+      _replyReused = IPC::Reply(
+        replyToken,
+        replier,
+        payload,
+        static_cast<UInt32>(sizeof(payload))
+      );
+    }
+
+    Task::Exit();
+  }
+
   bool IPCTests::TestSendReceive() {
     _sendDone = false;
     _recvDone = false;
@@ -90,7 +127,189 @@ namespace Quantum::System::Kernel::Tests {
     return ok;
   }
 
+  bool IPCTests::TestReceiveTimeout() {
+    UInt32 portId = IPC::CreatePort();
+
+    TEST_ASSERT(portId != 0, "failed to create IPC port");
+
+    UInt32 sender = 0;
+    UInt32 length = 0;
+    UInt8 buffer[4] = {};
+    UInt64 start = Timer::Ticks();
+
+    bool received = IPC::ReceiveTimeout(
+      portId,
+      sender,
+      buffer,
+      static_cast<UInt32>(sizeof(buffer)),
+      length,
+      5
+    );
+
+    UInt64 elapsed = Timer::Ticks() - start;
+
+    IPC::DestroyPort(portId);
+
+    TEST_ASSERT(!received, "IPC receive on empty port did not time out");
+    TEST_ASSERT(elapsed >= 5, "IPC receive timed out early");
+    TEST_ASSERT(elapsed < 50, "IPC receive timeout overshot deadline");
+
+    return true;
+  }
+
+  bool IPCTests::TestCallReply() {
+    _replyOk = false;
+    _replyReused = false;
+    _portId = IPC::CreatePort();
+
+    TEST_ASSERT(_portId != 0, "failed to create IPC port");
+
+    Task::Create(ReplierTask, 4096);
+
+    const UInt8 payload[] = { 'p', 'i', 'n', 'g' };
+    UInt8 reply[16] = {};
+    UInt32 replier = 0;
+    UInt32 length = 0;
+
+    bool ok = IPC::Call(
+      _portId,
+      Task::GetCurrentId(),
+      payload,
+      static_cast<UInt32>(sizeof(payload)),
+      replier,
+      reply,
+      static_cast<UInt32>(sizeof(reply)),
+      length,
+      100
+    );
+
+    IPC::DestroyPort(_portId);
+    _portId = 0;
+
+    TEST_ASSERT(ok, "IPC call did not receive a reply");
+    TEST_ASSERT(_replyOk, "IPC reply was rejected");
+    TEST_ASSERT(length == 4, "IPC reply length mismatch");
+    TEST_ASSERT(
+      reply[0] == 'p' && reply[1] == 'o'
+        && reply[2] == 'n' && reply[3] == 'g',
+      "IPC reply payload mismatch"
+    );
+    TEST_ASSERT(!_replyReused, "IPC reply token was accepted twice");
+
+    return true;
+  }
+
+  bool IPCTests::TestCallFullPort() {
+    UInt32 portId = IPC::CreatePort();
+
+    TEST_ASSERT(portId != 0, "failed to create IPC port");
+
+    const UInt8 payload[] = { 'f', 'u', 'l', 'l' };
+    UInt32 queued = 0;
+
+    // nobody receives, so the queue stays full
+    while (
+      queued < IPC::maxQueueDepth
+      && IPC::SendNoWait(
+        portId,
+        Task::GetCurrentId(),
+        payload,
+        static_cast<UInt32>(sizeof(payload))
+      )
+    ) {
+      ++queued;
+    }
+
+    UInt8 reply[16] = {};
+    UInt32 replier = 0;
+    UInt32 length = 0;
+    UInt64 start = Timer::Ticks();
+
+    bool ok = IPC::Call(
+      portId,
+      Task::GetCurrentId(),
+      payload,
+      static_cast<UInt32>(sizeof(payload)),
+      replier,
+      reply,
+      static_cast<UInt32>(sizeof(reply)),
+      length,
+      5
+    );
+
+    UInt64 elapsed = Timer::Ticks() - start;
+
+    IPC::DestroyPort(portId);
+
+    TEST_ASSERT(queued == IPC::maxQueueDepth, "IPC port did not fill");
+    TEST_ASSERT(!ok, "IPC call to a full port succeeded");
+    TEST_ASSERT(elapsed >= 5, "IPC call to a full port timed out early");
+    TEST_ASSERT(elapsed < 50, "IPC call to a full port ignored its timeout");
+
+    return true;
+  }
+
+  bool IPCTests::TestPortSetWaitAny() {
+    _sendDone = false;
+
+    UInt32 idlePortId = IPC::CreatePort();
+
+    _portId = IPC::CreatePort();
+
+    Objects::PortSetObject* set = IPC::CreatePortSet();
+
+    TEST_ASSERT(idlePortId != 0 && _portId != 0, "failed to create IPC ports");
+    TEST_ASSERT(set != nullptr, "failed to create port set");
+
+    if (!set) {
+      return false;
+    }
+
+    UInt32 setId = set->portSetId;
+
+    TEST_ASSERT(IPC::AddToPortSet(setId, idlePortId), "port set add failed");
+    TEST_ASSERT(IPC::AddToPortSet(setId, _portId), "port set add failed");
+    TEST_ASSERT(
+      !IPC::AddToPortSet(setId, _portId),
+      "port was attached to a port set twice"
+    );
+
+    UInt32 readyPortId = 0;
+    bool timedOut = !IPC::WaitAny(setId, 5, readyPortId);
+
+    Task::Create(SenderTask, 4096);
+
+    bool ready = IPC::WaitAny(setId, 100, readyPortId);
+    UInt32 sender = 0;
+    UInt32 length = 0;
+    UInt8 buffer[4] = {};
+    bool received = ready && IPC::TryReceive(
+      readyPortId,
+      sender,
+      buffer,
+      static_cast<UInt32>(sizeof(buffer)),
+      length
+    );
+
+    set->Release();
+    IPC::DestroyPort(idlePortId);
+    IPC::DestroyPort(_portId);
+
+    TEST_ASSERT(timedOut, "port set wait on idle ports did not time out");
+    TEST_ASSERT(ready, "port set wait missed a message");
+    TEST_ASSERT(readyPortId == _portId, "port set reported the wrong port");
+    TEST_ASSERT(received && length == 4, "ready port had no message");
+
+    _portId = 0;
+
+    return true;
+  }
+
   void IPCTests::RegisterTests() {
     Testing::Register("IPC send/receive", TestSendReceive);
+    Testing::Register("IPC receive timeout", TestReceiveTimeout);
+    Testing::Register("IPC call/reply", TestCallReply);
+    Testing::Register("IPC call to a full port", TestCallFullPort);
+    Testing::Register("IPC port set wait", TestPortSetWaitAny);
   }
 }
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "Arch/PhysicalAllocator.hpp"
 #include "Heap.hpp"
 #include "Testing.hpp"
 #include "Tests/MemoryTests.hpp"
@@ -24,7 +25,36 @@ namespace Quantum::System::Kernel::Tests {
     return true;
   }
 
+  bool MemoryTests::TestContiguousAllocation() {
+    using Arch::PhysicalAllocator;
+
+    constexpr UInt32 pages = 4;
+    constexpr UInt32 boundary = 0x10000;
+    UInt32 base = PhysicalAllocator::AllocateContiguousBelow(
+      0x01000000,
+      pages,
+      true,
+      boundary
+    );
+
+    TEST_ASSERT(base != 0, "Contiguous allocation returned null");
+
+    UInt32 last = base + pages * PhysicalAllocator::pageSize - 1;
+
+    TEST_ASSERT(
+      (base / boundary) == (last / boundary),
+      "Contiguous allocation crossed its boundary"
+    );
+
+    for (UInt32 i = 0; i < pages; ++i) {
+      PhysicalAllocator::FreePage(base + i * PhysicalAllocator::pageSize);
+    }
+
+    return true;
+  }
+
   void MemoryTests::RegisterTests() {
     Testing::Register("Memory alloc/free", TestMemoryAllocation);
+    Testing::Register("Memory contiguous pages", TestContiguousAllocation);
   }
 }
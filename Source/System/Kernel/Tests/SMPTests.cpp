@@ -0,0 +1,85 @@
+/**
+ * @file System/Kernel/Tests/SMPTests.cpp
+ * @brief Multiprocessor kernel tests.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "Arch/SMP.hpp"
+#include "Task.hpp"
+#include "Testing.hpp"
+#include "Tests/SMPTests.hpp"
+
+namespace Quantum::System::Kernel::Tests {
+  using Arch::SMP;
+
+  void SMPTests::SpinnerTask() {
+    while (!_stopSpinner) {
+      _spinnerProcessor = SMP::CurrentIndex();
+      _spinnerCount++;
+    }
+
+    Task::Exit();
+  }
+
+  bool SMPTests::TestProcessorIndex() {
+    UInt32 count = SMP::GetProcessorCount();
+
+    TEST_ASSERT(count >= 1, "No processors online");
+    TEST_ASSERT(
+      count <= SMP::maxProcessors,
+      "More processors online than supported"
+    );
+    TEST_ASSERT(
+      SMP::CurrentIndex() < count,
+      "Processor index out of range"
+    );
+    TEST_ASSERT(SMP::IsOnline(0), "Bootstrap processor not online");
+
+    return true;
+  }
+
+  bool SMPTests::TestParallelTasks() {
+    // nothing to run in parallel with on a single processor
+    if (SMP::GetProcessorCount() < 2) {
+      return true;
+    }
+
+    _stopSpinner = false;
+    _spinnerCount = 0;
+
+    Task::EnablePreemption();
+    Task::Create(SpinnerTask, 4096);
+
+    const UInt32 target = 100000;
+    const UInt32 maxIterations = 50000000;
+    UInt32 iterations = 0;
+
+    // busy-wait without yielding; an idle processor should steal the
+    // spinner rather than leaving it to share this one
+    while (_spinnerCount < target && iterations < maxIterations) {
+      iterations++;
+    }
+
+    UInt32 self = SMP::CurrentIndex();
+    UInt32 spinner = _spinnerProcessor;
+    bool progressed = _spinnerCount >= target;
+
+    _stopSpinner = true;
+
+    for (int i = 0; i < 4; ++i) {
+      Task::Yield();
+    }
+
+    TEST_ASSERT(progressed, "Spinner task did not run");
+    TEST_ASSERT(spinner != self, "Spinner task shared the test processor");
+
+    return true;
+  }
+
+  void SMPTests::RegisterTests() {
+    Testing::Register("SMP processor index", TestProcessorIndex);
+    Testing::Register("SMP parallel tasks", TestParallelTasks);
+  }
+}
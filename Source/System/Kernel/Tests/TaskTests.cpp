@@ -8,25 +8,26 @@
 
 #include "Task.hpp"
 #include "Testing.hpp"
+#include "Timer.hpp"
 #include "Tests/TaskTests.hpp"
 
 namespace Quantum::System::Kernel::Tests {
   void TaskTests::TaskA() {
-    _taskCounter += 1;
+    _taskCounter.FetchAdd(1);
 
     Task::Yield();
 
-    _taskCounter += 1;
+    _taskCounter.FetchAdd(1);
 
     Task::Exit();
   }
 
   void TaskTests::TaskB() {
-    _taskCounter += 1;
+    _taskCounter.FetchAdd(1);
 
     Task::Yield();
 
-    _taskCounter += 1;
+    _taskCounter.FetchAdd(1);
 
     Task::Exit();
   }
@@ -47,18 +48,30 @@ namespace Quantum::System::Kernel::Tests {
     Task::Exit();
   }
 
+  void TaskTests::LowPriorityTask() {
+    _priorityOrder[_priorityRuns.FetchAdd(1)] = 1;
+
+    Task::Exit();
+  }
+
+  void TaskTests::HighPriorityTask() {
+    _priorityOrder[_priorityRuns.FetchAdd(1)] = 2;
+
+    Task::Exit();
+  }
+
   bool TaskTests::TestTaskYield() {
-    _taskCounter = 0;
+    _taskCounter.Store(0);
 
     Task::Create(TaskA, 4096);
     Task::Create(TaskB, 4096);
 
     // yield until both tasks have run to completion
-    while (_taskCounter < 4) {
+    while (_taskCounter.Load() < 4) {
       Task::Yield();
     }
 
-    TEST_ASSERT(_taskCounter == 4, "Expected 4 increments across tasks");
+    TEST_ASSERT(_taskCounter.Load() == 4, "Expected 4 increments across tasks");
 
     return true;
   }
@@ -100,8 +113,94 @@ namespace Quantum::System::Kernel::Tests {
     return true;
   }
 
+  bool TaskTests::TestTaskPriority() {
+    _priorityRuns.Store(0);
+
+    // keep both tasks queued until their priorities are set
+    Task::DisablePreemption();
+
+    // the low task is queued first, so FIFO order would run it first
+    Task::ControlBlock* low = Task::Create(LowPriorityTask, 4096);
+    Task::ControlBlock* high = Task::Create(HighPriorityTask, 4096);
+
+    if (low && high) {
+      Thread::SetPriority(low->mainThread, 0);
+      Thread::SetPriority(high->mainThread, Thread::maxPriority);
+    }
+
+    Task::EnablePreemption();
+
+    TEST_ASSERT(low && high, "Failed to create priority test tasks");
+
+    if (!low || !high) {
+      return false;
+    }
+
+    // sleep rather than yield so the low task is not starved by this one
+    for (UInt32 i = 0; i < 100 && _priorityRuns.Load() < 2; ++i) {
+      Task::SleepTicks(1);
+    }
+
+    TEST_ASSERT(
+      _priorityRuns.Load() == 2,
+      "Priority test tasks did not both run"
+    );
+    TEST_ASSERT(
+      _priorityOrder[0] == 2 && _priorityOrder[1] == 1,
+      "Higher priority task did not run first"
+    );
+
+    return true;
+  }
+
+  bool TaskTests::TestTaskSleep() {
+    UInt64 start = Timer::Ticks();
+
+    Task::SleepTicks(3);
+
+    UInt64 elapsed = Timer::Ticks() - start;
+
+    TEST_ASSERT(elapsed >= 3, "Task woke before its sleep elapsed");
+    TEST_ASSERT(elapsed <= 5, "Task overslept its deadline");
+
+    return true;
+  }
+
+  bool TaskTests::TestTaskNanosecondSleep() {
+    constexpr UInt64 sleepNanoseconds = 2000000;
+
+    // deadlines are kept in PIT counts while the clock may run from the TSC,
+    // so allow for calibration error
+    constexpr UInt64 toleranceNanoseconds = 50000;
+
+    UInt64 first = Timer::Nanoseconds();
+    UInt64 second = Timer::Nanoseconds();
+
+    TEST_ASSERT(second >= first, "Nanosecond clock went backwards");
+
+    UInt64 start = Timer::Nanoseconds();
+
+    Task::SleepNanoseconds(sleepNanoseconds);
+
+    UInt64 elapsed = Timer::Nanoseconds() - start;
+
+    TEST_ASSERT(
+      elapsed + toleranceNanoseconds >= sleepNanoseconds,
+      "Task woke before its nanosecond sleep elapsed"
+    );
+    TEST_ASSERT(
+      elapsed < sleepNanoseconds * 4,
+      "Nanosecond sleep was rounded to a coarse deadline"
+    );
+
+    return true;
+  }
+
   void TaskTests::RegisterTests() {
     Testing::Register("Task yield scheduling", TestTaskYield);
     Testing::Register("Task preemption scheduling", TestTaskPreemption);
+    Testing::Register("Task priority scheduling", TestTaskPriority);
+    Testing::Register("Task timed sleep", TestTaskSleep);
+    Testing::Register("Task nanosecond sleep", TestTaskNanosecondSleep);
   }
 }
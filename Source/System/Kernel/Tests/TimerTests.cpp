@@ -0,0 +1,113 @@
+/**
+ * @file System/Kernel/Tests/TimerTests.cpp
+ * @brief Timer-related kernel tests.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "Task.hpp"
+#include "Testing.hpp"
+#include "Timer.hpp"
+#include "Tests/TimerTests.hpp"
+
+namespace Quantum::System::Kernel::Tests {
+  void TimerTests::CountExpiry(void* context) {
+    volatile UInt32* counter = static_cast<volatile UInt32*>(context);
+
+    *counter += 1;
+  }
+
+  bool TimerTests::TestWheelCascade() {
+    constexpr UInt64 unit = 1ull << TimerWheel::unitShift;
+
+    // one deadline per wheel level, plus one that is not unit aligned
+    const UInt64 deadlines[] = {
+      unit * 10,
+      unit * 100,
+      unit * 5000,
+      unit * 300000,
+      unit * 300100 + 1
+    };
+    constexpr UInt32 count = sizeof(deadlines) / sizeof(deadlines[0]);
+
+    TimerWheel::Entry entries[count] = {};
+    TimerWheel::Entry cancelled = {};
+    volatile UInt32 fired[count] = {};
+    volatile UInt32 cancelledFired = 0;
+
+    _wheel.Initialize();
+
+    for (UInt32 i = 0; i < count; ++i) {
+      _wheel.Insert(
+        entries[i],
+        deadlines[i],
+        CountExpiry,
+        const_cast<UInt32*>(&fired[i])
+      );
+    }
+
+    _wheel.Insert(
+      cancelled,
+      unit * 200,
+      CountExpiry,
+      const_cast<UInt32*>(&cancelledFired)
+    );
+
+    TEST_ASSERT(_wheel.Remove(cancelled), "Pending timer was not removed");
+    TEST_ASSERT(!_wheel.Remove(cancelled), "Timer was removed twice");
+
+    for (UInt32 i = 0; i < count; ++i) {
+      UInt64 due = (deadlines[i] + unit - 1) & ~(unit - 1);
+
+      TEST_ASSERT(
+        _wheel.NextDeadline() <= due,
+        "Wheel deadline is later than the next timer"
+      );
+
+      _wheel.Advance(due - 1);
+
+      TEST_ASSERT(fired[i] == 0, "Timer fired before its deadline");
+
+      _wheel.Advance(due);
+
+      TEST_ASSERT(fired[i] == 1, "Timer did not fire at its deadline");
+    }
+
+    TEST_ASSERT(cancelledFired == 0, "Cancelled timer fired");
+    TEST_ASSERT(_wheel.NextDeadline() == 0, "Wheel not empty after expiry");
+
+    return true;
+  }
+
+  bool TimerTests::TestTimerCallback() {
+    TimerWheel::Entry timer = {};
+    TimerWheel::Entry cancelled = {};
+    volatile UInt32 fired = 0;
+    volatile UInt32 cancelledFired = 0;
+    UInt64 deadline = Timer::Now() + Timer::TicksToCounts(2);
+
+    Timer::Start(timer, deadline, CountExpiry, const_cast<UInt32*>(&fired));
+    Timer::Start(
+      cancelled,
+      deadline,
+      CountExpiry,
+      const_cast<UInt32*>(&cancelledFired)
+    );
+
+    TEST_ASSERT(Timer::Cancel(cancelled), "Pending timer was not cancelled");
+
+    Task::SleepTicks(4);
+
+    TEST_ASSERT(fired == 1, "Timer callback did not run");
+    TEST_ASSERT(cancelledFired == 0, "Cancelled timer callback ran");
+    TEST_ASSERT(!Timer::Cancel(timer), "Expired timer was still pending");
+
+    return true;
+  }
+
+  void TimerTests::RegisterTests() {
+    Testing::Register("Timer wheel cascade", TestWheelCascade);
+    Testing::Register("Timer callback", TestTimerCallback);
+  }
+}
@@ -64,11 +64,31 @@ namespace Quantum::System::Kernel {
     return Arch::Thread::Tick(context);
   }
 
-  void Thread::Wake(Thread::ControlBlock* thread) {
-    Arch::Thread::Wake(thread);
+  void Thread::Wake(Thread::ControlBlock* thread, bool boost) {
+    Arch::Thread::Wake(thread, boost);
+  }
+
+  bool Thread::SetPriority(Thread::ControlBlock* thread, UInt32 priority) {
+    return Arch::Thread::SetPriority(thread, priority);
+  }
+
+  Thread::ControlBlock* Thread::FindById(UInt32 id) {
+    return reinterpret_cast<Thread::ControlBlock*>(Arch::Thread::FindById(id));
   }
 
   void Thread::SleepTicks(UInt32 ticks) {
     Arch::Thread::SleepTicks(ticks);
   }
+
+  void Thread::SleepNanoseconds(UInt64 nanoseconds) {
+    Arch::Thread::SleepNanoseconds(nanoseconds);
+  }
+
+  void Thread::Block(UInt64 wakeTick) {
+    Arch::Thread::Block(wakeTick);
+  }
+
+  void Thread::BlockUntil(UInt64 wakeTime) {
+    Arch::Thread::BlockUntil(wakeTime);
+  }
 }
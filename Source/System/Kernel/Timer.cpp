@@ -0,0 +1,50 @@
+/**
+ * @file System/Kernel/Timer.cpp
+ * @brief Architecture-agnostic system timer.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "Arch/Thread.hpp"
+#include "Arch/Timer.hpp"
+#include "Timer.hpp"
+
+namespace Quantum::System::Kernel {
+  UInt64 Timer::Ticks() {
+    return Arch::Timer::Ticks();
+  }
+
+  UInt32 Timer::FrequencyHz() {
+    return Arch::Timer::FrequencyHz();
+  }
+
+  UInt64 Timer::Now() {
+    return Arch::Timer::Now();
+  }
+
+  UInt64 Timer::TicksToCounts(UInt64 ticks) {
+    return Arch::Timer::TicksToCounts(ticks);
+  }
+
+  UInt64 Timer::NanosecondsToCounts(UInt64 nanoseconds) {
+    return Arch::Timer::NanosecondsToCounts(nanoseconds);
+  }
+
+  UInt64 Timer::Nanoseconds() {
+    return Arch::Timer::Nanoseconds();
+  }
+
+  void Timer::Start(
+    TimerWheel::Entry& entry,
+    UInt64 deadline,
+    TimerWheel::Callback callback,
+    void* context
+  ) {
+    Arch::Thread::StartTimer(entry, deadline, callback, context);
+  }
+
+  bool Timer::Cancel(TimerWheel::Entry& entry) {
+    return Arch::Thread::CancelTimer(entry);
+  }
+}
@@ -0,0 +1,248 @@
+/**
+ * @file System/Kernel/TimerWheel.cpp
+ * @brief Hierarchical timer wheel for kernel deadlines.
+ * @author Brandon Belna <bbelna@aol.com>
+ * @copyright © 2025-2026 The Quantum OS Project
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "TimerWheel.hpp"
+
+namespace Quantum::System::Kernel {
+  static UInt32 LowestBit(UInt64 bits) {
+    UInt32 low = static_cast<UInt32>(bits);
+
+    if (low != 0) {
+      return static_cast<UInt32>(__builtin_ctz(low));
+    }
+
+    UInt32 high = static_cast<UInt32>(bits >> 32);
+
+    return 32 + static_cast<UInt32>(__builtin_ctz(high));
+  }
+
+  void TimerWheel::Initialize() {
+    _lock.Initialize();
+    _current = 0;
+
+    for (UInt32 level = 0; level < _levels; ++level) {
+      for (UInt32 slot = 0; slot < _slotCount; ++slot) {
+        _slots[level][slot] = nullptr;
+      }
+
+      _occupied[level] = 0;
+    }
+  }
+
+  void TimerWheel::Place(Entry& entry, UInt64 unit) {
+    UInt64 delta = unit - _current;
+    UInt32 level = 0;
+
+    while (
+      level < _levels - 1
+      && delta >= (1ull << (_slotBits * (level + 1)))
+    ) {
+      ++level;
+    }
+
+    UInt64 span = 1ull << (_slotBits * _levels);
+
+    if (delta >= span) {
+      unit = _current + span - 1;
+    }
+
+    UInt32 slot = static_cast<UInt32>(unit >> (_slotBits * level))
+      & (_slotCount - 1);
+    Entry*& head = _slots[level][slot];
+
+    entry.prev = nullptr;
+    entry.next = head;
+    entry.level = static_cast<UInt8>(level);
+    entry.slot = static_cast<UInt8>(slot);
+    entry.pending = true;
+
+    if (head) {
+      head->prev = &entry;
+    }
+
+    head = &entry;
+    _occupied[level] |= 1ull << slot;
+  }
+
+  void TimerWheel::Unlink(Entry& entry) {
+    Entry*& head = _slots[entry.level][entry.slot];
+
+    if (entry.prev) {
+      entry.prev->next = entry.next;
+    } else {
+      head = entry.next;
+    }
+
+    if (entry.next) {
+      entry.next->prev = entry.prev;
+    }
+
+    if (head == nullptr) {
+      _occupied[entry.level] &= ~(1ull << entry.slot);
+    }
+
+    entry.next = nullptr;
+    entry.prev = nullptr;
+    entry.pending = false;
+  }
+
+  void TimerWheel::Insert(
+    Entry& entry,
+    UInt64 expires,
+    Callback callback,
+    void* context
+  ) {
+    UInt64 mask = (1ull << unitShift) - 1;
+    UInt64 unit = (expires + mask) >> unitShift;
+    UInt32 flags = 0;
+
+    _lock.AcquireIRQSave(flags);
+
+    if (entry.pending) {
+      Unlink(entry);
+    }
+
+    entry.expires = expires;
+    entry.callback = callback;
+    entry.context = context;
+
+    // units up to `_current` are already processed, so the earliest a new
+    // timer can fire is the next one
+    Place(entry, unit > _current ? unit : _current + 1);
+
+    _lock.ReleaseIRQRestore(flags);
+  }
+
+  bool TimerWheel::Remove(Entry& entry) {
+    UInt32 flags = 0;
+
+    _lock.AcquireIRQSave(flags);
+
+    bool pending = entry.pending;
+
+    if (pending) {
+      Unlink(entry);
+    }
+
+    _lock.ReleaseIRQRestore(flags);
+
+    return pending;
+  }
+
+  void TimerWheel::Cascade() {
+    UInt64 mask = (1ull << unitShift) - 1;
+
+    for (UInt32 level = 1; level < _levels; ++level) {
+      UInt32 shift = _slotBits * level;
+
+      if ((_current & ((1ull << shift) - 1)) != 0) {
+        break;
+      }
+
+      UInt32 slot = static_cast<UInt32>(_current >> shift) & (_slotCount - 1);
+      Entry* entry = _slots[level][slot];
+
+      _slots[level][slot] = nullptr;
+      _occupied[level] &= ~(1ull << slot);
+
+      while (entry) {
+        Entry* next = entry->next;
+        UInt64 unit = (entry->expires + mask) >> unitShift;
+
+        // entries due now land in the level 0 slot about to be run
+        Place(*entry, unit > _current ? unit : _current);
+
+        entry = next;
+      }
+    }
+  }
+
+  UInt64 TimerWheel::NextUnit() {
+    UInt64 next = 0;
+
+    for (UInt32 level = 0; level < _levels; ++level) {
+      UInt64 bits = _occupied[level];
+
+      if (bits == 0) {
+        continue;
+      }
+
+      UInt32 shift = _slotBits * level;
+      UInt64 base = _current >> shift;
+      UInt32 start = static_cast<UInt32>(base + 1) & (_slotCount - 1);
+
+      // rotate so bit 0 is the slot after the current one
+      UInt64 rotated = start == 0
+        ? bits
+        : (bits >> start) | (bits << (_slotCount - start));
+      UInt64 unit = (base + LowestBit(rotated) + 1) << shift;
+
+      if (next == 0 || unit < next) {
+        next = unit;
+      }
+    }
+
+    return next;
+  }
+
+  void TimerWheel::Advance(UInt64 now) {
+    UInt64 nowUnit = now >> unitShift;
+    UInt32 flags = 0;
+
+    _lock.AcquireIRQSave(flags);
+
+    for (;;) {
+      UInt64 next = NextUnit();
+
+      // nothing comes due in between, so the wheel can jump ahead
+      if (next == 0 || next > nowUnit) {
+        if (nowUnit > _current) {
+          _current = nowUnit;
+        }
+
+        break;
+      }
+
+      _current = next;
+
+      Cascade();
+
+      UInt32 slot = static_cast<UInt32>(_current) & (_slotCount - 1);
+
+      while (_slots[0][slot]) {
+        Entry* entry = _slots[0][slot];
+        Callback callback = entry->callback;
+        void* context = entry->context;
+
+        Unlink(*entry);
+
+        _lock.ReleaseIRQRestore(flags);
+
+        if (callback) {
+          callback(context);
+        }
+
+        _lock.AcquireIRQSave(flags);
+      }
+    }
+
+    _lock.ReleaseIRQRestore(flags);
+  }
+
+  UInt64 TimerWheel::NextDeadline() {
+    UInt32 flags = 0;
+
+    _lock.AcquireIRQSave(flags);
+
+    UInt64 next = NextUnit();
+
+    _lock.ReleaseIRQRestore(flags);
+
+    return next << unitShift;
+  }
+}
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "Sync/ScopedIRQLock.hpp"
+#include "Timer.hpp"
 #include "WaitQueue.hpp"
 
 namespace Quantum::System::Kernel {
@@ -15,97 +17,142 @@ namespace Quantum::System::Kernel {
     _tail = nullptr;
   }
 
+  bool WaitQueue::Unlink(Thread::ControlBlock* thread) {
+    Thread::ControlBlock* prev = nullptr;
+    Thread::ControlBlock* current = _head;
+
+    while (current) {
+      if (current == thread) {
+        if (prev) {
+          prev->waitNext = current->waitNext;
+        } else {
+          _head = current->waitNext;
+        }
+
+        if (_tail == current) {
+          _tail = prev;
+        }
+
+        current->waitNext = nullptr;
+        current->waitQueued = false;
+
+        return true;
+      }
+
+      prev = current;
+      current = current->waitNext;
+    }
+
+    return false;
+  }
+
   void WaitQueue::EnqueueCurrent() {
+    Prepare();
+    Wait(0);
+  }
+
+  bool WaitQueue::WaitTicks(UInt32 ticks) {
+    if (ticks == 0) {
+      return false;
+    }
+
+    Prepare();
+
+    return Wait(Timer::Ticks() + ticks);
+  }
+
+  void WaitQueue::Prepare() {
     Thread::ControlBlock* thread = Thread::GetCurrent();
 
     if (thread == nullptr) {
       return;
     }
 
-    {
-      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
 
-      thread->waitNext = nullptr;
-      thread->state = Thread::State::Blocked;
-
-      if (_tail == nullptr) {
-        _head = thread;
-        _tail = thread;
-      } else {
-        _tail->waitNext = thread;
-        _tail = thread;
-      }
+    if (thread->waitQueued) {
+      return;
     }
 
-    Thread::Yield();
+    thread->waitNext = nullptr;
+    thread->waitQueued = true;
+
+    if (_tail == nullptr) {
+      _head = thread;
+      _tail = thread;
+    } else {
+      _tail->waitNext = thread;
+      _tail = thread;
+    }
   }
 
-  bool WaitQueue::WaitTicks(UInt32 ticks) {
+  bool WaitQueue::Wait(UInt64 deadlineTick) {
+    return WaitUntil(
+      deadlineTick != 0 ? Timer::TicksToCounts(deadlineTick) : 0
+    );
+  }
+
+  bool WaitQueue::WaitUntil(UInt64 deadline) {
     Thread::ControlBlock* thread = Thread::GetCurrent();
 
     if (thread == nullptr) {
       return false;
     }
 
-    if (ticks == 0) {
-      return false;
+    UInt32 flags = 0;
+
+    _lock.AcquireIRQSave(flags);
+
+    if (!thread->waitQueued) {
+      _lock.ReleaseIRQRestore(flags);
+
+      return true;
     }
 
-    {
-      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+    // a wakeup that lands between dropping the lock and blocking (possibly
+    // from another processor) is recorded by Wake(), so BlockUntil returns
+    // at once; an early return for any other reason just blocks again
+    while (
+      thread->waitQueued
+      && (deadline == 0 || Timer::Now() < deadline)
+    ) {
+      _lock.Release();
 
-      thread->waitNext = nullptr;
-      thread->state = Thread::State::Blocked;
-
-      if (_tail == nullptr) {
-        _head = thread;
-        _tail = thread;
-      } else {
-        _tail->waitNext = thread;
-        _tail = thread;
-      }
+      Thread::BlockUntil(deadline);
+
+      _lock.Acquire();
     }
 
-    Thread::SleepTicks(ticks);
+    bool woken = !thread->waitQueued;
 
-    bool removed = false;
+    if (!woken) {
+      Unlink(thread);
+    }
 
-    {
-      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
-      Thread::ControlBlock* prev = nullptr;
-      Thread::ControlBlock* current = _head;
-
-      while (current) {
-        if (current == thread) {
-          if (prev) {
-            prev->waitNext = current->waitNext;
-          } else {
-            _head = current->waitNext;
-          }
-
-          if (_tail == current) {
-            _tail = prev;
-          }
-
-          current->waitNext = nullptr;
-          removed = true;
-
-          break;
-        }
+    _lock.ReleaseIRQRestore(flags);
 
-        prev = current;
-        current = current->waitNext;
-      }
+    return woken;
+  }
+
+  void WaitQueue::Cancel() {
+    Thread::ControlBlock* thread = Thread::GetCurrent();
+
+    if (thread == nullptr) {
+      return;
     }
 
-    return !removed;
+    Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
+
+    if (thread->waitQueued) {
+      Unlink(thread);
+    }
   }
 
-  bool WaitQueue::WakeOne() {
+  bool WaitQueue::WakeOne(bool boost) {
     Thread::ControlBlock* thread = nullptr;
 
     {
-      Sync::ScopedLock<Sync::SpinLock> guard(_lock);
+      Sync::ScopedIRQLock<Sync::SpinLock> guard(_lock);
 
       if (_head == nullptr) {
         return false;
@@ -119,9 +166,10 @@ namespace Quantum::System::Kernel {
       }
 
       thread->waitNext = nullptr;
+      thread->waitQueued = false;
     }
 
-    Thread::Wake(thread);
+    Thread::Wake(thread, boost);
 
     return true;
   }